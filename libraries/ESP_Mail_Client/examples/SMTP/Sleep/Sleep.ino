@@ -248,6 +248,15 @@ void setup()
     /* Set the callback function to get the sending results */
     smtp.callback(smtpCallback);
 
+    /** Keep the TLS session in RTC memory to resume it after wake up
+     * which skips the full TLS handshake.
+     * The RTC memory storage is available on ESP32 only, other devices
+     * can use esp_mail_session_cache_storage_flash instead.
+     */
+#if defined(ESP32)
+    MailClient.setSessionCache(true, 3600, esp_mail_session_cache_storage_rtc);
+#endif
+
     sendEmail();
 
     // Sleep for 60 seconds
@@ -137,11 +137,11 @@ bool ESP_Mail_Client::sessionExisted(T sessionPtr)
 #if defined(ENABLE_SMTP) || defined(ENABLE_IMAP)
 
   Session_Config *config = sessionPtr->_session_cfg;
-  _vectorImpl<int> *configPtrList = &(sessionPtr->_configPtrList);
+  _vectorImpl<uintptr_t> *configPtrList = &(sessionPtr->_configPtrList);
 
   if (config)
   {
-    int ptr = toAddr(*config);
+    uintptr_t ptr = toAddr(*config);
     for (size_t i = 0; i < configPtrList->size(); i++)
     {
       if ((*configPtrList)[i] == ptr)
@@ -558,6 +558,209 @@ bool ESP_Mail_Client::validEmail(const char *s)
   return (at != MB_String::npos) && (dot != MB_String::npos);
 }
 
+#if defined(ESP_MAIL_SESSION_CACHE_ENABLED)
+
+#if defined(ESP32)
+// Retained during deep sleep, the magic number tells whether it is valid
+RTC_DATA_ATTR static esp_mail_session_cache_t esp_mail_rtc_session_cache;
+#endif
+
+void ESP_Mail_Client::setSessionCache(bool enable, uint32_t lifetime, esp_mail_session_cache_storage_type storage)
+{
+  freeSessionCache();
+
+  if (!enable)
+    return;
+
+#if !defined(ESP32)
+  if (storage == esp_mail_session_cache_storage_rtc)
+    storage = esp_mail_session_cache_storage_memory;
+#endif
+
+  sessionCacheLifetime = lifetime;
+  sessionCacheStorage = storage;
+
+#if defined(ESP32)
+  if (storage == esp_mail_session_cache_storage_rtc)
+    sessionCache = &esp_mail_rtc_session_cache;
+  else
+#endif
+    sessionCache = allocMem<esp_mail_session_cache_t *>(sizeof(esp_mail_session_cache_t));
+
+  if (!sessionCache)
+    return;
+
+  if (sessionCache->magic != ESP_MAIL_SESSION_CACHE_MAGIC)
+  {
+    memset(sessionCache, 0, sizeof(esp_mail_session_cache_t));
+    sessionCache->magic = ESP_MAIL_SESSION_CACHE_MAGIC;
+  }
+
+  if (storage == esp_mail_session_cache_storage_flash)
+    readSessionCacheFile();
+}
+
+void ESP_Mail_Client::clearSessionCache()
+{
+  if (!sessionCache)
+    return;
+
+  memset(sessionCache->entries, 0, sizeof(sessionCache->entries));
+  sessionCache->tick = 0;
+
+  if (sessionCacheStorage == esp_mail_session_cache_storage_flash)
+    writeSessionCacheFile();
+}
+
+uint32_t ESP_Mail_Client::sessionCacheHits()
+{
+  return sessionCache ? sessionCache->hits : 0;
+}
+
+uint32_t ESP_Mail_Client::sessionCacheMisses()
+{
+  return sessionCache ? sessionCache->misses : 0;
+}
+
+void ESP_Mail_Client::freeSessionCache()
+{
+  if (sessionCache && sessionCacheStorage != esp_mail_session_cache_storage_rtc)
+    freeMem(&sessionCache);
+  sessionCache = nullptr;
+}
+
+int ESP_Mail_Client::findSessionCache(const char *host, uint16_t port)
+{
+  for (int i = 0; sessionCache && i < ESP_MAIL_SESSION_CACHE_SIZE; i++)
+  {
+    esp_mail_session_cache_entry_t &entry = sessionCache->entries[i];
+    if (entry.used > 0 && entry.port == port && strcmp(entry.host, host) == 0)
+      return i;
+  }
+  return -1;
+}
+
+template <class T>
+void ESP_Mail_Client::restoreSessionCache(Session_Config *session_config, T sessionPtr)
+{
+  if (!sessionCache)
+    return;
+
+  int index = findSessionCache(session_config->server.host_name.c_str(), session_config->server.port);
+
+  if (index > -1 && sessionCacheLifetime > 0)
+  {
+    // Drop the expired session, or the one stored before the time was set as its age is unknown
+    uint32_t ts = sessionCache->entries[index].ts;
+    if (ts == 0 || (Time.timeReady() && Time.getCurrentTimestamp() > (uint64_t)ts + sessionCacheLifetime))
+    {
+      memset(&sessionCache->entries[index], 0, sizeof(esp_mail_session_cache_entry_t));
+      index = -1;
+    }
+  }
+
+  // The hit or miss is counted after the handshake, when the server resumed the session or not
+  if (index > -1)
+  {
+    memcpy(sessionPtr->_bsslSession.getSession(), &sessionCache->entries[index].params, sizeof(br_ssl_session_parameters));
+    sessionCache->entries[index].used = ++sessionCache->tick;
+  }
+  else
+  {
+    // Don't offer the session of other server
+    memset(sessionPtr->_bsslSession.getSession(), 0, sizeof(br_ssl_session_parameters));
+  }
+
+#if defined(SESSION_DEBUG_ENABLED)
+  if (sessionPtr->_debug && !isResponseCB<T>(sessionPtr))
+  {
+    MB_String dbMsg = esp_mail_dbg_str_84; /* "TLS session cache hit/miss > " */
+    dbMsg += sessionCache->hits;
+    dbMsg += '/';
+    dbMsg += sessionCache->misses;
+    esp_mail_debug_print_tag(dbMsg.c_str(), esp_mail_debug_tag_type_client, true);
+  }
+#endif
+}
+
+void ESP_Mail_Client::storeSessionCache(Session_Config *session_config, BearSSL_Session *session)
+{
+  if (!sessionCache || !session_config)
+    return;
+
+  br_ssl_session_parameters *params = session->getSession();
+
+  int index = findSessionCache(session_config->server.host_name.c_str(), session_config->server.port);
+
+  // The server resumed the offered session when it accepted its session ID
+  if (index > -1 && params->session_id_len > 0 && sessionCache->entries[index].params.session_id_len == params->session_id_len &&
+      memcmp(sessionCache->entries[index].params.session_id, params->session_id, params->session_id_len) == 0)
+  {
+    sessionCache->hits++;
+    sessionCache->entries[index].used = ++sessionCache->tick;
+    return;
+  }
+
+  sessionCache->misses++;
+
+  // The server did not issue the session ID
+  if (params->session_id_len == 0 || session_config->server.host_name.length() >= ESP_MAIL_SESSION_CACHE_HOST_LEN)
+    return;
+
+  // Take the free entry or the least recently used one
+  if (index == -1)
+  {
+    index = 0;
+    for (int i = 1; i < ESP_MAIL_SESSION_CACHE_SIZE; i++)
+    {
+      if (sessionCache->entries[i].used < sessionCache->entries[index].used)
+        index = i;
+    }
+  }
+
+  esp_mail_session_cache_entry_t &entry = sessionCache->entries[index];
+  memset(&entry, 0, sizeof(esp_mail_session_cache_entry_t));
+  strcpy(entry.host, session_config->server.host_name.c_str());
+  entry.port = session_config->server.port;
+  entry.ts = Time.timeReady() ? (uint32_t)Time.getCurrentTimestamp() : 0;
+  entry.used = ++sessionCache->tick;
+  memcpy(&entry.params, params, sizeof(br_ssl_session_parameters));
+
+  if (sessionCacheStorage == esp_mail_session_cache_storage_flash)
+    writeSessionCacheFile();
+}
+
+void ESP_Mail_Client::readSessionCacheFile()
+{
+#if defined(MBFS_FLASH_FS)
+  MB_String filename = ESP_MAIL_SESSION_CACHE_FILE;
+  if (mbfs->open(filename, mbfs_type mb_fs_mem_storage_type_flash, mb_fs_open_mode_read) == (int)sizeof(esp_mail_session_cache_t))
+  {
+    if (mbfs->read(mbfs_type mb_fs_mem_storage_type_flash, (uint8_t *)sessionCache, sizeof(esp_mail_session_cache_t)) != (int)sizeof(esp_mail_session_cache_t) ||
+        sessionCache->magic != ESP_MAIL_SESSION_CACHE_MAGIC)
+    {
+      memset(sessionCache, 0, sizeof(esp_mail_session_cache_t));
+      sessionCache->magic = ESP_MAIL_SESSION_CACHE_MAGIC;
+    }
+  }
+  mbfs->close(mbfs_type mb_fs_mem_storage_type_flash);
+#endif
+}
+
+void ESP_Mail_Client::writeSessionCacheFile()
+{
+#if defined(MBFS_FLASH_FS)
+  MB_String filename = ESP_MAIL_SESSION_CACHE_FILE;
+  if (mbfs->open(filename, mbfs_type mb_fs_mem_storage_type_flash, mb_fs_open_mode_write) > -1)
+  {
+    mbfs->write(mbfs_type mb_fs_mem_storage_type_flash, (uint8_t *)sessionCache, sizeof(esp_mail_session_cache_t));
+    mbfs->close(mbfs_type mb_fs_mem_storage_type_flash);
+  }
+#endif
+}
+
+#endif
+
 #if defined(ENABLE_SMTP) && defined(ENABLE_IMAP)
 
 bool ESP_Mail_Client::mAppendMessage(IMAPSession *imap, SMTP_Message *msg, bool lastAppend, MB_StringPtr flags, MB_StringPtr dateTime)
@@ -1016,6 +1219,48 @@ int ESP_Mail_Client::readLine(ESP_Mail_TCPClient *client, char *buf, int bufLen,
 
     yield_impl();
 
+    // Scan the decrypted data in place when available.
+    size_t avail = 0;
+    const char *p = client->peekBuffer(avail);
+    if (p)
+    {
+      size_t n = 0;
+      while (n < avail)
+      {
+        c = p[n++];
+        buf[idx++] = c;
+        count++;
+        if (_c == '\r' && c == '\n')
+        {
+          lineBreak = true;
+          break;
+        }
+        _c = c;
+
+        if (idx >= bufLen - 1)
+        {
+          ovf = true;
+          break;
+        }
+      }
+      client->peekConsume(n);
+
+      if (lineBreak)
+      {
+        if (!withLineBreak)
+        {
+          buf[idx - 2] = 0;
+          idx -= 2;
+        }
+        return idx;
+      }
+
+      if (ovf)
+        return idx;
+
+      continue;
+    }
+
     ret = client->read();
     if (ret > -1)
     {
@@ -1294,6 +1539,12 @@ bool ESP_Mail_Client::beginConnection(Session_Config *session_config, T sessionP
   if (!reconnect<T>(sessionPtr))
     return false;
 
+#if defined(ESP_MAIL_SESSION_CACHE_ENABLED)
+  // The session is also used by STARTTLS upgrade
+  if (session_config->secure.mode != esp_mail_secure_mode_nonsecure)
+    restoreSessionCache<T>(session_config, sessionPtr);
+#endif
+
 #if defined(SESSION_DEBUG_ENABLED)
   if (sessionPtr->_debug && !isResponseCB<T>(sessionPtr))
   {
@@ -1332,6 +1583,11 @@ bool ESP_Mail_Client::beginConnection(Session_Config *session_config, T sessionP
     }
   }
 
+#if defined(ESP_MAIL_SESSION_CACHE_ENABLED)
+  if (secureMode)
+    storeSessionCache(session_config, &(sessionPtr->_bsslSession));
+#endif
+
   return true;
 }
 
@@ -1427,7 +1683,7 @@ bool ESP_Mail_Client::sessionReady(T sessionPtr)
 
 void ESP_Mail_Client::setCert(Session_Config *session_config, const char *ca)
 {
-  int ptr = reinterpret_cast<int>(ca);
+  uintptr_t ptr = reinterpret_cast<uintptr_t>(ca);
   if (ptr != session_config->cert_ptr)
   {
     session_config->cert_updated = true;
@@ -1585,6 +1841,9 @@ String ESP_Mail_Client::errorReason(bool isSMTP, int errorCode, const char *msg)
   case SMTP_STATUS_UNDEFINED:
     ret = esp_mail_error_smtp_str_12; /* "undefined error" */
     break;
+  case SMTP_STATUS_SEND_RESET_FAILED:
+    ret = esp_mail_error_smtp_str_13; /* "reset transaction failed" */
+    break;
 #endif
 
 #if defined(ENABLE_IMAP)
@@ -1812,87 +2071,26 @@ MB_String ESP_Mail_Client::getXOAUTH2String(const MB_String &email, const MB_Str
 
 unsigned char *ESP_Mail_Client::decodeBase64(const unsigned char *src, size_t len, size_t *out_len)
 {
-  unsigned char *out, *pos, block[4], tmp;
-  size_t i, count, olen;
-  int pad = 0;
-  size_t extra_pad;
-
-  unsigned char *dtable = allocMem<unsigned char *>(256);
-
-  memset(dtable, 0x80, 256);
+  mb_b64_dec_state st;
 
-  for (i = 0; i < sizeof(b64_index_table) - 1; i++)
-    dtable[b64_index_table[i]] = (unsigned char)i;
-  dtable['='] = 0;
-
-  count = 0;
-  for (i = 0; i < len; i++)
-  {
-    if (dtable[src[i]] != 0x80)
-      count++;
-  }
-
-  if (count == 0)
-    goto exit;
-
-  extra_pad = (4 - count % 4) % 4;
-
-  olen = (count + extra_pad) / 4 * 3;
-
-  pos = out = allocMem<unsigned char *>(olen);
+  // the extra byte keeps the decoded text null terminated
+  unsigned char *out = allocMem<unsigned char *>(mb_b64_dec_len(len) + 1);
 
   if (out == NULL)
-    goto exit;
+    return nullptr;
 
-  count = 0;
+  size_t olen = mb_b64_dec_update(st, src, len, out);
+  olen += mb_b64_dec_final(st, out + olen);
 
-  for (i = 0; i < len + extra_pad; i++)
+  if (st.error || olen == 0)
   {
-    unsigned char val;
-
-    if (i >= len)
-      val = '=';
-    else
-      val = src[i];
-    tmp = dtable[val];
-    if (tmp == 0x80)
-      continue;
-
-    if (val == '=')
-      pad++;
-    block[count] = tmp;
-    count++;
-    if (count == 4)
-    {
-      *pos++ = (block[0] << 2) | (block[1] >> 4);
-      *pos++ = (block[1] << 4) | (block[2] >> 2);
-      *pos++ = (block[2] << 6) | block[3];
-      count = 0;
-      if (pad)
-      {
-        if (pad == 1)
-          pos--;
-        else if (pad == 2)
-          pos -= 2;
-        else
-        {
-          // release memory
-          free(out);
-          goto exit;
-        }
-        break;
-      }
-    }
+    // release memory
+    freeMem(&out);
+    return nullptr;
   }
 
-  *out_len = pos - out;
-  // release memory
-  freeMem(&dtable);
+  *out_len = olen;
   return out;
-exit:
-  // release memory
-  freeMem(&dtable);
-  return nullptr;
 }
 
 MB_String ESP_Mail_Client::encodeBase64Str(const unsigned char *src, size_t len)
@@ -1903,43 +2101,12 @@ MB_String ESP_Mail_Client::encodeBase64Str(const unsigned char *src, size_t len)
 MB_String ESP_Mail_Client::encodeBase64Str(uint8_t *src, size_t len)
 {
   MB_String outStr;
-  unsigned char *out, *pos;
-  const unsigned char *end, *in;
-  size_t olen = 4 * ((len + 2) / 3);
+  size_t olen = mb_b64_enc_len(len, false);
   if (olen < len)
     return outStr;
 
   outStr.resize(olen);
-  out = (unsigned char *)&outStr[0];
-
-  end = src + len;
-  in = src;
-  pos = out;
-
-  while (end - in >= 3)
-  {
-    *pos++ = b64_index_table[in[0] >> 2];
-    *pos++ = b64_index_table[((in[0] & 0x03) << 4) | (in[1] >> 4)];
-    *pos++ = b64_index_table[((in[1] & 0x0f) << 2) | (in[2] >> 6)];
-    *pos++ = b64_index_table[in[2] & 0x3f];
-    in += 3;
-  }
-
-  if (end - in)
-  {
-    *pos++ = b64_index_table[in[0] >> 2];
-    if (end - in == 1)
-    {
-      *pos++ = b64_index_table[(in[0] & 0x03) << 4];
-      *pos++ = '=';
-    }
-    else
-    {
-      *pos++ = b64_index_table[((in[0] & 0x03) << 4) | (in[1] >> 4)];
-      *pos++ = b64_index_table[(in[1] & 0x0f) << 2];
-    }
-    *pos++ = '=';
-  }
+  mb_b64_enc(src, len, (uint8_t *)&outStr[0]);
 
   return outStr;
 }
@@ -33,6 +33,7 @@
 
 #include <Arduino.h>
 #include "extras/RFC2047.h"
+#include "extras/MB_Base64.h"
 #include <time.h>
 #include <ctype.h>
 
@@ -98,6 +99,34 @@ extern char *__brkval;
 
 using namespace mb_string;
 
+#if (defined(ENABLE_SMTP) || defined(ENABLE_IMAP)) && !defined(ESP_MAIL_DISABLE_SSL)
+
+#define ESP_MAIL_SESSION_CACHE_ENABLED
+
+/* The TLS session cache entry */
+struct esp_mail_session_cache_entry_t
+{
+  char host[ESP_MAIL_SESSION_CACHE_HOST_LEN];
+  uint16_t port;
+  // The timestamp when session was stored, 0 when time is not set
+  uint32_t ts;
+  // The access order for LRU eviction, 0 for free entry
+  uint32_t used;
+  br_ssl_session_parameters params;
+};
+
+/* The TLS session cache shared by all sessions */
+struct esp_mail_session_cache_t
+{
+  uint32_t magic;
+  uint32_t tick;
+  uint32_t hits;
+  uint32_t misses;
+  esp_mail_session_cache_entry_t entries[ESP_MAIL_SESSION_CACHE_SIZE];
+};
+
+#endif
+
 class IMAPSession;
 class SMTPSession;
 class SMTP_Status;
@@ -781,6 +810,10 @@ public:
 
   ~ESP_Mail_Client()
   {
+#if defined(ESP_MAIL_SESSION_CACHE_ENABLED)
+    freeSessionCache();
+#endif
+
     if (mbfs)
       delete mbfs;
     mbfs = nullptr;
@@ -799,6 +832,23 @@ public:
    * @return The boolean value indicates the success of operation.
    */
   bool sendMail(SMTPSession *smtp, SMTP_Message *msg, bool closeSession = true);
+
+  /** Sending multiple Emails through the same SMTP connection
+   *
+   * @param smtp The pointer to SMTP session object which holds the data and the
+   * TCP client.
+   * @param msgs The array of SMTP_Message class which contains the header,
+   * body, and attachments of each message.
+   * @param count The number of messages in array.
+   * @param closeSession The option to Close the SMTP session after all messages were sent.
+   * @return The boolean value indicates all messages were sent successfully.
+   *
+   * The sending results of all messages are kept in SMTPSession's sendingResult.
+   * The session is kept when server rejected the message and RSET command will be sent
+   * before the next message. The MAIL and RCPT commands are sent in one round trip
+   * when server supports PIPELINING extension.
+   */
+  bool sendMails(SMTPSession *smtp, SMTP_Message *msgs, size_t count, bool closeSession = true);
 #endif
 
 #if defined(ENABLE_SMTP) && defined(ENABLE_IMAP)
@@ -1047,6 +1097,57 @@ public:
   template <typename T = const char *>
   String toBase64(T str) { return mGetBase64(toStringPtr(str)).c_str(); }
 
+  /** Decode the base64 encoded data.
+   *
+   * @param src The base64 encoded data.
+   * @param len The length of data.
+   * @param out_len The length of decoded data.
+   * @return The null terminated decoded data that must be freed, or nullptr if the data is not valid.
+   */
+  unsigned char *decodeBase64(const unsigned char *src, size_t len, size_t *out_len);
+
+  /** Encode the data to base64.
+   *
+   * @param src The data to encode.
+   * @param len The length of data.
+   * @return The base64 encoded string.
+   */
+  MB_String encodeBase64Str(const unsigned char *src, size_t len);
+  MB_String encodeBase64Str(uint8_t *src, size_t len);
+
+#if defined(ESP_MAIL_SESSION_CACHE_ENABLED)
+  /** Enable the TLS session cache shared by all SMTP and IMAP sessions.
+   *
+   * @param enable The option to enable the session cache.
+   * @param lifetime The session lifetime in seconds, 0 for no expiry. The sessions stored
+   * before the device time was set will not be resumed when lifetime is set.
+   * @param storage The esp_mail_session_cache_storage_type enum to keep the sessions
+   * in heap memory, RTC memory (ESP32 only) or flash file.
+   *
+   * The sessions are keyed by host and port and will be resumed on the next connection
+   * to the same server to skip the full TLS handshake e.g. after deep sleep wake up.
+   */
+  void setSessionCache(bool enable, uint32_t lifetime = 3600, esp_mail_session_cache_storage_type storage = esp_mail_session_cache_storage_memory);
+
+  /** Remove all sessions from the TLS session cache.
+   *
+   */
+  void clearSessionCache();
+
+  /** Get the number of TLS handshakes that resumed the session from TLS session cache.
+   *
+   * @return The number of cache hits.
+   */
+  uint32_t sessionCacheHits();
+
+  /** Get the number of TLS handshakes that did not resume the session from TLS session cache,
+   * because there was no session or the server refused it.
+   *
+   * @return The number of cache misses.
+   */
+  uint32_t sessionCacheMisses();
+#endif
+
   MB_Time Time;
 
 #if defined(ENABLE_IMAP)
@@ -1060,6 +1161,9 @@ public:
   // Decode TIS620 to UTF-8
   void decodeTIS620_UTF8(char *out, const char *in, size_t len);
 
+  // Decode Quoted Printable string
+  void decodeQP_UTF8(const char *buf, char *out);
+
   // handle rfc2047 Q (quoted printable) and B (base64) decodings
   RFC2047_Decoder RFC2047Decoder;
 
@@ -1158,6 +1262,31 @@ private:
   // Get and set timezone
   void getSetTimezoneEnv(const char *TZ_file, const char *TZ_Var);
 
+#if defined(ESP_MAIL_SESSION_CACHE_ENABLED)
+
+  esp_mail_session_cache_t *sessionCache = nullptr;
+  esp_mail_session_cache_storage_type sessionCacheStorage = esp_mail_session_cache_storage_memory;
+  uint32_t sessionCacheLifetime = 0;
+
+  // Get the cache entry index of host and port or -1 if not found
+  int findSessionCache(const char *host, uint16_t port);
+
+  // Copy the cached session of server to the TLS session
+  template <class T>
+  void restoreSessionCache(Session_Config *session_config, T sessionPtr);
+
+  // Store the TLS session of server after handshake
+  void storeSessionCache(Session_Config *session_config, BearSSL_Session *session);
+
+  // Read and write the session cache flash file
+  void readSessionCacheFile();
+  void writeSessionCacheFile();
+
+  // Free the session cache
+  void freeSessionCache();
+
+#endif
+
   // Get TCP connected status
   template <class T>
   bool connected(T sessionPtr);
@@ -1174,15 +1303,6 @@ private:
   // Spit the string into token strings
   void splitToken(const char *str, _vectorImpl<MB_String> &tk, const char *delim);
 
-  // Decode base64 encoded string
-  unsigned char *decodeBase64(const unsigned char *src, size_t len, size_t *out_len);
-
-  // Decode base64 encoded string
-  MB_String encodeBase64Str(const unsigned char *src, size_t len);
-
-  // Decode base64 encoded string
-  MB_String encodeBase64Str(uint8_t *src, size_t len);
-
   // Decode base64 encoded string
   MB_String mGetBase64(MB_StringPtr str);
   
@@ -1360,6 +1480,15 @@ private:
   // Handle the error by sending callback and close session
   bool handleSMTPError(SMTPSession *smtp, int err, bool ret = false);
 
+  // Send RSET command to clear the failed transaction
+  bool smtpReset(SMTPSession *smtp);
+
+  // Send MAIL or RCPT command or queue it when pipelining
+  bool sendEnvelopeCommand(SMTPSession *smtp, SMTP_Message *msg, MB_String &cmd, esp_mail_smtp_command type, int errCode);
+
+  // Send the queued MAIL and RCPT commands and read their responses
+  bool sendPipelinedCommands(SMTPSession *smtp, SMTP_Message *msg);
+
   // Send parallel attachment RFC1521
   bool sendParallelAttachments(SMTPSession *smtp, SMTP_Message *msg, const MB_String &boundary);
 
@@ -1460,13 +1589,13 @@ private:
   int chunkAvailable(SMTPSession *smtp, esp_mail_smtp_send_base64_data_info_t &data_info);
 
   // Read chunk data of blob or file
-  int getChunk(SMTPSession *smtp, esp_mail_smtp_send_base64_data_info_t &data_info, unsigned char *rawChunk, bool base64);
+  int getChunk(SMTPSession *smtp, esp_mail_smtp_send_base64_data_info_t &data_info, unsigned char *rawChunk, size_t len);
 
   // Terminate chunk reading
   void closeChunk(esp_mail_smtp_send_base64_data_info_t &data_info);
 
   // Get base64 encoded buffer or raw buffer
-  void getBuffer(bool base64, uint8_t *out, uint8_t *in, int &encodedCount, int &bufIndex, bool &dataReady, int &size, size_t chunkSize);
+  void getBuffer(bool base64, uint8_t *out, uint8_t *in, mb_b64_enc_state &b64, int &bufIndex, bool &dataReady, int &size, size_t chunkSize);
 
   // Send blob or file as base64 encoded chunk
   bool sendBase64(SMTPSession *smtp, SMTP_Message *msg, esp_mail_smtp_send_base64_data_info_t &data_info, bool base64, bool report);
@@ -1475,7 +1604,7 @@ private:
   void saveSendingLogs(SMTPSession *smtp, SMTP_Message *msg, bool result);
 
   // Get imap or smtp report progress var pointer
-  uint32_t altProgressPtr(SMTPSession *smtp);
+  uintptr_t altProgressPtr(SMTPSession *smtp);
 
   // Get SMTP response status (statusCode and text)
   void getResponseStatus(const char *buf, esp_mail_smtp_status_code statusCode, int beginPos, struct esp_mail_smtp_response_status_t &status);
@@ -1493,7 +1622,7 @@ private:
   bool handleSMTPResponse(SMTPSession *smtp, esp_mail_smtp_command cmd, esp_mail_smtp_status_code statusCode, int errCode);
 
   // Print the upload status to the debug port
-  void uploadReport(const char *filename, uint32_t pgAddr, int progress);
+  void uploadReport(const char *filename, uintptr_t pgAddr, int progress);
 
   // Get MB_FS object pointer
   MB_FS *getMBFS();
@@ -1511,9 +1640,6 @@ private:
   // Decode string
   int decodeChar(const char *s);
 
-  // Decode Quoted Printable string
-  void decodeQP_UTF8(const char *buf, char *out);
-
   // Actually not decode because 7bit string is enencode string unless prepare valid 7bit string and do qp decoding
   char *decode7Bit_UTF8(char *buf);
 
@@ -1598,7 +1724,7 @@ private:
   int countChar(const char *buf, char find);
 
   // Store the value to string via its the pointer
-  bool storeStringPtr(IMAPSession *imap, uint32_t addr, MB_String &value, const char *buf);
+  bool storeStringPtr(IMAPSession *imap, uintptr_t addr, MB_String &value, const char *buf);
 
   // Get part header properties
   bool getPartHeaderProperties(IMAPSession *imap, const char *buf, PGM_P p, PGM_P e, bool num, MB_String &value, MB_String &old_value, esp_mail_char_decoding_scheme &scheme, bool caseSensitive);
@@ -1618,6 +1744,9 @@ private:
 #if !defined(MB_USE_STD_VECTOR)
   // Decending sort
   void numDecSort(_vectorImpl<struct esp_mail_imap_msg_num_t> &arr);
+
+  // Min-heap sift down for numDecSort
+  void numSiftDown(_vectorImpl<struct esp_mail_imap_msg_num_t> &arr, size_t root, size_t size);
 #endif
 
   // Handle IMAP response
@@ -1641,22 +1770,34 @@ private:
   // Get IMAP response status e.g. OK, NO and Bad status enum value
   esp_mail_imap_response_status imapResponseStatus(IMAPSession *imap, char *response, PGM_P tag);
 
-  // Add header item to string buffer
-  void addHeaderItem(MB_String &str, esp_mail_message_header_t *header, bool json);
+  // Add header item to header writer
+  void addHeaderItem(esp_mail_header_writer_t &w, esp_mail_message_header_t *header);
 
   // Get RFC822 header string pointer by index
-  int getRFC822HeaderPtr(int index, esp_mail_imap_rfc822_msg_header_item_t *header);
+  uintptr_t getRFC822HeaderPtr(int index, esp_mail_imap_rfc822_msg_header_item_t *header);
+
+  // Add RFC822 headers to header writer
+  void addRFC822Headers(esp_mail_header_writer_t &w, esp_mail_imap_rfc822_msg_header_item_t *header);
+
+  // Add RFC822 header item to header writer
+  void addRFC822HeaderItem(esp_mail_header_writer_t &w, esp_mail_imap_rfc822_msg_header_item_t *header, int index);
 
-  // Add RFC822 headers to string buffer
-  void addRFC822Headers(MB_String &s, esp_mail_imap_rfc822_msg_header_item_t *header, bool json);
+  // Add header string by name and value to header writer
+  void addHeader(esp_mail_header_writer_t &w, const char *name, const char *s_value, int num_value, bool trim);
 
-  // Add RFC822 header item to string buffer
-  void addRFC822HeaderItem(MB_String &s, esp_mail_imap_rfc822_msg_header_item_t *header, int index, bool json);
+  // Write the PROGMEM string to header writer
+  void writeHeader(esp_mail_header_writer_t &w, PGM_P str);
 
-  // Add header string by name and value to string buffer
-  void addHeader(MB_String &s, const char *name, const char *s_value, int num_value, bool trim, bool isJson);
+  // Write the number to header writer
+  void writeHeader(esp_mail_header_writer_t &w, int value);
 
-  // Save header string buffer to file
+  // Write the header value in RAM to header writer with JSON escaping
+  void writeHeaderValue(esp_mail_header_writer_t &w, const char *value, bool trim);
+
+  // Write the header writer buffered data to file
+  void flushHeader(esp_mail_header_writer_t &w);
+
+  // Stream the message headers to file
   void saveHeader(IMAPSession *imap, bool json);
 
   // Send MIME stream to callback
@@ -1671,6 +1812,9 @@ private:
   // Handle atachment parsing and download
   bool parseAttachmentResponse(IMAPSession *imap, char *buf, esp_mail_imap_response_data &res);
 
+  // Read the rest of attachment literal data in blocks and pass to the attachment parser
+  bool readAttachmentLiteral(IMAPSession *imap, esp_mail_imap_response_data &res);
+
   // Get List
   char *getList(char *buf, bool &isList);
 
@@ -2316,7 +2460,7 @@ private:
   bool _auth_capability[esp_mail_auth_capability_maxType];
   bool _feature_capability[esp_mail_imap_read_capability_maxType];
   Session_Config *_session_cfg;
-  _vectorImpl<int> _configPtrList;
+  _vectorImpl<uintptr_t> _configPtrList;
   MB_String _currentFolder;
   bool _mailboxOpened = false;
   unsigned long _lastSameFolderOpenMillis = 0;
@@ -2824,7 +2968,7 @@ private:
   bool _feature_capability[esp_mail_smtp_send_capability_maxType];
 
   Session_Config *_session_cfg = NULL;
-  _vectorImpl<int> _configPtrList;
+  _vectorImpl<uintptr_t> _configPtrList;
 
   bool _debug = false;
   int _debugLevel = 0;
@@ -2847,6 +2991,14 @@ private:
   int _lastProgress = -1;
   BearSSL_Session _bsslSession;
 
+  // Batch sending states
+  bool _batchSending = false;
+  bool _resetRequired = false;
+  bool _pipelining = false;
+  bool _pipelinedResponse = false;
+  MB_String _pipelinedCmds;
+  _vectorImpl<esp_mail_smtp_command> _pipelinedCmdTypes;
+
   ESP_Mail_TCPClient client;
 
   // Start TCP connection
@@ -66,6 +66,19 @@
 #define ESP_MAIL_CLIENT_RESPONSE_BUFFER_SIZE 1024 // should be 1 k or more to prevent buffer overflow
 #define ESP_MAIL_CLIENT_VALID_TS 1577836800
 
+// The write buffer size used when saving the message headers to file
+#if !defined(ESP_MAIL_HEADER_WRITE_BUFFER_SIZE)
+#define ESP_MAIL_HEADER_WRITE_BUFFER_SIZE 128
+#endif
+
+// The maximum number of TLS sessions in the shared session cache
+#if !defined(ESP_MAIL_SESSION_CACHE_SIZE)
+#define ESP_MAIL_SESSION_CACHE_SIZE 4
+#endif
+#define ESP_MAIL_SESSION_CACHE_HOST_LEN 64
+#define ESP_MAIL_SESSION_CACHE_MAGIC 0x54534331
+#define ESP_MAIL_SESSION_CACHE_FILE "/tls_sess.dat"
+
 #endif
 
 typedef struct esp_mail_client_static_address
@@ -118,6 +131,17 @@ enum esp_mail_file_storage_type
     esp_mail_file_storage_type_sd
 };
 
+/* The TLS session cache storage types enum */
+enum esp_mail_session_cache_storage_type
+{
+    // Keep in heap memory, lost on reboot
+    esp_mail_session_cache_storage_memory,
+    // Keep in RTC memory, retained during deep sleep (ESP32 only)
+    esp_mail_session_cache_storage_rtc,
+    // Keep in flash file, retained across reboot
+    esp_mail_session_cache_storage_flash
+};
+
 /* The session types enum */
 enum esp_mail_session_type
 {
@@ -241,6 +265,7 @@ enum esp_mail_smtp_command_types
     esp_mail_smtp_command_body,
     esp_mail_smtp_command_terminate,
     esp_mail_smtp_command_starttls,
+    esp_mail_smtp_command_rset,
     esp_mail_smtp_command_maxType
 };
 
@@ -885,7 +910,8 @@ const struct esp_mail_smtp_command_t smtp_commands[esp_mail_smtp_command_maxType
     "DELAY",
     "BODY",
     "\r\n.\r\n",
-    "STARTTLS"};
+    "STARTTLS",
+    "RSET"};
 
 struct esp_mail_smtp_commands_tokens
 {
@@ -1616,7 +1642,8 @@ enum esp_mail_smtp_command
     esp_mail_smtp_cmd_send_body,
     esp_mail_smtp_cmd_chunk_termination,
     esp_mail_smtp_cmd_logout,
-    esp_mail_smtp_cmd_custom
+    esp_mail_smtp_cmd_custom,
+    esp_mail_smtp_cmd_reset
 };
 
 /* SMTP message priority level enum */
@@ -2185,7 +2212,7 @@ struct esp_mail_message_part_info_t
     int nestedLevel = 0;
 
     // pointer to the MB_String for storing multi-line header field content.
-    uint32_t stringPtr = 0;
+    uintptr_t stringPtr = 0;
     esp_mail_char_decoding_scheme stringEnc = esp_mail_char_decoding_scheme_default;
 
     content_header_field cur_content_hdr = content_header_field_none;
@@ -2634,6 +2661,22 @@ public:
     }
 };
 
+// The writer that streams the message headers to the opened file through the fixed size buffer
+struct esp_mail_header_writer_t
+{
+public:
+    esp_mail_file_storage_type storageType = esp_mail_file_storage_type_none;
+    char buf[ESP_MAIL_HEADER_WRITE_BUFFER_SIZE];
+    size_t bufLen = 0;
+    size_t bytesWritten = 0;
+    int startHeap = 0;
+    int minHeap = 0;
+    bool json = false;
+    // no item was added to the current header object or section
+    bool first = true;
+    bool error = false;
+};
+
 #endif
 
 #if defined(ENABLE_SMTP) || defined(ENABLE_IMAP)
@@ -2781,7 +2824,7 @@ public:
         aremovePtr();
     }
 
-    void addPtr(_vectorImpl<int> *listPtr, int ptr)
+    void addPtr(_vectorImpl<uintptr_t> *listPtr, uintptr_t ptr)
     {
         if (listPtr)
         {
@@ -2803,7 +2846,7 @@ public:
     {
         if (listPtr)
         {
-            int ptr = toAddr(*this);
+            uintptr_t ptr = toAddr(*this);
             for (size_t i = 0; i < listPtr->size(); i++)
             {
                 if ((*listPtr)[i] == ptr)
@@ -2842,9 +2885,9 @@ public:
     }
 
 private:
-    int cert_ptr = 0;
+    uintptr_t cert_ptr = 0;
     bool cert_updated = false;
-    _vectorImpl<int> *listPtr = nullptr;
+    _vectorImpl<uintptr_t> *listPtr = nullptr;
 
     // Internal flags use to keep user sercure.startTLS and secure.mode.
     bool int_start_tls = false;
@@ -3023,6 +3066,8 @@ static const char esp_mail_dbg_str_14[] PROGMEM = "send inline data";
 static const char esp_mail_dbg_str_15[] PROGMEM = "send smtp command, AUTH XOAUTH2";
 static const char esp_mail_dbg_str_16[] PROGMEM = "finishing the message sending";
 static const char esp_mail_dbg_str_17[] PROGMEM = "No ESMTP supported, send SMTP command, HELO";
+static const char esp_mail_dbg_str_85[] PROGMEM = "send SMTP command, RSET";
+static const char esp_mail_dbg_str_86[] PROGMEM = "send pipelined SMTP commands, MAIL and RCPT";
 #endif
 
 /////////////////////////
@@ -3032,6 +3077,7 @@ static const char esp_mail_dbg_str_19[] PROGMEM = "Host > ";
 static const char esp_mail_dbg_str_20[] PROGMEM = "Port > ";
 static const char esp_mail_dbg_str_21[] PROGMEM = "Reading time from NTP server";
 static const char esp_mail_dbg_str_22[] PROGMEM = "perform SSL/TLS handshake";
+static const char esp_mail_dbg_str_84[] PROGMEM = "TLS session cache hit/miss > ";
 
 #if defined(ENABLE_IMAP)
 static const char esp_mail_dbg_str_23[] PROGMEM = "get my ACL";
@@ -3095,6 +3141,7 @@ static const char esp_mail_dbg_str_80[] PROGMEM = "get Flags";
 static const char esp_mail_dbg_str_81[] PROGMEM = "delete folder";
 static const char esp_mail_dbg_str_82[] PROGMEM = "send IMAP command, ID";
 static const char esp_mail_dbg_str_83[] PROGMEM = "send IMAP command, NOOP";
+static const char esp_mail_dbg_str_87[] PROGMEM = "header file bytes written/peak heap > ";
 #endif
 
 /////////////////////////
@@ -3286,6 +3333,7 @@ static const char esp_mail_error_smtp_str_9[] PROGMEM = "set recipient failed";
 static const char esp_mail_error_smtp_str_10[] PROGMEM = "send custom command failed";
 static const char esp_mail_error_smtp_str_11[] PROGMEM = "XOAuth2 authenticate failed";
 static const char esp_mail_error_smtp_str_12[] PROGMEM = "undefined error";
+static const char esp_mail_error_smtp_str_13[] PROGMEM = "reset transaction failed";
 #endif
 #endif
 
@@ -3428,8 +3476,6 @@ static const char boundary_table[] PROGMEM = "=_abcdefghijklmnopqrstuvwxyz012345
 
 #if defined(ENABLE_SMTP) || defined(ENABLE_IMAP)
 
-static const unsigned char b64_index_table[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
 static void __attribute__((used))
 appendDebugTag(MB_String &buf, esp_mail_debug_tag_type type, bool clear, PGM_P text = NULL)
 {
@@ -30,6 +30,7 @@
 #define SMTP_STATUS_SEND_CUSTOM_COMMAND_FAILED -114
 #define SMTP_STATUS_XOAUTH2_AUTH_FAILED -115
 #define SMTP_STATUS_UNDEFINED -116
+#define SMTP_STATUS_SEND_RESET_FAILED -117
 #endif
 
 #if defined(ENABLE_IMAP)
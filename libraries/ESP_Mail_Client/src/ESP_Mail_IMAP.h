@@ -85,7 +85,7 @@ char *ESP_Mail_Client::decode7Bit_UTF8(char *buf)
 
     for (size_t i = 0; i < len; i++)
     {
-        if (buf[i] > 0 && buf[i] < 128 && i < 998)
+        if ((uint8_t)buf[i] > 0 && (uint8_t)buf[i] < 128 && i < 998)
             s.append(1, buf[i]);
     }
 
@@ -256,11 +256,12 @@ void ESP_Mail_Client::decodeTIS620_UTF8(char *out, const char *in, size_t len)
     int j = 0;
     for (size_t i = 0; i < len; i++)
     {
-        if (in[i] < 0x80)
-            out[j++] = in[i];
-        else if ((in[i] >= 0xa0 && in[i] < 0xdb) || (in[i] > 0xde && in[i] < 0xfc))
+        uint8_t c = in[i];
+        if (c < 0x80)
+            out[j++] = c;
+        else if ((c >= 0xa0 && c < 0xdb) || (c > 0xde && c < 0xfc))
         {
-            int unicode = 0x0e00 + in[i] - 0xa0;
+            int unicode = 0x0e00 + c - 0xa0;
             char o[5];
             memset(o, 0, 5);
             int r = encodeUnicode_UTF8(o, unicode);
@@ -1266,6 +1267,10 @@ unauthenticate:
             if (!imap->client.connectSSL(imap->_session_cfg->certificate.verify))
                 return handleIMAPError(imap, MAIL_CLIENT_ERROR_SSL_TLS_STRUCTURE_SETUP, false);
 
+#if defined(ESP_MAIL_SESSION_CACHE_ENABLED)
+            storeSessionCache(imap->_session_cfg, &imap->_bsslSession);
+#endif
+
             // set the secure mode
             imap->_session_cfg->int_start_tls = false;
             imap->_session_cfg->int_mode = esp_mail_secure_mode_undefined;
@@ -1679,10 +1684,11 @@ int ESP_Mail_Client::parseSearchResponse(IMAPSession *imap, esp_mail_imap_respon
                         msg_num.type = imap->_uidSearch ? esp_mail_imap_msg_num_type_uid : esp_mail_imap_msg_num_type_number;
                         msg_num.value = (uint32_t)atoi(res.response);
 
-                        imap->_imap_msg_num.push_back(msg_num);
-
-                        if (imap->_imap_msg_num.size() > imap->_imap_data->limit.search)
-                            imap->_imap_msg_num.erase(imap->_imap_msg_num.begin());
+                        // Keep the last limit numbers in the ring, they will be sorted at the tagged response
+                        if (imap->_imap_msg_num.size() < imap->_imap_data->limit.search)
+                            imap->_imap_msg_num.push_back(msg_num);
+                        else if (imap->_imap_data->limit.search > 0)
+                            imap->_imap_msg_num[(imap->_mbif._searchCount - 1) % imap->_imap_data->limit.search] = msg_num;
                     }
                     else
                     {
@@ -1740,22 +1746,43 @@ end_search:
 #if !defined(MB_USE_STD_VECTOR)
 void ESP_Mail_Client::numDecSort(_vectorImpl<struct esp_mail_imap_msg_num_t> &arr)
 {
+    // In-place heapsort using the min-heap, the minimum is moved to the end
+    // in each pass which gives the decending order without extra memory.
+    size_t n = arr.size();
+    if (n < 2)
+        return;
 
-    struct esp_mail_imap_msg_num_t tmp;
+    for (size_t i = n / 2; i > 0; i--)
+        numSiftDown(arr, i - 1, n);
 
-    for (size_t i = 0; i < arr.size(); ++i)
+    for (size_t end = n - 1; end > 0; end--)
     {
-        for (size_t j = i + 1; j < arr.size(); ++j)
-        {
-            if (arr[i].value < arr[j].value)
-            {
-                tmp = arr[i];
-                arr[i] = arr[j];
-                arr[j] = tmp;
-            }
-        }
+        struct esp_mail_imap_msg_num_t tmp = arr[0];
+        arr[0] = arr[end];
+        arr[end] = tmp;
+        numSiftDown(arr, 0, end);
     }
 }
+
+void ESP_Mail_Client::numSiftDown(_vectorImpl<struct esp_mail_imap_msg_num_t> &arr, size_t root, size_t size)
+{
+    struct esp_mail_imap_msg_num_t tmp = arr[root];
+    size_t child = 2 * root + 1;
+    while (child < size)
+    {
+        // select the smaller child
+        if (child + 1 < size && arr[child + 1].value < arr[child].value)
+            child++;
+
+        if (tmp.value <= arr[child].value)
+            break;
+
+        arr[root] = arr[child];
+        root = child;
+        child = 2 * root + 1;
+    }
+    arr[root] = tmp;
+}
 #endif
 
 struct esp_mail_message_part_info_t *ESP_Mail_Client::cPart(IMAPSession *imap)
@@ -1892,7 +1919,7 @@ void ESP_Mail_Client::collectHeaderField(IMAPSession *imap, char *buf, struct es
 
     if (state < esp_mail_rfc822_header_field_maxType)
     {
-        int ptr = getRFC822HeaderPtr(state, &header.header_fields);
+        uintptr_t ptr = getRFC822HeaderPtr(state, &header.header_fields);
         if (ptr > 0)
         {
             *(addrTo<MB_String *>(ptr)) += &buf[i];
@@ -2220,7 +2247,7 @@ void ESP_Mail_Client::parsePartHeaderResponse(IMAPSession *imap, esp_mail_imap_r
                     field += esp_mail_str_34; /* ":" */
                     ;
 
-                    int ptr = getRFC822HeaderPtr(i, &res.part.rfc822_header);
+                    uintptr_t ptr = getRFC822HeaderPtr(i, &res.part.rfc822_header);
                     if (ptr > 0)
                     {
                         if (getDecodedHeader(imap, res.response, field.c_str(), *(addrTo<MB_String *>(ptr)), caseSensitive))
@@ -2388,7 +2415,7 @@ int ESP_Mail_Client::countChar(const char *buf, char find)
     return count;
 }
 
-bool ESP_Mail_Client::storeStringPtr(IMAPSession *imap, uint32_t addr, MB_String &value, const char *buf)
+bool ESP_Mail_Client::storeStringPtr(IMAPSession *imap, uintptr_t addr, MB_String &value, const char *buf)
 {
     if (addr)
     {
@@ -2717,6 +2744,21 @@ bool ESP_Mail_Client::handleIMAPResponse(IMAPSession *imap, int errCode, bool cl
                         }
                     }
                 }
+                else if ((imap->_imap_cmd == esp_mail_imap_cmd_fetch_body_attachment || imap->_imap_cmd == esp_mail_imap_cmd_fetch_body_inline) &&
+                         res.chunkIdx > 0 && res.octetCount < res.octetLength)
+                {
+                    // The literal size is known, read the attachment data as octet counted blocks instead of lines
+                    if (!readAttachmentLiteral(imap, res))
+                    {
+                        errorStatusCB<IMAPSession *, IMAPSession *>(imap, nullptr, MAIL_CLIENT_ERROR_READ_TIMEOUT, true);
+                        return false;
+                    }
+
+                    if (!res.tmo)
+                        break;
+
+                    res.readLen = 0;
+                }
                 else
                 {
                     // response read as chunk ended with CRLF or complete buffer size
@@ -3185,48 +3227,135 @@ bool ESP_Mail_Client::handleIMAPResponse(IMAPSession *imap, int errCode, bool cl
     return true;
 }
 
-void ESP_Mail_Client::addHeader(MB_String &s, PGM_P name, const char *s_value, int num_value, bool trim, bool isJson)
+void ESP_Mail_Client::addHeader(esp_mail_header_writer_t &w, PGM_P name, const char *s_value, int num_value, bool trim)
 {
-    if (isJson)
+    if (w.json)
     {
-        s += (s.length() > 0) ? esp_mail_str_77 /* ",\"" */ : esp_mail_str_78 /* "{\"" */;
-        s += name;
+        writeHeader(w, w.first ? esp_mail_str_78 /* "{\"" */ : esp_mail_str_77 /* ",\"" */);
+        writeHeader(w, name);
 
         if (strlen(s_value) > 0)
         {
-            s += esp_mail_str_79; /* "\":\"" */
-            ;
-            if (trim)
-            {
-                MB_String t = s_value;
-                t.replaceAll("\"", "");
-                s += t;
-            }
-            else
-                s += s_value;
-            s += esp_mail_str_11; /* "\"" */
+            writeHeader(w, esp_mail_str_79); /* "\":\"" */
+            writeHeaderValue(w, s_value, trim);
+            writeHeader(w, esp_mail_str_11); /* "\"" */
         }
         else
         {
-            s += esp_mail_str_34 /* ":" */;
-            appendSpace(s);
-            s += num_value;
+            writeHeader(w, esp_mail_str_11 /* "\"" */);
+            writeHeader(w, esp_mail_str_34 /* ":" */);
+            writeHeader(w, num_value);
         }
     }
     else
     {
-        if (s.length() > 0)
-            appendNewline(s);
-        s += name;
-        s += esp_mail_str_34 /* ":" */;
-        appendSpace(s);
+        if (!w.first)
+            writeHeader(w, esp_mail_str_18 /* "\r\n" */);
+        writeHeader(w, name);
+        writeHeader(w, esp_mail_str_34 /* ":" */);
+        writeHeader(w, esp_mail_str_2 /* " " */);
         if (strlen(s_value) > 0)
-            s += s_value;
+            writeHeaderValue(w, s_value, false);
         else
-            s += num_value;
+            writeHeader(w, num_value);
+    }
+
+    w.first = false;
+}
+
+void ESP_Mail_Client::writeHeader(esp_mail_header_writer_t &w, PGM_P str)
+{
+    size_t len = strlen_P(str);
+    size_t pos = 0;
+
+    while (pos < len && !w.error)
+    {
+        size_t size = len - pos;
+        if (size > ESP_MAIL_HEADER_WRITE_BUFFER_SIZE - w.bufLen)
+            size = ESP_MAIL_HEADER_WRITE_BUFFER_SIZE - w.bufLen;
+
+        memcpy_P(w.buf + w.bufLen, str + pos, size);
+        w.bufLen += size;
+        pos += size;
+
+        if (w.bufLen == ESP_MAIL_HEADER_WRITE_BUFFER_SIZE)
+            flushHeader(w);
     }
 }
 
+void ESP_Mail_Client::writeHeader(esp_mail_header_writer_t &w, int value)
+{
+    char num[12];
+    snprintf(num, sizeof(num), "%d", value);
+    // The digits are in RAM, not PROGMEM, and need no escaping
+    writeHeaderValue(w, num, false);
+}
+
+void ESP_Mail_Client::writeHeaderValue(esp_mail_header_writer_t &w, const char *value, bool trim)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    for (const char *p = value; *p && !w.error; p++)
+    {
+        unsigned char c = (unsigned char)*p;
+        char esc[6];
+        int len = 0;
+
+        if (w.json)
+        {
+            // The quotes in address fields are removed, the others are escaped
+            if (c == '"' && trim)
+                continue;
+
+            if (c == '"' || c == '\\')
+            {
+                esc[len++] = '\\';
+                esc[len++] = c;
+            }
+            else if (c == '\r' || c == '\n' || c == '\t')
+            {
+                esc[len++] = '\\';
+                esc[len++] = c == '\r' ? 'r' : (c == '\n' ? 'n' : 't');
+            }
+            else if (c < 0x20)
+            {
+                memcpy(esc, "\\u00", 4);
+                len = 4;
+                esc[len++] = hex[c >> 4];
+                esc[len++] = hex[c & 0xf];
+            }
+        }
+
+        if (len == 0)
+            esc[len++] = c;
+
+        if (w.bufLen + len > ESP_MAIL_HEADER_WRITE_BUFFER_SIZE)
+            flushHeader(w);
+
+        memcpy(w.buf + w.bufLen, esc, len);
+        w.bufLen += len;
+    }
+}
+
+void ESP_Mail_Client::flushHeader(esp_mail_header_writer_t &w)
+{
+    if (w.bufLen == 0 || w.error)
+        return;
+
+    int heap = MailClient.getFreeHeap();
+    if (w.minHeap == 0 || heap < w.minHeap)
+        w.minHeap = heap;
+
+    int write = mbfs->write(mbfs_type w.storageType, (uint8_t *)w.buf, w.bufLen);
+
+    if (write != (int)w.bufLen)
+        w.error = true;
+    else
+        w.bytesWritten += w.bufLen;
+
+    w.bufLen = 0;
+}
+
 void ESP_Mail_Client::saveHeader(IMAPSession *imap, bool json)
 {
     if (!imap->_storageReady)
@@ -3254,76 +3383,93 @@ void ESP_Mail_Client::saveHeader(IMAPSession *imap, bool json)
         return;
     }
 
-    MB_String s;
+    // The header items are streamed through the fixed size buffer
+    // to keep the memory usage independent of the number of messages
+    esp_mail_header_writer_t w;
+    w.storageType = imap->_imap_data->storage.type;
+    w.json = json;
+    w.startHeap = MailClient.getFreeHeap();
+
+    if (json)
+        writeHeader(w, esp_mail_str_76); /* "{\"Messages\":[" */
+
     for (size_t i = 0; i < imap->_headers.size(); i++)
-        addHeaderItem(s, &imap->_headers[i], json);
+    {
+        if (i > 0)
+            writeHeader(w, json ? esp_mail_str_8 /* "," */ : esp_mail_str_18 /* "\r\n" */);
+        addHeaderItem(w, &imap->_headers[i]);
+    }
 
     if (json)
-        s += esp_mail_str_75; /* "]}" */
+        writeHeader(w, esp_mail_str_75); /* "]}" */
 
-    mbfs->print(mbfs_type imap->_imap_data->storage.type, s.c_str());
+    flushHeader(w);
 
     mbfs->close(mbfs_type imap->_imap_data->storage.type);
 
+#if !defined(SILENT_MODE)
+    if (imap->_debug)
+    {
+        MB_String dbMsg = esp_mail_dbg_str_87; /* "header file bytes written/peak heap > " */
+        dbMsg += (int)w.bytesWritten;
+        dbMsg += '/';
+        dbMsg += w.minHeap > 0 ? w.startHeap - w.minHeap : 0;
+        esp_mail_debug_print_tag(dbMsg.c_str(), esp_mail_debug_tag_type_client, true);
+    }
+#endif
+
     imap->_headerSaved = true;
 }
 
-void ESP_Mail_Client::addHeaderItem(MB_String &str, esp_mail_message_header_t *header, bool json)
+void ESP_Mail_Client::addHeaderItem(esp_mail_header_writer_t &w, esp_mail_message_header_t *header)
 {
-    MB_String s;
-    if (json)
-    {
-        if (str.length() > 0)
-            str += esp_mail_str_8; /* "," */
-        else
-            str = esp_mail_str_76; /* "{\"Messages\":[" */
-    }
+    w.first = true;
 
-    addHeader(s, message_headers[esp_mail_message_header_field_number].text, "", header->message_no, false, json);
-    addHeader(s, message_headers[esp_mail_message_header_field_uid].text, "", header->message_uid, false, json);
+    addHeader(w, message_headers[esp_mail_message_header_field_number].text, "", header->message_no, false);
+    addHeader(w, message_headers[esp_mail_message_header_field_uid].text, "", header->message_uid, false);
 
     if (header->accept_language.length() > 0)
-        addHeader(s, message_headers[esp_mail_message_header_field_accept_language].text, header->accept_language.c_str(), 0, false, json);
+        addHeader(w, message_headers[esp_mail_message_header_field_accept_language].text, header->accept_language.c_str(), 0, false);
 
     if (header->content_language.length() > 0)
-        addHeader(s, message_headers[esp_mail_message_header_field_content_language].text, header->content_language.c_str(), 0, false, json);
+        addHeader(w, message_headers[esp_mail_message_header_field_content_language].text, header->content_language.c_str(), 0, false);
 
-    addRFC822Headers(s, &header->header_fields, json);
+    addRFC822Headers(w, &header->header_fields);
 
     for (size_t j = 0; j < header->part_headers.size(); j++)
     {
         if (header->part_headers[j].rfc822_part)
         {
-            MB_String s1;
-            addRFC822Headers(s1, &header->part_headers[j].rfc822_header, json);
+            writeHeader(w, w.json ? esp_mail_str_69 /* ",\"RFC822\":" */ : esp_mail_str_70 /* "\r\n\r\nRFC822:\r\n" */);
 
-            if (json)
-            {
-                s += esp_mail_str_69; /* ",\"RFC822\":" */
-                s += s1;
-                s += esp_mail_str_36; /* "}" */
-            }
-            else
+            w.first = true;
+            addRFC822Headers(w, &header->part_headers[j].rfc822_header);
+
+            if (w.json)
             {
-                s += esp_mail_str_70; /* "\r\n\r\nRFC822:\r\n" */
-                s += s1;
+                // no RFC822 header item was added, write the empty object
+                if (w.first)
+                    writeHeader(w, esp_mail_str_36); /* "{" */
+                writeHeader(w, esp_mail_str_37);     /* "}" */
             }
+
+            w.first = false;
         }
     }
 
     if (header->attachment_count > 0)
     {
-        if (json)
+        if (w.json)
         {
-            s += esp_mail_str_71 /* ",\"Attachments\":{\"Count\":" */;
-            s += header->attachment_count;
-            s += esp_mail_str_72; /* ",\"Files\":[" */
+            writeHeader(w, esp_mail_str_71 /* ",\"Attachments\":{\"Count\":" */);
+            writeHeader(w, header->attachment_count);
+            writeHeader(w, esp_mail_str_72); /* ",\"Files\":[" */
         }
         else
         {
-            s += esp_mail_str_73; /* "\r\n\r\nAttachments (" */
-            s += header->attachment_count;
-            s += esp_mail_str_74; /* ")\r\n" */
+            writeHeader(w, esp_mail_str_73); /* "\r\n\r\nAttachments (" */
+            writeHeader(w, header->attachment_count);
+            writeHeader(w, esp_mail_str_74); /* ")\r\n" */
         }
 
         int index = 0;
@@ -3333,67 +3479,65 @@ void ESP_Mail_Client::addHeaderItem(MB_String &str, esp_mail_message_header_t *h
             if (header->part_headers[j].attach_type == esp_mail_att_type_none || header->part_headers[j].rfc822_part)
                 continue;
 
-            if (json)
+            if (w.json)
             {
                 if (index > 0)
-                    s += esp_mail_str_8; /* "," */
-                s += esp_mail_str_67;    /* /"{\"Filename\":\"" */
-                s += header->part_headers[j].filename;
-                s += esp_mail_str_11; /* "\"" */
+                    writeHeader(w, esp_mail_str_8); /* "," */
+                writeHeader(w, esp_mail_str_67);    /* /"{\"Filename\":\"" */
+                writeHeaderValue(w, header->part_headers[j].filename.c_str(), false);
+                writeHeader(w, esp_mail_str_11); /* "\"" */
+                w.first = false;
             }
             else
             {
                 if (index > 0)
-                    appendNewline(s);
-                appendNewline(s);
-                s += esp_mail_str_68; /* /"Index: " */
-                s += index + 1;
-                addHeader(s, message_headers[esp_mail_message_header_field_filename].text, header->part_headers[j].filename.c_str(), 0, false, json);
+                    writeHeader(w, esp_mail_str_18); /* "\r\n" */
+                writeHeader(w, esp_mail_str_18);     /* "\r\n" */
+                writeHeader(w, esp_mail_str_68);     /* /"Index: " */
+                writeHeader(w, index + 1);
+                w.first = false;
+                addHeader(w, message_headers[esp_mail_message_header_field_filename].text, header->part_headers[j].filename.c_str(), 0, false);
             }
 
-            addHeader(s, message_headers[esp_mail_message_header_field_name].text, header->part_headers[j].name.c_str(), 0, false, json);
-            addHeader(s, message_headers[esp_mail_message_header_field_size].text, "", header->part_headers[j].attach_data_size, false, json);
-            addHeader(s, message_headers[esp_mail_message_header_field_mime].text, header->part_headers[j].content_type.c_str(), 0, false, json);
-            addHeader(s, message_headers[esp_mail_message_header_field_type].text, header->part_headers[j].attach_type == esp_mail_att_type_attachment ? esp_mail_content_disposition_type_t::attachment : esp_mail_content_disposition_type_t::inline_, 0, false, json);
-            addHeader(s, message_headers[esp_mail_message_header_field_description].text, header->part_headers[j].content_description.c_str(), 0, false, json);
-            addHeader(s, message_headers[esp_mail_message_header_field_creation_date].text, header->part_headers[j].creation_date.c_str(), 0, false, json);
+            addHeader(w, message_headers[esp_mail_message_header_field_name].text, header->part_headers[j].name.c_str(), 0, false);
+            addHeader(w, message_headers[esp_mail_message_header_field_size].text, "", header->part_headers[j].attach_data_size, false);
+            addHeader(w, message_headers[esp_mail_message_header_field_mime].text, header->part_headers[j].content_type.c_str(), 0, false);
+            addHeader(w, message_headers[esp_mail_message_header_field_type].text, header->part_headers[j].attach_type == esp_mail_att_type_attachment ? esp_mail_content_disposition_type_t::attachment : esp_mail_content_disposition_type_t::inline_, 0, false);
+            addHeader(w, message_headers[esp_mail_message_header_field_description].text, header->part_headers[j].content_description.c_str(), 0, false);
+            addHeader(w, message_headers[esp_mail_message_header_field_creation_date].text, header->part_headers[j].creation_date.c_str(), 0, false);
 
-            if (json)
-                s += esp_mail_str_36; /* "}" */
+            if (w.json)
+                writeHeader(w, esp_mail_str_37); /* "}" */
 
             index++;
         }
 
-        if (json)
-            s += esp_mail_str_75; /* "]}" */
-    }
-
-    if (json)
-    {
-        s += esp_mail_str_36; /* "}" */
+        if (w.json)
+            writeHeader(w, esp_mail_str_75); /* "]}" */
     }
 
-    str += s;
+    if (w.json)
+        writeHeader(w, esp_mail_str_37); /* "}" */
 }
 
-int ESP_Mail_Client::getRFC822HeaderPtr(int index, esp_mail_imap_rfc822_msg_header_item_t *header)
+uintptr_t ESP_Mail_Client::getRFC822HeaderPtr(int index, esp_mail_imap_rfc822_msg_header_item_t *header)
 {
     if (index >= esp_mail_rfc822_header_field_from && index < esp_mail_rfc822_header_field_maxType)
         return toAddr(header->header_items[index]);
     return 0;
 }
 
-void ESP_Mail_Client::addRFC822Headers(MB_String &s, esp_mail_imap_rfc822_msg_header_item_t *header, bool json)
+void ESP_Mail_Client::addRFC822Headers(esp_mail_header_writer_t &w, esp_mail_imap_rfc822_msg_header_item_t *header)
 {
     for (int i = esp_mail_rfc822_header_field_from; i < esp_mail_rfc822_header_field_maxType; i++)
-        addRFC822HeaderItem(s, header, i, json);
+        addRFC822HeaderItem(w, header, i);
 }
 
-void ESP_Mail_Client::addRFC822HeaderItem(MB_String &s, esp_mail_imap_rfc822_msg_header_item_t *header, int index, bool json)
+void ESP_Mail_Client::addRFC822HeaderItem(esp_mail_header_writer_t &w, esp_mail_imap_rfc822_msg_header_item_t *header, int index)
 {
-    int ptr = getRFC822HeaderPtr(index, header);
+    uintptr_t ptr = getRFC822HeaderPtr(index, header);
     if (ptr > 0)
-        addHeader(s, rfc822_headers[index].text, addrTo<MB_String *>(ptr)->c_str(), 0, rfc822_headers[index].trim, json);
+        addHeader(w, rfc822_headers[index].text, addrTo<MB_String *>(ptr)->c_str(), 0, rfc822_headers[index].trim);
 }
 
 esp_mail_imap_response_status ESP_Mail_Client::imapResponseStatus(IMAPSession *imap, char *response, PGM_P tag)
@@ -4189,6 +4333,77 @@ bool ESP_Mail_Client::parseAttachmentResponse(IMAPSession *imap, char *buf, esp_
     return true;
 }
 
+bool ESP_Mail_Client::readAttachmentLiteral(IMAPSession *imap, esp_mail_imap_response_data &res)
+{
+    bool base64 = cPart(imap)->xencoding == esp_mail_msg_xencoding_base64;
+    int carry = 0; // The incomplete base64 group from previous block
+    unsigned long ms = millis();
+    unsigned long timeoutMs = imap->client.tcpTimeout();
+
+    res.tmo = true;
+
+    while (res.tmo && res.octetCount < res.octetLength && imap->connected())
+    {
+        int len = imap->client.available();
+
+        if (len <= 0)
+        {
+            if (millis() - ms >= timeoutMs)
+                return false;
+            yield_impl();
+            continue;
+        }
+
+        if (len > res.octetLength - res.octetCount)
+            len = res.octetLength - res.octetCount;
+
+        if (len > res.chunkBufSize - carry)
+            len = res.chunkBufSize - carry;
+
+        int read = imap->client.readBytes(res.response + carry, len);
+        if (read <= 0)
+            continue;
+
+        ms = millis();
+        res.octetCount += read;
+
+        int size = carry + read;
+
+        if (base64)
+        {
+            // Remove the line breaks and decode only the complete 4-char groups
+            // except the last block
+            int n = 0;
+            for (int i = 0; i < size; i++)
+            {
+                char c = res.response[i];
+                if (isalnum((unsigned char)c) || c == '+' || c == '/' || c == '=')
+                    res.response[n++] = c;
+            }
+            size = n;
+            carry = res.octetCount < res.octetLength ? size % 4 : 0;
+            size -= carry;
+        }
+
+        if (size > 0)
+        {
+            // The decoded size may differ from the octets read, keep the part octet count
+            // consistent so the parser does not clip the block as literal overrun
+            cPart(imap)->octetCount = res.octetCount > size ? res.octetCount - size : 0;
+            res.readLen = size;
+            res.tmo = parseAttachmentResponse(imap, res.response, res);
+        }
+
+        if (carry > 0)
+            memmove(res.response, res.response + size, carry);
+    }
+
+    memset(res.response, 0, res.chunkBufSize);
+    res.dataTime = millis();
+
+    return true;
+}
+
 void ESP_Mail_Client::downloadReport(IMAPSession *imap, int progress)
 {
     printProgress(progress, imap->_lastProgress);
@@ -4618,7 +4833,7 @@ bool IMAPSession::connect(Session_Config *session_config, IMAP_Data *imap_data,
 
     this->_customCmdResCallback = NULL;
 
-    int ptr = toAddr(*session_config);
+    uintptr_t ptr = toAddr(*session_config);
     session_config->addPtr(&_configPtrList, ptr);
 
     if (!handleConnection(session_config, imap_data, _sessionSSL))
@@ -164,6 +164,10 @@ initial_stage:
             if (!smtp->client.connectSSL(smtp->_session_cfg->certificate.verify))
                 return handleSMTPError(smtp, MAIL_CLIENT_ERROR_SSL_TLS_STRUCTURE_SETUP);
 
+#if defined(ESP_MAIL_SESSION_CACHE_ENABLED)
+            storeSessionCache(smtp->_session_cfg, &smtp->_bsslSession);
+#endif
+
             // set the secure mode
             smtp->_session_cfg->int_start_tls = false;
             smtp->_session_cfg->int_mode = esp_mail_secure_mode_undefined;
@@ -307,8 +311,9 @@ bool ESP_Mail_Client::addSendingResult(SMTPSession *smtp, SMTP_Message *msg, boo
     if (smtp->_session_cfg->sentLogs.filename.length() > 0 && smtp->_session_cfg->sentLogs.storage_type != esp_mail_file_storage_type_none)
         saveSendingLogs(smtp, msg, result);
 
-    // Store only tatest result
-    smtp->sendingResult.clear();
+    // Store only tatest result unless sending in batch
+    if (!smtp->_batchSending)
+        smtp->sendingResult.clear();
 
     SMTP_Result status;
     status.completed = result;
@@ -393,6 +398,148 @@ bool ESP_Mail_Client::sendMail(SMTPSession *smtp, SMTP_Message *msg, bool closeS
     return mSendMail(smtp, msg, closeSession);
 }
 
+bool ESP_Mail_Client::sendMails(SMTPSession *smtp, SMTP_Message *msgs, size_t count, bool closeSession)
+{
+    if (!smtp || !sessionExisted<SMTPSession *>(smtp))
+        return false;
+
+    smtp->_customCmdResCallback = NULL;
+
+    // Reconnect is allowed only when session was logged in before
+    bool loggedIn = smtp->_loginStatus;
+
+    smtp->_sentSuccessCount = 0;
+    smtp->_sentFailedCount = 0;
+    smtp->sendingResult.clear();
+    smtp->_batchSending = true;
+    smtp->_resetRequired = false;
+
+    bool ret = true;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        bool last = i == count - 1;
+
+        // The previous transaction was rejected, clear it before sending the next message
+        if (smtp->_resetRequired)
+        {
+            smtp->_resetRequired = false;
+            if (smtp->connected() && !smtpReset(smtp))
+                closeTCPSession<SMTPSession *>(smtp);
+        }
+
+        if (!smtp->connected() && loggedIn)
+        {
+            bool ssl = false;
+            smtp->_loginStatus = smtp->connect(ssl) && smtpAuth(smtp, ssl);
+            if (!smtp->_loginStatus)
+            {
+                closeTCPSession<SMTPSession *>(smtp);
+                addSendingResult(smtp, &msgs[i], false, true);
+                ret = false;
+                continue;
+            }
+        }
+
+        if (!mSendMail(smtp, &msgs[i], closeSession && last))
+        {
+            ret = false;
+            // The session state is unknown after failure other than server rejection
+            if (!smtp->_resetRequired && smtp->connected())
+                closeTCPSession<SMTPSession *>(smtp);
+        }
+    }
+
+    if (closeSession && smtp->connected())
+        closeTCPSession<SMTPSession *>(smtp);
+
+    smtp->_batchSending = false;
+    smtp->_resetRequired = false;
+    smtp->_pipelining = false;
+
+    return ret;
+}
+
+bool ESP_Mail_Client::smtpReset(SMTPSession *smtp)
+{
+#if !defined(SILENT_MODE)
+    if (smtp->_debug)
+        esp_mail_debug_print_tag(esp_mail_dbg_str_85 /* "send SMTP command, RSET" */, esp_mail_debug_tag_type_client, true);
+#endif
+
+    if (smtpSend(smtp, smtp_commands[esp_mail_smtp_command_rset].text, true) == ESP_MAIL_CLIENT_TRANSFER_DATA_FAILED)
+        return false;
+
+    // expected success status code 250
+    // expected error status code 500, 501, 504, 421
+    return handleSMTPResponse(smtp, esp_mail_smtp_cmd_reset, esp_mail_smtp_status_code_250, SMTP_STATUS_SEND_RESET_FAILED);
+}
+
+bool ESP_Mail_Client::sendEnvelopeCommand(SMTPSession *smtp, SMTP_Message *msg, MB_String &cmd, esp_mail_smtp_command type, int errCode)
+{
+    if (!smtp->_pipelining)
+        return altSendData(cmd, true, smtp, msg, true, true, type, esp_mail_smtp_status_code_250, errCode);
+
+    // The recipient forwarding status (251) is checked when reading the response
+    smtp->_canForward = false;
+    smtp->_pipelinedCmds += cmd;
+    appendNewline(smtp->_pipelinedCmds);
+    smtp->_pipelinedCmdTypes.push_back(type);
+    return true;
+}
+
+bool ESP_Mail_Client::sendPipelinedCommands(SMTPSession *smtp, SMTP_Message *msg)
+{
+#if !defined(SILENT_MODE)
+    if (smtp->_debug)
+        esp_mail_debug_print_tag(esp_mail_dbg_str_86 /* "send pipelined SMTP commands, MAIL and RCPT" */, esp_mail_debug_tag_type_client, true);
+#endif
+
+    smtp->_pipelining = false;
+
+    if (smtpSend(smtp, smtp->_pipelinedCmds.c_str(), false) == ESP_MAIL_CLIENT_TRANSFER_DATA_FAILED)
+    {
+        smtp->_pipelinedCmds.clear();
+        smtp->_pipelinedCmdTypes.clear();
+        return addSendingResult(smtp, msg, false, true);
+    }
+
+    smtp->_pipelinedCmds.clear();
+
+    // All responses should be read to keep the session in sync, the first failure will be kept.
+    bool ret = true;
+    esp_mail_smtp_response_status_t failedStatus;
+    smtp->_pipelinedResponse = true;
+
+    for (size_t i = 0; i < smtp->_pipelinedCmdTypes.size(); i++)
+    {
+        esp_mail_smtp_command type = smtp->_pipelinedCmdTypes[i];
+        smtp->_canForward = type == esp_mail_smtp_cmd_send_header_recipient;
+
+        // expected success status code 250 (and 251 for recipient)
+        if (!handleSMTPResponse(smtp, type, esp_mail_smtp_status_code_250, type == esp_mail_smtp_cmd_send_header_sender ? SMTP_STATUS_SEND_HEADER_SENDER_FAILED : SMTP_STATUS_SEND_HEADER_RECIPIENT_FAILED))
+        {
+            if (ret)
+                failedStatus = smtp->_responseStatus;
+            ret = false;
+
+            if (!smtp->connected())
+                break;
+        }
+    }
+
+    smtp->_pipelinedResponse = false;
+    smtp->_pipelinedCmdTypes.clear();
+
+    if (!ret)
+    {
+        smtp->_responseStatus = failedStatus;
+        return addSendingResult(smtp, msg, false, true);
+    }
+
+    return true;
+}
+
 size_t ESP_Mail_Client::numAtt(SMTPSession *smtp, esp_mail_attach_type type, SMTP_Message *msg)
 {
     size_t count = 0;
@@ -474,9 +621,13 @@ bool ESP_Mail_Client::mSendMail(SMTPSession *smtp, SMTP_Message *msg, bool close
             closeTCPSession<SMTPSession *>(smtp);
             return addSendingResult(smtp, msg, false, true);
         }
-        smtp->_sentSuccessCount = 0;
-        smtp->_sentFailedCount = 0;
-        smtp->sendingResult.clear();
+
+        if (!smtp->_batchSending)
+        {
+            smtp->_sentSuccessCount = 0;
+            smtp->_sentFailedCount = 0;
+            smtp->sendingResult.clear();
+        }
     }
     else
     {
@@ -566,6 +717,10 @@ bool ESP_Mail_Client::sendContent(SMTPSession *smtp, SMTP_Message *msg, bool clo
 
     if (!imap && smtp)
     {
+        // The MAIL and RCPT commands can be sent in one round trip when sending in batch
+        smtp->_pipelining = smtp->_batchSending && smtp->_feature_capability[esp_mail_smtp_send_capability_pipelining];
+        smtp->_pipelinedCmds.clear();
+        smtp->_pipelinedCmdTypes.clear();
 
         buf = smtp_cmd_post_tokens[esp_mail_smtp_command_mail];
         buf += smtp_commands[esp_mail_smtp_command_from].text;
@@ -594,7 +749,7 @@ bool ESP_Mail_Client::sendContent(SMTPSession *smtp, SMTP_Message *msg, bool clo
         // expected success status code 250
         // expected failure status code 552, 451, 452
         // expected error status code 500, 501, 421
-        if (!altSendData(buf, true, smtp, msg, true, true, esp_mail_smtp_cmd_send_header_sender, esp_mail_smtp_status_code_250, SMTP_STATUS_SEND_HEADER_SENDER_FAILED))
+        if (!sendEnvelopeCommand(smtp, msg, buf, esp_mail_smtp_cmd_send_header_sender, SMTP_STATUS_SEND_HEADER_SENDER_FAILED))
             return false;
     }
 
@@ -644,7 +799,7 @@ bool ESP_Mail_Client::sendContent(SMTPSession *smtp, SMTP_Message *msg, bool clo
             // expected success status code 250, 251
             // expected failure status code 550, 551, 552, 553, 450, 451, 452
             // expected error status code 500, 501, 503, 421
-            if (!altSendData(buf, true, smtp, msg, true, true, esp_mail_smtp_cmd_send_header_recipient, esp_mail_smtp_status_code_250, SMTP_STATUS_SEND_HEADER_RECIPIENT_FAILED))
+            if (!sendEnvelopeCommand(smtp, msg, buf, esp_mail_smtp_cmd_send_header_recipient, SMTP_STATUS_SEND_HEADER_RECIPIENT_FAILED))
                 return false;
         }
     }
@@ -665,7 +820,7 @@ bool ESP_Mail_Client::sendContent(SMTPSession *smtp, SMTP_Message *msg, bool clo
             // expected success status code 250, 251
             // expected failure status code 550, 551, 552, 553, 450, 451, 452
             // expected error status code 500, 501, 503, 421
-            if (!altSendData(buf, true, smtp, msg, true, true, esp_mail_smtp_cmd_send_header_recipient, esp_mail_smtp_status_code_250, SMTP_STATUS_SEND_HEADER_RECIPIENT_FAILED))
+            if (!sendEnvelopeCommand(smtp, msg, buf, esp_mail_smtp_cmd_send_header_recipient, SMTP_STATUS_SEND_HEADER_RECIPIENT_FAILED))
                 return false;
         }
     }
@@ -684,10 +839,14 @@ bool ESP_Mail_Client::sendContent(SMTPSession *smtp, SMTP_Message *msg, bool clo
             // expected success status code 250, 251
             // expected failure status code 550, 551, 552, 553, 450, 451, 452
             // expected error status code 500, 501, 503, 421
-            if (!altSendData(buf, true, smtp, msg, true, true, esp_mail_smtp_cmd_send_header_recipient, esp_mail_smtp_status_code_250, SMTP_STATUS_SEND_HEADER_RECIPIENT_FAILED))
+            if (!sendEnvelopeCommand(smtp, msg, buf, esp_mail_smtp_cmd_send_header_recipient, SMTP_STATUS_SEND_HEADER_RECIPIENT_FAILED))
                 return false;
         }
 
+        // The DATA or BDAT command is not pipelined, it will be sent only when all recipients were accepted
+        if (smtp->_pipelining && !sendPipelinedCommands(smtp, msg))
+            return false;
+
 #if !defined(SILENT_MODE)
         altSendCallback(smtp, esp_mail_cb_str_5 /* "Sending message body..." */, esp_mail_dbg_str_9 /* "send message body" */, esp_mail_debug_tag_type_client, true, false);
 #endif
@@ -1137,7 +1296,7 @@ bool ESP_Mail_Client::altIsDebug(SMTPSession *smtp)
 bool ESP_Mail_Client::sendBlobAttachment(SMTPSession *smtp, SMTP_Message *msg, SMTP_Attachment *att)
 {
     bool cb = altIsCB(smtp);
-    uint32_t addr = altProgressPtr(smtp);
+    uintptr_t addr = altProgressPtr(smtp);
 
     if (strcmp(att->descr.transfer_encoding.c_str(), Content_Transfer_Encoding::enc_base64) == 0 && strcmp(att->descr.transfer_encoding.c_str(), att->descr.content_encoding.c_str()) != 0)
     {
@@ -1211,7 +1370,7 @@ bool ESP_Mail_Client::sendBlobAttachment(SMTPSession *smtp, SMTP_Message *msg, S
 bool ESP_Mail_Client::sendFile(SMTPSession *smtp, SMTP_Message *msg, SMTP_Attachment *att)
 {
     bool cb = altIsCB(smtp);
-    uint32_t addr = altProgressPtr(smtp);
+    uintptr_t addr = altProgressPtr(smtp);
 
     if (strcmp(att->descr.transfer_encoding.c_str(), Content_Transfer_Encoding::enc_base64) == 0 && strcmp(att->descr.transfer_encoding.c_str(), att->descr.content_encoding.c_str()) != 0)
     {
@@ -1752,7 +1911,16 @@ bool ESP_Mail_Client::handleSMTPError(SMTPSession *smtp, int err, bool ret)
 
     if (smtp)
     {
-        closeTCPSession<SMTPSession *>(smtp);
+        // In batch sending, the rejected envelope or DATA command does not break the session,
+        // the transaction will be reset before sending the next message.
+        if (smtp->_batchSending && !smtp->_chunkedEnable && smtp->connected() &&
+            smtp->_responseStatus.statusCode > 0 && smtp->_responseStatus.statusCode != esp_mail_smtp_status_code_421 &&
+            (smtp->_smtp_cmd == esp_mail_smtp_cmd_send_header_sender ||
+             smtp->_smtp_cmd == esp_mail_smtp_cmd_send_header_recipient ||
+             smtp->_smtp_cmd == esp_mail_smtp_cmd_send_body))
+            smtp->_resetRequired = true;
+        else
+            closeTCPSession<SMTPSession *>(smtp);
     }
     else if (imap && !calDataLen)
     {
@@ -1888,7 +2056,7 @@ bool ESP_Mail_Client::sendBlobBody(SMTPSession *smtp, SMTP_Message *msg, uint8_t
 {
 
     bool cb = altIsCB(smtp);
-    uint32_t addr = altProgressPtr(smtp);
+    uintptr_t addr = altProgressPtr(smtp);
 
     if (msg->text.blob.size == 0 && msg->html.blob.size == 0 && strlen(msg->text.nonCopyContent) == 0 && strlen(msg->html.nonCopyContent) == 0)
         return true;
@@ -1986,7 +2154,7 @@ bool ESP_Mail_Client::sendBlobBody(SMTPSession *smtp, SMTP_Message *msg, uint8_t
 bool ESP_Mail_Client::sendFileBody(SMTPSession *smtp, SMTP_Message *msg, uint8_t type)
 {
     bool cb = altIsCB(smtp);
-    uint32_t addr = altProgressPtr(smtp);
+    uintptr_t addr = altProgressPtr(smtp);
 
     if (msg->text.file.name.length() == 0 && msg->html.file.name.length() == 0)
         return true;
@@ -2564,9 +2732,9 @@ void ESP_Mail_Client::getRFC822PartHeader(SMTPSession *smtp, MB_String &header,
     appendNewline(header);
 }
 
-uint32_t ESP_Mail_Client::altProgressPtr(SMTPSession *smtp)
+uintptr_t ESP_Mail_Client::altProgressPtr(SMTPSession *smtp)
 {
-    uint32_t addr = 0;
+    uintptr_t addr = 0;
     if (smtp)
     {
         smtp->_lastProgress = -1;
@@ -2608,7 +2776,12 @@ void ESP_Mail_Client::parseAuthCapability(SMTPSession *smtp, char *buf)
 
     for (int i = esp_mail_smtp_send_capability_binary_mime; i < esp_mail_smtp_send_capability_maxType; i++)
     {
-        if (strposP(buf, smtp_send_cap_pre_tokens[i].c_str(), 0) > -1)
+        // The keyword follows the status code e.g. 250-PIPELINING
+        size_t len = strlen_P(smtp_send_capabilities[i].text);
+        bool keyword = len > 0 && strlen(buf) >= len + 4 && strcmpP(buf, 4, smtp_send_capabilities[i].text, false) &&
+                       (buf[len + 4] == 0 || buf[len + 4] == ' ' || buf[len + 4] == '\r' || buf[len + 4] == '\n');
+
+        if (keyword || strposP(buf, smtp_send_cap_pre_tokens[i].c_str(), 0) > -1)
         {
             smtp->_feature_capability[i] = true;
             return;
@@ -2824,6 +2997,10 @@ bool ESP_Mail_Client::handleSMTPResponse(SMTPSession *smtp, esp_mail_smtp_comman
 
                     completedResponse = smtp->_responseStatus.statusCode > 0 && status.text.length() > minResLen;
 
+                    // Pipelined responses are read one reply at a time
+                    if (smtp->_pipelinedResponse && smtp->_responseStatus.statusCode > 0)
+                        completedResponse = true;
+
                     if (smtp->_smtp_cmd == esp_mail_smtp_command::esp_mail_smtp_cmd_auth_xoauth2 && smtp->_responseStatus.statusCode == esp_mail_smtp_status_code_334)
                     {
                         if (isOAuthError(response, readLen, chunkIndex, 4))
@@ -2896,7 +3073,7 @@ void ESP_Mail_Client::getResponseStatus(const char *buf, esp_mail_smtp_status_co
     }
 }
 
-void ESP_Mail_Client::uploadReport(const char *filename, uint32_t pgAddr, int progress)
+void ESP_Mail_Client::uploadReport(const char *filename, uintptr_t pgAddr, int progress)
 {
     if (pgAddr == 0)
         return;
@@ -2945,14 +3122,14 @@ int ESP_Mail_Client::chunkAvailable(SMTPSession *smtp, esp_mail_smtp_send_base64
     return data_info.size - data_info.dataIndex;
 }
 
-int ESP_Mail_Client::getChunk(SMTPSession *smtp, esp_mail_smtp_send_base64_data_info_t &data_info, unsigned char *rawChunk, bool base64)
+int ESP_Mail_Client::getChunk(SMTPSession *smtp, esp_mail_smtp_send_base64_data_info_t &data_info, unsigned char *rawChunk, size_t len)
 {
     int available = chunkAvailable(smtp, data_info);
 
     if (available <= 0)
         return available;
 
-    size_t size = base64 ? 3 : 4;
+    size_t size = len;
 
     if (data_info.dataIndex + size > data_info.size)
         size = data_info.size - data_info.dataIndex;
@@ -2997,14 +3174,18 @@ bool ESP_Mail_Client::sendBase64(SMTPSession *smtp, SMTP_Message *msg, esp_mail_
 
     bool ret = false;
 
-    uint32_t addr = altProgressPtr(smtp);
+    uintptr_t addr = altProgressPtr(smtp);
 
     size_t chunkSize = (BASE64_CHUNKED_LEN * UPLOAD_CHUNKS_NUM) + (2 * UPLOAD_CHUNKS_NUM);
+    // The raw data of UPLOAD_CHUNKS_NUM lines is read and encoded at once
+    size_t rawSize = base64 ? MB_BASE64_LINE_RAW_LEN * UPLOAD_CHUNKS_NUM : 4;
     int bufIndex = 0;
     bool dataReady = false;
-    int encodedCount = 0;
     int read = 0;
 
+    mb_b64_enc_state b64;
+    b64.wrap = true;
+
     if (!base64)
     {
         if (data_info.size < chunkSize)
@@ -3014,80 +3195,46 @@ bool ESP_Mail_Client::sendBase64(SMTPSession *smtp, SMTP_Message *msg, esp_mail_
     uint8_t *buf = allocMem<uint8_t *>(chunkSize);
     memset(buf, 0, chunkSize);
 
-    uint8_t *rawChunk = allocMem<uint8_t *>(base64 ? 3 : 4);
+    uint8_t *rawChunk = allocMem<uint8_t *>(rawSize);
 
     if (report)
         uploadReport(data_info.filename, addr, data_info.dataIndex / data_info.size);
 
-    int min = base64 ? 3 : 1;
-
     while (chunkAvailable(smtp, data_info))
     {
+        read = getChunk(smtp, data_info, rawChunk, rawSize);
 
-        if (chunkAvailable(smtp, data_info) >= min)
-        {
+        if (!read)
+            goto ex;
 
-            read = getChunk(smtp, data_info, rawChunk, base64);
+        getBuffer(base64, buf, rawChunk, b64, bufIndex, dataReady, read, chunkSize);
 
-            if (!read)
-                goto ex;
-
-            getBuffer(base64, buf, rawChunk, encodedCount, bufIndex, dataReady, read, chunkSize);
-
-            if (dataReady)
-            {
-
-                if (!sendBDAT(smtp, msg, base64 ? bufIndex : bufIndex + 1, false))
-                    goto ex;
-
-                if (!altSendData(buf, base64 ? bufIndex : bufIndex + 1, smtp, msg, false, false, esp_mail_smtp_cmd_undefined, esp_mail_smtp_status_code_0, SMTP_STATUS_UNDEFINED))
-                    goto ex;
+        if (dataReady)
+        {
 
-                memset(buf, 0, chunkSize);
-                bufIndex = 0;
-            }
+            if (!sendBDAT(smtp, msg, base64 ? bufIndex : bufIndex + 1, false))
+                goto ex;
 
-            if (report)
-                uploadReport(data_info.filename, addr, 100 * data_info.dataIndex / data_info.size);
-        }
-        else if (base64)
-        {
-            read = getChunk(smtp, data_info, rawChunk, base64);
-            if (!read)
+            if (!altSendData(buf, base64 ? bufIndex : bufIndex + 1, smtp, msg, false, false, esp_mail_smtp_cmd_undefined, esp_mail_smtp_status_code_0, SMTP_STATUS_UNDEFINED))
                 goto ex;
+
+            memset(buf, 0, chunkSize);
+            bufIndex = 0;
         }
+
+        if (report)
+            uploadReport(data_info.filename, addr, 100 * data_info.dataIndex / data_info.size);
     }
 
     closeChunk(data_info);
 
     if (base64)
     {
-        if (bufIndex > 0)
-        {
-            if (!sendBDAT(smtp, msg, bufIndex, false))
-                goto ex;
-
-            if (!altSendData(buf, bufIndex, smtp, msg, false, false, esp_mail_smtp_cmd_undefined, esp_mail_smtp_status_code_0, SMTP_STATUS_UNDEFINED))
-                goto ex;
-        }
+        // The last incomplete group with padding
+        bufIndex += mb_b64_enc_final(b64, buf + bufIndex);
 
-        if (read)
+        if (bufIndex > 0)
         {
-            memset(buf, 0, chunkSize);
-            bufIndex = 0;
-            buf[bufIndex++] = b64_index_table[rawChunk[0] >> 2];
-            if (read == 1)
-            {
-                buf[bufIndex++] = b64_index_table[(rawChunk[0] & 0x03) << 4];
-                buf[bufIndex++] = '=';
-            }
-            else
-            {
-                buf[bufIndex++] = b64_index_table[((rawChunk[0] & 0x03) << 4) | (rawChunk[1] >> 4)];
-                buf[bufIndex++] = b64_index_table[(rawChunk[1] & 0x0f) << 2];
-            }
-            buf[bufIndex++] = '=';
-
             if (!sendBDAT(smtp, msg, bufIndex, false))
                 goto ex;
 
@@ -3112,29 +3259,15 @@ ex:
     return ret;
 }
 
-void ESP_Mail_Client::getBuffer(bool base64, uint8_t *out, uint8_t *in, int &encodedCount, int &bufIndex, bool &dataReady, int &size, size_t chunkSize)
+void ESP_Mail_Client::getBuffer(bool base64, uint8_t *out, uint8_t *in, mb_b64_enc_state &b64, int &bufIndex, bool &dataReady, int &size, size_t chunkSize)
 {
     if (base64)
     {
+        // The input of up to UPLOAD_CHUNKS_NUM lines always fits the chunk,
+        // the incomplete group is kept in encoder state
+        bufIndex += mb_b64_enc_update(b64, in, size, out + bufIndex);
         size = 0;
-        out[bufIndex++] = b64_index_table[in[0] >> 2];
-        out[bufIndex++] = b64_index_table[((in[0] & 0x03) << 4) | (in[1] >> 4)];
-        out[bufIndex++] = b64_index_table[((in[1] & 0x0f) << 2) | (in[2] >> 6)];
-        out[bufIndex++] = b64_index_table[in[2] & 0x3f];
-
-        encodedCount += 4;
-
-        if (encodedCount == BASE64_CHUNKED_LEN)
-        {
-            if (bufIndex + 1 < (int)chunkSize)
-            {
-                out[bufIndex++] = 0x0d;
-                out[bufIndex++] = 0x0a;
-            }
-            encodedCount = 0;
-        }
-
-        dataReady = bufIndex >= (int)chunkSize - 4;
+        dataReady = bufIndex > 0;
     }
     else
     {
@@ -3183,7 +3316,7 @@ bool SMTPSession::connect(Session_Config *session_config, bool login)
 
     this->_customCmdResCallback = NULL;
 
-    int ptr = toAddr(*session_config);
+    uintptr_t ptr = toAddr(*session_config);
     session_config->addPtr(&_configPtrList, ptr);
 
     if (!handleConnection(session_config, _sessionSSL))
@@ -3378,6 +3511,10 @@ int SMTPSession::mSendCustomCommand(MB_StringPtr cmd, smtpResponseCallback callb
         if (!client.connectSSL(verify))
             return false;
 
+#if defined(ESP_MAIL_SESSION_CACHE_ENABLED)
+        MailClient.storeSessionCache(_session_cfg, &_bsslSession);
+#endif
+
         // set the secure mode
         if (_session_cfg)
         {
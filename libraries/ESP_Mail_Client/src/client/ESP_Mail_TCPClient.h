@@ -65,6 +65,9 @@ public:
     {
 #if !defined(ESP_MAIL_DISABLE_SSL)
         _tcp_client = new ESP_SSLClient();
+        // Every command and message upload is followed by the response reading
+        // which sends the staged record, no flush timer is needed.
+        _tcp_client->setWriteCoalescing(true, 0);
 #endif
     }
 
@@ -132,7 +135,7 @@ public:
 
     /**
      * Set Root CA certificate to verify.
-     * @param caCert The certificate.
+     * @param caCert The certificate, or the trust anchors blob created by tools/ta_blob.py.
      */
     void setCACert(const char *caCert)
     {
@@ -141,9 +144,21 @@ public:
         {
             if (_x509)
                 delete _x509;
+            _x509 = nullptr;
 
-            _x509 = new X509List(caCert);
-            _tcp_client->setTrustAnchors(_x509);
+#if defined(USE_LIB_SSL_ENGINE)
+            // The blob is used in place without decoding
+            if (TrustAnchorBlob::isBlob(caCert))
+            {
+                _tcp_client->setTrustAnchors(nullptr);
+                _tcp_client->setCACert(caCert);
+            }
+            else
+#endif
+            {
+                _x509 = new X509List(caCert);
+                _tcp_client->setTrustAnchors(_x509);
+            }
 
             setCertType(esp_mail_cert_type_data);
             setTA(true);
@@ -503,8 +518,21 @@ public:
         _host = host;
         _port = port;
 #if !defined(ESP_MAIL_DISABLE_SSL)
-        _tcp_client->setBufferSizes(_rx_size >= _minRXTXBufSize && _rx_size <= _maxRXBufSize ? _rx_size : _maxRXBufSize / rxBufDivider,
-                                    _tx_size >= _minRXTXBufSize && _tx_size <= _maxTXBufSize ? _tx_size : _maxTXBufSize / txBufDivider);
+        bool rxSet = _rx_size >= _minRXTXBufSize && _rx_size <= _maxRXBufSize;
+        bool txSet = _tx_size >= _minRXTXBufSize && _tx_size <= _maxTXBufSize;
+
+        if (!rxSet && !txSet)
+        {
+            // Offer the rx size as max fragment length, the rx buffer grows only if the server ignores it.
+            int rx = _maxRXBufSize / rxBufDivider, tx = _maxTXBufSize / txBufDivider;
+            if (sharedIOBuffer)
+                _tcp_client->setAdaptiveBufferSizes(rx > tx ? rx : tx, 0);
+            else
+                _tcp_client->setAdaptiveBufferSizes(rx, tx);
+        }
+        else
+            _tcp_client->setBufferSizes(rxSet ? _rx_size : _maxRXBufSize / rxBufDivider,
+                                        txSet ? _tx_size : _maxTXBufSize / txBufDivider);
 #endif
         _last_error = 0;
         return true;
@@ -687,7 +715,9 @@ public:
         if (!networkReady())
             return TCP_CLIENT_ERROR_NOT_CONNECTED;
 
-        if (!connect(isSecure(), isVerify()))
+        // Reconnect only when the connection was closed, connect() on the opened connection
+        // discards the unread response and sends the staged TLS record for every write.
+        if (!connected() && !connect(isSecure(), isVerify()))
             return TCP_CLIENT_ERROR_CONNECTION_REFUSED;
 
         int toSend = _chunkSize;
@@ -813,6 +843,33 @@ public:
         return readBytes((uint8_t *)buf, len);
     }
 
+    /**
+     * Get the decrypted data that can be read in place without copying.
+     * @param len The length of data.
+     * @return The pointer to data or nullptr when no data available or the connection is not secure.
+     */
+    const char *peekBuffer(size_t &len)
+    {
+        len = 0;
+#if !defined(ESP_MAIL_DISABLE_SSL)
+        if (_basic_client && _tcp_client)
+            return _tcp_client->peekBuffer(len);
+#endif
+        return nullptr;
+    }
+
+    /**
+     * Remove the data that was read from the buffer of peekBuffer.
+     * @param len The length of data to remove.
+     */
+    void peekConsume(size_t len)
+    {
+#if !defined(ESP_MAIL_DISABLE_SSL)
+        if (_basic_client && _tcp_client)
+            _tcp_client->peekConsume(len);
+#endif
+    }
+
     /**
      * Wait for all receive buffer data read.
      */
@@ -1158,6 +1215,10 @@ public:
 
     int rxBufDivider = 16;
     int txBufDivider = 32;
+    // Share one TLS buffer for rx and tx, opt-in for the strictly half-duplex use only.
+    // A reply that arrives while the output is still staged (e.g. SMTP PIPELINING or an
+    // early server error) stops the write until it is read.
+    bool sharedIOBuffer = false;
 
 private:
     // lwIP TCP Keepalive idle in seconds.
@@ -55,6 +55,27 @@ enum esp_ssl_client_error_types
     esp_ssl_internal_error
 };
 
+enum esp_ssl_cipher_engine
+{
+    // the AES hardware if available, otherwise ct64 on 64-bit and ct on 32-bit CPUs
+    esp_ssl_cipher_engine_auto,
+    // AES-NI/PCLMUL/SSE2 on x86 or the POWER8 crypto opcodes
+    esp_ssl_cipher_engine_hw,
+    // the constant-time bitsliced AES for 64-bit CPUs
+    esp_ssl_cipher_engine_ct64,
+    // the constant-time bitsliced AES for 32-bit CPUs
+    esp_ssl_cipher_engine_ct,
+    // the table-based AES, smaller and may be faster on MCUs but not constant-time
+    esp_ssl_cipher_engine_small
+};
+
+enum esp_ssl_bulk_cipher
+{
+    esp_ssl_bulk_cipher_aes128_gcm,
+    esp_ssl_bulk_cipher_aes128_cbc,
+    esp_ssl_bulk_cipher_chacha20_poly1305
+};
+
 #if defined(ESP_SSLCLIENT_ENABLE_DEBUG)
 
 static void esp_ssl_debug_print_prefix(const char *func_name, int level)
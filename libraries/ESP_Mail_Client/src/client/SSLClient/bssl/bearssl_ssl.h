@@ -1834,6 +1834,44 @@ void br_ssl_engine_set_buffer(br_ssl_engine_context *cc,
 void br_ssl_engine_set_buffers_bidi(br_ssl_engine_context *cc,
 	void *ibuf, size_t ibuf_len, void *obuf, size_t obuf_len);
 
+/**
+ * \brief Set the maximum fragment length.
+ *
+ * This function may be called after the buffers are set and before the
+ * handshake, to offer a maximum fragment length in the Maximum Fragment
+ * Length extension other than the one computed from the buffer sizes.
+ * The length MUST be 512, 1024, 2048 or 4096, and the input buffer MUST
+ * still fit an incoming record of that length. The outgoing records are
+ * also limited by the output buffer size, so the output buffer may be
+ * smaller.
+ *
+ * \param cc             SSL engine context.
+ * \param max_frag_len   maximum fragment length (in bytes).
+ * \return  1 on success, 0 if the length is not valid or does not fit
+ *          the input buffer (the engine is unchanged).
+ */
+int br_ssl_engine_set_max_frag_len(br_ssl_engine_context *cc,
+	unsigned max_frag_len);
+
+/**
+ * \brief Move the input buffer to a larger one.
+ *
+ * The current content of the input buffer is copied into the new
+ * buffer, which then replaces it; with a shared buffer (half-duplex
+ * mode), the output buffer is replaced too. This allows receiving a
+ * record larger than the input buffer, e.g. when the peer did not
+ * accept the offered maximum fragment length, once its header is
+ * known. The old buffer is no longer used and may be released.
+ *
+ * \param cc         SSL engine context.
+ * \param ibuf       new input buffer.
+ * \param ibuf_len   new input buffer length (in bytes).
+ * \return  1 on success, 0 if the new buffer is smaller than the current
+ *          one (the engine is unchanged).
+ */
+int br_ssl_engine_grow_ibuf(br_ssl_engine_context *cc,
+	void *ibuf, size_t ibuf_len);
+
 /**
  * \brief Determine if MFLN negotiation was successful
  *
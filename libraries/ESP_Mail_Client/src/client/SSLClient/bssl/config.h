@@ -231,6 +231,23 @@
 #define BR_UMUL128   1
  */
 
+/*
+ * When BR_AES_CT is set explicitly to 0, the cipher engines of the
+ * client do not use the constant-time bitsliced AES for 32-bit CPUs
+ * (aes_ct), and the table-based implementation is used in its place.
+ *
+#define BR_AES_CT   1
+ */
+
+/*
+ * When BR_AES_SMALL is set explicitly to 0, the cipher engines of the
+ * client do not use the table-based AES (aes_small), and the
+ * constant-time bitsliced implementation is used in its place. It
+ * can not be disabled together with BR_AES_CT.
+ *
+#define BR_AES_SMALL   1
+ */
+
 /*
  * When BR_LE_UNALIGNED is enabled, then the current architecture is
  * assumed to use little-endian encoding for integers, and to tolerate
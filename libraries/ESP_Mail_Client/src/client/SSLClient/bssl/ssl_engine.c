@@ -343,6 +343,53 @@ br_ssl_engine_new_max_frag_len(br_ssl_engine_context *rc, unsigned max_frag_len)
 	}
 }
 
+/* see bearssl_ssl.h */
+int
+br_ssl_engine_set_max_frag_len(br_ssl_engine_context *rc,
+	unsigned max_frag_len)
+{
+	unsigned u;
+
+	if (rc->ibuf == NULL) {
+		return 0;
+	}
+	for (u = 9; u <= 12; u ++) {
+		if (max_frag_len == ((unsigned)1 << u)) {
+			break;
+		}
+	}
+	if (u > 12 || rc->ibuf_len < max_frag_len + MAX_IN_OVERHEAD) {
+		return 0;
+	}
+
+	/*
+	 * The outgoing records are also bounded by the output buffer
+	 * in make_ready_out(), so a smaller output buffer only makes
+	 * smaller records.
+	 */
+	rc->log_max_frag_len = u;
+	br_ssl_engine_new_max_frag_len(rc, max_frag_len);
+	return 1;
+}
+
+/* see bearssl_ssl.h */
+int
+br_ssl_engine_grow_ibuf(br_ssl_engine_context *rc,
+	void *ibuf, size_t ibuf_len)
+{
+	if (rc->ibuf == NULL || ibuf == NULL || ibuf_len < rc->ibuf_len) {
+		return 0;
+	}
+	memcpy(ibuf, rc->ibuf, rc->ibuf_len);
+	if (rc->obuf == rc->ibuf) {
+		rc->obuf = ibuf;
+		rc->obuf_len = ibuf_len;
+	}
+	rc->ibuf = ibuf;
+	rc->ibuf_len = ibuf_len;
+	return 1;
+}
+
 /* see bearssl_ssl.h */
 void
 br_ssl_engine_set_buffer(br_ssl_engine_context *rc,
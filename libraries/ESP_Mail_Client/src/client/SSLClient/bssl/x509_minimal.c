@@ -1205,6 +1205,25 @@ br_x509_minimal_run(void *t0ctx)
 			T0_CO();
 		}
 	}
+	if (CTX->trust_anchor_dynamic) {
+		const br_x509_trust_anchor *ta;
+
+		ta = CTX->trust_anchor_dynamic(CTX->trust_anchor_dynamic_ctx,
+			CTX->saved_dn_hash, DNHASH_LEN);
+		if (ta) {
+			int ret;
+
+			ret = verify_signature(CTX, &ta->pkey) == 0;
+			if (CTX->trust_anchor_dynamic_free) {
+				CTX->trust_anchor_dynamic_free(
+					CTX->trust_anchor_dynamic_ctx, ta);
+			}
+			if (ret) {
+				CTX->err = BR_ERR_X509_OK;
+				T0_CO();
+			}
+		}
+	}
 
 				}
 				break;
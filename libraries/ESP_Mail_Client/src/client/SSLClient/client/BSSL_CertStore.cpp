@@ -29,6 +29,290 @@
 
 #include "BSSL_CertStore.h"
 
+namespace bssl
+{
+
+  // The blob header: "BRTA", uint16 version, uint16 count, uint32 total size,
+  // followed by the index entries of the DN hash and uint32 record offset, sorted by the hash.
+  static const uint8_t ta_blob_magic[] = {'B', 'R', 'T', 'A'};
+  static const uint16_t ta_blob_version = 1;
+  static const size_t ta_blob_header_len = 12;
+  static const size_t ta_blob_index_len = 36;
+  // uint16 dn length, uint8 flags, uint8 key type, uint16 n length or curve, uint16 e or q length
+  static const size_t ta_blob_record_len = 8;
+
+  static inline uint16_t ta_blob_rd16(const uint8_t *p) { return p[0] | (p[1] << 8); }
+
+  static inline uint32_t ta_blob_rd32(const uint8_t *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+  static inline uint8_t *ta_blob_wr16(uint8_t *p, uint16_t v)
+  {
+    p[0] = v;
+    p[1] = v >> 8;
+    return p + 2;
+  }
+
+  static inline uint8_t *ta_blob_wr32(uint8_t *p, uint32_t v)
+  {
+    ta_blob_wr16(p, v);
+    return ta_blob_wr16(p + 2, v >> 16);
+  }
+
+  extern "C"
+  {
+    // Orders the index entries by the DN hash, then by the record offset
+    static int ta_blob_index_cmp(const void *a, const void *b)
+    {
+      int cmp = memcmp(a, b, 32);
+      if (cmp)
+        return cmp;
+      uint32_t oa = ta_blob_rd32(reinterpret_cast<const uint8_t *>(a) + 32);
+      uint32_t ob = ta_blob_rd32(reinterpret_cast<const uint8_t *>(b) + 32);
+      return oa < ob ? -1 : oa > ob;
+    }
+  }
+
+  TrustAnchorBlob::~TrustAnchorBlob()
+  {
+    clear();
+  }
+
+  void TrustAnchorBlob::clear()
+  {
+    free(_dups);
+    _dups = nullptr;
+    _dupCount = 0;
+    _blob = nullptr;
+    _count = 0;
+  }
+
+  bool TrustAnchorBlob::isBlob(const void *data)
+  {
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(data);
+    return p && !memcmp(p, ta_blob_magic, sizeof(ta_blob_magic)) && ta_blob_rd16(p + 4) == ta_blob_version;
+  }
+
+  int TrustAnchorBlob::load(const uint8_t *blob, size_t len)
+  {
+    clear();
+
+    if (!isBlob(blob))
+      return 0;
+
+    size_t count = ta_blob_rd16(blob + 6);
+    size_t total = ta_blob_rd32(blob + 8);
+    size_t records = ta_blob_header_len + count * ta_blob_index_len;
+    if ((len && total > len) || records > total)
+      return 0;
+
+    // Only the record bounds are checked, the trust anchors are not decoded.
+    // The records follow the index, a record may not overlap the header or the index.
+    size_t dups = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+      const uint8_t *entry = blob + ta_blob_header_len + i * ta_blob_index_len;
+      // The bounds are compared with the bytes left, a sum may wrap on a 32-bit size_t
+      size_t offset = ta_blob_rd32(entry + 32);
+      if (offset < records || offset > total || ta_blob_record_len > total - offset)
+        return 0;
+
+      const uint8_t *rec = blob + offset;
+      size_t left = total - offset - ta_blob_record_len;
+      size_t dnLen = ta_blob_rd16(rec);
+      size_t keyLen = 0;
+      if (rec[3] == BR_KEYTYPE_RSA)
+        keyLen = ta_blob_rd16(rec + 4) + ta_blob_rd16(rec + 6);
+      else if (rec[3] == BR_KEYTYPE_EC)
+        keyLen = ta_blob_rd16(rec + 6);
+      else
+        return 0;
+
+      if (dnLen > left || keyLen > left - dnLen)
+        return 0;
+
+      if ((i > 0 && !memcmp(entry, entry - ta_blob_index_len, 32)) || (i + 1 < count && !memcmp(entry, entry + ta_blob_index_len, 32)))
+        dups++;
+    }
+
+    _blob = blob;
+    _count = count;
+
+    // The lookup by DN hash returns one trust anchor, the roots with the same DN are scanned instead
+    if (dups)
+    {
+      _dups = reinterpret_cast<br_x509_trust_anchor *>(malloc(dups * sizeof(br_x509_trust_anchor)));
+      if (_dups)
+      {
+        for (size_t i = 0; i < count; i++)
+        {
+          const uint8_t *entry = blob + ta_blob_header_len + i * ta_blob_index_len;
+          if ((i > 0 && !memcmp(entry, entry - ta_blob_index_len, 32)) || (i + 1 < count && !memcmp(entry, entry + ta_blob_index_len, 32)))
+            readTA(i, &_dups[_dupCount++]);
+        }
+      }
+    }
+
+    return _count;
+  }
+
+  bool TrustAnchorBlob::readTA(size_t idx, br_x509_trust_anchor *ta) const
+  {
+    if (!_blob || idx >= _count)
+      return false;
+
+    const uint8_t *rec = _blob + ta_blob_rd32(_blob + ta_blob_header_len + idx * ta_blob_index_len + 32);
+    unsigned char *data = const_cast<unsigned char *>(rec + ta_blob_record_len);
+
+    memset(ta, 0, sizeof(br_x509_trust_anchor));
+    ta->dn.data = data;
+    ta->dn.len = ta_blob_rd16(rec);
+    ta->flags = rec[2];
+    ta->pkey.key_type = rec[3];
+    data += ta->dn.len;
+
+    if (rec[3] == BR_KEYTYPE_RSA)
+    {
+      ta->pkey.key.rsa.n = data;
+      ta->pkey.key.rsa.nlen = ta_blob_rd16(rec + 4);
+      ta->pkey.key.rsa.e = data + ta->pkey.key.rsa.nlen;
+      ta->pkey.key.rsa.elen = ta_blob_rd16(rec + 6);
+    }
+    else
+    {
+      ta->pkey.key.ec.curve = ta_blob_rd16(rec + 4);
+      ta->pkey.key.ec.q = data;
+      ta->pkey.key.ec.qlen = ta_blob_rd16(rec + 6);
+    }
+    return true;
+  }
+
+  const uint8_t *TrustAnchorBlob::findIndex(const void *hashed_dn) const
+  {
+    int lo = 0, hi = (int)_count - 1;
+    while (lo <= hi)
+    {
+      int mid = lo + (hi - lo) / 2;
+      const uint8_t *entry = _blob + ta_blob_header_len + mid * ta_blob_index_len;
+      int cmp = memcmp(entry, hashed_dn, 32);
+      if (cmp == 0)
+        return entry;
+      if (cmp < 0)
+        lo = mid + 1;
+      else
+        hi = mid - 1;
+    }
+    return nullptr;
+  }
+
+  size_t TrustAnchorBlob::build(const X509List *list, uint8_t *dest, size_t size)
+  {
+    if (!list || list->getCount() > 0xffff)
+      return 0;
+
+    const br_x509_trust_anchor *tas = list->getTrustAnchors();
+    size_t count = list->getCount();
+    size_t total = ta_blob_header_len + count * ta_blob_index_len;
+    for (size_t i = 0; i < count; i++)
+    {
+      total += ta_blob_record_len + tas[i].dn.len;
+      if (tas[i].pkey.key_type == BR_KEYTYPE_RSA)
+        total += tas[i].pkey.key.rsa.nlen + tas[i].pkey.key.rsa.elen;
+      else
+        total += tas[i].pkey.key.ec.qlen;
+    }
+
+    if (!dest)
+      return total;
+
+    if (size < total)
+      return 0;
+
+    memcpy(dest, ta_blob_magic, sizeof(ta_blob_magic));
+    ta_blob_wr16(dest + 4, ta_blob_version);
+    ta_blob_wr16(dest + 6, count);
+    ta_blob_wr32(dest + 8, total);
+
+    uint8_t *entry = dest + ta_blob_header_len;
+    uint8_t *p = entry + count * ta_blob_index_len;
+    br_sha256_context sha256;
+
+    for (size_t i = 0; i < count; i++, entry += ta_blob_index_len)
+    {
+      const br_x509_trust_anchor *ta = &tas[i];
+
+      // The same hash as the hashed_dn of the X509 decoder
+      br_sha256_init(&sha256);
+      br_sha256_update(&sha256, ta->dn.data, ta->dn.len);
+      br_sha256_out(&sha256, entry);
+      ta_blob_wr32(entry + 32, p - dest);
+
+      p = ta_blob_wr16(p, ta->dn.len);
+      *p++ = ta->flags;
+      *p++ = ta->pkey.key_type;
+      if (ta->pkey.key_type == BR_KEYTYPE_RSA)
+      {
+        p = ta_blob_wr16(p, ta->pkey.key.rsa.nlen);
+        p = ta_blob_wr16(p, ta->pkey.key.rsa.elen);
+        memcpy(p, ta->dn.data, ta->dn.len);
+        p += ta->dn.len;
+        memcpy(p, ta->pkey.key.rsa.n, ta->pkey.key.rsa.nlen);
+        p += ta->pkey.key.rsa.nlen;
+        memcpy(p, ta->pkey.key.rsa.e, ta->pkey.key.rsa.elen);
+        p += ta->pkey.key.rsa.elen;
+      }
+      else
+      {
+        p = ta_blob_wr16(p, ta->pkey.key.ec.curve);
+        p = ta_blob_wr16(p, ta->pkey.key.ec.qlen);
+        memcpy(p, ta->dn.data, ta->dn.len);
+        p += ta->dn.len;
+        memcpy(p, ta->pkey.key.ec.q, ta->pkey.key.ec.qlen);
+        p += ta->pkey.key.ec.qlen;
+      }
+    }
+
+    qsort(dest + ta_blob_header_len, count, ta_blob_index_len, ta_blob_index_cmp);
+    return total;
+  }
+
+  void TrustAnchorBlob::installCertStore(br_x509_minimal_context *ctx)
+  {
+    br_x509_minimal_set_dynamic(ctx, (void *)this, findHashedTA, freeHashedTA);
+    if (_dupCount && !ctx->trust_anchors_num)
+    {
+      ctx->trust_anchors = _dups;
+      ctx->trust_anchors_num = _dupCount;
+    }
+  }
+
+  const br_x509_trust_anchor *TrustAnchorBlob::findHashedTA(void *ctx, void *hashed_dn, size_t len)
+  {
+    TrustAnchorBlob *tb = static_cast<TrustAnchorBlob *>(ctx);
+    if (!tb || !tb->_blob || len != 32)
+      return nullptr;
+
+    const uint8_t *entry = tb->findIndex(hashed_dn);
+    if (!entry)
+      return nullptr;
+
+    size_t idx = (entry - tb->_blob - ta_blob_header_len) / ta_blob_index_len;
+
+    // The roots with the same DN are the static trust anchors
+    if ((idx > 0 && !memcmp(entry, entry - ta_blob_index_len, 32)) || (idx + 1 < tb->_count && !memcmp(entry, entry + ta_blob_index_len, 32)))
+      return nullptr;
+
+    return tb->readTA(idx, &tb->_ta) ? &tb->_ta : nullptr;
+  }
+
+  void TrustAnchorBlob::freeHashedTA(void *ctx, const br_x509_trust_anchor *ta)
+  {
+    // Nothing to free, the trust anchor points into the blob
+    (void)ctx;
+    (void)ta;
+  }
+
+}
+
 #if defined(ESP_SSL_FS_SUPPORTED)
 
 #include <memory>
@@ -50,12 +334,54 @@ namespace bssl
       br_sha256_context *sha1 = (br_sha256_context *)ctx;
       br_sha256_update(sha1, buf, len);
     }
+
+    // Orders the index records by the DN hash
+    static int cert_info_cmp(const void *a, const void *b)
+    {
+      return memcmp(a, b, 32);
+    }
   }
 
   CertStore::~CertStore()
   {
     free(_indexName);
     free(_dataName);
+    freeIndex();
+    freeCache();
+  }
+
+  void CertStore::freeIndex()
+  {
+    free(_index);
+    _index = nullptr;
+    _indexCount = 0;
+  }
+
+  void CertStore::freeCache()
+  {
+    if (_cache)
+    {
+      for (uint8_t i = 0; i < _cacheSize; i++)
+        delete _cache[i].x509;
+      delete[] _cache;
+    }
+    _cache = nullptr;
+    _cacheTick = 0;
+  }
+
+  void CertStore::setTrustAnchorCacheSize(uint8_t size)
+  {
+    freeCache();
+    _cacheSize = size;
+    if (_cacheSize)
+    {
+      _cache = new (std::nothrow) CachedTA[_cacheSize];
+      if (!_cache)
+      {
+        DEBUG_BSSL("CertStore::setTrustAnchorCacheSize: OOM\n");
+        _cacheSize = 0;
+      }
+    }
   }
 
   CertStore::CertInfo CertStore::_preprocessCert(uint32_t length, uint32_t offset, const void *raw)
@@ -97,13 +423,22 @@ namespace bssl
 
   // The certs.ar file is a UNIX ar format file, concatenating all the
   // individual certificates into a single blob in a space-efficient way.
-  int CertStore::initCertStore(FS &fs, const char *indexFileName, const char *dataFileName)
+  int CertStore::initCertStore(FS &fs, const char *indexFileName, const char *dataFileName, bool memIndex)
   {
     int count = 0;
+    int capacity = 0;
     uint32_t offset = 0;
 
     _fs = &fs;
 
+    // The cached trust anchors may belong to the old data file
+    freeIndex();
+    for (uint8_t i = 0; _cache && i < _cacheSize; i++)
+    {
+      delete _cache[i].x509;
+      _cache[i].x509 = nullptr;
+    }
+
     // In case initCertStore called multiple times, don't leak old filenames
     free(_indexName);
     free(_dataName);
@@ -180,6 +515,26 @@ namespace bssl
           free(raw);
           break;
         }
+
+        if (memIndex)
+        {
+          if (count == capacity)
+          {
+            capacity = capacity ? capacity * 2 : 32;
+            CertInfo *p = (CertInfo *)realloc(_index, capacity * sizeof(CertInfo));
+            if (!p)
+            {
+              // Fall back to the index file lookup
+              DEBUG_BSSL("CertStore::initCertStore: OOM\n");
+              freeIndex();
+              memIndex = false;
+            }
+            else
+              _index = p;
+          }
+          if (memIndex)
+            _index[count] = ci;
+        }
         count++;
       }
 
@@ -194,6 +549,12 @@ namespace bssl
     }
     data.close();
     index.close();
+
+    if (memIndex && _index)
+    {
+      _indexCount = count;
+      qsort(_index, _indexCount, sizeof(CertInfo), cert_info_cmp);
+    }
     return count;
   }
 
@@ -202,20 +563,32 @@ namespace bssl
     br_x509_minimal_set_dynamic(ctx, (void *)this, findHashedTA, freeHashedTA);
   }
 
-  const br_x509_trust_anchor *CertStore::findHashedTA(void *ctx, void *hashed_dn, size_t len)
+  bool CertStore::findIndex(const void *hashed_dn, CertInfo &ci)
   {
-    CertStore *cs = static_cast<CertStore *>(ctx);
-    CertStore::CertInfo ci;
-
-    if (!cs || len != sizeof(ci.sha256) || !cs->_indexName || !cs->_dataName || !cs->_fs)
+    int lo = 0, hi = _indexCount - 1;
+    while (lo <= hi)
     {
-      return nullptr;
+      int mid = lo + (hi - lo) / 2;
+      int cmp = memcmp(_index[mid].sha256, hashed_dn, sizeof(ci.sha256));
+      if (cmp == 0)
+      {
+        ci = _index[mid];
+        return true;
+      }
+      if (cmp < 0)
+        lo = mid + 1;
+      else
+        hi = mid - 1;
     }
+    return false;
+  }
 
-    File index = cs->_fs->open(cs->_indexName, FILE_READ);
+  bool CertStore::findFile(const void *hashed_dn, CertInfo &ci)
+  {
+    File index = _fs->open(_indexName, FILE_READ);
     if (!index)
     {
-      return nullptr;
+      return false;
     }
 
     while (index.read((uint8_t *)&ci, sizeof(ci)) == sizeof(ci))
@@ -223,52 +596,148 @@ namespace bssl
       if (!memcmp(ci.sha256, hashed_dn, sizeof(ci.sha256)))
       {
         index.close();
-        uint8_t *der = (uint8_t *)malloc(ci.length);
-        if (!der)
-        {
-          return nullptr;
-        }
-        File data = cs->_fs->open(cs->_dataName, FILE_READ);
-        if (!data)
-        {
-          free(der);
-          return nullptr;
-        }
-        if (!data.seek(ci.offset, SeekSet))
-        {
-          data.close();
-          free(der);
-          return nullptr;
-        }
-        if ((int)data.read(der, ci.length) != (int)ci.length)
-        {
-          free(der);
-          return nullptr;
-        }
-        data.close();
-        cs->_x509 = new (std::nothrow) X509List(der, ci.length);
-        free(der);
-        if (!cs->_x509)
-        {
-          DEBUG_BSSL("CertStore::findHashedTA: OOM\n");
-          return nullptr;
-        }
+        return true;
+      }
+    }
+    index.close();
+    return false;
+  }
+
+  X509List *CertStore::loadCert(const CertInfo &ci)
+  {
+    uint8_t *der = (uint8_t *)malloc(ci.length);
+    if (!der)
+    {
+      return nullptr;
+    }
+    File data = _fs->open(_dataName, FILE_READ);
+    if (!data)
+    {
+      free(der);
+      return nullptr;
+    }
+    if (!data.seek(ci.offset, SeekSet))
+    {
+      data.close();
+      free(der);
+      return nullptr;
+    }
+    if ((int)data.read(der, ci.length) != (int)ci.length)
+    {
+      data.close();
+      free(der);
+      return nullptr;
+    }
+    data.close();
+    X509List *x509 = new (std::nothrow) X509List(der, ci.length);
+    free(der);
+    if (!x509)
+    {
+      DEBUG_BSSL("CertStore::loadCert: OOM\n");
+      return nullptr;
+    }
 
-        br_x509_trust_anchor *ta = (br_x509_trust_anchor *)cs->_x509->getTrustAnchors();
-        memcpy(ta->dn.data, ci.sha256, sizeof(ci.sha256));
-        ta->dn.len = sizeof(ci.sha256);
+    // The DN is replaced by its hash, a DN shorter than the hash needs a larger buffer
+    br_x509_trust_anchor *ta = (br_x509_trust_anchor *)x509->getTrustAnchors();
+    if (ta->dn.len < sizeof(ci.sha256))
+    {
+      unsigned char *dn = (unsigned char *)realloc(ta->dn.data, sizeof(ci.sha256));
+      if (!dn)
+      {
+        delete x509;
+        return nullptr;
+      }
+      ta->dn.data = dn;
+    }
+    memcpy(ta->dn.data, ci.sha256, sizeof(ci.sha256));
+    ta->dn.len = sizeof(ci.sha256);
+    return x509;
+  }
 
-        return ta;
+  X509List *CertStore::findCache(const void *hashed_dn)
+  {
+    for (uint8_t i = 0; _cache && i < _cacheSize; i++)
+    {
+      if (_cache[i].x509 && !memcmp(_cache[i].sha256, hashed_dn, sizeof(_cache[i].sha256)))
+      {
+        _cache[i].lastUsed = ++_cacheTick;
+        return _cache[i].x509;
       }
     }
-    index.close();
     return nullptr;
   }
 
+  void CertStore::addCache(const CertInfo &ci, X509List *x509)
+  {
+    // Take the free slot or the least recently used one
+    int slot = -1;
+    for (uint8_t i = 0; _cache && i < _cacheSize; i++)
+    {
+      if (!_cache[i].x509)
+      {
+        slot = i;
+        break;
+      }
+      if (slot < 0 || _cache[i].lastUsed < _cache[slot].lastUsed)
+        slot = i;
+    }
+
+    if (slot < 0)
+      return;
+
+    delete _cache[slot].x509;
+    memcpy(_cache[slot].sha256, ci.sha256, sizeof(ci.sha256));
+    _cache[slot].x509 = x509;
+    _cache[slot].lastUsed = ++_cacheTick;
+  }
+
+  const br_x509_trust_anchor *CertStore::findHashedTA(void *ctx, void *hashed_dn, size_t len)
+  {
+    CertStore *cs = static_cast<CertStore *>(ctx);
+    CertStore::CertInfo ci;
+
+    if (!cs || len != sizeof(ci.sha256) || !cs->_indexName || !cs->_dataName || !cs->_fs)
+    {
+      return nullptr;
+    }
+
+    // The cached trust anchor does not need the file access
+    X509List *x509 = cs->findCache(hashed_dn);
+    if (x509)
+    {
+      return x509->getTrustAnchors();
+    }
+
+    bool found = cs->_index ? cs->findIndex(hashed_dn, ci) : cs->findFile(hashed_dn, ci);
+    if (!found)
+    {
+      return nullptr;
+    }
+
+    x509 = cs->loadCert(ci);
+    if (!x509)
+    {
+      return nullptr;
+    }
+
+    if (cs->_cache)
+    {
+      cs->addCache(ci, x509);
+    }
+    else
+    {
+      // Not cached, it will be freed in freeHashedTA
+      cs->_x509 = x509;
+    }
+
+    return x509->getTrustAnchors();
+  }
+
   void CertStore::freeHashedTA(void *ctx, const br_x509_trust_anchor *ta)
   {
     CertStore *cs = static_cast<CertStore *>(ctx);
     (void)ta; // Unused
+    // The cached trust anchors are kept until evicted or the store is destroyed
     delete cs->_x509;
     cs->_x509 = nullptr;
   }
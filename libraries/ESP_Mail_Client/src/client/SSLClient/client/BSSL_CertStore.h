@@ -35,9 +35,6 @@
 #endif
 #endif
 
-#if defined(ESP_SSL_FS_SUPPORTED)
-
-
 #include "../bssl/bearssl.h"
 #include "BSSL_Helper.h"
 
@@ -59,6 +56,56 @@ namespace bssl
     virtual void installCertStore(br_x509_minimal_context *ctx) = 0;
   };
 
+  // The trust anchors decoded ahead of time by tools/ta_blob.py or build(), referenced in place
+  // from flash, PROGMEM or RAM, so the connection costs no PEM and X.509 decoding and no heap.
+  class TrustAnchorBlob : public CertStoreBase
+  {
+  public:
+    TrustAnchorBlob(){};
+    explicit TrustAnchorBlob(const uint8_t *blob, size_t len = 0) { load(blob, len); }
+    ~TrustAnchorBlob();
+
+    // Owns the trust anchors of the roots with the same DN
+    TrustAnchorBlob(const TrustAnchorBlob &) = delete;
+    TrustAnchorBlob &operator=(const TrustAnchorBlob &) = delete;
+
+    // Reference the blob without copying, it must stay valid while in use.
+    // Returns the number of trust anchors or 0 if the blob is not valid.
+    int load(const uint8_t *blob, size_t len = 0);
+
+    void clear();
+
+    size_t getCount() const { return _count; }
+
+    // Check the blob signature
+    static bool isBlob(const void *data);
+
+    // Serialize the trust anchors of the X509List, returns the blob size or 0 on error.
+    // With null dest, returns the size needed.
+    static size_t build(const X509List *list, uint8_t *dest, size_t size);
+
+    // Installs the cert store into the X509 decoder (normally via static function callbacks)
+    void installCertStore(br_x509_minimal_context *ctx);
+
+  protected:
+    const uint8_t *_blob = nullptr;
+    size_t _count = 0;
+    // The trust anchor returned by the last lookup, pointing into the blob
+    br_x509_trust_anchor _ta;
+    // The trust anchors that share the DN hash, BearSSL scans them as the static trust anchors
+    br_x509_trust_anchor *_dups = nullptr;
+    size_t _dupCount = 0;
+
+    const uint8_t *findIndex(const void *hashed_dn) const;
+    bool readTA(size_t idx, br_x509_trust_anchor *ta) const;
+
+    // These need to be static as they are callbacks from BearSSL C code
+    static const br_x509_trust_anchor *findHashedTA(void *ctx, void *hashed_dn, size_t len);
+    static void freeHashedTA(void *ctx, const br_x509_trust_anchor *ta);
+  };
+
+#if defined(ESP_SSL_FS_SUPPORTED)
+
   class CertStore : public CertStoreBase
   {
   public:
@@ -66,7 +113,12 @@ namespace bssl
     ~CertStore();
 
     // Set the file interface instances, do preprocessing
-    int initCertStore(FS &fs, const char *indexFileName, const char *dataFileName);
+    // When memIndex is true, the index is also kept in memory sorted by the DN hash
+    // and binary searched instead of scanning the index file on every lookup.
+    int initCertStore(FS &fs, const char *indexFileName, const char *dataFileName, bool memIndex = false);
+
+    // Set the number of decoded trust anchors to keep for the next lookups, 0 to disable
+    void setTrustAnchorCacheSize(uint8_t size);
 
     // Installs the cert store into the X509 decoder (normally via static function callbacks)
     void installCertStore(br_x509_minimal_context *ctx);
@@ -77,10 +129,6 @@ namespace bssl
     char *_dataName = nullptr;
     X509List *_x509 = nullptr;
 
-    // These need to be static as they are callbacks from BearSSL C code
-    static const br_x509_trust_anchor *findHashedTA(void *ctx, void *hashed_dn, size_t len);
-    static void freeHashedTA(void *ctx, const br_x509_trust_anchor *ta);
-
     // The binary format of the index file
     class CertInfo
     {
@@ -89,13 +137,40 @@ namespace bssl
       uint32_t offset;
       uint32_t length;
     };
+
+    // The decoded trust anchor cache entry
+    class CachedTA
+    {
+    public:
+      uint8_t sha256[32];
+      X509List *x509 = nullptr;
+      uint32_t lastUsed = 0;
+    };
+
+    CertInfo *_index = nullptr;
+    int _indexCount = 0;
+    CachedTA *_cache = nullptr;
+    uint8_t _cacheSize = 0;
+    uint32_t _cacheTick = 0;
+
+    void freeIndex();
+    void freeCache();
+    bool findIndex(const void *hashed_dn, CertInfo &ci);
+    bool findFile(const void *hashed_dn, CertInfo &ci);
+    X509List *loadCert(const CertInfo &ci);
+    X509List *findCache(const void *hashed_dn);
+    void addCache(const CertInfo &ci, X509List *x509);
+
+    // These need to be static as they are callbacks from BearSSL C code
+    static const br_x509_trust_anchor *findHashedTA(void *ctx, void *hashed_dn, size_t len);
+    static void freeHashedTA(void *ctx, const br_x509_trust_anchor *ta);
     static CertInfo _preprocessCert(uint32_t length, uint32_t offset, const void *raw);
   };
 
-};
-
 #endif
 
+};
+
 #endif
 
 #endif
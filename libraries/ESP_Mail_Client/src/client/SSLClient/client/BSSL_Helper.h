@@ -72,9 +72,45 @@
 #elif defined(USE_LIB_SSL_ENGINE)
 
 #include "../bssl/bearssl.h"
+#include "../bssl/config.h"
 
 #endif
 
+// The bulk cipher implementations of the cipher engines. A BR_* switch of bssl/config.h set
+// to 0 keeps its implementation out of the engines, the hardware ones are only for their CPUs.
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#if !defined(BR_AES_X86NI) || BR_AES_X86NI
+#define BSSL_CIPHER_X86NI 1
+#endif
+#if !defined(BR_SSE2) || BR_SSE2
+#define BSSL_CIPHER_SSE2 1
+#endif
+#endif
+
+#if (defined(_ARCH_PWR8) || defined(_ARCH_PPC)) && (!defined(BR_POWER8) || BR_POWER8)
+#define BSSL_CIPHER_PWR8 1
+#endif
+
+#if !defined(BR_64) || BR_64
+#define BSSL_CIPHER_CT64 1
+#endif
+
+#if (!defined(BR_INT128) && !defined(BR_UMUL128)) || BR_INT128 || BR_UMUL128
+#define BSSL_CIPHER_CTMULQ 1
+#endif
+
+#if !defined(BR_AES_CT) || BR_AES_CT
+#define BSSL_CIPHER_CT 1
+#endif
+
+#if !defined(BR_AES_SMALL) || BR_AES_SMALL
+#define BSSL_CIPHER_SMALL 1
+#endif
+
+#if !defined(BSSL_CIPHER_CT) && !defined(BSSL_CIPHER_SMALL)
+#error "BR_AES_CT and BR_AES_SMALL can not be both disabled"
+#endif
+
 #if defined(USE_LIB_SSL_ENGINE) || defined(USE_EMBED_SSL_ENGINE)
 // Cache for a TLS session with a server
 // Use with BearSSL::WiFiClientSecure::setSession
@@ -322,6 +358,157 @@ namespace bssl
 #endif
         }
 
+        // The bulk cipher implementations of the cipher engine
+        struct br_cipher_engine_impl
+        {
+            const br_block_cbcenc_class *cbcenc;
+            const br_block_cbcdec_class *cbcdec;
+            const br_block_ctr_class *ctr;
+            const br_block_ctrcbc_class *ctrcbc;
+            br_ghash ghash;
+            br_chacha20_run chacha20;
+            br_poly1305_run poly1305;
+        };
+
+        // Get the implementations of the cipher engine, returns the engine in use.
+        // The hardware getters return null when the CPU or the compiler does not support them,
+        // an engine left out of the build falls back to the portable one.
+        static int br_cipher_engine_get(int engine, br_cipher_engine_impl *impl)
+        {
+            memset(impl, 0, sizeof(br_cipher_engine_impl));
+
+            if (engine == esp_ssl_cipher_engine_auto || engine == esp_ssl_cipher_engine_hw)
+            {
+#if defined(BSSL_CIPHER_X86NI)
+                impl->cbcenc = br_aes_x86ni_cbcenc_get_vtable();
+                impl->cbcdec = br_aes_x86ni_cbcdec_get_vtable();
+                impl->ctr = br_aes_x86ni_ctr_get_vtable();
+                impl->ctrcbc = br_aes_x86ni_ctrcbc_get_vtable();
+                impl->ghash = br_ghash_pclmul_get();
+#endif
+#if defined(BSSL_CIPHER_PWR8)
+                if (!impl->ctr)
+                {
+                    impl->cbcenc = br_aes_pwr8_cbcenc_get_vtable();
+                    impl->cbcdec = br_aes_pwr8_cbcdec_get_vtable();
+                    impl->ctr = br_aes_pwr8_ctr_get_vtable();
+                    impl->ctrcbc = br_aes_pwr8_ctrcbc_get_vtable();
+                    impl->ghash = br_ghash_pwr8_get();
+                }
+#endif
+
+                if (impl->cbcenc && impl->cbcdec && impl->ctr && impl->ctrcbc && impl->ghash)
+                    engine = esp_ssl_cipher_engine_hw;
+                else
+                    engine = UINTPTR_MAX > 0xffffffffUL ? esp_ssl_cipher_engine_ct64 : esp_ssl_cipher_engine_ct;
+            }
+
+#if !defined(BSSL_CIPHER_CT64)
+            if (engine == esp_ssl_cipher_engine_ct64)
+                engine = esp_ssl_cipher_engine_ct;
+#endif
+#if !defined(BSSL_CIPHER_CT)
+            if (engine == esp_ssl_cipher_engine_ct)
+                engine = esp_ssl_cipher_engine_small;
+#endif
+#if !defined(BSSL_CIPHER_SMALL)
+            if (engine == esp_ssl_cipher_engine_small)
+                engine = esp_ssl_cipher_engine_ct;
+#endif
+
+            switch (engine)
+            {
+#if defined(BSSL_CIPHER_CT64)
+            case esp_ssl_cipher_engine_ct64:
+                impl->cbcenc = &br_aes_ct64_cbcenc_vtable;
+                impl->cbcdec = &br_aes_ct64_cbcdec_vtable;
+                impl->ctr = &br_aes_ct64_ctr_vtable;
+                impl->ctrcbc = &br_aes_ct64_ctrcbc_vtable;
+                impl->ghash = &br_ghash_ctmul64;
+                break;
+#endif
+#if defined(BSSL_CIPHER_CT)
+            case esp_ssl_cipher_engine_ct:
+                impl->cbcenc = &br_aes_ct_cbcenc_vtable;
+                impl->cbcdec = &br_aes_ct_cbcdec_vtable;
+                impl->ctr = &br_aes_ct_ctr_vtable;
+                impl->ctrcbc = &br_aes_ct_ctrcbc_vtable;
+                impl->ghash = &br_ghash_ctmul;
+                break;
+#endif
+#if defined(BSSL_CIPHER_SMALL)
+            case esp_ssl_cipher_engine_small:
+                impl->cbcenc = &br_aes_small_cbcenc_vtable;
+                impl->cbcdec = &br_aes_small_cbcdec_vtable;
+                impl->ctr = &br_aes_small_ctr_vtable;
+                impl->ctrcbc = &br_aes_small_ctrcbc_vtable;
+                impl->ghash = &br_ghash_ctmul;
+                break;
+#endif
+            default:
+                break;
+            }
+
+            // ChaCha20 and Poly1305 use SSE2 and the 64x64 multiplications when available
+            if (engine == esp_ssl_cipher_engine_hw || engine == esp_ssl_cipher_engine_ct64)
+            {
+#if defined(BSSL_CIPHER_SSE2)
+                impl->chacha20 = br_chacha20_sse2_get();
+#endif
+#if defined(BSSL_CIPHER_CTMULQ)
+                impl->poly1305 = br_poly1305_ctmulq_get();
+#endif
+            }
+            if (!impl->chacha20)
+                impl->chacha20 = &br_chacha20_ct_run;
+            if (!impl->poly1305)
+                impl->poly1305 = &br_poly1305_ctmul_run;
+
+            return engine;
+        }
+
+        // Install the bulk cipher implementations of the cipher engine, returns the engine in use.
+        // Without the AES hardware, ChaCha20-Poly1305 is faster than AES-GCM and stays first in the
+        // default suites, otherwise the ECDHE AES-GCM suites are moved before it.
+        static int br_ssl_engine_set_cipher_engine(br_ssl_engine_context *eng, int engine, bool reorderSuites)
+        {
+            br_cipher_engine_impl impl;
+            engine = br_cipher_engine_get(engine, &impl);
+
+            br_ssl_engine_set_aes_cbc(eng, impl.cbcenc, impl.cbcdec);
+#ifndef BEARSSL_SSL_BASIC
+            br_ssl_engine_set_aes_ctr(eng, impl.ctr);
+            br_ssl_engine_set_ghash(eng, impl.ghash);
+            br_ssl_engine_set_aes_ctrcbc(eng, impl.ctrcbc);
+            br_ssl_engine_set_chacha20(eng, impl.chacha20);
+            br_ssl_engine_set_poly1305(eng, impl.poly1305);
+
+            if (reorderSuites && engine == esp_ssl_cipher_engine_hw)
+            {
+                uint16_t chapol[2];
+                int n = 0, last = -1;
+                for (int i = 0; i < eng->suites_num; i++)
+                {
+                    uint16_t s = eng->suites_buf[i];
+                    if ((s == BR_TLS_ECDHE_ECDSA_WITH_CHACHA20_POLY1305_SHA256 || s == BR_TLS_ECDHE_RSA_WITH_CHACHA20_POLY1305_SHA256) && n < 2)
+                        chapol[n++] = s;
+                    else
+                    {
+                        eng->suites_buf[i - n] = s;
+                        if (s == BR_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256 || s == BR_TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256 ||
+                            s == BR_TLS_ECDHE_ECDSA_WITH_AES_256_GCM_SHA384 || s == BR_TLS_ECDHE_RSA_WITH_AES_256_GCM_SHA384)
+                            last = i - n;
+                    }
+                }
+
+                // insert the ChaCha20-Poly1305 suites after the last ECDHE AES-GCM suite
+                memmove(eng->suites_buf + last + 1 + n, eng->suites_buf + last + 1, (eng->suites_num - n - last - 1) * sizeof(uint16_t));
+                memcpy(eng->suites_buf + last + 1, chapol, n * sizeof(uint16_t));
+            }
+#endif
+            return engine;
+        }
+
         // BearSSL doesn't define a true insecure decoder, so we make one ourselves
         // from the simple parser.  It generates the issuer and subject hashes and
         // the SHA1 fingerprint, only one (or none!) of which will be used to
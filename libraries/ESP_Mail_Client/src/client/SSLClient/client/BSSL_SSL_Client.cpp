@@ -85,7 +85,7 @@ BSSL_SSL_Client::BSSL_SSL_Client(Client *client)
     setClient(client);
     mClear();
     mClearAuthenticationSettings();
-#if defined(ESP_SSL_FS_SUPPORTED)
+#if defined(USE_LIB_SSL_ENGINE)
     _certStore = nullptr; // Don't want to remove cert store on a clear, should be long lived
 #endif
     _sk = nullptr;
@@ -211,6 +211,9 @@ uint8_t BSSL_SSL_Client::connected()
         mPrintClientError(getWriteError(), esp_ssl_debug_error, __func__);
 #endif
     }
+    // the connection polling loop also sends the staged data once the flush delay is over
+    else if (c_con && br_con)
+        mFlushExpired();
 
     return c_con && br_con;
 }
@@ -233,6 +236,10 @@ int BSSL_SSL_Client::available()
     if (!_secure)
         return _basic_client->available();
 
+    // decrypted data is still in the receive window, no need to run the engine
+    if (_recvapp_buf && _recvapp_len)
+        return (int)_recvapp_len;
+
     // connection check
     if (!mSoftConnected(__func__))
         return 0;
@@ -257,15 +264,22 @@ int BSSL_SSL_Client::available()
         esp_ssl_debug_print(PSTR("SSL Engine closed after update."), _debug_level, esp_ssl_debug_info, __func__);
 #endif
     }
-    // flush the buffer if it's stuck in the SENDAPP state
-    else if (state & BR_SSL_SENDAPP)
-        br_ssl_engine_flush(_eng, 0);
+    // send the staged data so the server can respond, unless the writes are corked
+    else if (state & BR_SSL_SENDAPP && !_write_corked)
+        mFlushWrite();
     // other state, or client is closed
     return 0;
 }
 
 int BSSL_SSL_Client::read()
 {
+    if (_secure && _recvapp_buf && _recvapp_len)
+    {
+        uint8_t read_val = _recvapp_buf[0];
+        mRecvAppAck(1);
+        return read_val;
+    }
+
     uint8_t read_val;
     return read(&read_val, 1) > 0 ? read_val : -1;
 };
@@ -278,16 +292,15 @@ int BSSL_SSL_Client::read(uint8_t *buf, size_t size)
     if (!_secure)
         return _basic_client->read(buf, size);
 
-    // check that the engine is ready to read
+    // check that the engine is ready to read, this also sets the receive window
     if (available() <= 0 || !size)
         return -1;
     // read the buffer, send the ack, and return the bytes read
-    _recvapp_buf = br_ssl_engine_recvapp_buf(_eng, &_recvapp_len);
     const size_t read_amount = size > _recvapp_len ? _recvapp_len : size;
     if (buf)
         memcpy(buf, _recvapp_buf, read_amount);
     // tell engine we read that many bytes
-    br_ssl_engine_recvapp_ack(_eng, read_amount);
+    mRecvAppAck(read_amount);
     // tell the user we read that many bytes
     return read_amount;
 }
@@ -315,6 +328,14 @@ size_t BSSL_SSL_Client::write(const uint8_t *buf, size_t size)
     // check if the socket is still open and such
     if (!mSoftConnected(func_name) || !buf || !size)
         return 0;
+    // in coalescing mode, the data that fits the current record is staged without running the engine
+    if (_write_coalescing && _write_idx > 0 && _write_idx + size < _sendapp_len)
+    {
+        memcpy(_sendapp_buf + _write_idx, buf, size);
+        _write_idx += size;
+        mFlushExpired();
+        return size;
+    }
     // wait until bearssl is ready to send
     if (mRunUntil(BR_SSL_SENDAPP) < 0)
     {
@@ -365,6 +386,18 @@ size_t BSSL_SSL_Client::write(const uint8_t *buf, size_t size)
             br_buf = br_ssl_engine_sendapp_buf(_eng, &alen);
         }
     }
+
+    _sendapp_buf = br_buf;
+    _sendapp_len = alen;
+
+    if (!_write_pending)
+    {
+        _write_pending = true;
+        _write_ts = millis();
+    }
+
+    mFlushExpired();
+
     // works oky
     return size;
 }
@@ -536,9 +569,10 @@ void BSSL_SSL_Client::flush()
         return;
     }
 
-    if (_write_idx > 0)
+    // send the staged data without waiting for the server response
+    if (_write_pending)
     {
-        if (mRunUntil(BR_SSL_RECVAPP) < 0)
+        if (mFlushWrite() < 0)
         {
 #if defined(ESP_SSLCLIENT_ENABLE_DEBUG)
             esp_ssl_debug_print(PSTR("Could not flush write buffer!"), _debug_level, esp_ssl_debug_error, __func__);
@@ -554,19 +588,42 @@ void BSSL_SSL_Client::flush()
 
 void BSSL_SSL_Client::setBufferSizes(int recv, int xmit)
 {
-    // Following constants taken from bearssl/src/ssl/ssl_engine.c (not exported unfortunately)
-    const int MAX_OUT_OVERHEAD = 85;
-    const int MAX_IN_OVERHEAD = 325;
-
     // The data buffers must be between 512B and 16KB
     recv = std::max(512, std::min(16384, recv));
     xmit = std::max(512, std::min(16384, xmit));
 
     // Add in overhead for SSL protocol
-    recv += MAX_IN_OVERHEAD;
-    xmit += MAX_OUT_OVERHEAD;
+    recv += BSSL_SSL_CLIENT_MAX_IN_OVERHEAD;
+    xmit += BSSL_SSL_CLIENT_MAX_OUT_OVERHEAD;
     _iobuf_in_size = recv;
     _iobuf_out_size = xmit;
+    _adaptive_frag = 0;
+}
+
+void BSSL_SSL_Client::setAdaptiveBufferSizes(int fragLen, int xmit)
+{
+    // The max fragment length extension supports only 512, 1024, 2048 and 4096 bytes
+    int frag = 512;
+    while (frag < 4096 && frag * 2 <= fragLen)
+        frag *= 2;
+    _adaptive_frag = frag;
+
+    // The outgoing records are not larger than the offered fragment
+    _adaptive_xmit = xmit > 0 ? std::max(512, std::min(frag, xmit)) : 0;
+}
+
+void BSSL_SSL_Client::setWriteCoalescing(bool enable, uint16_t flushDelayMs)
+{
+    _write_coalescing = enable;
+    _write_flush_delay = flushDelayMs;
+}
+
+void BSSL_SSL_Client::cork() { _write_corked = true; }
+
+void BSSL_SSL_Client::uncork()
+{
+    _write_corked = false;
+    mFlushWrite();
 }
 
 int BSSL_SSL_Client::availableForWrite()
@@ -725,6 +782,12 @@ int BSSL_SSL_Client::getMFLNStatus()
     return connected() && br_ssl_engine_get_mfln_negotiated(_eng);
 }
 
+int BSSL_SSL_Client::getInBufferSize() { return _iobuf_in_size; }
+
+int BSSL_SSL_Client::getOutBufferSize() { return _iobuf_out_size; }
+
+int BSSL_SSL_Client::getPeakBufferSize() { return _iobuf_peak; }
+
 // Returns an error ID and possibly a string (if dest != null) of the last
 // BearSSL reported error.
 int BSSL_SSL_Client::getLastSSLError(char *dest, size_t len)
@@ -952,7 +1015,7 @@ int BSSL_SSL_Client::getLastSSLError(char *dest, size_t len)
 }
 
 // Attach a preconfigured certificate store
-#if defined(ESP_SSL_FS_SUPPORTED)
+#if defined(USE_LIB_SSL_ENGINE)
 void BSSL_SSL_Client::setCertStore(CertStoreBase *certStore)
 {
     _certStore = certStore;
@@ -985,6 +1048,64 @@ bool BSSL_SSL_Client::setCiphersLessSecure()
     return setCiphers(faster_suites_P, sizeof(faster_suites_P) / sizeof(faster_suites_P[0]));
 }
 
+void BSSL_SSL_Client::setCipherEngine(esp_ssl_cipher_engine engine) { _cipher_engine = engine; }
+
+uint32_t BSSL_SSL_Client::benchmarkCipher(esp_ssl_cipher_engine engine, esp_ssl_bulk_cipher cipher, uint32_t durationMs)
+{
+    bssl::br_cipher_engine_impl impl;
+
+    // The hardware engine is not available
+    if (bssl::br_cipher_engine_get(engine, &impl) != engine && engine != esp_ssl_cipher_engine_auto)
+        return 0;
+
+    // One record of the max fragment length
+    const size_t len = 1024;
+    uint8_t *buf = reinterpret_cast<uint8_t *>(mallocImpl(len));
+    if (!buf)
+        return 0;
+
+    uint8_t key[32], iv[16], tag[16], h[16], y[16];
+    memset(key, 0x5a, sizeof(key));
+    memset(iv, 0xa5, sizeof(iv));
+    memset(h, 0x3c, sizeof(h));
+    memset(y, 0, sizeof(y));
+
+    br_aes_gen_ctr_keys ctr;
+    br_aes_gen_cbcenc_keys cbc;
+    if (cipher == esp_ssl_bulk_cipher_aes128_gcm)
+        impl.ctr->init(&ctr.vtable, key, 16);
+    else if (cipher == esp_ssl_bulk_cipher_aes128_cbc)
+        impl.cbcenc->init(&cbc.vtable, key, 16);
+
+    uint64_t bytes = 0;
+    unsigned long ms = millis(), elapsed = 0;
+    do
+    {
+        switch (cipher)
+        {
+        case esp_ssl_bulk_cipher_aes128_gcm:
+            ctr.vtable->run(&ctr.vtable, iv, 2, buf, len);
+            impl.ghash(y, h, buf, len);
+            break;
+        case esp_ssl_bulk_cipher_aes128_cbc:
+            cbc.vtable->run(&cbc.vtable, iv, buf, len);
+            break;
+        case esp_ssl_bulk_cipher_chacha20_poly1305:
+            impl.poly1305(key, iv, buf, len, iv, 13, tag, impl.chacha20, 1);
+            break;
+        default:
+            break;
+        }
+        bytes += len;
+        elapsed = millis() - ms;
+    } while (elapsed < durationMs);
+
+    freeImpl(&buf);
+
+    // KB/s
+    return elapsed ? (uint32_t)(bytes * 1000 / 1024 / elapsed) : 0;
+}
+
 bool BSSL_SSL_Client::setSSLVersion(uint32_t min, uint32_t max)
 {
     if (((min != BR_TLS10) && (min != BR_TLS11) && (min != BR_TLS12)) ||
@@ -1022,31 +1143,52 @@ bool BSSL_SSL_Client::probeMaxFragmentLength(const String &host, uint16_t port,
     return BSSL_SSL_Client::probeMaxFragmentLength(host.c_str(), port, len);
 }
 
+// the decrypted data can only be peeked in secure mode
 size_t BSSL_SSL_Client::peekAvailable()
 {
-    return available();
+    if (!_secure || available() <= 0)
+        return 0;
+    return _recvapp_len;
 }
 
 // return a pointer to available data buffer (size = peekAvailable())
 // semantic forbids any kind of read() before calling peekConsume()
 const char *BSSL_SSL_Client::peekBuffer()
 {
-    return (const char *)_recvapp_buf;
+    size_t len = 0;
+    return peekBuffer(len);
+}
+
+// return a pointer to the decrypted data in the receive window and its length,
+// the data stays valid until peekConsume() or read()
+const char *BSSL_SSL_Client::peekBuffer(size_t &len)
+{
+    len = peekAvailable();
+    return len ? (const char *)_recvapp_buf : nullptr;
 }
 
 // consume bytes after use (see peekBuffer)
 void BSSL_SSL_Client::peekConsume(size_t consume)
 {
-    // according to BSSL_SSL_Client::read:
-    br_ssl_engine_recvapp_ack(_eng, consume);
-    _recvapp_buf = nullptr;
-    _recvapp_len = 0;
+    if (!_secure || !_recvapp_buf)
+        return;
+    mRecvAppAck(consume > _recvapp_len ? _recvapp_len : consume);
 }
 
 void BSSL_SSL_Client::setCACert(const char *rootCA)
 {
     if (_esp32_ta)
         delete _esp32_ta;
+    _esp32_ta = nullptr;
+#if defined(USE_LIB_SSL_ENGINE)
+    // The pre-decoded trust anchors blob is used in place
+    _esp32_ta_blob.clear();
+    if (TrustAnchorBlob::isBlob(rootCA))
+    {
+        _esp32_ta_blob.load(reinterpret_cast<const uint8_t *>(rootCA));
+        return;
+    }
+#endif
     _esp32_ta = new X509List(rootCA);
 }
 
@@ -1068,7 +1210,12 @@ bool BSSL_SSL_Client::loadCACert(Stream &stream, size_t size)
 {
     bool ret = false;
     auto buff = reinterpret_cast<char *>(mallocImpl(size));
+#if defined(USE_LIB_SSL_ENGINE)
+    // The trust anchors blob must outlive the connection, it cannot be loaded from this temporary buffer
+    if (size == stream.readBytes(buff, size) && !TrustAnchorBlob::isBlob(buff))
+#else
     if (size == stream.readBytes(buff, size))
+#endif
     {
         setCACert(buff);
         ret = true;
@@ -1140,6 +1287,9 @@ void BSSL_SSL_Client::setSecure(const char *rootCABuff, const char *cli_cert, co
         delete _esp32_ta;
         _esp32_ta = nullptr;
     }
+#if defined(USE_LIB_SSL_ENGINE)
+    _esp32_ta_blob.clear();
+#endif
     if (_esp32_chain)
     {
         delete _esp32_chain;
@@ -1480,8 +1630,8 @@ int BSSL_SSL_Client::mConnectSSL(const char *host)
 
 #if defined(ESP_SSLCLIENT_ENABLE_DEBUG)
     // BearSSL will reject all connections unless an authentication option is set, warn in DEBUG builds
-#if defined(ESP_SSL_FS_SUPPORTED)
-#define CRTSTORECOND &&!_certStore
+#if defined(USE_LIB_SSL_ENGINE)
+#define CRTSTORECOND &&!_certStore && !_esp32_ta_blob.getCount()
 #else
 #define CRTSTORECOND
 #endif
@@ -1494,10 +1644,21 @@ int BSSL_SSL_Client::mConnectSSL(const char *host)
     _sc = std::make_shared<br_ssl_client_context>();
     _eng = &_sc->eng; // Allocation/deallocation taken care of by the _sc shared_ptr
 
+    // In adaptive mode, the input buffer fits the offered fragment and grows only
+    // when the server did not accept it and sends the larger record.
+    if (_adaptive_frag)
+    {
+        _iobuf_in_size = _adaptive_frag + BSSL_SSL_CLIENT_MAX_IN_OVERHEAD;
+        _iobuf_out_size = _adaptive_xmit ? _adaptive_xmit + BSSL_SSL_CLIENT_MAX_OUT_OVERHEAD : 0;
+    }
+
     _iobuf_in = reinterpret_cast<unsigned char *>(mallocImpl(_iobuf_in_size));
-    _iobuf_out = reinterpret_cast<unsigned char *>(mallocImpl(_iobuf_out_size));
+    // no output buffer for the shared in/out buffer
+    if (_iobuf_out_size)
+        _iobuf_out = reinterpret_cast<unsigned char *>(mallocImpl(_iobuf_out_size));
+    _iobuf_peak = _iobuf_in_size + _iobuf_out_size;
 
-    if (!_sc || !_iobuf_in || !_iobuf_out)
+    if (!_sc || !_iobuf_in || (_iobuf_out_size && !_iobuf_out))
     {
         mFreeSSL(); // Frees _sc, _iobuf*
         _oom_err = true;
@@ -1513,6 +1674,17 @@ int BSSL_SSL_Client::mConnectSSL(const char *host)
     else
         bssl::br_ssl_client_base_init(_sc.get(), _cipher_list, _cipher_cnt);
 
+    // Install the fastest bulk ciphers for this CPU, and order the default suites for them
+    int engine = bssl::br_ssl_engine_set_cipher_engine(_eng, _cipher_engine, !_cipher_list);
+#if defined(ESP_SSLCLIENT_ENABLE_DEBUG)
+    static const char *engines[] = {"auto", "hw", "ct64", "ct", "small"};
+    String e = PSTR("Cipher engine: ");
+    e += engines[engine];
+    esp_ssl_debug_print(e.c_str(), _debug_level, esp_ssl_debug_info, __func__);
+#else
+    (void)engine;
+#endif
+
     // Only failure possible in the installation is OOM
     if (!mInstallClientX509Validator())
     {
@@ -1524,7 +1696,16 @@ int BSSL_SSL_Client::mConnectSSL(const char *host)
         return 0;
     }
 
-    br_ssl_engine_set_buffers_bidi(_eng, _iobuf_in, _iobuf_in_size, _iobuf_out, _iobuf_out_size);
+    if (_iobuf_out)
+        br_ssl_engine_set_buffers_bidi(_eng, _iobuf_in, _iobuf_in_size, _iobuf_out, _iobuf_out_size);
+    else
+        br_ssl_engine_set_buffer(_eng, _iobuf_in, _iobuf_in_size, 0);
+
+    // BearSSL offers the fragment length that fits both buffers, the adaptive fragment
+    // is offered even when the output buffer is smaller as the outgoing records still fit it.
+    if (_adaptive_frag)
+        br_ssl_engine_set_max_frag_len(_eng, _adaptive_frag);
+
     br_ssl_engine_set_versions(_eng, _tls_min, _tls_max);
 
     // Apply any client certificates, if supplied.
@@ -1602,6 +1783,16 @@ int BSSL_SSL_Client::mConnectSSL(const char *host)
 
 #if defined(ESP_SSLCLIENT_ENABLE_DEBUG)
     esp_ssl_debug_print(PSTR("Connection successful!"), _debug_level, esp_ssl_debug_info, __func__);
+    String s = PSTR("IO buffers in: ");
+    s += _iobuf_in_size;
+    s += PSTR(", out: ");
+    if (_iobuf_out_size)
+        s += _iobuf_out_size;
+    else
+        s += PSTR("shared");
+    s += PSTR(", max fragment: ");
+    s += _eng->max_frag_len;
+    esp_ssl_debug_print(s.c_str(), _debug_level, esp_ssl_debug_info, __func__);
 #endif
     _handshake_done = true;
     _is_connected = true;
@@ -1927,6 +2118,9 @@ unsigned BSSL_SSL_Client::mUpdateEngine()
                 }
                 if (rlen > 0)
                 {
+                    // the record header is complete, make room for the encrypted record that does not fit
+                    if (_adaptive_frag && _eng->incrypt && buf - _iobuf_in + rlen == 5)
+                        mGrowInBuffer();
                     br_ssl_engine_recvrec_ack(_eng, rlen);
                 }
                 continue;
@@ -2057,6 +2251,9 @@ void BSSL_SSL_Client::mClearAuthenticationSettings()
         delete _esp32_ta;
         _esp32_ta = nullptr;
     }
+#if defined(USE_LIB_SSL_ENGINE)
+    _esp32_ta_blob.clear();
+#endif
 }
 
 void BSSL_SSL_Client::mClear()
@@ -2087,6 +2284,9 @@ void BSSL_SSL_Client::mClear()
         delete _esp32_ta;
         _esp32_ta = nullptr;
     }
+#if defined(USE_LIB_SSL_ENGINE)
+    _esp32_ta_blob.clear();
+#endif
 }
 
 // X.509 validators differ from server to client
@@ -2170,8 +2370,12 @@ bool BSSL_SSL_Client::mInstallClientX509Validator()
             // Magic constants convert to x509 times
             br_x509_minimal_set_time(_x509_minimal.get(), ((uint32_t)_now) / 86400 + 719528, ((uint32_t)_now) % 86400);
         }
-#if defined(ESP_SSL_FS_SUPPORTED)
-        if (_certStore)
+#if defined(USE_LIB_SSL_ENGINE)
+        if (_esp32_ta_blob.getCount())
+        {
+            _esp32_ta_blob.installCertStore(_x509_minimal.get());
+        }
+        else if (_certStore)
         {
             _certStore->installCertStore(_x509_minimal.get());
         }
@@ -2181,6 +2385,14 @@ bool BSSL_SSL_Client::mInstallClientX509Validator()
     return true;
 }
 
+void BSSL_SSL_Client::mRecvAppAck(size_t len)
+{
+    // the engine moves the start of the window by the acknowledged bytes
+    br_ssl_engine_recvapp_ack(_eng, len);
+    _recvapp_len -= len;
+    _recvapp_buf = _recvapp_len ? _recvapp_buf + len : nullptr;
+}
+
 void BSSL_SSL_Client::mFreeSSL()
 {
     // These are smart pointers and will free if refcnt==0
@@ -2193,6 +2405,10 @@ void BSSL_SSL_Client::mFreeSSL()
     // Reset non-allocated ptrs (pointing to bits potentially free'd above)
     _recvapp_buf = nullptr;
     _recvapp_len = 0;
+    _sendapp_buf = nullptr;
+    _sendapp_len = 0;
+    _write_idx = 0;
+    _write_pending = false;
     // This connection is toast
     _handshake_done = false;
     _timeout_ms = 15000;
@@ -2200,6 +2416,72 @@ void BSSL_SSL_Client::mFreeSSL()
     _is_connected = false;
 }
 
+int BSSL_SSL_Client::mFlushWrite()
+{
+    if (!_write_pending || !_secure || !_eng)
+        return 0;
+
+    _write_pending = false;
+
+    // hand the staged data to the engine, close the record and send it
+    if (mRunUntil(BR_SSL_SENDAPP) < 0)
+        return -1;
+
+    br_ssl_engine_flush(_eng, 0);
+
+    return mRunUntil(BR_SSL_SENDAPP);
+}
+
+void BSSL_SSL_Client::mFlushExpired()
+{
+    if (_write_pending && _write_coalescing && !_write_corked && _write_flush_delay > 0 && millis() - _write_ts >= _write_flush_delay)
+        mFlushWrite();
+}
+
+bool BSSL_SSL_Client::mGrowInBuffer()
+{
+    // the record header is at the start of the input buffer
+    const size_t recLen = (_iobuf_in[3] << 8) | _iobuf_in[4];
+    if (recLen + 5 <= (size_t)_iobuf_in_size)
+        return true;
+
+    // The server did not accept the offered fragment length, grow to the full record size.
+    // BearSSL rejects the record if it is still too large.
+    const int size = 16384 + BSSL_SSL_CLIENT_MAX_IN_OVERHEAD;
+    unsigned char *buf = reinterpret_cast<unsigned char *>(mallocImpl(size, false));
+    if (!buf)
+    {
+#if defined(ESP_SSLCLIENT_ENABLE_DEBUG)
+        esp_ssl_debug_print(PSTR("OOM error, can't grow the receive buffer."), _debug_level, esp_ssl_debug_error, __func__);
+#endif
+        return false;
+    }
+
+    // the shared in/out buffer moves with it
+    if (!br_ssl_engine_grow_ibuf(_eng, buf, size))
+    {
+        freeImpl(&buf);
+        return false;
+    }
+
+    // both receive buffers are allocated during the copy
+    _iobuf_peak = std::max(_iobuf_peak, _iobuf_in_size + size + _iobuf_out_size);
+
+    freeImpl(&_iobuf_in);
+    _iobuf_in = buf;
+    _iobuf_in_size = size;
+
+#if defined(ESP_SSLCLIENT_ENABLE_DEBUG)
+    String s = PSTR("Receive buffer grown to ");
+    s += size;
+    s += PSTR(" for the record of ");
+    s += recLen;
+    s += PSTR(" bytes.");
+    esp_ssl_debug_print(s.c_str(), _debug_level, esp_ssl_debug_info, __func__);
+#endif
+    return true;
+}
+
 uint8_t *BSSL_SSL_Client::mStreamLoad(Stream &stream, size_t size)
 {
     uint8_t *dest = reinterpret_cast<uint8_t *>(malloc(size + 1));
@@ -60,6 +60,12 @@
 
 #define BSSL_SSL_CLIENT_MIN_SESSION_TIMEOUT_SEC 60
 
+#define BSSL_SSL_CLIENT_WRITE_FLUSH_DELAY_MS 5
+
+// Following constants taken from bearssl/src/ssl/ssl_engine.c (not exported unfortunately)
+#define BSSL_SSL_CLIENT_MAX_OUT_OVERHEAD 85
+#define BSSL_SSL_CLIENT_MAX_IN_OVERHEAD 325
+
 #if defined(USE_LIB_SSL_ENGINE) || defined(USE_EMBED_SSL_ENGINE)
 
 #include <vector>
@@ -166,6 +172,14 @@ public:
 
     void setBufferSizes(int recv, int xmit);
 
+    void setAdaptiveBufferSizes(int fragLen, int xmit);
+
+    void setWriteCoalescing(bool enable, uint16_t flushDelayMs = BSSL_SSL_CLIENT_WRITE_FLUSH_DELAY_MS);
+
+    void cork();
+
+    void uncork();
+
     operator bool() override { return connected() > 0; }
 
     int availableForWrite() override;
@@ -190,8 +204,14 @@ public:
 
     int getMFLNStatus();
 
+    int getInBufferSize();
+
+    int getOutBufferSize();
+
+    int getPeakBufferSize();
+
     int getLastSSLError(char *dest, size_t len);
-#if defined(ESP_SSL_FS_SUPPORTED)
+#if defined(USE_LIB_SSL_ENGINE)
     void setCertStore(CertStoreBase *certStore);
 #endif
     bool setCiphers(const uint16_t *cipherAry, int cipherCount);
@@ -200,6 +220,10 @@ public:
 
     bool setCiphersLessSecure();
 
+    void setCipherEngine(esp_ssl_cipher_engine engine);
+
+    uint32_t benchmarkCipher(esp_ssl_cipher_engine engine, esp_ssl_bulk_cipher cipher, uint32_t durationMs = 200);
+
     bool setSSLVersion(uint32_t min, uint32_t max);
 
     bool probeMaxFragmentLength(IPAddress ip, uint16_t port, uint16_t len);
@@ -212,6 +236,8 @@ public:
 
     const char *peekBuffer() EMBED_SSL_ENGINE_BASE_OVERRIDE;
 
+    const char *peekBuffer(size_t &len);
+
     void peekConsume(size_t consume) EMBED_SSL_ENGINE_BASE_OVERRIDE;
 
     void setCACert(const char *rootCA);
@@ -292,6 +318,14 @@ private:
 
     void mFreeSSL();
 
+    void mRecvAppAck(size_t len);
+
+    int mFlushWrite();
+
+    void mFlushExpired();
+
+    bool mGrowInBuffer();
+
     uint8_t *mStreamLoad(Stream &stream, size_t size);
 
     void *mallocImpl(size_t len, bool clear = true);
@@ -310,6 +344,19 @@ private:
     //  weird timing issues
     size_t _write_idx = 0;
 
+    // the current sendapp window, valid while _write_idx > 0
+    unsigned char *_sendapp_buf = nullptr;
+    size_t _sendapp_len = 0;
+
+    // the staged data that is not sent yet is flushed when the record is full,
+    // on flush(), on read, or in coalescing mode once it is _write_flush_delay ms old
+    // at the next write() or connected() call, there is no timer
+    bool _write_pending = false;
+    bool _write_coalescing = false;
+    bool _write_corked = false;
+    uint16_t _write_flush_delay = BSSL_SSL_CLIENT_WRITE_FLUSH_DELAY_MS;
+    unsigned long _write_ts = 0;
+
     // store the last BearSSL state so we can print changes to the console
     unsigned int _bssl_last_state = 0;
 
@@ -327,10 +374,17 @@ private:
     unsigned char *_iobuf_out = nullptr;
     int _iobuf_in_size = 512;
     int _iobuf_out_size = 512;
+    // the largest total of the I/O buffers allocated at once since the connection
+    int _iobuf_peak = 0;
+
+    // the max fragment length to offer in adaptive buffer sizing, or 0 for the fixed sizes
+    int _adaptive_frag = 0;
+    // the adaptive output buffer size, or 0 for the shared in/out buffer
+    int _adaptive_xmit = 0;
 
     time_t _now = 0;
     const X509List *_ta = nullptr;
-#if defined(ESP_SSL_FS_SUPPORTED)
+#if defined(USE_LIB_SSL_ENGINE)
     CertStoreBase *_certStore = 0;
 #endif
     // Optional client certificate
@@ -354,11 +408,18 @@ private:
     uint16_t *_cipher_list = nullptr;
     uint8_t _cipher_cnt = 0;
 
+    // The bulk cipher implementations to install at handshake init
+    esp_ssl_cipher_engine _cipher_engine = esp_ssl_cipher_engine_auto;
+
     // TLS ciphers allowed
     uint32_t _tls_min = BR_TLS10;
     uint32_t _tls_max = BR_TLS12;
 
     X509List *_esp32_ta = nullptr;
+#if defined(USE_LIB_SSL_ENGINE)
+    // The trust anchors blob set by setCACert, referenced in place
+    TrustAnchorBlob _esp32_ta_blob;
+#endif
     X509List *_esp32_chain = nullptr;
     PrivateKey *_esp32_sk = nullptr;
 
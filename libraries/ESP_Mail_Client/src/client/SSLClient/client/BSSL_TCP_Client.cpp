@@ -148,19 +148,18 @@ int BSSL_TCP_Client::available()
     return _ssl_client.available();
 }
 
+// the decrypted data left in the receive window is read without checking the connection
 int BSSL_TCP_Client::read()
 {
-    uint8_t data = -1;
-    int res = read(&data, 1);
-    if (res < 0)
-        return res;
-    return data;
+    if (_ssl_client.available() <= 0)
+        return -1;
+    return _ssl_client.read();
 }
 
 int BSSL_TCP_Client::read(uint8_t *buf, size_t size)
 {
-    if (!_ssl_client.connected())
-        return 0;
+    if (_ssl_client.available() <= 0)
+        return _ssl_client.connected() ? -1 : 0;
     return _ssl_client.read(buf, size);
 }
 
@@ -301,6 +300,20 @@ void BSSL_TCP_Client::setBufferSizes(int recv, int xmit)
     _ssl_client.setBufferSizes(recv, xmit);
 }
 
+void BSSL_TCP_Client::setAdaptiveBufferSizes(int fragLen, int xmit)
+{
+    _ssl_client.setAdaptiveBufferSizes(fragLen, xmit);
+}
+
+void BSSL_TCP_Client::setWriteCoalescing(bool enable, uint16_t flushDelayMs)
+{
+    _ssl_client.setWriteCoalescing(enable, flushDelayMs);
+}
+
+void BSSL_TCP_Client::cork() { _ssl_client.cork(); }
+
+void BSSL_TCP_Client::uncork() { _ssl_client.uncork(); }
+
 int BSSL_TCP_Client::availableForWrite() { return _ssl_client.availableForWrite(); };
 
 void BSSL_TCP_Client::setSession(BearSSL_Session *session) { _ssl_client.setSession(session); };
@@ -347,12 +360,18 @@ void BSSL_TCP_Client::setClientECCert(const X509List *cert, const PrivateKey *sk
 
 int BSSL_TCP_Client::getMFLNStatus() { return _ssl_client.getMFLNStatus(); };
 
+int BSSL_TCP_Client::getInBufferSize() { return _ssl_client.getInBufferSize(); }
+
+int BSSL_TCP_Client::getOutBufferSize() { return _ssl_client.getOutBufferSize(); }
+
+int BSSL_TCP_Client::getPeakBufferSize() { return _ssl_client.getPeakBufferSize(); }
+
 int BSSL_TCP_Client::getLastSSLError(char *dest, size_t len)
 {
     return _ssl_client.getLastSSLError(dest, len);
 }
 
-#if defined(ESP_SSL_FS_SUPPORTED)
+#if defined(USE_LIB_SSL_ENGINE)
 void BSSL_TCP_Client::setCertStore(CertStoreBase *certStore)
 {
     _ssl_client.setCertStore(certStore);
@@ -374,6 +393,13 @@ bool BSSL_TCP_Client::setCiphersLessSecure()
     return _ssl_client.setCiphersLessSecure();
 }
 
+void BSSL_TCP_Client::setCipherEngine(esp_ssl_cipher_engine engine) { _ssl_client.setCipherEngine(engine); }
+
+uint32_t BSSL_TCP_Client::benchmarkCipher(esp_ssl_cipher_engine engine, esp_ssl_bulk_cipher cipher, uint32_t durationMs)
+{
+    return _ssl_client.benchmarkCipher(engine, cipher, durationMs);
+}
+
 bool BSSL_TCP_Client::setSSLVersion(uint32_t min, uint32_t max)
 {
     return _ssl_client.setSSLVersion(min, max);
@@ -395,6 +421,9 @@ size_t BSSL_TCP_Client::peekAvailable() { return _ssl_client.peekAvailable(); }
 // semantic forbids any kind of read() before calling peekConsume()
 const char *BSSL_TCP_Client::peekBuffer() { return _ssl_client.peekBuffer(); }
 
+// return a pointer to available data buffer and its length
+const char *BSSL_TCP_Client::peekBuffer(size_t &len) { return _ssl_client.peekBuffer(len); }
+
 // consume bytes after use (see peekBuffer)
 void BSSL_TCP_Client::peekConsume(size_t consume) { return _ssl_client.peekConsume(consume); }
 
@@ -342,6 +342,41 @@ public:
      */
     void setBufferSizes(int recv, int xmit);
 
+    /**
+     * Set the adaptive buffer sizes.
+     *
+     * The max fragment length is offered in the handshake and the receive buffer is sized to it.
+     * The receive buffer grows to the full record size only when the server sends the larger record.
+     *
+     * @param fragLen The max fragment length to offer, 512, 1024, 2048 or 4096.
+     * @param xmit The transmit buffer size, 0 to share the receive buffer for the half-duplex protocol.
+     */
+    void setAdaptiveBufferSizes(int fragLen, int xmit);
+
+    /**
+     * Set the write coalescing mode.
+     *
+     * The small writes are staged into the current TLS record which is sent when it is full,
+     * on read, or when the oldest staged data is older than the flush delay. There is no timer,
+     * the delay is checked on the next write() or connected() call, so the data written last
+     * waits for the next I/O or poll, call flush() to send it at once.
+     *
+     * @param enable The option to enable the write coalescing.
+     * @param flushDelayMs The maximum time in ms that the staged data waits, 0 for no timer.
+     */
+    void setWriteCoalescing(bool enable, uint16_t flushDelayMs = BSSL_SSL_CLIENT_WRITE_FLUSH_DELAY_MS);
+
+    /**
+     * Hold the written data until uncork() is called, only the full records are sent.
+     * With the shared buffer, nothing is received while corked.
+     */
+    void cork();
+
+    /**
+     * Release the corked data and send it.
+     */
+    void uncork();
+
     operator bool() override { return connected(); }
 
     int availableForWrite() override;
@@ -372,8 +407,30 @@ public:
 
     int getMFLNStatus();
 
+    /**
+     * Get the receive buffer size in use, including the record overhead.
+     *
+     * @return The receive buffer size in bytes, after any growth for the records larger than the offered fragment.
+     */
+    int getInBufferSize();
+
+    /**
+     * Get the transmit buffer size in use, including the record overhead.
+     *
+     * @return The transmit buffer size in bytes, 0 for the buffer shared with the receive buffer.
+     */
+    int getOutBufferSize();
+
+    /**
+     * Get the peak I/O buffer allocation of the connection.
+     *
+     * @return The largest total in bytes of the I/O buffers allocated at once, including the
+     * old and new receive buffers while the receive buffer grows.
+     */
+    int getPeakBufferSize();
+
     int getLastSSLError(char *dest = NULL, size_t len = 0);
-#if defined(ESP_SSL_FS_SUPPORTED)
+#if defined(USE_LIB_SSL_ENGINE)
     void setCertStore(CertStoreBase *certStore);
 #endif
     bool setCiphers(const uint16_t *cipherAry, int cipherCount);
@@ -382,6 +439,27 @@ public:
 
     bool setCiphersLessSecure();
 
+    /**
+     * Set the bulk cipher implementations to use.
+     *
+     * The auto engine uses the AES hardware (AES-NI/PCLMUL or POWER8) when the CPU supports it,
+     * otherwise the constant-time ct64 on 64-bit and ct on 32-bit CPUs. With the default cipher
+     * suites, ChaCha20-Poly1305 is preferred unless the AES hardware is used.
+     *
+     * @param engine The esp_ssl_cipher_engine, the hardware engine falls back to auto when not available.
+     */
+    void setCipherEngine(esp_ssl_cipher_engine engine);
+
+    /**
+     * Measure the bulk cipher throughput of the cipher engine on 1 KB records.
+     *
+     * @param engine The esp_ssl_cipher_engine.
+     * @param cipher The esp_ssl_bulk_cipher.
+     * @param durationMs The duration to measure.
+     * @return The throughput in KB/s or 0 if the engine is not available.
+     */
+    uint32_t benchmarkCipher(esp_ssl_cipher_engine engine, esp_ssl_bulk_cipher cipher, uint32_t durationMs = 200);
+
     bool setSSLVersion(uint32_t min = BR_TLS10, uint32_t max = BR_TLS12);
 
     bool probeMaxFragmentLength(IPAddress ip, uint16_t port, uint16_t len);
@@ -396,11 +474,14 @@ public:
 
     const char *peekBuffer() EMBED_SSL_ENGINE_BASE_OVERRIDE;
 
+    const char *peekBuffer(size_t &len);
+
     void peekConsume(size_t consume) EMBED_SSL_ENGINE_BASE_OVERRIDE;
 
     /**
      * Set the Root CA or CA certificate.
-     * @param rootCA The Root CA or CA certificate.
+     * @param rootCA The Root CA or CA certificate in PEM format, or the trust anchors blob
+     * created by tools/ta_blob.py which is used in place and must stay valid while connecting.
      */
     void setCACert(const char *rootCA);
 
@@ -0,0 +1,324 @@
+#ifndef MB_BASE64_H
+#define MB_BASE64_H
+
+/*
+ * Base64 codec v1.0.0
+ *
+ * Created October 17, 2026
+ *
+ * The table-driven base64 encoder and decoder with streaming state.
+ * The data can be fed in any chunk size and the encoder can emit
+ * the 76-column CRLF wrapped lines (RFC 2045) directly.
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <Arduino.h>
+
+// The number of characters per line of wrapped output (RFC 2045)
+#define MB_BASE64_LINE_LEN 76
+
+// The number of raw bytes per line of wrapped output
+#define MB_BASE64_LINE_RAW_LEN 57
+
+#define MB_BASE64_PAD 0x40
+#define MB_BASE64_INVALID 0x80
+
+static const uint8_t mb_b64_enc_table[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// The 6-bit values of the alphabet, MB_BASE64_PAD for '=' and MB_BASE64_INVALID for the others
+static const uint8_t mb_b64_dec_table[256] = {
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 62, 0x80, 0x80, 0x80, 63,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 0x80, 0x80, 0x80, 0x40, 0x80, 0x80,
+    0x80, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80};
+
+struct mb_b64_enc_state
+{
+    // The bytes of incomplete 3-byte group from the previous input
+    uint8_t carry[3];
+    uint8_t carryLen = 0;
+    // The current output column, used when wrap is set
+    uint8_t col = 0;
+    // Insert CRLF after every MB_BASE64_LINE_LEN characters
+    bool wrap = false;
+};
+
+struct mb_b64_dec_state
+{
+    // The 6-bit values of incomplete 4-char group
+    uint32_t acc = 0;
+    uint8_t count = 0;
+    uint8_t pad = 0;
+    // The padded group was decoded, the rest of input is ignored
+    bool done = false;
+    // Too many padding characters or the single character group
+    bool error = false;
+};
+
+// The maximum encoded length of len bytes input including the CRLFs when wrap
+static inline size_t mb_b64_enc_len(size_t len, bool wrap)
+{
+    size_t olen = (len + 2) / 3 * 4;
+    if (wrap)
+        olen += (olen / MB_BASE64_LINE_LEN + 1) * 2;
+    return olen;
+}
+
+// The maximum decoded length of len characters input
+static inline size_t mb_b64_dec_len(size_t len)
+{
+    return (len + 3) / 4 * 3;
+}
+
+// Encode the 3-byte group as the 32-bit word and write 4 characters
+static inline uint8_t *mb_b64_enc_group(const uint8_t *in, uint8_t *out)
+{
+    uint32_t v = ((uint32_t)in[0] << 16) | ((uint32_t)in[1] << 8) | in[2];
+    out[0] = mb_b64_enc_table[v >> 18];
+    out[1] = mb_b64_enc_table[(v >> 12) & 0x3f];
+    out[2] = mb_b64_enc_table[(v >> 6) & 0x3f];
+    out[3] = mb_b64_enc_table[v & 0x3f];
+    return out + 4;
+}
+
+static inline uint8_t *mb_b64_enc_put(mb_b64_enc_state &st, const uint8_t *in, uint8_t *out)
+{
+    out = mb_b64_enc_group(in, out);
+    if (st.wrap)
+    {
+        st.col += 4;
+        if (st.col >= MB_BASE64_LINE_LEN)
+        {
+            *out++ = '\r';
+            *out++ = '\n';
+            st.col = 0;
+        }
+    }
+    return out;
+}
+
+/** Encode the chunk of data.
+ *
+ * @param st The encoder state.
+ * @param in The input data.
+ * @param len The input length.
+ * @param out The output buffer of at least mb_b64_enc_len(len + 2, st.wrap) bytes.
+ * @return The number of characters written.
+ * The incomplete group is kept in state until the next call or mb_b64_enc_final.
+ */
+static inline size_t mb_b64_enc_update(mb_b64_enc_state &st, const uint8_t *in, size_t len, uint8_t *out)
+{
+    uint8_t *p = out;
+
+    if (st.carryLen > 0)
+    {
+        while (st.carryLen < 3 && len > 0)
+        {
+            st.carry[st.carryLen++] = *in++;
+            len--;
+        }
+
+        if (st.carryLen < 3)
+            return 0;
+
+        p = mb_b64_enc_put(st, st.carry, p);
+        st.carryLen = 0;
+    }
+
+    // The whole lines
+    if (st.wrap)
+    {
+        while (st.col == 0 && len >= MB_BASE64_LINE_RAW_LEN)
+        {
+            for (int i = 0; i < MB_BASE64_LINE_RAW_LEN; i += 3)
+                p = mb_b64_enc_group(in + i, p);
+            *p++ = '\r';
+            *p++ = '\n';
+            in += MB_BASE64_LINE_RAW_LEN;
+            len -= MB_BASE64_LINE_RAW_LEN;
+        }
+    }
+
+    while (len >= 3)
+    {
+        p = mb_b64_enc_put(st, in, p);
+        in += 3;
+        len -= 3;
+    }
+
+    while (len > 0)
+    {
+        st.carry[st.carryLen++] = *in++;
+        len--;
+    }
+
+    return p - out;
+}
+
+/** Encode the remaining incomplete group with padding.
+ *
+ * @param st The encoder state.
+ * @param out The output buffer of at least 4 bytes.
+ * @return The number of characters written.
+ * No CRLF is added after the last incomplete line.
+ */
+static inline size_t mb_b64_enc_final(mb_b64_enc_state &st, uint8_t *out)
+{
+    if (st.carryLen == 0)
+        return 0;
+
+    uint8_t b[3] = {st.carry[0], (uint8_t)(st.carryLen > 1 ? st.carry[1] : 0), 0};
+    mb_b64_enc_group(b, out);
+    out[3] = '=';
+    if (st.carryLen == 1)
+        out[2] = '=';
+
+    st.col += 4;
+    st.carryLen = 0;
+    return 4;
+}
+
+// Encode the data to buffer without line breaks and returns the encoded length
+static inline size_t mb_b64_enc(const uint8_t *in, size_t len, uint8_t *out)
+{
+    mb_b64_enc_state st;
+    size_t olen = mb_b64_enc_update(st, in, len, out);
+    return olen + mb_b64_enc_final(st, out + olen);
+}
+
+static inline uint8_t *mb_b64_dec_group(mb_b64_dec_state &st, uint8_t *out)
+{
+    uint32_t v = st.acc;
+    st.acc = 0;
+    st.count = 0;
+
+    if (st.pad > 2)
+    {
+        st.error = true;
+        st.done = true;
+        return out;
+    }
+
+    *out++ = v >> 16;
+    if (st.pad < 2)
+        *out++ = (v >> 8) & 0xff;
+    if (st.pad < 1)
+        *out++ = v & 0xff;
+
+    st.done = st.pad > 0;
+    return out;
+}
+
+/** Decode the chunk of base64 data.
+ *
+ * @param st The decoder state.
+ * @param in The input data.
+ * @param len The input length.
+ * @param out The output buffer of at least mb_b64_dec_len(len) bytes.
+ * @return The number of bytes written.
+ * The characters outside the alphabet e.g. CRLF are skipped and the input after
+ * the padded group is ignored.
+ */
+static inline size_t mb_b64_dec_update(mb_b64_dec_state &st, const uint8_t *in, size_t len, uint8_t *out)
+{
+    uint8_t *p = out;
+    const uint8_t *end = in + len;
+
+    while (in < end && !st.done)
+    {
+        // The complete groups without padding
+        if (st.count == 0)
+        {
+            while (end - in >= 4)
+            {
+                uint8_t a = mb_b64_dec_table[in[0]], b = mb_b64_dec_table[in[1]];
+                uint8_t c = mb_b64_dec_table[in[2]], d = mb_b64_dec_table[in[3]];
+
+                if ((a | b | c | d) & 0xc0)
+                    break;
+
+                uint32_t v = ((uint32_t)a << 18) | ((uint32_t)b << 12) | ((uint32_t)c << 6) | d;
+                p[0] = v >> 16;
+                p[1] = (v >> 8) & 0xff;
+                p[2] = v & 0xff;
+                p += 3;
+                in += 4;
+            }
+
+            if (in == end)
+                break;
+        }
+
+        uint8_t v = mb_b64_dec_table[*in++];
+
+        if (v & MB_BASE64_INVALID)
+            continue;
+
+        if (v == MB_BASE64_PAD)
+        {
+            st.pad++;
+            v = 0;
+        }
+
+        st.acc = (st.acc << 6) | v;
+        if (++st.count == 4)
+            p = mb_b64_dec_group(st, p);
+    }
+
+    return p - out;
+}
+
+/** Decode the remaining incomplete group as it was padded.
+ *
+ * @param st The decoder state.
+ * @param out The output buffer of at least 3 bytes.
+ * @return The number of bytes written.
+ */
+static inline size_t mb_b64_dec_final(mb_b64_dec_state &st, uint8_t *out)
+{
+    if (st.done || st.count == 0)
+        return 0;
+
+    while (st.count < 4)
+    {
+        st.acc <<= 6;
+        st.count++;
+        st.pad++;
+    }
+
+    return mb_b64_dec_group(st, out) - out;
+}
+
+#endif
@@ -149,7 +149,7 @@ namespace mb_string
     {
 
     public:
-        mb_string_ptr_t(uint32_t addr = 0, mb_string_sub_type type = mb_string_sub_type_cstring, int precision = -1, const StringSumHelper *s = nullptr)
+        mb_string_ptr_t(uintptr_t addr = 0, mb_string_sub_type type = mb_string_sub_type_cstring, int precision = -1, const StringSumHelper *s = nullptr)
         {
             _addr = addr;
             _type = type;
@@ -158,13 +158,13 @@ namespace mb_string
         }
         int precision() { return _precision; }
         mb_string_sub_type type() { return _type; }
-        uint32_t address() { return _addr; }
+        uintptr_t address() { return _addr; }
         const StringSumHelper *stringsumhelper() { return _ssh; }
 
     private:
         mb_string_sub_type _type = mb_string_sub_type_none;
         int _precision = -1;
-        uint32_t _addr = 0;
+        uintptr_t _addr = 0;
         const StringSumHelper *_ssh = nullptr;
 
     } MB_StringPtr;
@@ -391,17 +391,17 @@ namespace mb_string
     };
 
     template <typename T>
-    uint32_t toAddr(T &v) { return reinterpret_cast<uint32_t>(&v); }
+    uintptr_t toAddr(T &v) { return reinterpret_cast<uintptr_t>(&v); }
 
 #if defined(__AVR__)
     template <typename T>
-    T addrTo(int address)
+    T addrTo(uintptr_t address)
     {
         return reinterpret_cast<T>(address);
     }
 #else
     template <typename T>
-    auto addrTo(int address) -> typename MB_ENABLE_IF<!MB_IS_SAME<T, nullptr_t>::value, T>::type
+    auto addrTo(uintptr_t address) -> typename MB_ENABLE_IF<!MB_IS_SAME<T, nullptr_t>::value, T>::type
     {
         return reinterpret_cast<T>(address);
     }
@@ -459,25 +459,25 @@ namespace mb_string
     template <typename T>
     auto toStringPtr(const T &val) -> typename MB_ENABLE_IF<is_std_string<T>::value || is_arduino_string<T>::value || is_mb_string<T>::value, MB_StringPtr>::type
     {
-        return MB_StringPtr(reinterpret_cast<uint32_t>(&val), getSubType(val));
+        return MB_StringPtr(reinterpret_cast<uintptr_t>(&val), getSubType(val));
     }
 
     template <typename T>
     auto toStringPtr(const T &val) -> typename MB_ENABLE_IF<MB_IS_SAME<T, StringSumHelper>::value, MB_StringPtr>::type
     {
 #if defined(ESP8266)
-        return MB_StringPtr(reinterpret_cast<uint32_t>(&val), getSubType(val), -1);
+        return MB_StringPtr(reinterpret_cast<uintptr_t>(&val), getSubType(val), -1);
 
 #else
-        return MB_StringPtr(reinterpret_cast<uint32_t>(&val), getSubType(val), -1, &val);
+        return MB_StringPtr(reinterpret_cast<uintptr_t>(&val), getSubType(val), -1, &val);
 #endif
     }
 
     template <typename T>
-    auto toStringPtr(T val) -> typename MB_ENABLE_IF<is_const_chars<T>::value, MB_StringPtr>::type { return MB_StringPtr(reinterpret_cast<uint32_t>(val), getSubType(val)); }
+    auto toStringPtr(T val) -> typename MB_ENABLE_IF<is_const_chars<T>::value, MB_StringPtr>::type { return MB_StringPtr(reinterpret_cast<uintptr_t>(val), getSubType(val)); }
 
     template <typename T>
-    auto toStringPtr(T &val) -> typename MB_ENABLE_IF<is_arduino_flash_string_helper<T>::value, MB_StringPtr>::type { return MB_StringPtr(reinterpret_cast<uint32_t>(val), getSubType(val)); }
+    auto toStringPtr(T &val) -> typename MB_ENABLE_IF<is_arduino_flash_string_helper<T>::value, MB_StringPtr>::type { return MB_StringPtr(reinterpret_cast<uintptr_t>(val), getSubType(val)); }
 
 #if !defined(__AVR__)
     template <typename T>
@@ -494,7 +494,7 @@ namespace mb_string
     }
 
     template <typename T>
-    auto toStringPtr(T &val, int precision = -1) -> typename MB_ENABLE_IF<is_num_int<T>::value || is_num_float<T>::value || MB_IS_SAME<T, bool>::value, MB_StringPtr>::type { return MB_StringPtr(reinterpret_cast<uint32_t>(&val), getSubType(val), precision); }
+    auto toStringPtr(T &val, int precision = -1) -> typename MB_ENABLE_IF<is_num_int<T>::value || is_num_float<T>::value || MB_IS_SAME<T, bool>::value, MB_StringPtr>::type { return MB_StringPtr(reinterpret_cast<uintptr_t>(&val), getSubType(val), precision); }
 }
 
 using namespace mb_string;
@@ -1484,14 +1484,16 @@ private:
     char *int32Str(signed long value)
     {
         char *t = (char *)newP(64);
-        sprintf(t, (const char *)MBSTRING_FLASH_MCR("%ld"), value);
+        if (t)
+            sprintf(t, (const char *)MBSTRING_FLASH_MCR("%ld"), value);
         return t;
     }
 
     char *uint32Str(unsigned long value)
     {
         char *t = (char *)newP(64);
-        sprintf(t, (const char *)MBSTRING_FLASH_MCR("%lu"), value);
+        if (t)
+            sprintf(t, (const char *)MBSTRING_FLASH_MCR("%lu"), value);
         return t;
     }
 
@@ -1500,21 +1502,24 @@ private:
     char *int64Str(signed long long value)
     {
         char *t = (char *)newP(64);
-        sprintf(t, (const char *)MBSTRING_FLASH_MCR("%lld"), value);
+        if (t)
+            sprintf(t, (const char *)MBSTRING_FLASH_MCR("%lld"), value);
         return t;
     }
 
     char *uint64Str(unsigned long long value)
     {
         char *t = (char *)newP(64);
-        sprintf(t, (const char *)MBSTRING_FLASH_MCR("%llu"), value);
+        if (t)
+            sprintf(t, (const char *)MBSTRING_FLASH_MCR("%llu"), value);
         return t;
     }
 
     char *boolStr(bool value)
     {
         char *t = (char *)newP(8);
-        value ? strcpy(t, (const char *)MBSTRING_FLASH_MCR("true")) : strcpy(t, (const char *)MBSTRING_FLASH_MCR("false"));
+        if (t)
+            value ? strcpy(t, (const char *)MBSTRING_FLASH_MCR("true")) : strcpy(t, (const char *)MBSTRING_FLASH_MCR("false"));
         return t;
     }
 
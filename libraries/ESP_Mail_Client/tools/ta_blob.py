@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+"""
+Trust anchor blob generator for the TrustAnchorBlob loader (BSSL_CertStore.h).
+
+Decodes the PEM or DER root certificates on the host and writes the trust
+anchors (subject DN and public key) in the binary format that the device
+references in place, without PEM or X.509 decoding at connect time.
+
+Usage:
+    python3 ta_blob.py ca-bundle.pem -o ta_blob.bin
+    python3 ta_blob.py ca-bundle.pem -o ta_blob.h --name ta_blob
+
+The .h output is a PROGMEM array that can be passed to setCACert() or
+TrustAnchorBlob::load(), the .bin output can be stored in a flash partition.
+
+Blob format (little-endian):
+    0   char[4]   "BRTA"
+    4   uint16    version (1)
+    6   uint16    count
+    8   uint32    total size
+    12  index     count x { uint8 sha256(dn)[32]; uint32 record offset }, sorted by hash
+        records   uint16 dn_len; uint8 flags; uint8 key_type;
+                  RSA: uint16 n_len; uint16 e_len; dn; n; e
+                  EC:  uint16 curve; uint16 q_len; dn; q
+"""
+
+import argparse
+import base64
+import hashlib
+import re
+import struct
+import sys
+
+BR_X509_TA_CA = 0x0001
+BR_KEYTYPE_RSA = 1
+BR_KEYTYPE_EC = 2
+
+OID_RSA = bytes.fromhex("2a864886f70d010101")
+OID_EC = bytes.fromhex("2a8648ce3d0201")
+OID_BASIC_CONSTRAINTS = bytes.fromhex("551d13")
+
+# The named curves known to BearSSL
+CURVES = {
+    bytes.fromhex("2a8648ce3d030107"): 23,  # secp256r1
+    bytes.fromhex("2b81040022"): 24,  # secp384r1
+    bytes.fromhex("2b81040023"): 25,  # secp521r1
+}
+
+
+def der_read(data, pos):
+    """Returns (tag, value start, value end) of the element at pos."""
+    tag = data[pos]
+    length = data[pos + 1]
+    pos += 2
+    if length & 0x80:
+        n = length & 0x7F
+        length = int.from_bytes(data[pos:pos + n], "big")
+        pos += n
+    return tag, pos, pos + length
+
+
+def der_children(data, start, end):
+    """Returns (tag, element start, value start, value end) of the child elements."""
+    items = []
+    while start < end:
+        tag, vs, ve = der_read(data, start)
+        items.append((tag, start, vs, ve))
+        start = ve
+    return items
+
+
+def strip_int(value):
+    """The unsigned big-endian integer without the leading zeros, like the BearSSL decoder."""
+    value = value.lstrip(b"\x00")
+    return value if value else b"\x00"
+
+
+def is_ca(data, tbs):
+    """The cA flag of the basic constraints extension, like br_x509_decoder_isCA()."""
+    for tag, _, vs, ve in tbs:
+        if tag != 0xA3:
+            continue
+        _, es, ee = der_read(data, vs)
+        for _, _, xs, xe in der_children(data, es, ee):
+            ext = der_children(data, xs, xe)
+            if data[ext[0][2]:ext[0][3]] != OID_BASIC_CONSTRAINTS:
+                continue
+            _, bs, be = der_read(data, ext[-1][2])
+            bc = der_children(data, bs, be)
+            return len(bc) > 0 and bc[0][0] == 0x01 and data[bc[0][2]] != 0
+    return False
+
+
+def trust_anchor(der):
+    """Returns (dn, flags, key_type, key fields) of the certificate."""
+    _, cs, ce = der_read(der, 0)
+    _, _, ts, te = der_children(der, cs, ce)[0]
+    tbs = der_children(der, ts, te)
+    i = 1 if tbs[0][0] == 0xA0 else 0
+    # serial, signature, issuer, validity, subject, subjectPublicKeyInfo
+    subject = tbs[i + 4]
+    spki = tbs[i + 5]
+    dn = bytes(der[subject[1]:subject[3]])
+    flags = BR_X509_TA_CA if is_ca(der, tbs) else 0
+
+    alg, key = der_children(der, spki[2], spki[3])
+    alg_items = der_children(der, alg[2], alg[3])
+    oid = bytes(der[alg_items[0][2]:alg_items[0][3]])
+    bits = bytes(der[key[2] + 1:key[3]])  # skip the unused bits byte
+
+    if oid == OID_RSA:
+        _, rs, re_ = der_read(bits, 0)
+        n, e = der_children(bits, rs, re_)
+        return dn, flags, BR_KEYTYPE_RSA, (strip_int(bits[n[2]:n[3]]), strip_int(bits[e[2]:e[3]]))
+    if oid == OID_EC:
+        curve = CURVES.get(bytes(der[alg_items[1][2]:alg_items[1][3]]))
+        if curve is None:
+            raise ValueError("unsupported EC curve")
+        return dn, flags, BR_KEYTYPE_EC, (curve, bits)
+    raise ValueError("unsupported public key type")
+
+
+def load_certs(path):
+    with open(path, "rb") as f:
+        raw = f.read()
+    pems = re.findall(rb"-----BEGIN CERTIFICATE-----(.+?)-----END CERTIFICATE-----", raw, re.S)
+    if pems:
+        return [base64.b64decode(b"".join(p.split())) for p in pems]
+    return [raw]
+
+
+def build(certs):
+    records = []
+    for der in certs:
+        try:
+            records.append(trust_anchor(der))
+        except (ValueError, IndexError) as e:
+            print("skipped a certificate: %s" % e, file=sys.stderr)
+
+    # The records are kept in the input order, the index is sorted by the DN hash
+    offset = 12 + 36 * len(records)
+    index, body = [], b""
+    for dn, flags, key_type, key in records:
+        if key_type == BR_KEYTYPE_RSA:
+            n, e = key
+            rec = struct.pack("<HBBHH", len(dn), flags, key_type, len(n), len(e)) + dn + n + e
+        else:
+            curve, q = key
+            rec = struct.pack("<HBBHH", len(dn), flags, key_type, curve, len(q)) + dn + q
+        index.append((hashlib.sha256(dn).digest(), offset + len(body)))
+        body += rec
+    index.sort()
+    total = offset + len(body)
+    index = b"".join(h + struct.pack("<I", off) for h, off in index)
+    return b"BRTA" + struct.pack("<HHI", 1, len(records), total) + index + body, len(records)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("input", nargs="+", help="PEM bundle or DER certificate files")
+    ap.add_argument("-o", "--output", required=True, help="the .bin or .h output file")
+    ap.add_argument("--name", default="ta_blob", help="the array name of the .h output")
+    args = ap.parse_args()
+
+    certs = []
+    for path in args.input:
+        certs += load_certs(path)
+    blob, count = build(certs)
+
+    if args.output.endswith(".h"):
+        lines = ["// %d trust anchors, %d bytes, generated by ta_blob.py" % (count, len(blob)),
+                 "#pragma once", "#include <Arduino.h>", "",
+                 "static const uint8_t %s[] PROGMEM __attribute__((aligned(4))) = {" % args.name]
+        for i in range(0, len(blob), 16):
+            lines.append("    " + ", ".join("0x%02x" % b for b in blob[i:i + 16]) + ",")
+        lines.append("};")
+        with open(args.output, "w") as f:
+            f.write("\n".join(lines) + "\n")
+    else:
+        with open(args.output, "wb") as f:
+            f.write(blob)
+    print("%d trust anchors, %d bytes" % (count, len(blob)))
+
+
+if __name__ == "__main__":
+    main()
@@ -67,6 +67,10 @@ void LiquidCrystal::init(uint8_t fourbitmode, uint8_t rs, uint8_t rw, uint8_t en
   _data_pins[6] = d6;
   _data_pins[7] = d7; 
 
+  _busyPolling = false;
+  _busySince = 0;
+  _busyTimeout = 0;
+
   if (fourbitmode)
     _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
   else 
@@ -76,6 +80,10 @@ void LiquidCrystal::init(uint8_t fourbitmode, uint8_t rs, uint8_t rw, uint8_t en
 }
 
 void LiquidCrystal::begin(uint8_t cols, uint8_t lines, uint8_t dotsize) {
+  // the busy flag can't be read before the interface is set
+  bool busyPolling = _busyPolling;
+  _busyPolling = false;
+
   if (lines > 1) {
     _displayfunction |= LCD_2LINE;
   }
@@ -162,6 +170,14 @@ void LiquidCrystal::begin(uint8_t cols, uint8_t lines, uint8_t dotsize) {
   // set the entry mode
   command(LCD_ENTRYMODESET | _displaymode);
 
+  _busyPolling = busyPolling;
+  _busyTimeout = 0;
+}
+
+void LiquidCrystal::setBusyPolling(bool enable)
+{
+  _busyPolling = enable && _rw_pin != 255;
+  _busyTimeout = 0;
 }
 
 void LiquidCrystal::setRowOffsets(int row0, int row1, int row2, int row3)
@@ -176,13 +192,15 @@ void LiquidCrystal::setRowOffsets(int row0, int row1, int row2, int row3)
 void LiquidCrystal::clear()
 {
   command(LCD_CLEARDISPLAY);  // clear display, set cursor position to zero
-  delayMicroseconds(2000);  // this command takes a long time!
+  if (_busyPolling) _busyTimeout = 2000;  // the next command waits for it
+  else delayMicroseconds(2000);  // this command takes a long time!
 }
 
 void LiquidCrystal::home()
 {
   command(LCD_RETURNHOME);  // set cursor position to zero
-  delayMicroseconds(2000);  // this command takes a long time!
+  if (_busyPolling) _busyTimeout = 2000;  // the next command waits for it
+  else delayMicroseconds(2000);  // this command takes a long time!
 }
 
 void LiquidCrystal::setCursor(uint8_t col, uint8_t row)
@@ -285,6 +303,10 @@ inline size_t LiquidCrystal::write(uint8_t value) {
 
 // write either command or data, with automatic 4/8-bit selection
 void LiquidCrystal::send(uint8_t value, uint8_t mode) {
+  if (_busyPolling) {
+    waitReady();
+  }
+
   digitalWrite(_rs_pin, mode);
 
   // if there is a RW pin indicated, set it low to Write
@@ -298,6 +320,11 @@ void LiquidCrystal::send(uint8_t value, uint8_t mode) {
     write4bits(value>>4);
     write4bits(value);
   }
+
+  if (_busyPolling) {
+    _busySince = micros();
+    _busyTimeout = 100;
+  }
 }
 
 void LiquidCrystal::pulseEnable(void) {
@@ -306,7 +333,44 @@ void LiquidCrystal::pulseEnable(void) {
   digitalWrite(_enable_pin, HIGH);
   delayMicroseconds(1);    // enable pulse must be >450ns
   digitalWrite(_enable_pin, LOW);
-  delayMicroseconds(100);   // commands need > 37us to settle
+  if (!_busyPolling) {
+    delayMicroseconds(100);   // commands need > 37us to settle
+  }
+}
+
+// Reads the busy flag on DB7 until the last command is done. The fixed
+// command time is the timeout, e.g. when the LCD does not answer.
+void LiquidCrystal::waitReady() {
+  if (micros() - _busySince >= _busyTimeout) return;
+
+  uint8_t pins = (_displayfunction & LCD_8BITMODE) ? 8 : 4;
+  for (int i = 0; i < pins; i++) {
+    pinMode(_data_pins[i], INPUT);
+  }
+  digitalWrite(_rs_pin, LOW);
+  digitalWrite(_rw_pin, HIGH);
+
+  bool busy = true;
+  while (busy && micros() - _busySince < _busyTimeout) {
+    digitalWrite(_enable_pin, HIGH);
+    delayMicroseconds(1);    // data is valid 360ns after enable
+    busy = digitalRead(_data_pins[pins - 1]);
+    digitalWrite(_enable_pin, LOW);
+    delayMicroseconds(1);
+
+    // in 4 bit mode the low nibble of the address counter is read too
+    if (pins == 4) {
+      digitalWrite(_enable_pin, HIGH);
+      delayMicroseconds(1);
+      digitalWrite(_enable_pin, LOW);
+      delayMicroseconds(1);
+    }
+  }
+
+  digitalWrite(_rw_pin, LOW);
+  for (int i = 0; i < pins; i++) {
+    pinMode(_data_pins[i], OUTPUT);
+  }
 }
 
 void LiquidCrystal::write4bits(uint8_t value) {
@@ -77,6 +77,9 @@ public:
   void autoscroll();
   void noAutoscroll();
 
+  // Reads the busy flag instead of waiting the fixed command times, needs the RW pin
+  void setBusyPolling(bool enable);
+
   void setRowOffsets(int row1, int row2, int row3, int row4);
   void createChar(uint8_t, uint8_t[]);
   void setCursor(uint8_t, uint8_t); 
@@ -89,6 +92,7 @@ private:
   void write4bits(uint8_t);
   void write8bits(uint8_t);
   void pulseEnable();
+  void waitReady();
 
   uint8_t _rs_pin; // LOW: command.  HIGH: character.
   uint8_t _rw_pin; // LOW: write to LCD.  HIGH: read from LCD.
@@ -103,6 +107,10 @@ private:
 
   uint8_t _numlines;
   uint8_t _row_offsets[4];
+
+  bool _busyPolling;
+  unsigned long _busySince;  // micros() of the last command
+  uint16_t _busyTimeout;     // the longest time the last command takes, in us
 };
 
 #endif
@@ -8,16 +8,30 @@
 
 #define printIIC(args)	Wire.write(args)
 inline size_t LiquidCrystal_I2C::write(uint8_t value) {
-	send(value, Rs);
+	if (_shadow) fbWrite(value);
+	else send(value, Rs);
 	return 1;
 }
 
+// The string is sent in as few transmissions as the Wire buffer allows
+size_t LiquidCrystal_I2C::write(const uint8_t *buffer, size_t size) {
+	if (_shadow) {
+		for (size_t i = 0; i < size; i++) fbWrite(buffer[i]);
+		return size;
+	}
+	burstBegin();
+	for (size_t i = 0; i < size; i++) burstSend(buffer[i], Rs);
+	burstEnd();
+	return size;
+}
+
 #else
 #include "WProgram.h"
 
 #define printIIC(args)	Wire.send(args)
 inline void LiquidCrystal_I2C::write(uint8_t value) {
-	send(value, Rs);
+	if (_shadow) fbWrite(value);
+	else send(value, Rs);
 }
 
 #endif
@@ -52,6 +66,11 @@ LiquidCrystal_I2C::LiquidCrystal_I2C(uint8_t lcd_Addr,uint8_t lcd_cols,uint8_t l
   _backlightval = LCD_NOBACKLIGHT;
 }
 
+LiquidCrystal_I2C::~LiquidCrystal_I2C()
+{
+  free(_shadow);
+}
+
 void LiquidCrystal_I2C::oled_init(){
   _oled = true;
 	init_priv();
@@ -130,17 +149,31 @@ void LiquidCrystal_I2C::begin(uint8_t cols, uint8_t lines, uint8_t dotsize) {
 
 /********** high level commands, for the user! */
 void LiquidCrystal_I2C::clear(){
+	if (_shadow) {
+		memset(_shadow, ' ', _cols * _rows);
+		_fbCol = _fbRow = 0;
+		return;
+	}
 	command(LCD_CLEARDISPLAY);// clear display, set cursor position to zero
 	delayMicroseconds(2000);  // this command takes a long time!
   if (_oled) setCursor(0,0);
 }
 
 void LiquidCrystal_I2C::home(){
+	if (_shadow) {
+		_fbCol = _fbRow = 0;
+		return;
+	}
 	command(LCD_RETURNHOME);  // set cursor position to zero
 	delayMicroseconds(2000);  // this command takes a long time!
 }
 
 void LiquidCrystal_I2C::setCursor(uint8_t col, uint8_t row){
+	if (_shadow) {
+		_fbCol = col;
+		_fbRow = row < _rows ? row : _rows - 1;
+		return;
+	}
 	int row_offsets[] = { 0x00, 0x40, 0x14, 0x54 };
 	if ( row > _numlines ) {
 		row = _numlines-1;    // we count rows starting w/0
@@ -216,7 +249,7 @@ void LiquidCrystal_I2C::createChar(uint8_t location, uint8_t charmap[]) {
 	location &= 0x7; // we only have 8 locations 0-7
 	command(LCD_SETCGRAMADDR | (location << 3));
 	for (int i=0; i<8; i++) {
-		write(charmap[i]);
+		send(charmap[i], Rs);
 	}
 }
 
@@ -225,7 +258,7 @@ void LiquidCrystal_I2C::createChar(uint8_t location, const char *charmap) {
 	location &= 0x7; // we only have 8 locations 0-7
 	command(LCD_SETCGRAMADDR | (location << 3));
 	for (int i=0; i<8; i++) {
-	    	write(pgm_read_byte_near(charmap++));
+	    	send(pgm_read_byte_near(charmap++), Rs);
 	}
 }
 
@@ -245,18 +278,93 @@ void LiquidCrystal_I2C::backlight(void) {
 /*********** mid level commands, for sending data/cmds */
 
 inline void LiquidCrystal_I2C::command(uint8_t value) {
+	_lcdAddr = 0xFF;	// the framebuffer no longer knows the display address
 	send(value, 0);
 }
 
 
+/*********** framebuffer */
+
+// The framebuffer holds the characters printed and the characters on the display,
+// enabling it clears both and the display.
+bool LiquidCrystal_I2C::setFramebuffer(bool enable) {
+	free(_shadow);
+	_shadow = nullptr;
+	if (!enable) return true;
+
+	size_t cells = _cols * _rows;
+	uint8_t *buf = (uint8_t *)malloc(cells * 2);
+	if (!buf) return false;
+	memset(buf, ' ', cells * 2);
+
+	clear();
+	_shadow = buf;
+	_fbCol = _fbRow = 0;
+	_lcdAddr = 0;
+	return true;
+}
+
+void LiquidCrystal_I2C::setSettleTime(uint16_t us) {
+	_settleTime = us;
+}
+
+void LiquidCrystal_I2C::fbWrite(uint8_t value) {
+	if (_fbCol < _cols && _fbRow < _rows) {
+		_shadow[_fbRow * _cols + _fbCol] = value;
+	}
+	if (_displaymode & LCD_ENTRYLEFT) _fbCol++;
+	else _fbCol--;
+}
+
+// Sends the characters that differ from the display. The cursor is only moved when the
+// next changed character is not where the display writes, e.g. on the next row.
+size_t LiquidCrystal_I2C::refresh() {
+	if (!_shadow) return 0;
+
+	static const uint8_t row_offsets[] = { 0x00, 0x40, 0x14, 0x54 };
+	size_t cells = _cols * _rows;
+	uint8_t *shown = _shadow + cells;
+	bool increment = (_displaymode & LCD_ENTRYLEFT) && !(_displaymode & LCD_ENTRYSHIFTINCREMENT);
+
+	burstBegin();
+	for (uint8_t row = 0; row < _rows && row < 4; row++) {
+		for (uint8_t col = 0; col < _cols; col++) {
+			size_t i = row * _cols + col;
+			if (_shadow[i] == shown[i]) continue;
+
+			uint8_t addr = col + row_offsets[row];
+			if (addr != _lcdAddr) burstSend(LCD_SETDDRAMADDR | addr, 0);
+			burstSend(_shadow[i], Rs);
+			shown[i] = _shadow[i];
+			_lcdAddr = increment ? addr + 1 : 0xFF;
+		}
+	}
+
+	// The visible cursor stays at the print position
+	if ((_displaycontrol & (LCD_CURSORON | LCD_BLINKON)) && _fbCol < _cols && _fbRow < 4) {
+		uint8_t addr = _fbCol + row_offsets[_fbRow];
+		if (addr != _lcdAddr) burstSend(LCD_SETDDRAMADDR | addr, 0);
+		_lcdAddr = addr;
+	}
+	burstEnd();
+
+	size_t bytes = _burstBytes;
+	_burstBytes = 0;
+	return bytes;
+}
+
+void LiquidCrystal_I2C::flush() {
+	refresh();
+}
+
+
 /************ low level data pushing commands **********/
 
-// write either command or data
+// write either command or data, both nibbles in one transmission
 void LiquidCrystal_I2C::send(uint8_t value, uint8_t mode) {
-	uint8_t highnib=value&0xf0;
-	uint8_t lownib=(value<<4)&0xf0;
-       write4bits((highnib)|mode);
-	write4bits((lownib)|mode); 
+	burstBegin();
+	burstSend(value, mode);
+	burstEnd();
 }
 
 void LiquidCrystal_I2C::write4bits(uint8_t value) {
@@ -270,12 +378,43 @@ void LiquidCrystal_I2C::expanderWrite(uint8_t _data){
 	Wire.endTransmission();   
 }
 
+// Several nibbles are sent in one Wire transmission, the same expander states as write4bits().
+// Within the transmission the I2C time of the next 3 bytes covers the 37us execution time
+// up to 400 kHz bus clock (67us), not at 1 MHz (27us), the settle time is waited after it.
+void LiquidCrystal_I2C::burstBegin(){
+	_burstLen = 0;
+	_burstBytes = 0;
+}
+
+void LiquidCrystal_I2C::burstSend(uint8_t value, uint8_t mode){
+	uint8_t nibbles[2] = { (uint8_t)((value & 0xf0) | mode), (uint8_t)(((value << 4) & 0xf0) | mode) };
+	if (_burstLen + 6 > LCD_I2C_BURST_SIZE) burstEnd();
+	if (_burstLen == 0) {
+		Wire.beginTransmission(_Addr);
+		_burstBytes++;	// the address byte
+	}
+	for (int i = 0; i < 2; i++) {
+		printIIC((int)(nibbles[i]) | _backlightval);
+		printIIC((int)(nibbles[i] | En) | _backlightval);
+		printIIC((int)(nibbles[i] & ~En) | _backlightval);
+		_burstLen += 3;
+	}
+}
+
+void LiquidCrystal_I2C::burstEnd(){
+	if (_burstLen == 0) return;
+	Wire.endTransmission();
+	_burstBytes += _burstLen;
+	_burstLen = 0;
+	delayMicroseconds(_settleTime);
+}
+
 void LiquidCrystal_I2C::pulseEnable(uint8_t _data){
 	expanderWrite(_data | En);	// En high
 	delayMicroseconds(1);		// enable pulse must be >450ns
 	
 	expanderWrite(_data & ~En);	// En low
-	delayMicroseconds(50);		// commands need > 37us to settle
+	delayMicroseconds(_settleTime);	// commands need > 37us to settle
 } 
 
 
@@ -52,9 +52,21 @@
 #define Rw B00000010  // Read/Write bit
 #define Rs B00000001  // Register select bit
 
+// The bytes sent in one Wire transmission, within the Wire buffer of all the boards.
+// Within a transmission the next nibble follows a character by 3 bytes (27 bit times), at
+// least the 37us execution time up to 400 kHz bus clock. Faster buses (1 MHz Fast-mode
+// Plus) must define it to 6, one character per transmission followed by the settle time.
+#ifndef LCD_I2C_BURST_SIZE
+#define LCD_I2C_BURST_SIZE 30
+#endif
+
 class LiquidCrystal_I2C : public Print {
 public:
   LiquidCrystal_I2C(uint8_t lcd_Addr,uint8_t lcd_cols,uint8_t lcd_rows);
+  ~LiquidCrystal_I2C();
+  // Owns the framebuffer
+  LiquidCrystal_I2C(const LiquidCrystal_I2C &) = delete;
+  LiquidCrystal_I2C &operator=(const LiquidCrystal_I2C &) = delete;
   void begin(uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS );
   void clear();
   void home();
@@ -83,6 +95,8 @@ public:
   void setCursor(uint8_t, uint8_t); 
 #if defined(ARDUINO) && ARDUINO >= 100
   virtual size_t write(uint8_t);
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  using Print::write;
 #else
   virtual void write(uint8_t);
 #endif
@@ -90,6 +104,17 @@ public:
   void init();
   void oled_init();
 
+  // Framebuffer mode: print(), setCursor(), clear() and home() only change the buffer in RAM,
+  // refresh() or flush() sends the changed characters. refresh() returns the bytes sent on the bus.
+  bool setFramebuffer(bool enable);
+
+  // The wait after each transmission for the LCD to execute the last command or character,
+  // 50us by default. The characters within a transmission are spaced by the I2C bus time,
+  // see LCD_I2C_BURST_SIZE above 400 kHz.
+  void setSettleTime(uint16_t us);
+  size_t refresh();
+  void flush();
+
 ////compatibility API function aliases
 void blink_on();						// alias for blink()
 void blink_off();       					// alias for noBlink()
@@ -117,6 +142,10 @@ private:
   void write4bits(uint8_t);
   void expanderWrite(uint8_t);
   void pulseEnable(uint8_t);
+  void fbWrite(uint8_t);
+  void burstBegin();
+  void burstSend(uint8_t, uint8_t);
+  void burstEnd();
   uint8_t _Addr;
   uint8_t _displayfunction;
   uint8_t _displaycontrol;
@@ -126,6 +155,14 @@ private:
   uint8_t _cols;
   uint8_t _rows;
   uint8_t _backlightval;
+
+  uint8_t *_shadow = nullptr;  // the characters printed, followed by the characters on the display
+  uint8_t _fbCol = 0;
+  uint8_t _fbRow = 0;
+  uint8_t _lcdAddr = 0xFF;     // the DDRAM address of the display, 0xFF when unknown
+  uint16_t _settleTime = 50;   // in us
+  uint8_t _burstLen = 0;
+  size_t _burstBytes = 0;
 };
 
 #endif
@@ -0,0 +1,41 @@
+// Measures the characters per second printed to the LCD at 100 kHz and 400 kHz I2C clock,
+// the results are printed on the serial port.
+#include <Wire.h>
+#include <LiquidCrystal_I2C.h>
+
+LiquidCrystal_I2C lcd(0x27,16,2);  // set the LCD address to 0x27 for a 16 chars and 2 line display
+
+const char *lines[2] = {"The quick brown ", "fox jumps over  "};
+
+void bench(uint32_t clock)
+{
+  Wire.setClock(clock);
+  unsigned long us = micros();
+  for (int i = 0; i < 100; i++) {
+    lcd.setCursor(0,0);
+    lcd.print(lines[0]);
+    lcd.setCursor(0,1);
+    lcd.print(lines[1]);
+  }
+  us = micros() - us;
+
+  Serial.print(clock / 1000);
+  Serial.print(" kHz: ");
+  Serial.print(3200.0 * 1000000.0 / us, 0);
+  Serial.println(" chars/s");
+}
+
+void setup()
+{
+  Serial.begin(9600);
+  lcd.init();                      // initialize the lcd
+  lcd.backlight();
+
+  bench(100000);
+  bench(400000);
+  Wire.setClock(100000);
+}
+
+void loop()
+{
+}
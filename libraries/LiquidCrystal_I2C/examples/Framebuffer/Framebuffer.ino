@@ -0,0 +1,37 @@
+// Redraws the whole screen every loop, only the changed characters are sent to the LCD.
+// The number of bytes sent on the I2C bus for each frame is printed on the serial port.
+#include <Wire.h>
+#include <LiquidCrystal_I2C.h>
+
+LiquidCrystal_I2C lcd(0x27,16,2);  // set the LCD address to 0x27 for a 16 chars and 2 line display
+
+void setup()
+{
+  Serial.begin(9600);
+  lcd.init();                      // initialize the lcd
+  lcd.backlight();
+  if (!lcd.setFramebuffer(true)) {
+    Serial.println("Out of memory");
+  }
+}
+
+void loop()
+{
+  unsigned long s = millis() / 1000;
+
+  lcd.clear();
+  lcd.setCursor(0,0);
+  lcd.print("Uptime");
+  lcd.setCursor(0,1);
+  lcd.print(s / 3600);
+  lcd.print(":");
+  if ((s / 60) % 60 < 10) lcd.print("0");
+  lcd.print((s / 60) % 60);
+  lcd.print(":");
+  if (s % 60 < 10) lcd.print("0");
+  lcd.print(s % 60);
+
+  Serial.print("bus bytes: ");
+  Serial.println(lcd.refresh());
+  delay(200);
+}
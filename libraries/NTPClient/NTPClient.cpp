@@ -86,39 +86,152 @@ bool NTPClient::forceUpdate() {
     Serial.println("Update from NTP Server");
   #endif
 
+  if (!this->beginUpdate()) return false;
+
+  // Wait till the round completes or timeout...
+  while (this->_pending) {
+    if (this->poll()) return true;
+    delay ( 1 );
+  }
+  return false;
+}
+
+bool NTPClient::beginUpdate() {
+  if (!this->_udpSetup) this->begin(this->_port); // setup the UDP client if needed
+
   // flush any existing packets
   while(this->_udp->parsePacket() != 0)
     this->_udp->flush();
 
-  this->sendNTPPacket();
+  this->_sent       = 0;
+  this->_replied    = 0;
+  this->_hasSample  = false;
+  this->_lastAttempt = millis();
+
+  // pipeline the requests to all servers, the responses are matched by the originate timestamp
+  for (byte i = 0; i <= this->_serverCount; i++) {
+    if (this->sendNTPPacket(i)) this->_sent |= 1 << i;
+  }
+
+  this->_pending = this->_sent != 0;
+  return this->_pending;
+}
+
+bool NTPClient::poll() {
+  if (!this->_pending) {
+    unsigned long now = millis();
+    unsigned long retry = this->_updateInterval < NTP_RETRY_INTERVAL ? this->_updateInterval : NTP_RETRY_INTERVAL;
+    bool due = (!this->isTimeSet() || now - this->_lastUpdate >= this->currentInterval())
+            && (this->_lastAttempt == 0 || now - this->_lastAttempt >= retry);
+    if (!due || !this->beginUpdate()) return false;
+  }
+
+  while (this->_udp->parsePacket() != 0)
+    this->readNTPPacket();
 
-  // Wait till data is there or timeout...
-  byte timeout = 0;
-  int cb = 0;
-  do {
-    delay ( 10 );
-    cb = this->_udp->parsePacket();
-    if (timeout > 100) return false; // timeout after 1000 ms
-    timeout++;
-  } while (cb == 0);
+  // Wait for the other servers till timeout
+  if (this->_replied != this->_sent && millis() - this->_lastAttempt < this->_timeout) return false;
 
-  this->_lastUpdate = millis() - (10 * (timeout + 1)); // Account for delay in reading the time
+  this->_pending = false;
+  if (!this->_hasSample) return false;
 
-  this->_udp->read(this->_packetBuffer, NTP_PACKET_SIZE);
+  bool timeSet = this->isTimeSet();
+  if (timeSet) {
+    unsigned long long localMs = this->getEpochMillis() - (long long)this->_timeOffset * 1000 - (millis() - this->_sampleTime);
+    this->_lastOffset = (long)(this->_sampleEpochMs - localMs);
+  } else {
+    this->_lastOffset = 0;
+  }
+  this->_lastDelay = this->_sampleDelay;
 
-  unsigned long highWord = word(this->_packetBuffer[40], this->_packetBuffer[41]);
-  unsigned long lowWord = word(this->_packetBuffer[42], this->_packetBuffer[43]);
-  // combine the four bytes (two words) into a long integer
-  // this is NTP time (seconds since Jan 1 1900):
-  unsigned long secsSince1900 = highWord << 16 | lowWord;
+  unsigned long long epochMs = this->_discipline ? this->discipline(timeSet) : this->_sampleEpochMs;
 
-  this->_currentEpoc = secsSince1900 - SEVENZYYEARS;
+  // Keep the whole seconds and move the last update back to the start of the current second
+  this->_currentEpoc = epochMs / 1000;
+  this->_lastUpdate = this->_sampleTime - (unsigned long)(epochMs % 1000);
+  if (this->_lastUpdate == 0) this->_lastUpdate--; // 0 is reserved for the time is not set
 
   return true;  // return true after successful update
 }
 
+bool NTPClient::isUpdating() const {
+  return this->_pending;
+}
+
+unsigned long long NTPClient::discipline(bool timeSet) {
+  long offset = this->_lastOffset;
+  bool step = !timeSet || offset > NTP_STEP_THRESHOLD || offset < -NTP_STEP_THRESHOLD;
+  step |= this->_samples == 0; // the discipline was just enabled, there is no reference yet
+
+  // Step the clock and start over when the offset is too large to be the drift
+  if (step) {
+    this->_samples = 0;
+    this->_drift = 0;
+    this->_pollInterval = this->_updateInterval;
+    this->_refTime = this->_sampleTime;
+    this->_refEpochMs = this->_sampleEpochMs;
+  }
+
+  if (this->_samples == NTP_DISCIPLINE_SAMPLES) {
+    this->_samples--;
+    memmove(this->_sampleTimes, this->_sampleTimes + 1, this->_samples * sizeof(this->_sampleTimes[0]));
+    memmove(this->_sampleOffsets, this->_sampleOffsets + 1, this->_samples * sizeof(this->_sampleOffsets[0]));
+  }
+  this->_sampleTimes[this->_samples] = this->_sampleTime;
+  this->_sampleOffsets[this->_samples] = (long)(this->_sampleEpochMs - (this->_refEpochMs + (this->_sampleTime - this->_refTime)));
+  this->_samples++;
+
+  // Least squares fit of the offsets over the local time, the slope is the drift
+  // and the fitted offset at the last sample is less noisy than the sample itself
+  double meanX = 0, meanY = 0;
+  for (byte i = 0; i < this->_samples; i++) {
+    meanX += (long)(this->_sampleTimes[i] - this->_sampleTime);
+    meanY += this->_sampleOffsets[i];
+  }
+  meanX /= this->_samples;
+  meanY /= this->_samples;
+
+  double sxx = 0, sxy = 0;
+  for (byte i = 0; i < this->_samples; i++) {
+    double x = (long)(this->_sampleTimes[i] - this->_sampleTime) - meanX;
+    sxx += x * x;
+    sxy += x * (this->_sampleOffsets[i] - meanY);
+  }
+  if (sxx > 0) {
+    this->_drift = sxy / sxx * 1e6;
+    if (this->_drift > NTP_MAX_DRIFT) this->_drift = NTP_MAX_DRIFT;
+    if (this->_drift < -NTP_MAX_DRIFT) this->_drift = -NTP_MAX_DRIFT;
+  }
+  double fitted = meanY - this->_drift / 1e6 * meanX;
+
+  // Poll less often while the offset stays within the measurement error
+  long tolerance = this->_sampleDelay / 2 + NTP_DISCIPLINE_TOLERANCE;
+  if (step) {
+    // keep the update interval
+  } else if (offset <= tolerance && offset >= -tolerance) {
+    if (this->_pollInterval < this->_maxPollInterval / 2) this->_pollInterval *= 2;
+    else this->_pollInterval = this->_maxPollInterval;
+  } else if (offset > 2 * tolerance || offset < -2 * tolerance) {
+    this->_pollInterval /= 2;
+    if (this->_pollInterval < this->_updateInterval) this->_pollInterval = this->_updateInterval;
+  }
+
+  // Re-anchor the reference at this sample on the fitted time, the local time differences
+  // then span one poll interval and never wrap, and the offsets stay small
+  long correction = (long)(fitted < 0 ? fitted - 0.5 : fitted + 0.5);
+  this->_refEpochMs += (this->_sampleTime - this->_refTime) + correction;
+  this->_refTime = this->_sampleTime;
+  for (byte i = 0; i < this->_samples; i++) this->_sampleOffsets[i] -= correction;
+
+  return this->_refEpochMs;
+}
+
+unsigned long NTPClient::currentInterval() const {
+  return this->_discipline ? this->_pollInterval : this->_updateInterval;
+}
+
 bool NTPClient::update() {
-  if ((millis() - this->_lastUpdate >= this->_updateInterval)     // Update after _updateInterval
+  if ((millis() - this->_lastUpdate >= this->currentInterval())     // Update after the update interval
     || this->_lastUpdate == 0) {                                // Update if there was no update yet.
     if (!this->_udpSetup || this->_port != NTP_DEFAULT_LOCAL_PORT) this->begin(this->_port); // setup the UDP client if needed
     return this->forceUpdate();
@@ -131,9 +244,15 @@ bool NTPClient::isTimeSet() const {
 }
 
 unsigned long NTPClient::getEpochTime() const {
-  return this->_timeOffset + // User offset
-         this->_currentEpoc + // Epoch returned by the NTP server
-         ((millis() - this->_lastUpdate) / 1000); // Time since last update
+  return this->getEpochMillis() / 1000;
+}
+
+unsigned long long NTPClient::getEpochMillis() const {
+  unsigned long elapsed = millis() - this->_lastUpdate; // Time since last update
+  long long correction = this->_discipline ? (long long)(elapsed * (double)this->_drift / 1e6) : 0; // Drift since last update
+  return (long long)this->_timeOffset * 1000 + // User offset
+         (unsigned long long)this->_currentEpoc * 1000 + // Epoch returned by the NTP server
+         elapsed + correction;
 }
 
 int NTPClient::getDay() const {
@@ -175,13 +294,49 @@ void NTPClient::setTimeOffset(int timeOffset) {
 
 void NTPClient::setUpdateInterval(unsigned long updateInterval) {
   this->_updateInterval = updateInterval;
+  if (this->_pollInterval < updateInterval) this->_pollInterval = updateInterval;
+}
+
+void NTPClient::setDiscipline(bool enable, unsigned long maxInterval) {
+  this->_discipline = enable;
+  this->_maxPollInterval = maxInterval > this->_updateInterval ? maxInterval : this->_updateInterval;
+  this->_pollInterval = this->_updateInterval;
+  this->_drift = 0;
+  this->_samples = 0;
+}
+
+float NTPClient::getDrift() const {
+  return this->_drift;
+}
+
+unsigned long NTPClient::getPollInterval() const {
+  return this->currentInterval();
 }
 
 void NTPClient::setPoolServerName(const char* poolServerName) {
     this->_poolServerName = poolServerName;
 }
 
-void NTPClient::sendNTPPacket() {
+// NTP timestamp (seconds since Jan 1 1900 and 32-bit fraction) to ms since Jan 1 1970
+static unsigned long long ntpToEpochMs(const byte* buf) {
+  unsigned long long secs = (unsigned long)buf[0] << 24 | (unsigned long)buf[1] << 16 | (unsigned long)buf[2] << 8 | buf[3];
+  unsigned long long frac = (unsigned long)buf[4] << 24 | (unsigned long)buf[5] << 16 | (unsigned long)buf[6] << 8 | buf[7];
+  if (secs < SEVENZYYEARS) secs += 0x100000000ULL; // NTP era 1 starts in 2036
+  return (secs - SEVENZYYEARS) * 1000 + ((frac * 1000) >> 32);
+}
+
+static unsigned long readWord32(const byte* buf) {
+  return (unsigned long)buf[0] << 24 | (unsigned long)buf[1] << 16 | (unsigned long)buf[2] << 8 | buf[3];
+}
+
+static void writeWord32(byte* buf, unsigned long value) {
+  buf[0] = value >> 24;
+  buf[1] = value >> 16;
+  buf[2] = value >> 8;
+  buf[3] = value;
+}
+
+bool NTPClient::sendNTPPacket(byte server) {
   // set all bytes in the buffer to 0
   memset(this->_packetBuffer, 0, NTP_PACKET_SIZE);
   // Initialize values needed to form NTP request
@@ -195,15 +350,85 @@ void NTPClient::sendNTPPacket() {
   this->_packetBuffer[14]  = 49;
   this->_packetBuffer[15]  = 52;
 
+  const char* serverName = server == 0 ? this->_poolServerName : this->_serverNames[server - 1];
+  IPAddress serverIP = server == 0 ? this->_poolServerIP : this->_serverIPs[server - 1];
+
   // all NTP fields have been given values, now
   // you can send a packet requesting a timestamp:
-  if  (this->_poolServerName) {
-    this->_udp->beginPacket(this->_poolServerName, 123);
-  } else {
-    this->_udp->beginPacket(this->_poolServerIP, 123);
-  }
+  int ret = serverName ? this->_udp->beginPacket(serverName, 123) : this->_udp->beginPacket(serverIP, 123);
+  if (!ret) return false;
+
+  // The transmit timestamp is returned as the originate timestamp,
+  // it holds the send time (T1) and the server index to match the response
+  this->_sendTime[server] = millis();
+  writeWord32(this->_packetBuffer + 40, this->_sendTime[server]);
+  writeWord32(this->_packetBuffer + 44, 0x4E545000UL | server);
+
   this->_udp->write(this->_packetBuffer, NTP_PACKET_SIZE);
-  this->_udp->endPacket();
+  return this->_udp->endPacket() == 1;
+}
+
+void NTPClient::readNTPPacket() {
+  unsigned long receiveTime = millis(); // T4
+
+  if (this->_udp->read(this->_packetBuffer, NTP_PACKET_SIZE) < NTP_PACKET_SIZE) return;
+
+  byte leap = this->_packetBuffer[0] >> 6;
+  byte mode = this->_packetBuffer[0] & 0x07;
+  byte stratum = this->_packetBuffer[1];
+
+  // Ignore the unsynchronized server, kiss-o'-death and the non-server packets
+  if (leap == 3 || mode != 4 || stratum == 0 || stratum > 15) return;
+
+  unsigned long tag = readWord32(this->_packetBuffer + 28);
+  byte server = tag & 0xFF;
+  if ((tag & 0xFFFFFF00UL) != 0x4E545000UL || server > this->_serverCount || !(this->_sent & (1 << server)) || (this->_replied & (1 << server)))
+    return;
+
+  if (readWord32(this->_packetBuffer + 24) != (this->_sendTime[server] & 0xFFFFFFFFUL)) return; // response of the previous round
+
+  this->_replied |= 1 << server;
+
+  unsigned long long receiveEpochMs = ntpToEpochMs(this->_packetBuffer + 32);  // T2
+  unsigned long long transmitEpochMs = ntpToEpochMs(this->_packetBuffer + 40); // T3
+
+  long roundTrip = (long)(receiveTime - this->_sendTime[server]) - (long)(transmitEpochMs - receiveEpochMs);
+  if (roundTrip < 0) roundTrip = 0;
+
+  // Keep the sample with the lowest delay, the server time at T4 is T3 + delay / 2
+  if (!this->_hasSample || roundTrip < this->_sampleDelay) {
+    this->_hasSample     = true;
+    this->_sampleDelay   = roundTrip;
+    this->_sampleTime    = receiveTime;
+    this->_sampleEpochMs = transmitEpochMs + roundTrip / 2;
+  }
+}
+
+bool NTPClient::addServer(const char* serverName) {
+  if (this->_serverCount >= NTP_MAX_SERVERS - 1) return false;
+  this->_serverNames[this->_serverCount] = serverName;
+  this->_serverCount++;
+  return true;
+}
+
+bool NTPClient::addServer(IPAddress serverIP) {
+  if (this->_serverCount >= NTP_MAX_SERVERS - 1) return false;
+  this->_serverNames[this->_serverCount] = NULL;
+  this->_serverIPs[this->_serverCount] = serverIP;
+  this->_serverCount++;
+  return true;
+}
+
+void NTPClient::setUpdateTimeout(unsigned long timeout) {
+  this->_timeout = timeout;
+}
+
+long NTPClient::getLastOffset() const {
+  return this->_lastOffset;
+}
+
+long NTPClient::getLastDelay() const {
+  return this->_lastDelay;
 }
 
 void NTPClient::setRandomPort(unsigned int minValue, unsigned int maxValue) {
@@ -7,6 +7,14 @@
 #define SEVENZYYEARS 2208988800UL
 #define NTP_PACKET_SIZE 48
 #define NTP_DEFAULT_LOCAL_PORT 1337
+#define NTP_DEFAULT_TIMEOUT 1000
+#define NTP_RETRY_INTERVAL 5000
+#define NTP_MAX_SERVERS 4
+#define NTP_MAX_POLL_INTERVAL 1024000UL  // In ms
+#define NTP_STEP_THRESHOLD 500           // In ms
+#define NTP_MAX_DRIFT 500                // In ppm
+#define NTP_DISCIPLINE_TOLERANCE 20      // In ms
+#define NTP_DISCIPLINE_SAMPLES 8
 
 class NTPClient {
   private:
@@ -25,7 +33,47 @@ class NTPClient {
 
     byte          _packetBuffer[NTP_PACKET_SIZE];
 
-    void          sendNTPPacket();
+    // Additional servers, the requests are sent to all servers in each round
+    const char*   _serverNames[NTP_MAX_SERVERS - 1];
+    IPAddress     _serverIPs[NTP_MAX_SERVERS - 1];
+    byte          _serverCount    = 0;
+
+    unsigned long _timeout        = NTP_DEFAULT_TIMEOUT;  // In ms
+    unsigned long _lastAttempt    = 0;      // In ms
+
+    // State of the pending round
+    bool          _pending        = false;
+    byte          _sent           = 0;      // Bit mask of the servers requested
+    byte          _replied        = 0;      // Bit mask of the servers replied
+    unsigned long _sendTime[NTP_MAX_SERVERS];  // In ms
+
+    // The best sample (lowest delay) of the pending round
+    bool          _hasSample      = false;
+    unsigned long long _sampleEpochMs = 0;
+    unsigned long _sampleTime     = 0;      // In ms
+    long          _sampleDelay    = 0;      // In ms
+
+    long          _lastOffset     = 0;      // In ms
+    long          _lastDelay      = 0;      // In ms
+
+    // Clock discipline
+    bool          _discipline     = false;
+    float         _drift          = 0;      // In ppm, the local clock runs slow when positive
+    unsigned long _pollInterval   = 60000;  // In ms
+    unsigned long _maxPollInterval = NTP_MAX_POLL_INTERVAL;  // In ms
+
+    // The samples of the drift fit, the offsets are from the reference, the disciplined time of the last sample
+    byte          _samples        = 0;
+    unsigned long _sampleTimes[NTP_DISCIPLINE_SAMPLES];    // In ms
+    long          _sampleOffsets[NTP_DISCIPLINE_SAMPLES];  // In ms
+    unsigned long _refTime        = 0;      // In ms
+    unsigned long long _refEpochMs = 0;
+
+    unsigned long currentInterval() const;
+    unsigned long long discipline(bool timeSet);
+
+    bool          sendNTPPacket(byte server);
+    void          readNTPPacket();
 
   public:
     NTPClient(UDP& udp);
@@ -74,6 +122,72 @@ class NTPClient {
      */
     bool forceUpdate();
 
+    /**
+     * Sends the requests to the time server and the additional servers and returns immediately.
+     * Call poll() to receive the responses.
+     *
+     * @return true if the requests were sent, else false
+     */
+    bool beginUpdate();
+
+    /**
+     * This should be called in the main loop of your application instead of update() to never block it.
+     * It reads the responses of the pending requests without waiting and sets the time from the sample
+     * with the lowest round trip delay when all servers replied or the timeout has elapsed.
+     * A new update is started every update interval, a failed update is retried after NTP_RETRY_INTERVAL.
+     *
+     * @return true if the time has been set by this call, else false
+     */
+    bool poll();
+
+    /**
+     * @return true if the requests were sent and the responses are awaited
+     */
+    bool isUpdating() const;
+
+    /**
+     * Adds the time server that is requested together with the pool server in each update.
+     *
+     * @return true if added, false if NTP_MAX_SERVERS servers have been set
+     */
+    bool addServer(const char* serverName);
+    bool addServer(IPAddress serverIP);
+
+    /**
+     * Set the time to wait for the responses in ms, 1000 by default
+     */
+    void setUpdateTimeout(unsigned long timeout);
+
+    /**
+     * @return the clock offset in ms of the last update, the correction applied to the previous time
+     * computed from the originate, receive, transmit and destination timestamps, ((T2 - T1) + (T3 - T4)) / 2
+     */
+    long getLastOffset() const;
+
+    /**
+     * @return the round trip delay in ms of the last update, (T4 - T1) - (T3 - T2)
+     */
+    long getLastDelay() const;
+
+    /**
+     * Enables the clock discipline. The local oscillator drift and the time are estimated by the least
+     * squares fit of the last NTP_DISCIPLINE_SAMPLES updates, the drift corrects getEpochTime() and
+     * getEpochMillis() between the updates. The update interval
+     * is doubled up to maxInterval while the offsets stay within the measurement error and is reduced
+     * back to the update interval when they do not.
+     */
+    void setDiscipline(bool enable, unsigned long maxInterval = NTP_MAX_POLL_INTERVAL);
+
+    /**
+     * @return the estimated local clock drift in ppm
+     */
+    float getDrift() const;
+
+    /**
+     * @return the current update interval in ms
+     */
+    unsigned long getPollInterval() const;
+
     /**
      * This allows to check if the NTPClient successfully received a NTP packet and set the time.
      *
@@ -107,6 +221,11 @@ class NTPClient {
      */
     unsigned long getEpochTime() const;
 
+    /**
+     * @return time in milliseconds since Jan. 1, 1970
+     */
+    unsigned long long getEpochMillis() const;
+
     /**
      * Stops the underlying UDP client
      */
@@ -0,0 +1,48 @@
+#include <NTPClient.h>
+// change next line to use with another board/shield
+#include <ESP8266WiFi.h>
+//#include <WiFi.h> // for WiFi shield
+//#include <WiFi101.h> // for WiFi 101 shield or MKR1000
+#include <WiFiUdp.h>
+
+const char *ssid     = "<SSID>";
+const char *password = "<PASSWORD>";
+
+WiFiUDP ntpUDP;
+
+NTPClient timeClient(ntpUDP, "0.pool.ntp.org", 0, 60000);
+
+unsigned long lastPrint = 0;
+
+void setup(){
+  Serial.begin(115200);
+
+  WiFi.begin(ssid, password);
+
+  while ( WiFi.status() != WL_CONNECTED ) {
+    delay ( 500 );
+    Serial.print ( "." );
+  }
+
+  // The requests are sent to all servers and the response with the lowest delay is used
+  timeClient.addServer("1.pool.ntp.org");
+  timeClient.addServer("2.pool.ntp.org");
+
+  timeClient.begin();
+}
+
+void loop() {
+  // poll() never waits for the server, the loop keeps running while the update is in progress
+  if (timeClient.poll()) {
+    Serial.print("Updated, offset ");
+    Serial.print(timeClient.getLastOffset());
+    Serial.print(" ms, delay ");
+    Serial.print(timeClient.getLastDelay());
+    Serial.println(" ms");
+  }
+
+  if (timeClient.isTimeSet() && millis() - lastPrint >= 1000) {
+    lastPrint = millis();
+    Serial.println(timeClient.getFormattedTime());
+  }
+}
@@ -0,0 +1,258 @@
+/**
+ * The example to measure the throughput of the base64, quoted-printable and RFC2047 codecs
+ * that are used when sending and fetching the message.
+ *
+ * Each result is printed as one JSON line e.g.
+ * {"codec":"b64_enc","input":"binary","bytes":262144,"us":51234,"mbps":5.117,"allocs_per_mb":4.0}
+ * so the output of two runs can be compared for regressions.
+ *
+ * The allocations are the heap allocations counted by the host build (libraries/host) that
+ * runs this sketch as bench/readymail_codec_bench, they are 0 on the device.
+ */
+#include <Arduino.h>
+
+#define ENABLE_SMTP
+#define ENABLE_IMAP
+#include <ReadyMail.h>
+
+// The minimum number of bytes to process for each test
+#ifndef BENCH_MIN_BYTES
+#define BENCH_MIN_BYTES 256 * 1024
+#endif
+
+#define SAMPLE_SIZE 4096
+
+const char *text_line = "The quick brown fox jumps over the lazy dog. Pack my box with five dozen liquor jugs!\r\n";
+
+// UTF-8 text of mixed languages, mostly encoded by quoted-printable
+const char *mixed_line = "Grüße aus München, สวัสดีครับ, 你好世界, Привет! Temperature 23.5°C = OK\r\n";
+
+const char *html_line = "<p style=\"color:#333;font-family:sans-serif\">Sensor <b>#12</b> reported 23.5&deg;C at "
+                        "<a href=\"https://example.com/s?id=12&amp;t=now\">12:00</a></p>\r\n";
+
+// Non UTF-8 and mixed encoded-word headers
+const char *headers[] = {
+    "=?ISO-8859-1?Q?Andr=E9_Pirard?= <pirard@example.com>",
+    "=?windows-874?B?wNLJ0uTL6MfDpOPK6Ljl0q+hqbc=?=",
+    "=?UTF-8?B?4LiX4LiU4Liq4Lit4Lia4Lig4Liy4Lip4Liy4LmE4LiX4Lii?= =?UTF-8?Q?_and_more_text?=",
+    "Plain subject line without encoded word"};
+
+uint8_t *text_data = nullptr, *html_data = nullptr, *mixed_data = nullptr, *bin_data = nullptr;
+
+void fill(uint8_t *buf, const char *line)
+{
+    size_t len = strlen(line);
+    for (size_t i = 0; i < SAMPLE_SIZE; i++)
+        buf[i] = line[i % len];
+}
+
+void fillBinary(uint8_t *buf)
+{
+    // JPEG SOI and APP0 markers followed by the incompressible data
+    const uint8_t soi[] = {0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 'J', 'F', 'I', 'F', 0x00};
+    uint32_t x = 2463534242UL;
+    for (size_t i = 0; i < SAMPLE_SIZE; i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        buf[i] = i < sizeof(soi) ? soi[i] : (uint8_t)x;
+    }
+}
+
+// The number of heap allocations so far
+uint32_t allocCount()
+{
+#if defined(ARDUINO_HOST)
+    return host::heapStats().allocs;
+#else
+    return 0;
+#endif
+}
+
+void printResult(const char *codec, const char *input, size_t bytes, unsigned long us, uint32_t allocs)
+{
+    double mb = (double)bytes / (1024.0 * 1024.0);
+    String s;
+    s.reserve(160);
+    s += "{\"codec\":\"";
+    s += codec;
+    s += "\",\"input\":\"";
+    s += input;
+    s += "\",\"bytes\":";
+    s += bytes;
+    s += ",\"us\":";
+    s += us;
+    s += ",\"mbps\":";
+    s += String(us ? mb * 1000000.0 / us : 0, 3);
+    s += ",\"allocs_per_mb\":";
+    s += String(mb > 0 ? allocs / mb : 0, 1);
+    s += "}";
+    Serial.println(s);
+}
+
+void benchB64Encode(const char *input, const uint8_t *data)
+{
+    size_t bytes = 0;
+    uint32_t allocs = allocCount();
+    unsigned long ms = micros();
+    while (bytes < BENCH_MIN_BYTES)
+    {
+        char *enc = rd_b64_enc(data, SAMPLE_SIZE);
+        rd_free(&enc);
+        bytes += SAMPLE_SIZE;
+    }
+    printResult("b64_enc", input, bytes, micros() - ms, allocCount() - allocs);
+}
+
+void benchB64Decode(const char *input, const uint8_t *data)
+{
+    char *enc = rd_b64_enc(data, SAMPLE_SIZE);
+    size_t bytes = 0;
+    uint32_t allocs = allocCount();
+    unsigned long ms = micros();
+    while (bytes < BENCH_MIN_BYTES)
+    {
+        char *dec = rd_b64_dec(enc);
+        rd_free(&dec);
+        bytes += SAMPLE_SIZE;
+    }
+    printResult("b64_dec", input, bytes, micros() - ms, allocCount() - allocs);
+    rd_free(&enc);
+}
+
+// The streaming encoder with 76-column CRLF wrapped output, fed in odd sized chunks
+void benchB64WrapEncode(const char *input, const uint8_t *data)
+{
+    const size_t chunk = 1000;
+    uint8_t *out = rd_mem<uint8_t *>(rd_b64_enc_len(chunk + 2, true));
+    size_t bytes = 0;
+    uint32_t allocs = allocCount();
+    unsigned long ms = micros();
+    while (bytes < BENCH_MIN_BYTES)
+    {
+        rd_b64_enc_state st;
+        st.wrap = true;
+        for (size_t i = 0; i < SAMPLE_SIZE; i += chunk)
+            rd_b64_enc_update(st, data + i, SAMPLE_SIZE - i > chunk ? chunk : SAMPLE_SIZE - i, out);
+        rd_b64_enc_final(st, out);
+        bytes += SAMPLE_SIZE;
+    }
+    printResult("b64_wrap_enc", input, bytes, micros() - ms, allocCount() - allocs);
+    rd_free(&out);
+}
+
+// The line encoder that is used when sending the message body, mode 2 is quoted-printable and 3 is base64
+void benchLineEncode(const char *codec, const char *input, const uint8_t *data, int mode, bool flowed = false)
+{
+    size_t bytes = 0;
+    uint32_t allocs = allocCount();
+    unsigned long ms = micros();
+    while (bytes < BENCH_MIN_BYTES)
+    {
+        src_data_ctx src;
+        src.setSource(rd_cast<const char *>(data), SAMPLE_SIZE, src_data_static);
+        rd_line_enc_ctx ctx;
+        char line[RD_LINE_ENC_OUT_SIZE];
+        int index = 0;
+        while (index < SAMPLE_SIZE)
+            rd_qb_encode_chunk(src, index, mode, flowed, MAX_LINE_LEN, ctx, line);
+        bytes += SAMPLE_SIZE;
+    }
+    printResult(codec, input, bytes, micros() - ms, allocCount() - allocs);
+}
+
+void benchQPDecode(const char *input, const uint8_t *data)
+{
+    // Encode the sample once as the decoder input
+    String enc;
+    src_data_ctx src;
+    src.setSource(rd_cast<const char *>(data), SAMPLE_SIZE, src_data_static);
+    rd_line_enc_ctx ctx;
+    char line[RD_LINE_ENC_OUT_SIZE];
+    int index = 0;
+    while (index < SAMPLE_SIZE)
+        enc.concat(line, rd_qb_encode_chunk(src, index, 2 /* xenc_qp */, false, MAX_LINE_LEN, ctx, line));
+
+    char *out = rd_mem<char *>(enc.length() + 1, true);
+    size_t bytes = 0;
+    uint32_t allocs = allocCount();
+    unsigned long ms = micros();
+    while (bytes < BENCH_MIN_BYTES)
+    {
+        rd_dec_qp_utf8(enc.c_str(), out);
+        bytes += enc.length();
+    }
+    printResult("qp_dec", input, bytes, micros() - ms, allocCount() - allocs);
+    rd_free(&out);
+}
+
+void benchRFC2047Decode()
+{
+    QBDecoder decoder;
+    char out[256];
+    size_t bytes = 0;
+    uint32_t allocs = allocCount();
+    unsigned long ms = micros();
+    while (bytes < BENCH_MIN_BYTES / 4)
+    {
+        for (size_t i = 0; i < sizeof(headers) / sizeof(headers[0]); i++)
+        {
+            decoder.decode(out, headers[i], sizeof(out));
+            bytes += strlen(headers[i]);
+        }
+    }
+    printResult("rfc2047_dec", "header", bytes, micros() - ms, allocCount() - allocs);
+}
+
+void setup()
+{
+    Serial.begin(115200);
+#if !defined(ARDUINO_HOST)
+    delay(2000);
+#endif
+
+    text_data = rd_mem<uint8_t *>(SAMPLE_SIZE);
+    html_data = rd_mem<uint8_t *>(SAMPLE_SIZE);
+    mixed_data = rd_mem<uint8_t *>(SAMPLE_SIZE);
+    bin_data = rd_mem<uint8_t *>(SAMPLE_SIZE);
+
+    if (!text_data || !html_data || !mixed_data || !bin_data)
+    {
+        Serial.println("Out of memory");
+        return;
+    }
+
+    fill(text_data, text_line);
+    fill(html_data, html_line);
+    fill(mixed_data, mixed_line);
+    fillBinary(bin_data);
+
+    benchB64Encode("text", text_data);
+    benchB64Encode("binary", bin_data);
+    benchB64Decode("text", text_data);
+    benchB64Decode("binary", bin_data);
+    benchB64WrapEncode("binary", bin_data);
+
+    benchLineEncode("b64_line_enc", "binary", bin_data, 3 /* xenc_base64 */);
+    benchLineEncode("qp_line_enc", "text", text_data, 2 /* xenc_qp */);
+    benchLineEncode("qp_line_enc", "html", html_data, 2 /* xenc_qp */);
+    benchLineEncode("qp_line_enc", "mixed", mixed_data, 2 /* xenc_qp */);
+    benchLineEncode("qp_line_enc", "binary", bin_data, 2 /* xenc_qp */);
+    benchLineEncode("qp_flowed_enc", "text", text_data, 2 /* xenc_qp */, true);
+
+    benchQPDecode("text", text_data);
+    benchQPDecode("html", html_data);
+    benchQPDecode("mixed", mixed_data);
+
+    benchRFC2047Decode();
+
+    rd_free(&text_data);
+    rd_free(&html_data);
+    rd_free(&mixed_data);
+    rd_free(&bin_data);
+}
+
+void loop()
+{
+}
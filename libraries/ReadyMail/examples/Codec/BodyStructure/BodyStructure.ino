@@ -0,0 +1,121 @@
+/**
+ * The example to measure the BODYSTRUCTURE parser that finds the message parts (files)
+ * from the FETCH response.
+ *
+ * The responses below are in the styles of Gmail, Outlook and Dovecot servers,
+ * the last one is the deep multipart/mixed tree with many attachments.
+ *
+ * Each result is printed as one JSON line e.g.
+ * {"server":"gmail","bytes":597,"files":4,"us_per_parse":5.1,"allocs_per_parse":21.0}
+ * followed by the mime type and file name of each part.
+ */
+#include <Arduino.h>
+
+#define ENABLE_IMAP
+#include <ReadyMail.h>
+
+#ifndef BENCH_ROUNDS
+#define BENCH_ROUNDS 500
+#endif
+
+const char *gmail = "* 3 FETCH (FLAGS () INTERNALDATE \"17-Jul-2024 02:44:25 +0000\" RFC822.SIZE 900000 ENVELOPE (\"Wed, 17 Jul 2024 09:44:25 +0700\" \"Invoice\" ((\"Bob\" NIL \"bob\" \"gmail.com\")) ((\"Bob\" NIL \"bob\" \"gmail.com\")) ((\"Bob\" NIL \"bob\" \"gmail.com\")) ((NIL NIL \"alice\" \"example.com\")) NIL NIL NIL \"<CAB2@mail.gmail.com>\") "
+                    "BODY (((\"TEXT\" \"PLAIN\" (\"CHARSET\" \"UTF-8\") NIL NIL \"7BIT\" 54 2)(\"TEXT\" \"HTML\" (\"CHARSET\" \"UTF-8\") NIL NIL \"7BIT\" 124 2) \"ALTERNATIVE\")(\"APPLICATION\" \"PDF\" (\"NAME\" \"invoice-2024.pdf\") \"<f_lx1>\" NIL \"BASE64\" 124330)(\"IMAGE\" \"JPEG\" (\"NAME\" \"photo 1.jpg\") \"<ii_lx2>\" NIL \"BASE64\" 524288) \"MIXED\"))\r\n";
+
+const char *outlook = "* 4 FETCH (FLAGS (\\Seen) INTERNALDATE \"17-Jul-2024 02:44:25 +0000\" RFC822.SIZE 120000 ENVELOPE (\"Wed, 17 Jul 2024 02:44:25 +0000\" \"RE: Report\" ((\"Carol\" NIL \"carol\" \"outlook.com\")) ((\"Carol\" NIL \"carol\" \"outlook.com\")) ((\"Carol\" NIL \"carol\" \"outlook.com\")) ((NIL NIL \"alice\" \"example.com\")) NIL NIL \"<AM1@outlook.com>\" \"<AM2@outlook.com>\") "
+                      "BODY (((\"text\" \"plain\" (\"charset\" \"utf-8\") NIL NIL \"base64\" 2340 30)((\"text\" \"html\" (\"charset\" \"utf-8\") NIL NIL \"quoted-printable\" 9876 120)(\"image\" \"png\" (\"name\" \"image001.png\") \"<image001.png@01DA1234.5678ABCD>\" \"image001.png\" \"base64\" 23456) \"related\") \"alternative\")"
+                      "(\"application\" \"vnd.openxmlformats-officedocument.spreadsheetml.sheet\" (\"name\" \"=?utf-8?B?4Lij4Liy4Lii4LiH4Liy4LiZLnhsc3g=?=\") NIL \"=?utf-8?B?4Lij4Liy4Lii4LiH4Liy4LiZLnhsc3g=?=\" \"base64\" 45678) \"mixed\"))\r\n";
+
+const char *dovecot = "* 5 FETCH (FLAGS () INTERNALDATE \"17-Jul-2024 02:44:25 +0000\" RFC822.SIZE 3000 ENVELOPE (\"Wed, 17 Jul 2024 02:44:25 +0000\" \"Fwd: test\" ((\"Alice\" NIL \"alice\" \"example.com\")) ((\"Alice\" NIL \"alice\" \"example.com\")) ((\"Alice\" NIL \"alice\" \"example.com\")) ((NIL NIL \"bob\" \"example.org\")) NIL NIL NIL \"<f1@example.com>\") "
+                      "BODY ((\"text\" \"plain\" (\"charset\" \"utf-8\" \"format\" \"flowed\") NIL NIL \"8bit\" 320 10)(\"message\" \"rfc822\" (\"name\" \"Fwd.eml\") NIL NIL \"7bit\" 2048 (\"Mon, 7 Feb 1994 21:52:25 -0800\" \"test\" ((\"Eve\" NIL \"eve\" \"example.net\")) ((\"Eve\" NIL \"eve\" \"example.net\")) ((\"Eve\" NIL \"eve\" \"example.net\")) ((NIL NIL \"alice\" \"example.com\")) NIL NIL NIL \"<e1@example.net>\") "
+                      "((\"text\" \"plain\" (\"charset\" \"us-ascii\") NIL NIL \"7bit\" 120 4)(\"text\" \"html\" (\"charset\" \"us-ascii\") NIL NIL \"7bit\" 450 12) \"alternative\") 60) \"mixed\"))\r\n";
+
+IMAPParser parser;
+imap_context imap_ctx;
+
+// mixed(alternative(plain, related(html, images)), attachments)
+String deepTree(int count)
+{
+    String s = "* 9 FETCH (FLAGS () RFC822.SIZE 9 ENVELOPE (NIL \"deep\" NIL NIL NIL NIL NIL NIL NIL NIL) BODY (((\"text\" \"plain\" (\"charset\" \"utf-8\") NIL NIL \"quoted-printable\" 2000 40)((\"text\" \"html\" (\"charset\" \"utf-8\") NIL NIL \"quoted-printable\" 9000 100)";
+    for (int i = 0; i < count; i++)
+    {
+        s += "(\"image\" \"png\" (\"name\" \"img";
+        s += i;
+        s += ".png\") NIL NIL \"base64\" 12000)";
+    }
+    s += " \"related\") \"alternative\")";
+    for (int i = 0; i < count; i++)
+    {
+        s += "(\"application\" \"pdf\" (\"name\" \"doc";
+        s += i;
+        s += ".pdf\") NIL NIL \"base64\" 50000)";
+    }
+    s += " \"mixed\"))\r\n";
+    return s;
+}
+
+// The heap allocations, counted by the heap shim on the host only
+uint32_t allocCount()
+{
+#if defined(ARDUINO_HOST)
+    return host::heapStats().allocs;
+#else
+    return 0;
+#endif
+}
+
+void bench(const char *server, const String &line)
+{
+    size_t files = 0;
+    uint32_t allocs = allocCount();
+    unsigned long us = micros();
+    for (int i = 0; i < BENCH_ROUNDS; i++)
+    {
+        imap_msg_ctx cmsg;
+        parser.parseBodyStructure(&imap_ctx, line, cmsg);
+        files = cmsg.files.size();
+    }
+    us = micros() - us;
+    allocs = allocCount() - allocs;
+
+    String s;
+    s.reserve(128);
+    s += "{\"server\":\"";
+    s += server;
+    s += "\",\"bytes\":";
+    s += line.length();
+    s += ",\"files\":";
+    s += files;
+    s += ",\"us_per_parse\":";
+    s += String((float)us / BENCH_ROUNDS, 1);
+    s += ",\"allocs_per_parse\":";
+    s += String((float)allocs / BENCH_ROUNDS, 1);
+    s += "}";
+    Serial.println(s);
+
+    imap_msg_ctx cmsg;
+    parser.parseBodyStructure(&imap_ctx, line, cmsg);
+    for (size_t i = 0; i < cmsg.files.size(); i++)
+    {
+        Serial.print("  ");
+        Serial.print(cmsg.files[i].info.mime);
+        Serial.print(" ");
+        Serial.println(cmsg.files[i].info.filename);
+    }
+}
+
+void setup()
+{
+    Serial.begin(115200);
+#if !defined(ARDUINO_HOST)
+    delay(2000);
+#endif
+
+    bench("gmail", gmail);
+    bench("outlook", outlook);
+    bench("dovecot", dovecot);
+    bench("deep", deepTree(20));
+}
+
+void loop()
+{
+}
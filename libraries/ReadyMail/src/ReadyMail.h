@@ -57,6 +57,11 @@
 
 #define MAX_LINE_LEN 76
 
+// The default size of the buffer that the attachment lines are encoded into and sent at once
+#if !defined(READYMAIL_ATTACH_BUFFER_SIZE)
+#define READYMAIL_ATTACH_BUFFER_SIZE 4096
+#endif
+
 #define TCP_CLIENT_ERROR_INITIALIZE -1
 #define TCP_CLIENT_ERROR_CONNECTION -2
 #define TCP_CLIENT_ERROR_NOT_CONNECTED -3
@@ -33,45 +33,97 @@ public:
     bool valid = false, cid = false, nonascii = false;
     char c = 0;
     int index = 0;
+    // cached length of the string/static source
+    size_t len = 0;
+
+    // Set the string/static source and cache its length
+    void setSource(const char *str, size_t len, src_data_type type)
+    {
+        this->str = str;
+        this->len = str ? len : 0;
+        this->type = type;
+        index = 0;
+    }
+
     bool available()
     {
         if (type <= src_data_static)
-            return index < (int)size();
+            return index < (int)len;
 #if defined(ENABLE_FS)
         else if (fs)
             return fs.available();
 #endif
         return false;
     }
+
     size_t size()
     {
         if (type <= src_data_static)
-            return strlen(str);
+            return len;
 #if defined(ENABLE_FS)
         else if (fs)
             return fs.size();
 #endif
-        return false;
+        return 0;
     }
 
     char read()
     {
-        if (available())
+        if (type <= src_data_static)
         {
-            if (type <= src_data_static)
-            {
-                c = str[index];
-                index++;
-            }
+            if (index < (int)len)
+                c = str[index++];
+            else
+                return 0;
+        }
 #if defined(ENABLE_FS)
-            else if (fs)
-                c = fs.read();
+        else if (fs && fs.available())
+            c = fs.read();
 #endif
-            return c;
+        else
+            return 0;
+        return c;
+    }
+
+    // Read up to n bytes into buf, returns the number of bytes read
+    size_t read(uint8_t *buf, size_t n)
+    {
+        if (type <= src_data_static)
+        {
+            size_t remaining = index < (int)len ? len - index : 0;
+            if (n > remaining)
+                n = remaining;
+            memcpy(buf, str + index, n);
+            index += n;
+            return n;
+        }
+#if defined(ENABLE_FS)
+        else if (fs)
+            return fs.read(buf, n);
+#endif
+        return 0;
+    }
+
+    // Get the span of unread data without consuming it,
+    // only available for string/static source, returns 0 for file source
+    size_t peek(const char *&span)
+    {
+        span = nullptr;
+        if (type <= src_data_static && index < (int)len)
+        {
+            span = str + index;
+            return len - index;
         }
         return 0;
     }
 
+    // Consume n bytes that were previously peeked
+    void skip(size_t n)
+    {
+        if (type <= src_data_static)
+            index = index + n < len ? index + n : len;
+    }
+
     void close()
     {
 #if defined(ENABLE_FS)
@@ -91,8 +143,6 @@ public:
     }
 };
 
-static const unsigned char rd_b64_map[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
 static void __attribute__((used)) sys_yield()
 {
 #if defined(ARDUINO_ESP8266_MAJOR) && defined(ARDUINO_ESP8266_MINOR) && defined(ARDUINO_ESP8266_REVISION) && ((ARDUINO_ESP8266_MAJOR == 3 && ARDUINO_ESP8266_MINOR >= 1) || ARDUINO_ESP8266_MAJOR > 3)
@@ -114,70 +164,272 @@ static void rd_print_to(String &buff, int size, const char *format, ...)
     rd_free(&s);
 }
 
-static unsigned char rd_b64_lookup(char c)
-{
-    if (c >= 'A' && c <= 'Z')
-        return c - 'A';
-    if (c >= 'a' && c <= 'z')
-        return c - 71;
-    if (c >= '0' && c <= '9')
-        return c + 4;
-    if (c == '+')
-        return 62;
-    if (c == '/')
-        return 63;
-    return -1;
-}
+// The number of characters per line of wrapped base64 output (RFC 2045)
+#define RD_B64_LINE_LEN 76
+
+// The number of raw bytes per line of wrapped base64 output
+#define RD_B64_LINE_RAW_LEN 57
+
+#define RD_B64_PAD 0x40
+#define RD_B64_INVALID 0x80
+
+static const unsigned char rd_b64_map[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// The 6-bit values of the alphabet, RD_B64_PAD for '=' and RD_B64_INVALID for the others
+static const uint8_t rd_b64_dec_map[256] = {
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 62, 0x80, 0x80, 0x80, 63,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 0x80, 0x80, 0x80, 0x40, 0x80, 0x80,
+    0x80, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80};
+
+// base64 encoder state
+struct rd_b64_enc_state
+{
+    // the bytes of incomplete 3-byte group from previous input
+    uint8_t carry[3];
+    uint8_t carry_len = 0;
+    // the current output column, used when wrap is set
+    uint8_t col = 0;
+    // insert CRLF after every RD_B64_LINE_LEN characters
+    bool wrap = false;
+};
 
-static void rd_a4_to_a3(unsigned char *a3, unsigned char *a4)
+// base64 decoder state
+struct rd_b64_dec_state
 {
-    a3[0] = (a4[0] << 2) + ((a4[1] & 0x30) >> 4);
-    a3[1] = ((a4[1] & 0xf) << 4) + ((a4[2] & 0x3c) >> 2);
-    a3[2] = ((a4[2] & 0x3) << 6) + a4[3];
+    // the 6-bit values of incomplete 4-char group
+    uint32_t acc = 0;
+    uint8_t count = 0;
+    uint8_t pad = 0;
+    // the padded group was decoded, the rest of input is ignored
+    bool done = false;
+    // too many padding characters or the single character group
+    bool error = false;
+};
+
+// The maximum encoded length of len bytes including the CRLFs when wrap
+static inline size_t rd_b64_enc_len(size_t len, bool wrap)
+{
+    size_t olen = (len + 2) / 3 * 4;
+    if (wrap)
+        olen += (olen / RD_B64_LINE_LEN + 1) * 2;
+    return olen;
 }
 
-// base64 decoder
-static uint8_t *rd_b64_dec_impl(const char *encoded, int &size)
+// Encode the 3-byte group as the 32-bit word and write 4 characters
+static inline uint8_t *rd_b64_enc_group(const uint8_t *in, uint8_t *out)
 {
-    int encoded_len = strlen(encoded);
-    int decoded_len = (encoded_len * 3) / 4;
-    uint8_t *raw = rd_mem<uint8_t *>(decoded_len + 1);
-    int i = 0;
-    int raw_len = 0;
-    unsigned char a3[3];
-    unsigned char a4[4];
+    uint32_t v = ((uint32_t)in[0] << 16) | ((uint32_t)in[1] << 8) | in[2];
+    out[0] = rd_b64_map[v >> 18];
+    out[1] = rd_b64_map[(v >> 12) & 0x3f];
+    out[2] = rd_b64_map[(v >> 6) & 0x3f];
+    out[3] = rd_b64_map[v & 0x3f];
+    return out + 4;
+}
 
-    while (encoded_len--)
+static inline uint8_t *rd_b64_enc_put(rd_b64_enc_state &st, const uint8_t *in, uint8_t *out)
+{
+    out = rd_b64_enc_group(in, out);
+    if (st.wrap)
     {
-        if (*encoded == '=')
-            break;
+        st.col += 4;
+        if (st.col >= RD_B64_LINE_LEN)
+        {
+            *out++ = '\r';
+            *out++ = '\n';
+            st.col = 0;
+        }
+    }
+    return out;
+}
+
+// Streaming base64 encoder.
+// The data can be fed in any chunk size, the incomplete group is kept in state
+// until the next call or rd_b64_enc_final.
+// The out buffer should be at least rd_b64_enc_len(len + 2, st.wrap) bytes.
+// Returns the number of characters written.
+static inline size_t rd_b64_enc_update(rd_b64_enc_state &st, const uint8_t *in, size_t len, uint8_t *out)
+{
+    uint8_t *p = out;
 
-        a4[i++] = *(encoded++);
-        if (i == 4)
+    if (st.carry_len > 0)
+    {
+        while (st.carry_len < 3 && len > 0)
         {
-            for (i = 0; i < 4; i++)
-                a4[i] = rd_b64_lookup(a4[i]);
+            st.carry[st.carry_len++] = *in++;
+            len--;
+        }
+
+        if (st.carry_len < 3)
+            return 0;
 
-            rd_a4_to_a3(a3, a4);
-            for (i = 0; i < 3; i++)
-                raw[raw_len++] = a3[i];
-            i = 0;
+        p = rd_b64_enc_put(st, st.carry, p);
+        st.carry_len = 0;
+    }
+
+    // whole lines
+    if (st.wrap)
+    {
+        while (st.col == 0 && len >= RD_B64_LINE_RAW_LEN)
+        {
+            for (int i = 0; i < RD_B64_LINE_RAW_LEN; i += 3)
+                p = rd_b64_enc_group(in + i, p);
+            *p++ = '\r';
+            *p++ = '\n';
+            in += RD_B64_LINE_RAW_LEN;
+            len -= RD_B64_LINE_RAW_LEN;
         }
     }
 
-    if (i)
+    while (len >= 3)
+    {
+        p = rd_b64_enc_put(st, in, p);
+        in += 3;
+        len -= 3;
+    }
+
+    while (len > 0)
+    {
+        st.carry[st.carry_len++] = *in++;
+        len--;
+    }
+
+    return p - out;
+}
+
+// Encode the remaining incomplete group with padding.
+// No CRLF is added after the last incomplete line.
+// Returns the number of characters written (0 or 4).
+static inline size_t rd_b64_enc_final(rd_b64_enc_state &st, uint8_t *out)
+{
+    if (st.carry_len == 0)
+        return 0;
+
+    uint8_t b[3] = {st.carry[0], (uint8_t)(st.carry_len > 1 ? st.carry[1] : 0), 0};
+    rd_b64_enc_group(b, out);
+    out[3] = '=';
+    if (st.carry_len == 1)
+        out[2] = '=';
+
+    st.col += 4;
+    st.carry_len = 0;
+    return 4;
+}
+
+static inline uint8_t *rd_b64_dec_group(rd_b64_dec_state &st, uint8_t *out)
+{
+    uint32_t v = st.acc;
+    st.acc = 0;
+    st.count = 0;
+
+    if (st.pad > 2)
+    {
+        st.error = true;
+        st.done = true;
+        return out;
+    }
+
+    *out++ = v >> 16;
+    if (st.pad < 2)
+        *out++ = (v >> 8) & 0xff;
+    if (st.pad < 1)
+        *out++ = v & 0xff;
+
+    st.done = st.pad > 0;
+    return out;
+}
+
+// Streaming base64 decoder.
+// The characters outside the alphabet e.g. CRLF are skipped and the input
+// after the padded group is ignored.
+// The out buffer should be at least (len + 3) / 4 * 3 bytes.
+// Returns the number of bytes written.
+static inline size_t rd_b64_dec_update(rd_b64_dec_state &st, const uint8_t *in, size_t len, uint8_t *out)
+{
+    uint8_t *p = out;
+    const uint8_t *end = in + len;
+
+    while (in < end && !st.done)
     {
-        for (int j = i; j < 4; j++)
-            a4[j] = '\0';
+        // complete groups without padding
+        if (st.count == 0)
+        {
+            while (end - in >= 4)
+            {
+                uint8_t a = rd_b64_dec_map[in[0]], b = rd_b64_dec_map[in[1]];
+                uint8_t c = rd_b64_dec_map[in[2]], d = rd_b64_dec_map[in[3]];
+
+                if ((a | b | c | d) & 0xc0)
+                    break;
+
+                uint32_t v = ((uint32_t)a << 18) | ((uint32_t)b << 12) | ((uint32_t)c << 6) | d;
+                p[0] = v >> 16;
+                p[1] = (v >> 8) & 0xff;
+                p[2] = v & 0xff;
+                p += 3;
+                in += 4;
+            }
 
-        for (int j = 0; j < 4; j++)
-            a4[j] = rd_b64_lookup(a4[j]);
+            if (in == end)
+                break;
+        }
 
-        rd_a4_to_a3(a3, a4);
+        uint8_t v = rd_b64_dec_map[*in++];
 
-        for (int j = 0; j < i - 1; j++)
-            raw[raw_len++] = a3[j];
+        if (v & RD_B64_INVALID)
+            continue;
+
+        if (v == RD_B64_PAD)
+        {
+            st.pad++;
+            v = 0;
+        }
+
+        st.acc = (st.acc << 6) | v;
+        if (++st.count == 4)
+            p = rd_b64_dec_group(st, p);
     }
+
+    return p - out;
+}
+
+// Decode the remaining incomplete group as it was padded.
+// Returns the number of bytes written.
+static inline size_t rd_b64_dec_final(rd_b64_dec_state &st, uint8_t *out)
+{
+    if (st.done || st.count == 0)
+        return 0;
+
+    while (st.count < 4)
+    {
+        st.acc <<= 6;
+        st.count++;
+        st.pad++;
+    }
+
+    return rd_b64_dec_group(st, out) - out;
+}
+
+// base64 decoder
+static uint8_t *rd_b64_dec_impl(const char *encoded, int &size)
+{
+    int encoded_len = strlen(encoded);
+    uint8_t *raw = rd_mem<uint8_t *>((encoded_len + 3) / 4 * 3 + 1);
+    rd_b64_dec_state st;
+    size_t raw_len = rd_b64_dec_update(st, rd_cast<const uint8_t *>(encoded), encoded_len, raw);
+    raw_len += rd_b64_dec_final(st, raw + raw_len);
     size = raw_len;
     return raw;
 }
@@ -191,262 +443,289 @@ static char *rd_b64_dec(const char *encoded)
     return raw;
 }
 
+// base64 encoder that writes to the provided buffer
+// and returns the encoded length (without null terminator)
+static inline int rd_b64_enc_to(char *encoded, const unsigned char *raw, int len)
+{
+    rd_b64_enc_state st;
+    uint8_t *out = rd_cast<uint8_t *>(encoded);
+    size_t c = rd_b64_enc_update(st, raw, len, out);
+    return c + rd_b64_enc_final(st, out + c);
+}
+
 // base64 encoder
 static char *rd_b64_enc(const unsigned char *raw, int len)
 {
-    uint8_t count = 0;
-    char buffer[3];
     char *encoded = rd_mem<char *>(len * 4 / 3 + 4);
-    int c = 0;
-    for (int i = 0; i < len; i++)
-    {
-        buffer[count++] = raw[i];
-        if (count == 3)
-        {
-            encoded[c++] = rd_b64_map[buffer[0] >> 2];
-            encoded[c++] = rd_b64_map[((buffer[0] & 0x03) << 4) + (buffer[1] >> 4)];
-            encoded[c++] = rd_b64_map[((buffer[1] & 0x0f) << 2) + (buffer[2] >> 6)];
-            encoded[c++] = rd_b64_map[buffer[2] & 0x3f];
-            count = 0;
-        }
-    }
-    if (count > 0)
+    encoded[rd_b64_enc_to(encoded, raw, len)] = '\0';
+    return encoded;
+}
+
+// The number of 76-column lines with CRLF that fit in the buffer
+static inline int rd_b64_lines(int size) { return size / (RD_B64_LINE_LEN + 2); }
+
+// base64 line encoder that works in place.
+// The raw data (len bytes, len <= lines * 57) should be placed at
+// the end of buf (offset = size - lines * 57, where lines = rd_b64_lines(size)).
+// Each 57-byte group is encoded to the 76-column line with CRLF from the beginning of buf.
+// The write position never reaches the unread data because each line only grows by 21 bytes
+// and each 3-byte group is read before its 4 characters are written.
+// Returns the encoded length.
+static inline int rd_b64_enc_lines(uint8_t *buf, int offset, int len)
+{
+    rd_b64_enc_state st;
+    st.wrap = true;
+    int out = rd_b64_enc_update(st, buf + offset, len, buf);
+    out += rd_b64_enc_final(st, buf + out);
+    if (st.col > 0)
     {
-        encoded[c++] = rd_b64_map[buffer[0] >> 2];
-        if (count == 1)
-        {
-            encoded[c++] = rd_b64_map[(buffer[0] & 0x03) << 4];
-            encoded[c++] = '=';
-        }
-        else if (count == 2)
-        {
-            encoded[c++] = rd_b64_map[((buffer[0] & 0x03) << 4) + (buffer[1] >> 4)];
-            encoded[c++] = rd_b64_map[(buffer[1] & 0x0f) << 2];
-        }
-        encoded[c++] = '=';
+        buf[out++] = '\r';
+        buf[out++] = '\n';
     }
-    encoded[c] = '\0';
-    return encoded;
+    return out;
 }
 
 #if defined(ENABLE_SMTP)
 
-// soft break modifier
-static bool rd_add_sb(String &buf, int index, std::vector<int> &softbreak_index, String &softbreak_buf, int line_max_len)
+// msg data source checking 
+// for cid (inline attachment) and non-ascii (encoding applicable)
+static void rd_src_check(src_data_ctx &src)
 {
-    for (size_t i = 0; i < softbreak_index.size(); i++)
+    char c[4];
+    for (int i = 0; i < 4; i++)
+        c[i] = 0;
+
+    uint8_t buf[64];
+    while (!src.cid || !src.nonascii)
     {
-        if ((index == softbreak_index[i]))
+        // scan the string/static source in place, file source in blocks
+        const char *span = nullptr;
+        size_t n = src.peek(span);
+        if (n > 0)
+            src.skip(n);
+        else
         {
-            softbreak_index.erase(softbreak_index.begin() + i);
-            if ((int)buf.length() + 2 <= line_max_len)
-                buf += "\r\n"; // to complete soft break
-            else if ((int)buf.length() + 1 <= line_max_len)
-            {
-                buf += "\r";
-                softbreak_buf = "\n";
-            }
-            else
-                softbreak_buf = "\r\n";
-            return true;
+            n = src.read(buf, sizeof(buf));
+            span = rd_cast<const char *>(buf);
         }
-        else if (index == -1 * softbreak_index[i])
+
+        if (n == 0)
+            break;
+
+        for (size_t i = 0; i < n; i++)
         {
-            softbreak_index.erase(softbreak_index.begin() + i);
-            return true;
+            unsigned char v = (unsigned char)span[i];
+            if (v > 127)
+                src.nonascii = true;
+
+            c[3] = c[2];
+            c[2] = c[1];
+            c[1] = c[0];
+            c[0] = v;
+
+            if (c[3] == 'c' && c[2] == 'i' && c[1] == 'd' && c[0] == ':')
+                src.cid = true;
+
+            if (src.cid && src.nonascii)
+                break;
         }
     }
-    return false;
+    src.close();
 }
 
-// soft break marking
-static void rd_get_sb(src_data_ctx &src, int index, int max_len, std::vector<int> &softbreak_index)
+// The size of the look-ahead buffer of the line encoder,
+// it should hold at least RD_LINE_ENC_MAX_LEN + 3 bytes
+#define RD_LINE_ENC_BUF_SIZE 128
+
+// The maximum line length that the line encoder accepts (RFC 3676)
+#define RD_LINE_ENC_MAX_LEN 78
+
+// The minimum size of the output buffer of the line encoder
+#define RD_LINE_ENC_OUT_SIZE 160
+
+static const char rd_hex_map[17] = "0123456789ABCDEF";
+
+// line encoder context that keeps the data read ahead from the source
+// and the base64 state between calls
+struct rd_line_enc_ctx
 {
-    int last_index = softbreak_index.size() ? softbreak_index[softbreak_index.size() - 1] + 1 : index;
+    uint8_t buf[RD_LINE_ENC_BUF_SIZE];
+    int head = 0, tail = 0;
+    // the source was positioned at the start index
+    bool started = false;
+    rd_b64_enc_state b64;
 
-    // conver index to positive
-    if (last_index < 0)
-        last_index = -1 * last_index;
+    rd_line_enc_ctx() { b64.wrap = true; }
 
-    int i = last_index + max_len;
-    if (i < (int)src.size())
+    void clear()
+    {
+        head = 0;
+        tail = 0;
+        started = false;
+        b64 = rd_b64_enc_state();
+        b64.wrap = true;
+    }
+};
+
+// Read the source sequentially to keep at least min bytes in the look-ahead buffer.
+// The source is only positioned (seek) once at the first call.
+static void rd_line_enc_fill(src_data_ctx &src, int index, rd_line_enc_ctx &ctx, int min)
+{
+    if (!ctx.started)
     {
         src.seek(index);
-        bool softbreak = false;
-        bool hardbreak = false;
-        int sbPos = 0;
-        char c1 = 0;
-        while (src.available() && i >= last_index)
-        {
-            src.seek(i);
-            char c = src.read();
-            if (c == ' ' && i + 2 <= last_index + max_len)
-            {
-                if (!softbreak)
-                {
-                    softbreak = true;
-                    sbPos = i;
-                }
-            }
+        ctx.started = true;
+    }
 
-            // hard break? store keep index as the negative index
-            if (!hardbreak && c1 == '\n')
-            {
-                sbPos = -1 * (i + 2);
-                hardbreak = true;
-                break;
-            }
+    if (ctx.tail - ctx.head >= min)
+        return;
 
-            c1 = c;
-            i--;
-        }
+    if (ctx.head > 0)
+    {
+        memmove(ctx.buf, ctx.buf + ctx.head, ctx.tail - ctx.head);
+        ctx.tail -= ctx.head;
+        ctx.head = 0;
+    }
 
-        if (softbreak || hardbreak)
-            softbreak_index.push_back(sbPos);
+    while (ctx.tail < RD_LINE_ENC_BUF_SIZE && src.available())
+    {
+        size_t n = src.read(ctx.buf + ctx.tail, RD_LINE_ENC_BUF_SIZE - ctx.tail);
+        if (n == 0)
+            break;
+        ctx.tail += n;
     }
 }
 
-// quoted-printable encoder
-static String rd_qp_encode_chunk(src_data_ctx &src, int &index, bool flowed, int max_len, String &softbreak_buf, std::vector<int> &softbreak_index)
+// Encode one text line from the look-ahead buffer as quoted-printable (qp) or as is.
+// The line ends at the hard line break which is written as CRLF, or before the character that
+// exceeds max_len with the soft break, that is CRLF after the last space for flowed text,
+// or "=" CRLF for quoted-printable text.
+// Returns the output length and sets consumed to the number of source bytes used.
+static int rd_line_enc_text(rd_line_enc_ctx &ctx, bool qp, bool flowed, int max_len, bool eof, char *out, int &consumed)
 {
-    String sbuf;
-    int sindex = 0;
-    char *out = rd_mem<char *>(10);
-
-    // Breaks the string at sp with soft linebreak for flowed text
-    if (flowed)
+    const uint8_t *p = ctx.buf + ctx.head;
+    int avail = ctx.tail - ctx.head;
+    int i = 0, o = 0;
+    // the source and output positions after the last space
+    int sp_i = 0, sp_o = 0;
+    // reserve the column for "=" of quoted-printable soft break
+    int limit = qp ? max_len - 1 : max_len;
+
+    while (i < avail)
     {
-        rd_get_sb(src, index, max_len, softbreak_index);
-        if (softbreak_buf.length())
-            sbuf += softbreak_buf;
-        softbreak_buf.remove(0, softbreak_buf.length());
-    }
+        uint8_t c = p[i];
+        if (c == '\n' || (c == '\r' && i + 1 < avail && p[i + 1] == '\n'))
+        {
+            i += c == '\r' ? 2 : 1;
+            out[o++] = '\r';
+            out[o++] = '\n';
+            consumed = i;
+            return o;
+        }
 
-    src.seek(index);
-    int c1 = 0;
-    while (src.available() || c1 > 0)
-    {
-        int c = c1 == 0 ? src.read() : c1;
-        c1 = src.available() ? src.read() : 0;
-        if ((int)sbuf.length() >= max_len - 3 && c != 10 && c != 13)
+        int w = 1;
+        if (qp)
         {
-            sbuf += "=\r\n";
-            goto out;
+            // the trailing space before the line break or at the end of data should be encoded
+            bool trailing = c == ' ' && (i + 1 < avail ? (p[i + 1] == '\r' || p[i + 1] == '\n') : eof);
+            if (c < 32 || c == '=' || c > 126 || trailing)
+                w = 3;
         }
 
-        if (c == 10 || c == 13)
-            sbuf += (char)c;
-        else if (c < 32 || c == 61 || c > 126)
+        if (o + w > limit)
+            break;
+
+        if (w == 3)
         {
-            memset(out, 0, 10);
-            sprintf(out, "=%02X", (unsigned char)c);
-            sbuf += out;
+            out[o++] = '=';
+            out[o++] = rd_hex_map[c >> 4];
+            out[o++] = rd_hex_map[c & 0x0f];
         }
-        else if (c != 32 || (c1 != 10 && c1 != 13))
-            sbuf += (char)c;
         else
-            sbuf += "=20";
+            out[o++] = c;
 
-        if (flowed && rd_add_sb(sbuf, index + sindex, softbreak_index, softbreak_buf, max_len - 3))
+        i++;
+        if (flowed && c == ' ')
         {
-            sindex++; // skip space after soft break
-            break;
+            sp_i = i;
+            sp_o = o;
         }
-        sindex++;
     }
-out:
-    if (out)
-        rd_free(&out);
-    index += sindex;
-    return sbuf;
-}
-
-// msg data source checking 
-// for cid (inline attachment) and non-ascii (encoding applicable)
-static void rd_src_check(src_data_ctx &src)
-{
-    char c[4];
-    for (int i = 0; i < 4; i++)
-        c[i] = 0;
 
-    while (src.available())
+    // the line is full
+    if (i < avail)
     {
-        unsigned char v = (unsigned char)src.read();
-        if (v > 127)
-            src.nonascii = true;
-
-        c[3] = c[2];
-        c[2] = c[1];
-        c[1] = c[0];
-        c[0] = v;
-
-        if (c[3] == 'c' && c[2] == 'i' && c[1] == 'd' && c[0] == ':')
-            src.cid = true;
-
-        if (src.cid && src.nonascii)
-            break;
+        if (flowed && sp_i > 0)
+        {
+            i = sp_i;
+            o = sp_o;
+        }
+        else if (qp)
+            out[o++] = '=';
+        out[o++] = '\r';
+        out[o++] = '\n';
     }
-    src.close();
+    consumed = i;
+    return o;
 }
 
-// quoted-printable and base64 encoder
-static String rd_qb_encode_chunk(src_data_ctx &src, int &index, int mode, bool flowed, int max_len, String &softbreak_buf, std::vector<int> &softbreak_index)
+// quoted-printable, base64 and 7bit (flowed) line encoder.
+// The text without transfer encoding and 8bit text are line limited as well, the lines
+// longer than max_len are broken and the bare LF becomes CRLF (rfc5321 section 4.5.3.1.6).
+// The binary data and the non flowed 7bit text are sent as is.
+// The source is read sequentially through the look-ahead buffer of ctx.
+// The encoded data is written to out (RD_LINE_ENC_OUT_SIZE bytes at least)
+// and index is advanced by the number of source bytes consumed.
+// Returns the output length, the output can be empty while the base64 group is incomplete.
+static int rd_qb_encode_chunk(src_data_ctx &src, int &index, int mode, bool flowed, int max_len, rd_line_enc_ctx &ctx, char *out)
 {
-    String line, buf;
-    buf.reserve(100);
-    line.reserve(100);
-    int len = src.size();
-    if (mode == 2 /* xenc_qp */)
-        line = rd_qp_encode_chunk(src, index, flowed, max_len, softbreak_buf, softbreak_index);
-    else
+    if (max_len > RD_LINE_ENC_MAX_LEN)
+        max_len = RD_LINE_ENC_MAX_LEN;
+
+    rd_line_enc_fill(src, index, ctx, max_len + 3);
+
+    bool eof = !src.available();
+    int avail = ctx.tail - ctx.head;
+    int consumed = 0, len = 0;
+
+    if (mode == 2 /* xenc_qp */ || (mode == 1 /* xenc_7bit */ && flowed) || mode == 0 /* xenc_none */ || mode == 4 /* xenc_8bit */)
+        len = rd_line_enc_text(ctx, mode == 2, flowed, max_len, eof, out, consumed);
+    else if (mode == 3 /* xenc_base64 */)
     {
-        // Breaks the string at sp with soft linebreak for flowed text
+        const uint8_t *raw = ctx.buf + ctx.head;
+        char text[RD_LINE_ENC_MAX_LEN + 3];
+        int n = 0;
         if (flowed)
         {
-            rd_get_sb(src, index, max_len, softbreak_index);
-            if (softbreak_buf.length())
-                buf += softbreak_buf;
-            softbreak_buf.remove(0, softbreak_buf.length());
+            n = rd_line_enc_text(ctx, false, true, max_len, eof, text, consumed);
+            raw = rd_cast<const uint8_t *>(text);
         }
+        else
+            n = consumed = avail < RD_B64_LINE_RAW_LEN ? avail : RD_B64_LINE_RAW_LEN;
 
-        src.seek(index);
-        int sindex = 0;
-        while (src.available())
-        {
-            if ((int)buf.length() < (mode == 3 /* xenc_base64 */ ? 57 : max_len))
-            {
-                buf += src.read();
-                if (flowed && rd_add_sb(buf, index + sindex, softbreak_index, softbreak_buf, (mode == 3 /* xenc_base64 */ ? 57 : max_len)))
-                {
-                    sindex++; // skip space after soft break
-                    if (mode != 3 /* xenc_base64 */)
-                        break;
-                }
-                else
-                    sindex++;
-                continue;
-            }
-            break;
-        }
+        uint8_t *p = rd_cast<uint8_t *>(out);
+        len = rd_b64_enc_update(ctx.b64, raw, n, p);
 
-        if (buf.length())
+        if (eof && consumed == avail)
         {
-            if (mode == 3 /* xenc_base64 */)
+            len += rd_b64_enc_final(ctx.b64, p + len);
+            if (ctx.b64.col > 0)
             {
-                char *enc = rd_b64_enc(rd_cast<const unsigned char *>(buf.c_str()), buf.length());
-                line = enc;
-                rd_free(&enc);
+                out[len++] = '\r';
+                out[len++] = '\n';
+                ctx.b64.col = 0;
             }
-            else
-                line = buf;
-
-            if (mode != 1 /* xenc_7bit */)
-                line += "\r\n";
-
-            index = sindex > 0 ? index + sindex : len;
         }
     }
-    return line;
+    else
+    {
+        len = consumed = avail < max_len ? avail : max_len;
+        memcpy(out, ctx.buf + ctx.head, len);
+    }
+
+    ctx.head += consumed;
+    index += consumed;
+    return len;
 }
 
 #endif
@@ -484,7 +763,7 @@ static String rd_enc_plain(const String &email, const String &password)
 }
 
 #if defined(READYMAIL_USE_STRSEP_IMPL)
-static char *rd_strsep(char **stringp, const char *delim)
+static inline char *rd_strsep(char **stringp, const char *delim)
 {
     char *rv = *stringp;
     if (rv)
@@ -498,7 +777,7 @@ static char *rd_strsep(char **stringp, const char *delim)
     return rv;
 }
 #else
-static char *rd_strsep(char **stringp, const char *delim) { return strsep(stringp, delim); }
+static inline char *rd_strsep(char **stringp, const char *delim) { return strsep(stringp, delim); }
 #endif
 
 #if defined(ENABLE_IMAP)
@@ -555,11 +834,12 @@ static void rd_dec_tis620_utf8(char *out, const char *in, size_t len)
     int j = 0;
     for (size_t i = 0; i < len; i++)
     {
-        if (in[i] < 0x80)
+        uint8_t c = (uint8_t)in[i];
+        if (c < 0x80)
             out[j++] = in[i];
-        else if ((in[i] >= 0xa0 && in[i] < 0xdb) || (in[i] > 0xde && in[i] < 0xfc))
+        else if ((c >= 0xa0 && c < 0xdb) || (c > 0xde && c < 0xfc))
         {
-            int unicode = 0x0e00 + in[i] - 0xa0;
+            int unicode = 0x0e00 + c - 0xa0;
             char o[5];
             memset(o, 0, 5);
             int r = rd_encode_unicode_utf8(o, unicode);
@@ -608,7 +888,7 @@ static char *rd_dec_7bit_utf8(const char *src)
 
     for (size_t i = 0; i < len; i++)
     {
-        if (src[i] > 0 && src[i] < 128)
+        if ((uint8_t)src[i] > 0 && (uint8_t)src[i] < 128)
             buf += src[i];
     }
 
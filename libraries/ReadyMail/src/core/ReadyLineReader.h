@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef READY_LINE_READER_H
+#define READY_LINE_READER_H
+
+#include <Arduino.h>
+#include <Client.h>
+#include "QBDecoder.h"
+
+#if defined(ENABLE_IMAP) || defined(ENABLE_SMTP)
+
+#if !defined(READYMAIL_READ_BUFFER_SIZE)
+#define READYMAIL_READ_BUFFER_SIZE 1024
+#endif
+
+// Block-buffered line reader.
+// The client is read in blocks into the internal buffer and the lines
+// are handed out as the views into that buffer.
+class ReadyLineReader
+{
+private:
+    uint8_t *buf = nullptr;
+    size_t head = 0, tail = 0;
+
+    // Move the unread data to the front and fill the rest from client
+    int fill(Client *client)
+    {
+        if (head > 0)
+        {
+            memmove(buf, buf + head, tail - head);
+            tail -= head;
+            head = 0;
+        }
+
+        int avail = client->available();
+        if (avail <= 0 || tail == READYMAIL_READ_BUFFER_SIZE)
+            return 0;
+
+        size_t len = READYMAIL_READ_BUFFER_SIZE - tail;
+        if ((size_t)avail < len)
+            len = avail;
+
+        int read = client->read(buf + tail, len);
+        if (read > 0)
+            tail += read;
+        return read;
+    }
+
+    // Find the line end (LF) or the space at or after limit,
+    // returns the length up to and including the terminator
+    // or all buffered data when terminator was not found.
+    size_t scan(size_t limit, bool &eol)
+    {
+        size_t len = tail - head;
+        const uint8_t *p = buf + head;
+        const uint8_t *lf = rd_cast<const uint8_t *>(memchr(p, '\n', len));
+        size_t end = lf ? lf - p : len;
+
+        if (limit > 0 && end >= limit)
+        {
+            const uint8_t *sp = rd_cast<const uint8_t *>(memchr(p + limit - 1, ' ', end - limit + 1));
+            if (sp)
+                lf = sp;
+        }
+
+        eol = lf != nullptr;
+        return lf ? lf - p + 1 : len;
+    }
+
+public:
+    ReadyLineReader() {}
+    ~ReadyLineReader() { rd_free(&buf); }
+
+    /** Read the next line segment as a view into the internal buffer.
+     *
+     * @param client The client to read.
+     * @param view The pointer to the segment data. It is valid until the next read.
+     * @param limit The number of bytes after which a space also ends the line, 0 for no limit.
+     * @param eol Set when the segment ends the line.
+     * @return The segment length, 0 when no data is available and -1 for the memory allocation error.
+     */
+    int read(Client *client, const char *&view, size_t limit, bool &eol)
+    {
+        eol = false;
+        if (!buf)
+        {
+            buf = rd_mem<uint8_t *>(READYMAIL_READ_BUFFER_SIZE);
+            if (!buf)
+                return -1;
+        }
+
+        size_t len = head < tail ? scan(limit, eol) : 0;
+        if (!eol)
+        {
+            fill(client);
+            len = head < tail ? scan(limit, eol) : 0;
+        }
+
+        view = rd_cast<const char *>(buf + head);
+        head += len;
+        return len;
+    }
+
+    /** Read the line into String.
+     *
+     * @param client The client to read.
+     * @param line The String to append the line to.
+     * @param limit The number of bytes after which a space also ends the line, 0 for no limit.
+     * @return The number of bytes appended or -1 for the memory allocation error.
+     */
+    int readLine(Client *client, String &line, size_t limit = 0)
+    {
+        int p = 0;
+        bool eol = false;
+        while (!eol)
+        {
+            const char *view = nullptr;
+            int len = read(client, view, limit == 0 ? 0 : (limit > (size_t)p ? limit - p : 1), eol);
+            if (len <= 0)
+                return len < 0 && p == 0 ? -1 : p;
+            line.concat(view, len);
+            p += len;
+        }
+        return p;
+    }
+
+    // The number of bytes that are buffered but not read
+    size_t available() const { return tail - head; }
+
+    // Discard the buffered data e.g. when connection was closed or upgraded
+    void clear() { head = tail = 0; }
+};
+
+#endif
+#endif
@@ -26,6 +26,9 @@
 
 #define DEFAULT_IDLE_TIMEOUT 8 * 60 * 1000
 
+// The maximum nesting level of the body parts to parse
+#define IMAP_MAX_BODY_DEPTH 16
+
 using namespace ReadyMailCallbackNS;
 
 namespace ReadyMailIMAP
@@ -335,21 +338,29 @@ namespace ReadyMailIMAP
         bool use_auto_client = false;
     };
 
-    // body part field item
-    struct body_part_field
+    // BODYSTRUCTURE token types
+    enum imap_token_type
+    {
+        imap_token_end,
+        imap_token_atom,
+        imap_token_string,
+        imap_token_list
+    };
+
+    // token position in the response line
+    struct imap_span
     {
-        String token;
-        int depth = 0;
-        int index = 0;
+        int pos = 0, len = 0;
+        imap_token_type type = imap_token_end;
     };
 
-    // body part context
+    // non-multipart body part context, the fields are the spans in the response line
     struct part_ctx
     {
-        std::vector<body_part_field> field;
-        String name, section, id, parent_id;
-        uint8_t num_specifier = 0, part_count = 0;
-        int depth = 0, field_index = 0;
+        String section;
+        imap_span field[non_multipart_field_max_type];
+        // the body of message/rfc822 part
+        imap_span message;
     };
 
     struct imap_file_info
@@ -341,6 +341,8 @@ namespace ReadyMailIMAP
 #if defined(ENABLE_DEBUG)
                 setDebugState(imap_state_start_tls, "Performing TLS handshake...");
 #endif
+                // The plain text data that was received before upgrade must not be used
+                res->reader.clear();
 #if defined(ENABLE_READYCLIENT)
                 if (imap_ctx->auto_client && imap_ctx->options.use_auto_client)
                     imap_ctx->server_status->secured = imap_ctx->auto_client->connectSSL();
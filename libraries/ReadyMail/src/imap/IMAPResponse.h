@@ -14,6 +14,7 @@
 #include "IMAPSend.h"
 #include "./core/ReadyTimer.h"
 #include "./core/QBDecoder.h"
+#include "./core/ReadyLineReader.h"
 #include "Parser.h"
 
 namespace ReadyMailIMAP
@@ -225,37 +226,28 @@ namespace ReadyMailIMAP
 
         int readLine(String &buf)
         {
-            int p = 0;
-            while (tcpAvailable())
-            {
+            if (!imap_ctx->client || (!reader.available() && !tcpAvailable()))
+                return 0;
 #if defined(ESP8266)
-                sys_yield();
-                if (!imap_ctx->client || !imap_ctx->client->connected())
-                    return -1;
+            sys_yield();
+            if (!imap_ctx->client->connected())
+                return -1;
 #endif
-                int res = tcpRead();
-                if (res > -1)
-                {
-                    buf += (char)res;
-                    p++;
-                    if (res == '\n' || (p >= (int)limit && res == ' '))
-                        return p;
-                }
-            }
-            return p;
+            return reader.readLine(imap_ctx->client, buf, limit);
         }
 
         int tcpAvailable() { return imap_ctx->client ? imap_ctx->client->available() : 0; }
-        int tcpRead() { return imap_ctx->client ? imap_ctx->client->read() : -1; }
         void stop(bool forceStop = false)
         {
             stopImpl(forceStop);
+            reader.clear();
             clear(line);
         }
 
     private:
         bool complete = false;
         String line;
+        ReadyLineReader reader;
         ReadyTimer resp_timer, idle_timer;
         MailboxInfo mailbox_info;
         size_t limit = 2048;
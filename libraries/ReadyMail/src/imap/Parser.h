@@ -68,46 +68,6 @@ namespace ReadyMailIMAP
             }
         }
 
-        void setSection(std::vector<part_ctx> &parts)
-        {
-            int max_depth = 0;
-            for (int i = 0; i < (int)parts.size(); i++)
-            {
-                if (max_depth < parts[i].depth)
-                    max_depth = parts[i].depth;
-            }
-
-            String *section = new String[max_depth + 1];
-            for (int i = 0; i < (int)parts.size(); i++)
-            {
-                if (i > 0 && parts[i - 1].name == "message")
-                {
-                    parts[i].section = parts[i - 1].section;
-                    continue;
-                }
-
-                if (parts[i].depth == 1)
-                {
-                    parts[i].section = numString.get(parts[i].num_specifier);
-                    section[parts[i].depth] = parts[i].section;
-                }
-                else if (parts[i].depth > 0)
-                {
-                    if (parts[i].num_specifier == 1 && i > 0)
-                        section[parts[i].depth] = parts[i - 1].section;
-
-                    if (section[parts[i].depth].length() == 0)
-                        section[parts[i].depth] = numString.get(parts[i].num_specifier);
-
-                    parts[i].section = section[parts[i].depth];
-                    parts[i].section += ".";
-                    parts[i].section += parts[i].num_specifier;
-                }
-            }
-            delete[] section;
-            section = nullptr;
-        }
-
         String nextToken(const String &line, int &i, int lastIndex)
         {
             int pos1 = -1, pos2 = -1;
@@ -238,72 +198,6 @@ namespace ReadyMailIMAP
             return out;
         }
 
-        String getField(part_ctx &cpart, imap_body_structure_non_multipart_fields field_type, int index = -1, bool key = false)
-        {
-            int i = 0;
-            if (cpart.field.size())
-            {
-                while (i < (int)cpart.field.size() && cpart.field[i].index != field_type)
-                    i++;
-
-                if (index > -1)
-                {
-                    int cnt = 0;
-                    while (i < (int)cpart.field.size() && cpart.field[i].index == field_type)
-                    {
-                        if (key && cnt == index * 2)
-                            return cpart.field[i].token;
-
-                        if (!key && cnt == index * 2 + 1)
-                            return cpart.field[i].token;
-
-                        cnt++;
-                        i++;
-                    }
-                }
-            }
-            return i < (int)cpart.field.size() ? cpart.field[i].token : String();
-        }
-
-        uint32_t getOctetLen(const String &line)
-        {
-            uint32_t len = 0;
-            int pos1 = line.lastIndexOf("{"), pos2 = line.lastIndexOf("}");
-            if (pos1 < pos2 && pos1 > -1 && pos2 > -1)
-                len = numString.toNum(line.substring(pos1 + 1, pos2).c_str());
-            return len;
-        }
-
-        String getFilename(part_ctx &cpart)
-        {
-            String filename = getPartFiled(cpart, non_multipart_field_disposition, "filename", false);
-            if (filename.length())
-                return filename;
-            return getPartFiled(cpart, non_multipart_field_disposition, "name", false);
-        }
-
-        String getName(part_ctx &cpart) { return getPartFiled(cpart, non_multipart_field_parameter_list, "name", false); }
-
-        String getCharset(part_ctx &cpart) { return getPartFiled(cpart, non_multipart_field_parameter_list, "charset", true); }
-
-        String getPartFiled(part_ctx &cpart, imap_body_structure_non_multipart_fields field, const String &name, bool toLowercase)
-        {
-            String val;
-            int i = 0;
-            while (getField(cpart, field, i, true).length())
-            {
-                if (getField(cpart, field, i, true) == name)
-                {
-                    val = getField(cpart, field, i, false);
-                    break;
-                }
-                i++;
-            }
-            if (toLowercase)
-                val.toLowerCase();
-            return val;
-        }
-
         bool isLastOctet(const String &line) { return line.length() >= 3 && line[line.length() - 3] == ')' && line[line.length() - 2] == '\r' && line[line.length() - 1] == '\n'; }
 
         // remove last of octet bytes ')\r\n' if existed
@@ -488,116 +382,314 @@ namespace ReadyMailIMAP
             return scheme;
         }
 
-        void parseBodyStructure(const String &line, const String &beginToken, const String &lastToken, int depth, int index, int field_type, std::vector<part_ctx> &parts, part_ctx *cpart)
+        // Get the next token of BODYSTRUCTURE as the span in s without copying, i is advanced past the token.
+        // The quoted string span excludes the quotes, the literal span is its content
+        // and the parenthesized list span includes the parentheses.
+        imap_token_type nextSpan(const char *s, int &i, int end, imap_span &span)
         {
-            int beginIndex = 0, lastIndex = 0;
-            getBoundary(line, beginToken, lastToken, beginIndex, lastIndex);
-            int i = beginIndex;
+            while (i < end && (s[i] == ' ' || s[i] == '\r' || s[i] == '\n'))
+                i++;
 
-            int field_index = 0, part_count = 0, rnd = random(100000, 200000) + micros();
-            bool multipart = false, key = false;
+            span.pos = i;
+            span.len = 0;
+            span.type = imap_token_end;
 
-            if (line.indexOf("\"mixed\"") > -1 || line.indexOf("\"MIXED\"") > -1 || line.indexOf("\"alternative\"") > -1 || line.indexOf("\"ALTERNATIVE\"") > -1 || line.indexOf("\"related\"") > -1 || line.indexOf("\"RELATED\"") > -1)
-                multipart = true;
+            if (i >= end || s[i] == ')')
+                return span.type;
 
-            while (i <= lastIndex)
+            if (s[i] == '"')
             {
-                String token = nextToken(line, i, lastIndex);
-                if (token.length())
+                span.pos = ++i;
+                skipQuoted(s, i, end);
+                span.len = i - span.pos;
+                i++;
+                span.type = imap_token_string;
+            }
+            else if (s[i] == '{')
+            {
+                int n = skipLiteral(s, i, end);
+                span.pos = i - n;
+                span.len = n;
+                span.type = imap_token_string;
+            }
+            else if (s[i] == '(')
+            {
+                int depth = 0;
+                while (i < end)
                 {
-                    if (token[0] == '(' && token[token.length() - 1] == ')')
+                    char c = s[i++];
+                    if (c == '"')
                     {
-                        part_count++;
-                        part_ctx part;
-                        part.parent_id = numString.get(rnd);
-                        parseBodyStructure(token, "(", ")", depth + 1, part_count, field_index, parts, &part);
-                        field_index++;
+                        skipQuoted(s, i, end);
+                        i++;
                     }
-                    else
+                    else if (c == '{')
                     {
-                        String part_type = token;
-                        part_type.toLowerCase();
+                        i--;
+                        skipLiteral(s, i, end);
+                    }
+                    else if (c == '(')
+                        depth++;
+                    else if (c == ')' && --depth == 0)
+                        break;
+                }
+                if (i > end)
+                    i = end;
+                span.len = i - span.pos;
+                span.type = imap_token_list;
+            }
+            else
+            {
+                while (i < end && s[i] != ' ' && s[i] != '(' && s[i] != ')' && s[i] != '\r')
+                    i++;
+                span.len = i - span.pos;
+                span.type = imap_token_atom;
+            }
+            return span.type;
+        }
 
-                        if (part_type == "nil")
-                            token.remove(0, token.length());
+        // Move i to the closing quote
+        void skipQuoted(const char *s, int &i, int end)
+        {
+            while (i < end && s[i] != '"')
+                i += s[i] == '\\' ? 2 : 1;
+            if (i > end)
+                i = end;
+        }
 
-                        if (part_type == "attachment" || part_type == "inline") // disposition
-                        {
-                            key = false;
-                            field_index = field_type;
-                            continue;
-                        }
+        // Move i past the literal {n}CRLF and its content, returns the content length
+        int skipLiteral(const char *s, int &i, int end)
+        {
+            int n = 0;
+            while (++i < end && s[i] >= '0' && s[i] <= '9')
+                n = n * 10 + s[i] - '0';
+            while (i < end && s[i] != '\n')
+                i++;
+            i++;
+            if (n > end - i)
+                n = end - i > 0 ? end - i : 0;
+            i += n;
+            return n;
+        }
 
-                        if (cpart && (part_type == "message" || part_type == "text" || part_type == "mixed" || part_type == "alternative" || part_type == "related" || part_type == "application" || part_type == "image" || part_type == "audio" || part_type == "video"))
-                        {
-                            field_index = 0;
-                            cpart->name = part_type;
-                            if (part_type == "mixed")
-                                index = 1;
-                            cpart->num_specifier = index;
-                            cpart->part_count = part_count;
-                            cpart->depth = depth;
-                            cpart->id = numString.get(rnd);
-                            cpart->section = multipart ? "" : String(index);
-                            bool inserted = false;
-                            if (multipart)
-                            {
-                                int size = parts.size();
-                                for (int j = 0; j < size; j++)
-                                {
-                                    if (parts[j].parent_id == cpart->id)
-                                    {
-                                        if (!inserted)
-                                        {
-                                            inserted = true;
-                                            parts.insert(parts.begin() + j, 1, *cpart);
-                                            size++;
-                                        }
-                                    }
-                                }
-                            }
+        bool isNil(const char *s, const imap_span &span) { return span.type == imap_token_atom && span.len == 3 && strncasecmp(s + span.pos, "NIL", 3) == 0; }
 
-                            if (!inserted)
-                                parts.push_back(*cpart);
-                        }
+        bool spanEquals(const char *s, const imap_span &span, const char *str) { return span.type != imap_token_list && (int)strlen(str) == span.len && strncasecmp(s + span.pos, str, span.len) == 0; }
 
-                        if (parts.size())
-                        {
-                            body_part_field field;
-                            field.depth = depth;
-                            field.index = -1;
+        // Copy the span content, the quoted string is unescaped
+        String getSpan(const char *s, const imap_span &span, bool toLowercase = false)
+        {
+            String str;
+            if (span.type == imap_token_end || span.type == imap_token_list || isNil(s, span))
+                return str;
 
-                            if (parts[parts.size() - 1].id == String(rnd))
-                                field.index = field_index;
-                            else if (parts[parts.size() - 1].depth < depth)
-                            {
-                                field.index = field_type;
-                                key = !key;
-                                if (token.length() && key)
-                                    token.toLowerCase();
-                                else
-                                    decodeString(token);
-                            }
+            str.reserve(span.len);
+            for (int i = span.pos; i < span.pos + span.len; i++)
+            {
+                if (span.type == imap_token_string && s[i] == '\\' && i + 1 < span.pos + span.len)
+                    i++;
+                str += toLowercase ? (char)tolower(s[i]) : s[i];
+            }
+            return str;
+        }
 
-                            // Ignore any extension fields of message/xxxx part
-                            if (parts[parts.size() - 1].field.size() && parts[parts.size() - 1].field[0].token == "message" && (field.index == 0 || field.index > non_multipart_field_size))
-                                continue;
+        uint32_t getSpanNum(const char *s, const imap_span &span)
+        {
+            uint32_t n = 0;
+            for (int i = span.pos; i < span.pos + span.len && s[i] >= '0' && s[i] <= '9'; i++)
+                n = n * 10 + s[i] - '0';
+            return n;
+        }
 
-                            if (token.length() && field.index != 2 && field.index != 3 && field.index != 4 && field.index != 8)
-                                token.toLowerCase();
+        // Find the value of name in the parameter list span (key sp value ...)
+        bool findParam(const char *s, const imap_span &list, const char *name, imap_span &value)
+        {
+            if (list.type != imap_token_list)
+                return false;
 
-                            field.token = token;
+            int i = list.pos + 1, end = list.pos + list.len - 1;
+            imap_span key;
+            while (nextSpan(s, i, end, key) != imap_token_end && nextSpan(s, i, end, value) != imap_token_end)
+            {
+                if (spanEquals(s, key, name))
+                    return true;
+            }
+            return false;
+        }
 
-                            if (field.index > -1)
-                                parts[parts.size() - 1].field.push_back(field);
-                        }
-                        field_index++;
-                    }
+        // Get the parameter value with RFC 2047 decoding
+        String getParam(const char *s, const imap_span &list, const char *name, bool toLowercase)
+        {
+            imap_span value;
+            String val;
+            if (findParam(s, list, name, value))
+            {
+                val = getSpan(s, value, toLowercase);
+                decodeString(val);
+            }
+            return val;
+        }
+
+        // Get the parameter value from the disposition span ("attachment" (key sp value ...))
+        String getDispositionParam(const char *s, const imap_span &disposition, const char *name)
+        {
+            if (disposition.type != imap_token_list)
+                return String();
+
+            int i = disposition.pos + 1, end = disposition.pos + disposition.len - 1;
+            imap_span type, params;
+            nextSpan(s, i, end, type);
+            nextSpan(s, i, end, params);
+            return getParam(s, params, name, false);
+        }
+
+        // Parse the BODY or BODYSTRUCTURE of the FETCH response and add the files of non-multipart parts.
+        // The line is tokenized once, no part list is built and only the values used by the file are copied.
+        void parseBodyStructure(imap_context *imap_ctx, const String &line, imap_msg_ctx &cmsg)
+        {
+            const char *s = line.c_str();
+            int end = line.length();
+            int i = line.indexOf("FETCH (");
+            if (i == -1)
+                return;
+
+            // FETCH (name sp value ...)
+            i += 7;
+            imap_span name, value;
+            while (nextSpan(s, i, end, name) != imap_token_end && nextSpan(s, i, end, value) != imap_token_end)
+            {
+                if (value.type == imap_token_list && (spanEquals(s, name, "BODY") || spanEquals(s, name, "BODYSTRUCTURE")))
+                {
+                    parseBodyPart(imap_ctx, cmsg, s, value, "", true, 0);
+                    break;
                 }
             }
+        }
 
-            if (depth == 0)
-                setSection(parts);
+        // Parse the body span, section is the part section or the parent section of the top level
+        // or encapsulated (message/rfc822) body which its non-multipart part is numbered with ".1".
+        void parseBodyPart(imap_context *imap_ctx, imap_msg_ctx &cmsg, const char *s, const imap_span &body, const String &section, bool encapsulated, int depth)
+        {
+            if (depth > IMAP_MAX_BODY_DEPTH)
+                return;
+
+            sys_yield();
+
+            int i = body.pos + 1, end = body.pos + body.len - 1;
+            imap_span span;
+
+            // multipart, (body)(body)... sp subtype [extension data]
+            if (nextSpan(s, i, end, span) == imap_token_list)
+            {
+                int num = 1;
+                while (span.type == imap_token_list)
+                {
+                    String sub = section;
+                    if (sub.length())
+                        sub += ".";
+                    sub += num++;
+                    parseBodyPart(imap_ctx, cmsg, s, span, sub, false, depth + 1);
+                    nextSpan(s, i, end, span);
+                }
+                return;
+            }
+
+            part_ctx part;
+            if (encapsulated)
+                part.section = section.length() ? section + ".1" : "1";
+            else
+                part.section = section;
+
+            part.field[non_multipart_field_type] = span;
+            for (int f = non_multipart_field_subtype; f <= non_multipart_field_size; f++)
+                nextSpan(s, i, end, part.field[f]);
+
+            // type specific fields after the size
+            if (spanEquals(s, part.field[non_multipart_field_type], "message") && spanEquals(s, part.field[non_multipart_field_subtype], "rfc822"))
+            {
+                imap_span envelope;
+                nextSpan(s, i, end, envelope);
+                nextSpan(s, i, end, part.message);
+                nextSpan(s, i, end, span); // lines
+            }
+            else if (spanEquals(s, part.field[non_multipart_field_type], "text"))
+                nextSpan(s, i, end, span); // lines
+
+            // extension data
+            for (int f = non_multipart_field_lines_or_md5; f < non_multipart_field_max_type; f++)
+                nextSpan(s, i, end, part.field[f]);
+
+            addFile(imap_ctx, cmsg, s, part);
+
+            if (part.message.type == imap_token_list)
+                parseBodyPart(imap_ctx, cmsg, s, part.message, part.section, true, depth + 1);
+        }
+
+        String getFileName(const char *s, part_ctx &cpart, const String &type, const String &subtype)
+        {
+            String name = getParam(s, cpart.field[non_multipart_field_parameter_list], "name", false);
+            if (name.length() == 0)
+                name = getDispositionParam(s, cpart.field[non_multipart_field_disposition], "filename");
+            if (name.length() == 0)
+                name = getDispositionParam(s, cpart.field[non_multipart_field_disposition], "name");
+
+            if (type == "message" && name.length() && name.indexOf(".eml") == -1)
+                name += ".eml";
+
+            if (name.length() == 0)
+            {
+                String part = cpart.section;
+                part.replace(".", "_");
+                rd_print_to(name, 100, "%s.%s", part.c_str(), type == "message" ? "eml" : (subtype == "plain" ? "txt" : "html"));
+            }
+            return name;
+        }
+
+        void addFile(imap_context *imap_ctx, imap_msg_ctx &cmsg, const char *s, part_ctx &cpart)
+        {
+            imap_file_ctx cfile;
+            cfile.section = cpart.section;
+
+            cfile.octet_count = getSpanNum(s, cpart.field[non_multipart_field_size]);
+
+            cfile.info.transferEncoding = getSpan(s, cpart.field[non_multipart_field_encoding], true);
+            if (cfile.info.transferEncoding == "quoted-printable")
+                cfile.transfer_encoding = imap_transfer_encoding_quoted_printable;
+            else if (cfile.info.transferEncoding == "base64")
+                cfile.transfer_encoding = imap_transfer_encoding_base64;
+            else if (cfile.info.transferEncoding == "7bit")
+                cfile.transfer_encoding = imap_transfer_encoding_7bit;
+            else if (cfile.info.transferEncoding == "8bit")
+                cfile.transfer_encoding = imap_transfer_encoding_8bit;
+            else if (cfile.info.transferEncoding == "binary")
+                cfile.transfer_encoding = imap_transfer_encoding_binary;
+
+            String type = getSpan(s, cpart.field[non_multipart_field_type], true);
+            String subtype = getSpan(s, cpart.field[non_multipart_field_subtype], true);
+            cfile.text_part = type == "text";
+            cfile.info.mime = type;
+            cfile.info.mime += "/";
+            cfile.info.mime += subtype;
+
+            cfile.info.filename = getFileName(s, cpart, type, subtype);
+            if (cfile.text_part)
+            {
+                cfile.info.charset = getParam(s, cpart.field[non_multipart_field_parameter_list], "charset", true);
+                cfile.char_encoding = getCharEncoding(cfile.info.charset);
+            }
+
+            if (cfile.transfer_encoding == imap_transfer_encoding_base64 || cfile.transfer_encoding == imap_transfer_encoding_binary)
+            {
+                cfile.info.fileSize = numString.toNum(getDispositionParam(s, cpart.field[non_multipart_field_disposition], "size").c_str());
+                if (cfile.info.fileSize == 0)
+                    cfile.info.fileSize = cfile.octet_count * 3 / 4;
+            }
+            else if (type == "message")
+                cfile.info.fileSize = cfile.octet_count;
+
+            if (imap_ctx->options.searching || cfile.info.fileSize > imap_ctx->options.part_size_limit || (cfile.info.fileSize == 0 && cfile.octet_count > imap_ctx->options.part_size_limit))
+                cfile.fetch = false;
+            cmsg.files.push_back(cfile);
         }
 
         void parseCaps(String &line, imap_context *imap_ctx)
@@ -672,27 +764,53 @@ namespace ReadyMailIMAP
                 return;
             }
 
-            String token;
             int beginIndex = 0, lastIndex = 0;
             getBoundary(line, "* SEARCH", line[line.length() - 1] == ' ' ? " " : "\r\n", beginIndex, lastIndex);
-            int i = beginIndex;
+            const char *p = line.c_str() + beginIndex;
+            const char *end = line.c_str() + lastIndex;
+            size_t limit = imap_ctx->options.search_limit;
 
-            while (i <= lastIndex)
+            // Scan the numbers in place without creating the token string
+            while (p < end)
             {
-                token = nextToken(line, i, lastIndex);
+                if (*p == ' ')
+                {
+                    p++;
+                    continue;
+                }
 
-                if (token.length() == 0)
-                    break;
+                // Skip the list e.g. (MODSEQ 917162500) and other non-numeric tokens
+                if (*p < '0' || *p > '9')
+                {
+                    int list_count = 0;
+                    while (p < end && (list_count > 0 || *p != ' '))
+                    {
+                        if (*p == '(')
+                            list_count++;
+                        else if (*p == ')')
+                            list_count--;
+                        p++;
+                    }
+                    continue;
+                }
+
+                uint32_t msg_num = 0;
+                while (p < end && *p >= '0' && *p <= '9')
+                    msg_num = msg_num * 10 + (*p++ - '0');
+
+                int found = ++imap_ctx->cb_data.msgFound;
+                if (limit == 0)
+                    continue;
 
-                imap_ctx->cb_data.msgFound++;
-                uint32_t msg_num = numString.toNum(token.c_str());
                 if (imap_ctx->options.recent_sort)
                 {
-                    imap_msg_num.push_back(msg_num);
-                    if (imap_msg_num.size() > imap_ctx->options.search_limit)
-                        imap_msg_num.erase(imap_msg_num.begin());
+                    // Keep the last limit numbers in the ring, they will be sorted at the tagged response
+                    if (imap_msg_num.size() < limit)
+                        imap_msg_num.push_back(msg_num);
+                    else
+                        imap_msg_num[(found - 1) % limit] = msg_num;
                 }
-                else if (imap_msg_num.size() < imap_ctx->options.search_limit)
+                else if (imap_msg_num.size() < limit)
                     imap_msg_num.push_back(msg_num);
             }
         }
@@ -799,12 +917,7 @@ namespace ReadyMailIMAP
                 }
             }
             if (depth == 0)
-            {
-                std::vector<part_ctx> parts;
-                part_ctx part;
-                parseBodyStructure(line, "BODY (", ")", 0, 1, -1, parts, &part);
-                getFileInfo(imap_ctx, parts, cmsg);
-            }
+                parseBodyStructure(imap_ctx, line, cmsg);
         }
 
         void parseFetch(String &line, imap_context *imap_ctx, imap_msg_ctx &cmsg, imap_state &cstate, imap_file_ctx &cfile)
@@ -929,24 +1042,6 @@ namespace ReadyMailIMAP
                 cfile.progress.value = 100.0f;
         }
 
-        String getFileName(part_ctx &cpart)
-        {
-            String name = getName(cpart);
-            if (name.length() == 0)
-                name = getFilename(cpart);
-
-            if (getField(cpart, non_multipart_field_type) == "message" && name.length() && name.indexOf(".eml") == -1)
-                name += ".eml";
-
-            if (name.length() == 0)
-            {
-                String part = cpart.section;
-                part.replace(".", "_");
-                rd_print_to(name, 100, "%s.%s", part.c_str(), getField(cpart, non_multipart_field_type) == "message" ? "eml" : (getField(cpart, non_multipart_field_subtype) == "plain" ? "txt" : "html"));
-            }
-            return name;
-        }
-
 #if defined(ENABLE_FS)
         void openFile(imap_context *imap_ctx, imap_file_ctx &cfile)
         {
@@ -997,61 +1092,6 @@ namespace ReadyMailIMAP
         }
 #endif
 
-        void getFileInfo(imap_context *imap_ctx, std::vector<part_ctx> &parts, imap_msg_ctx &cmsg)
-        {
-            for (int i = 0; i < (int)parts.size(); i++)
-            {
-                String line;
-                part_ctx cpart = parts[i];
-                if (cpart.name != "mixed" && cpart.name != "alternative" && cpart.name != "related")
-                {
-                    imap_file_ctx cfile;
-                    cfile.section = cpart.section;
-
-                    cfile.octet_count = getField(cpart, non_multipart_field_size).toInt();
-
-                    cfile.info.transferEncoding = getField(cpart, non_multipart_field_encoding);
-                    if (cfile.info.transferEncoding == "quoted-printable")
-                        cfile.transfer_encoding = imap_transfer_encoding_quoted_printable;
-                    else if (cfile.info.transferEncoding == "base64")
-                        cfile.transfer_encoding = imap_transfer_encoding_base64;
-                    else if (cfile.info.transferEncoding == "7bit")
-                        cfile.transfer_encoding = imap_transfer_encoding_7bit;
-                    else if (cfile.info.transferEncoding == "8bit")
-                        cfile.transfer_encoding = imap_transfer_encoding_8bit;
-                    else if (cfile.info.transferEncoding == "binary")
-                        cfile.transfer_encoding = imap_transfer_encoding_binary;
-
-                    cfile.info.mime = getField(cpart, non_multipart_field_type);
-                    cfile.text_part = cfile.info.mime == "text";
-                    cfile.info.mime += "/";
-                    cfile.info.mime += getField(cpart, non_multipart_field_subtype);
-
-                    cfile.info.filename = getFileName(cpart);
-                    if (cfile.text_part)
-                    {
-                        cfile.info.charset = getCharset(cpart);
-                        cfile.char_encoding = getCharEncoding(cfile.info.charset);
-                    }
-
-                    if (cfile.octet_count == 0)
-                        cfile.octet_count = getOctetLen(line);
-
-                    if (cfile.transfer_encoding == imap_transfer_encoding_base64 || cfile.transfer_encoding == imap_transfer_encoding_binary)
-                    {
-                        cfile.info.fileSize = numString.toNum(getPartFiled(cpart, non_multipart_field_disposition, "size", false).c_str());
-                        if (cfile.info.fileSize == 0)
-                            cfile.info.fileSize = cfile.octet_count * 3 / 4;
-                    }
-                    else if (getField(cpart, non_multipart_field_type) == "message")
-                        cfile.info.fileSize = cfile.octet_count;
-
-                    if (imap_ctx->options.searching || cfile.info.fileSize > imap_ctx->options.part_size_limit || (cfile.info.fileSize == 0 && cfile.octet_count > imap_ctx->options.part_size_limit))
-                        cfile.fetch = false;
-                    cmsg.files.push_back(cfile);
-                }
-            }
-        }
     };
 }
 #endif
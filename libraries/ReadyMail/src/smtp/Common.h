@@ -342,8 +342,7 @@ namespace ReadyMailSMTP
         smtp_message_body_t &body(const String &body)
         {
             content = body;
-            src.type = src_data_string;
-            src.str = content.c_str();
+            src.setSource(content.c_str(), content.length(), src_data_string);
             src.valid = body.length() > 0;
             return *this;
         }
@@ -353,8 +352,7 @@ namespace ReadyMailSMTP
         {
             static_content = body;
             static_size = size;
-            src.type = src_data_static;
-            src.str = static_content;
+            src.setSource(static_content, size, src_data_static);
             src.valid = size > 0;
             return *this;
         }
@@ -365,8 +363,7 @@ namespace ReadyMailSMTP
         {
             this->filename = filename.startsWith("/") ? filename : "/" + filename;
             this->cb = callback;
-            src.type = src_data_file;
-            src.str = nullptr;
+            src.setSource(nullptr, 0, src_data_file);
             src.valid = cb;
             return *this;
         }
@@ -412,6 +409,8 @@ namespace ReadyMailSMTP
         smtp_message_body_t &clear()
         {
             content.remove(0, content.length());
+            if (src.type == src_data_string)
+                src.setSource(content.c_str(), 0, src_data_string);
             // Set to default values unless
             // content_type shall not be changed.
             charSet = "UTF-8";
@@ -430,13 +429,12 @@ namespace ReadyMailSMTP
         String content, charSet = "UTF-8", content_type = "text/html", transfer_encoding = "7bit";
         const char *static_content = nullptr;
         bool flowed = false, header_sent = false;
-        String softbreak_buf;
 #if defined(ENABLE_FS)
         String filename;
         FileCallback cb = NULL;
 #endif
         src_data_ctx src;
-        std::vector<int> softbreak_index;
+        rd_line_enc_ctx enc_ctx;
         embed_message_body_t embed;
 
 #if defined(ENABLE_FS)
@@ -561,7 +559,7 @@ namespace ReadyMailSMTP
         smtp_timeout timeout;
         String notify;
         bool last_append = false, ssl_mode = false, processing = false, accumulate = false, imap_mode = false, use_auto_client = false;
-        int level = 0, data_len = 0;
+        int level = 0, data_len = 0, attach_buf_size = READYMAIL_ATTACH_BUFFER_SIZE;
     };
 
     struct smtp_cmd_ctx
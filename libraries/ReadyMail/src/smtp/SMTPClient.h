@@ -366,6 +366,13 @@ namespace ReadyMailSMTP
             conn.begin(&smtp_ctx, tlsCallback, &res);
         }
 
+        /** Set the attachment buffer size.
+         *
+         * @param size The size in bytes of the buffer that the attachment data is encoded into and sent at once.
+         * The minimum size is 78 bytes (one line). The default size is READYMAIL_ATTACH_BUFFER_SIZE (4096 bytes).
+         */
+        void setAttachmentBufferSize(int size) { smtp_ctx.options.attach_buf_size = size; }
+
         /** Provides the SMTP status information.
          *
          * @return SMTPStatus class object.
@@ -379,7 +386,7 @@ namespace ReadyMailSMTP
         SMTPCommandResponse commandResponse() { return smtp_ctx.cmd_ctx.resp; }
 
         // Private used by other classes.
-        uint32_t contextAddr() { return rd_cast<uint32_t>(&smtp_ctx); }
+        uintptr_t contextAddr() { return rd_cast<uintptr_t>(&smtp_ctx); }
 
         SMTPMessage &getMessage() { return sender.local_msg; }
     };
@@ -293,6 +293,8 @@ namespace ReadyMailSMTP
 #if defined(ENABLE_DEBUG)
                 setDebugState(smtp_state_start_tls, "Performing TLS handshake...");
 #endif
+                // The plain text data that was received before upgrade must not be used
+                res->reader.clear();
 #if defined(ENABLE_READYCLIENT)
                 if (smtp_ctx->auto_client && smtp_ctx->options.use_auto_client)
                     smtp_ctx->server_status->secured = smtp_ctx->auto_client->connectSSL();
@@ -206,10 +206,10 @@ namespace ReadyMailSMTP
     NumString numString;
     std::vector<Attachment> el;
     Attachment att;
-    uint32_t parent_addr =0;
+    uintptr_t parent_addr =0;
     int attachments_idx = 0, attachment_idx = 0, inline_idx = 0, parallel_idx = 0;
 
-    void setParent(uint32_t addr) { parent_addr = addr; }
+    void setParent(uintptr_t addr) { parent_addr = addr; }
 
     void push_back(Attachment att) { el.push_back(att); }
 
@@ -11,6 +11,7 @@
 #include "Common.h"
 #include "SMTPBase.h"
 #include "SMTPConnection.h"
+#include "./core/ReadyLineReader.h"
 
 namespace ReadyMailSMTP
 {
@@ -23,6 +24,7 @@ namespace ReadyMailSMTP
         bool auth_caps[smtp_auth_cap_max_type];
         bool feature_caps[smtp_send_cap_max_type];
         String response;
+        ReadyLineReader reader;
         ReadyTimer resp_timer;
         bool complete = false;
 
@@ -51,8 +53,8 @@ namespace ReadyMailSMTP
 
             cCode() = function_return_undefined;
             bool ret = false;
+            // The line is only allocated when a reply arrives, not in each step of the body data
             String line;
-            line.reserve(1024);
             int readLen = readLine(line);
             if (readLen > 0)
             {
@@ -174,28 +176,17 @@ namespace ReadyMailSMTP
 
         int readLine(String &buf)
         {
-            int p = 0;
-            while (tcpAvailable())
-            {
+            if (!smtp_ctx->client || (!reader.available() && !tcpAvailable()))
+                return 0;
 #if defined(ESP8266)
-                sys_yield();
-                if (!smtp_ctx->client || !smtp_ctx->client->connected())
-                    return -1;
+            sys_yield();
+            if (!smtp_ctx->client->connected())
+                return -1;
 #endif
-                int res = tcpRead();
-                if (res > -1)
-                {
-                    buf += (char)res;
-                    p++;
-                    if (res == '\n')
-                        return p;
-                }
-            }
-            return p;
+            return reader.readLine(smtp_ctx->client, buf);
         }
 
         int tcpAvailable() { return smtp_ctx->client ? smtp_ctx->client->available() : 0; }
-        int tcpRead() { return smtp_ctx->client ? smtp_ctx->client->read() : -1; }
         void getResponseStatus(const String &resp, smtp_server_status_code statusCode, smtp_response_status_t &status)
         {
             if (statusCode > smtp_server_status_code_0)
@@ -260,6 +251,7 @@ namespace ReadyMailSMTP
         void stop(bool forceStop = false)
         {
             stopImpl(forceStop);
+            reader.clear();
             clear(response);
         }
 
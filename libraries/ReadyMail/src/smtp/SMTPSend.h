@@ -24,8 +24,10 @@ namespace ReadyMailSMTP
         SMTPConnection *conn = nullptr;
         SMTPResponse *res = nullptr;
         SMTPMessage *msg_ptr = nullptr;
-        uint32_t root_msg_addr = 0;
+        uintptr_t root_msg_addr = 0;
         SMTPMessage local_msg;
+        uint8_t *attach_buf = nullptr;
+        int attach_buf_size = 0;
 
         void begin(smtp_context *smtp_ctx, SMTPResponse *res, SMTPConnection *conn)
         {
@@ -86,7 +88,7 @@ namespace ReadyMailSMTP
         {
             smtp_ctx->options.processing = true;
             msg_ptr = &msg;
-            root_msg_addr = rd_cast<uint32_t>(&msg);
+            root_msg_addr = rd_cast<uintptr_t>(&msg);
             msg.recipient_index = 0;
             msg.cc_index = 0;
             msg.bcc_index = 0;
@@ -553,9 +555,10 @@ namespace ReadyMailSMTP
 #endif
                 if ((html ? msg.html.src.type : msg.text.src.type) >= src_data_static)
                     updateUploadStatus(filename, html ? msg.html.data_index : msg.text.data_index, html ? msg.html.data_size : msg.text.data_size, html ? msg.html.progress : msg.text.progress, html ? msg.html.last_progress : msg.text.last_progress);
-                String line = rd_qb_encode_chunk(html ? msg.html.src : msg.text.src, html ? msg.html.data_index : msg.text.data_index, html ? msg.html.xenc : msg.text.xenc, html ? false : msg.text.flowed, MAX_LINE_LEN, html ? msg.html.softbreak_buf : msg.text.softbreak_buf, html ? msg.html.softbreak_index : msg.text.softbreak_index);
+                char line[RD_LINE_ENC_OUT_SIZE];
+                int len = rd_qb_encode_chunk(html ? msg.html.src : msg.text.src, html ? msg.html.data_index : msg.text.data_index, html ? msg.html.xenc : msg.text.xenc, html ? false : msg.text.flowed, MAX_LINE_LEN, html ? msg.html.enc_ctx : msg.text.enc_ctx, line);
 
-                if (line.length() && !sendBuffer(line))
+                if (len > 0 && tcpSend(rd_cast<const uint8_t *>(line), len) != (size_t)len)
                     return setError(__func__, TCP_CLIENT_ERROR_SEND_DATA);
             }
 
@@ -579,9 +582,9 @@ namespace ReadyMailSMTP
                 }
 
                 if (html)
-                    msg.html.softbreak_index.clear();
+                    msg.html.enc_ctx.clear();
                 else
-                    msg.text.softbreak_index.clear();
+                    msg.text.enc_ctx.clear();
 
                 if (close_boundary && !sendEndBoundary(msg, content_type_index))
                     return false;
@@ -751,38 +754,51 @@ namespace ReadyMailSMTP
 #endif
                 validateAttEnc(cAttach(msg), available);
 
-                int chunkSize = cAttach(msg).content_encoding != cAttach(msg).transfer_encoding ? 57 : MAX_LINE_LEN;
+                bool enc = cAttach(msg).content_encoding != cAttach(msg).transfer_encoding;
+                int chunkSize = enc ? 57 : MAX_LINE_LEN;
 
-                int toSend = available > chunkSize ? chunkSize : available;
+                // The lines are encoded in place, see rd_b64_enc_lines
+                int lines = rd_b64_lines(smtp_ctx->options.attach_buf_size);
+                if (lines < 1)
+                    lines = 1;
+
+                int toSend = available > lines * chunkSize ? lines * chunkSize : available;
                 if (toSend)
                 {
-                    uint8_t *readBuf = rd_mem<uint8_t *>(toSend + 1, true);
+                    if (!allocAttachBuf(lines * 78))
+                    {
+                        setError(__func__, TCP_CLIENT_ERROR_SEND_DATA);
+                        goto exit;
+                    }
+
+                    int offset = attach_buf_size - lines * chunkSize;
 #if defined(ENABLE_FS)
-                    int read = cAttach(msg).attach_file.callback ? msg.file.read(readBuf, toSend) : readBlob(msg, readBuf, toSend);
+                    int read = cAttach(msg).attach_file.callback ? msg.file.read(attach_buf + offset, toSend) : readBlob(msg, attach_buf + offset, toSend);
 #else
-                    int read = readBlob(msg, readBuf, toSend);
+                    int read = readBlob(msg, attach_buf + offset, toSend);
 #endif
-                    String buf;
+                    if (read < 0)
+                        read = 0;
 
                     cAttach(msg).data_index += read;
                     updateUploadStatus(cAttach(msg));
 
-                    if (cAttach(msg).content_encoding != cAttach(msg).transfer_encoding)
+                    int len = 0;
+                    if (enc)
+                        len = rd_b64_enc_lines(attach_buf, offset, read);
+                    else
                     {
-                        char *enc = rd_b64_enc(readBuf, read);
-                        if (enc)
+                        for (int i = 0; i < read; i += chunkSize)
                         {
-                            buf = enc;
-                            rd_free(&enc);
+                            int n = read - i > chunkSize ? chunkSize : read - i;
+                            memmove(attach_buf + len, attach_buf + offset + i, n);
+                            len += n;
+                            attach_buf[len++] = '\r';
+                            attach_buf[len++] = '\n';
                         }
                     }
-                    else
-                        buf = rd_cast<const char *>(readBuf);
-
-                    rd_free(&readBuf);
-                    buf += "\r\n";
 
-                    if (!sendBuffer(buf))
+                    if (len && tcpSend(attach_buf, len) != (size_t)len)
                     {
                         setError(__func__, TCP_CLIENT_ERROR_SEND_DATA);
                         goto exit;
@@ -801,9 +817,30 @@ namespace ReadyMailSMTP
             }
 #endif
         exit:
+            if (!ret || cAttach(msg).data_size - cAttach(msg).data_index <= 0)
+                freeAttachBuf();
             return ret;
         }
 
+        bool allocAttachBuf(int size)
+        {
+            if (attach_buf && attach_buf_size != size)
+                freeAttachBuf();
+
+            if (!attach_buf)
+            {
+                attach_buf = rd_mem<uint8_t *>(size);
+                attach_buf_size = attach_buf ? size : 0;
+            }
+            return attach_buf != nullptr;
+        }
+
+        void freeAttachBuf()
+        {
+            rd_free(&attach_buf);
+            attach_buf_size = 0;
+        }
+
         void validateAttEnc(Attachment &cAtt, int len)
         {
             if (cAtt.data_index == 0)
@@ -973,10 +1010,12 @@ namespace ReadyMailSMTP
             msg.text.header_sent = false;
             msg.text.data_index = 0;
             msg.text.data_size = 0;
+            msg.text.enc_ctx.clear();
 
             msg.html.header_sent = false;
             msg.html.data_index = 0;
             msg.html.data_size = 0;
+            msg.html.enc_ctx.clear();
 
             if (msg.text.src.valid)
                 msg.beginSource(false);
@@ -1102,6 +1141,7 @@ namespace ReadyMailSMTP
 
     public:
         SMTPSend() {}
+        ~SMTPSend() { freeAttachBuf(); }
     };
 }
 #endif
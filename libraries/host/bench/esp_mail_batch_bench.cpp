@@ -0,0 +1,87 @@
+/*
+ * ESP_Mail_Client batch sending to the SMTP sink over the loopback Client, with the server
+ * replies held back for a round trip of 2 ms: 50 messages sent with sendMail in a loop on
+ * the open session and with one sendMails call, each with and without PIPELINING from the
+ * server. One JSON line per case with the messages per second and the round trips per
+ * message. All messages must be sent and reach the sink. --quick sends 10 messages
+ * with a 0.5 ms round trip.
+ */
+#include <ESP_Mail_Client.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include "support/SMTPServer.h"
+
+// The session is destroyed before the loopback client it uses
+static SMTPSession *session = nullptr;
+
+static void networkStatus() { session->setNetworkStatus(true); }
+
+static void networkConnection() {}
+
+static bool run(bool batch, bool pipelining, size_t count, uint64_t rttUs)
+{
+    SMTPServer server;
+    server.pipelining = pipelining;
+    server.replyDelayUs = rttUs;
+    LoopbackClient client(server);
+    SMTPSession smtp;
+    session = &smtp;
+
+    Session_Config config;
+    config.server.host_name = "127.0.0.1";
+    config.server.port = 25;
+    config.login.email = "me@example.com";
+    config.login.password = "pw";
+    config.login.user_domain = "127.0.0.1";
+    config.secure.mode = esp_mail_secure_mode_nonsecure;
+
+    smtp.setClient(&client);
+    smtp.networkStatusRequestCallback(networkStatus);
+    smtp.networkConnectionRequestCallback(networkConnection);
+    if (!smtp.connect(&config))
+        return false;
+
+    std::vector<SMTP_Message> messages(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        messages[i].sender.name = "Sensor";
+        messages[i].sender.email = "me@example.com";
+        messages[i].subject = "Report";
+        messages[i].addRecipient("Ops", "ops@example.com");
+        messages[i].addCc("backup@example.com");
+        messages[i].text.content = "Temperature 21.5 C, humidity 40 %.";
+        messages[i].date = "Mon, 01 Jan 2024 00:00:00 +0000";
+    }
+
+    unsigned long roundTrips = client.roundTrips;
+    auto start = std::chrono::steady_clock::now();
+    bool ok = true;
+    if (batch)
+        ok = MailClient.sendMails(&smtp, messages.data(), count, true);
+    else
+    {
+        for (size_t i = 0; i < count; i++)
+            ok = MailClient.sendMail(&smtp, &messages[i], i == count - 1) && ok;
+    }
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("{\"mode\":\"%s\",\"pipelining\":%s,\"messages\":%zu,\"rtt_us\":%lu,\"msgs/s\":%.1f,\"round_trips_per_msg\":%.2f}\n",
+           batch ? "sendMails" : "sendMail", pipelining ? "true" : "false", count, (unsigned long)rttUs, count / s,
+           (double)(client.roundTrips - roundTrips) / count);
+    return ok && server.messages.size() == count;
+}
+
+int main(int argc, char **argv)
+{
+    bool quick = argc > 1 && strcmp(argv[1], "--quick") == 0;
+    size_t count = quick ? 10 : 50;
+    uint64_t rttUs = quick ? 500 : 2000;
+    bool ok = true;
+    for (bool pipelining : {false, true})
+    {
+        ok = run(false, pipelining, count, rttUs) && ok;
+        ok = run(true, pipelining, count, rttUs) && ok;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+/*
+ * The ESP_Mail_Client codecs: decodeBase64, encodeBase64Str, decodeQP_UTF8, the RFC2047
+ * header decoder and the PEM decoding of the certificates in X509List. One JSON line per
+ * codec and input with the MB/s and the heap allocations per MB counted by the heap shim.
+ * --quick processes 16 KB per test instead of 1 MB.
+ */
+#include <ESP_Mail_Client.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include "support/test_certs.h"
+
+static size_t minBytes = 1024 * 1024;
+
+static const size_t SAMPLE_SIZE = 4096;
+
+static std::string sample(const char *line)
+{
+    std::string s;
+    while (s.size() < SAMPLE_SIZE)
+        s += line;
+    s.resize(SAMPLE_SIZE);
+    return s;
+}
+
+static std::string binary()
+{
+    std::string s(SAMPLE_SIZE, 0);
+    uint32_t x = 2463534242UL;
+    for (char &c : s)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        c = (char)x;
+    }
+    return s;
+}
+
+// Quoted-printable with the soft line breaks at 76 columns
+static std::string encodeQP(const std::string &in)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    std::string out;
+    size_t col = 0;
+    for (size_t i = 0; i < in.size(); i++)
+    {
+        uint8_t c = in[i];
+        if (c == '\r' && i + 1 < in.size() && in[i + 1] == '\n')
+        {
+            out += "\r\n";
+            i++;
+            col = 0;
+            continue;
+        }
+        std::string enc = (c >= 33 && c <= 126 && c != '=') || c == ' ' ? std::string(1, c) : std::string{'=', hex[c >> 4], hex[c & 15]};
+        if (col + enc.size() > 75)
+        {
+            out += "=\r\n";
+            col = 0;
+        }
+        out += enc;
+        col += enc.size();
+    }
+    return out;
+}
+
+class Bench
+{
+public:
+    Bench(const char *codec, const char *input) : _codec(codec), _input(input)
+    {
+        _allocs = host::heapStats().allocs;
+        _start = std::chrono::steady_clock::now();
+    }
+
+    bool done() const { return bytes >= minBytes; }
+
+    ~Bench()
+    {
+        double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+        double mb = bytes / 1048576.0;
+        printf("{\"codec\":\"%s\",\"input\":\"%s\",\"bytes\":%zu,\"MB/s\":%.1f,\"allocs_per_mb\":%.1f}\n",
+               _codec, _input, bytes, s > 0 ? mb / s : 0, (host::heapStats().allocs - _allocs) / mb);
+    }
+
+    size_t bytes = 0;
+
+private:
+    const char *_codec, *_input;
+    size_t _allocs;
+    std::chrono::steady_clock::time_point _start;
+};
+
+static bool benchBase64(const char *input, const std::string &data)
+{
+    {
+        Bench b("b64_enc", input);
+        while (!b.done())
+        {
+            MB_String enc = MailClient.encodeBase64Str(reinterpret_cast<const unsigned char *>(data.data()), data.size());
+            b.bytes += data.size();
+        }
+    }
+
+    MB_String enc = MailClient.encodeBase64Str(reinterpret_cast<const unsigned char *>(data.data()), data.size());
+    bool ok = true;
+    Bench b("b64_dec", input);
+    while (!b.done())
+    {
+        size_t len = 0;
+        unsigned char *dec = MailClient.decodeBase64(reinterpret_cast<const unsigned char *>(enc.c_str()), enc.length(), &len);
+        ok = ok && dec && len == data.size() && memcmp(dec, data.data(), len) == 0;
+        free(dec);
+        b.bytes += data.size();
+    }
+    return ok;
+}
+
+static bool benchQP(const char *input, const std::string &data)
+{
+    std::string enc = encodeQP(data);
+    std::string out(enc.size() + 1, 0);
+    bool ok = true;
+    Bench b("qp_dec", input);
+    while (!b.done())
+    {
+        memset(&out[0], 0, out.size());
+        MailClient.decodeQP_UTF8(enc.c_str(), &out[0]);
+        ok = ok && memcmp(out.data(), data.data(), data.size()) == 0;
+        b.bytes += enc.size();
+    }
+    return ok;
+}
+
+static void benchRFC2047()
+{
+    static const char *headers[] = {
+        "=?ISO-8859-1?Q?Andr=E9_Pirard?= <pirard@example.com>",
+        "=?windows-874?B?wNLJ0uTL6MfDpOPK6Ljl0q+hqbc=?=",
+        "=?UTF-8?B?4LiX4LiU4Liq4Lit4Lia4Lig4Liy4Lip4Liy4LmE4LiX4Lii?= =?UTF-8?Q?_and_more_text?=",
+        "Plain subject line without encoded word"};
+    MB_FS fs;
+    char out[256];
+    Bench b("rfc2047_dec", "header");
+    while (b.bytes < minBytes / 4)
+    {
+        for (const char *h : headers)
+        {
+            MailClient.RFC2047Decoder.decode(&fs, out, h, sizeof(out));
+            b.bytes += strlen(h);
+        }
+    }
+}
+
+static bool benchPEM()
+{
+    const char *pems[] = {test_ca_a_pem, test_ca_d1_pem, test_ca_d2_pem, test_ca_x_pem};
+    bool ok = true;
+    Bench b("pem_x509list", "ca");
+    while (!b.done())
+    {
+        X509List list;
+        for (const char *pem : pems)
+        {
+            ok = list.append(pem) && ok;
+            b.bytes += strlen(pem);
+        }
+        ok = ok && list.getCount() == 4;
+    }
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && strcmp(argv[1], "--quick") == 0)
+        minBytes = 16 * 1024;
+
+    std::string text = sample("The quick brown fox jumps over the lazy dog. Pack my box with five dozen liquor jugs!\r\n");
+    std::string html = sample("<p style=\"color:#333;font-family:sans-serif\">Sensor <b>#12</b> reported 23.5&deg;C at "
+                              "<a href=\"https://example.com/s?id=12&amp;t=now\">12:00</a></p>\r\n");
+    std::string mixed = sample("Grüße aus München, สวัสดีครับ, 你好世界, Привет! Temperature 23.5°C = OK\r\n");
+    std::string bin = binary();
+
+    bool ok = benchBase64("text", text);
+    ok = benchBase64("binary", bin) && ok;
+    ok = benchQP("text", text) && ok;
+    ok = benchQP("html", html) && ok;
+    ok = benchQP("mixed", mixed) && ok;
+    benchRFC2047();
+    ok = benchPEM() && ok;
+    return ok ? 0 : 1;
+}
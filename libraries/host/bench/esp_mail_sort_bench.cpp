@@ -0,0 +1,132 @@
+/*
+ * ESP_Mail_Client numDecSort, the in-place heapsort of the SEARCH message numbers, over 1k,
+ * 10k and 100k numbers in random and server (ascending) order, next to the previous
+ * selection sort (up to 10k, it is quadratic) and std::sort. With the search limit of 10, 100
+ * and 1000, the newest numbers kept in the ring of the SEARCH response and sorted are timed
+ * next to the previous push_back/erase(begin()) and selection sort. The order must match
+ * std::sort. One JSON line per case with the ms. --quick stops at 10k.
+ */
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#define private public
+#include <ESP_Mail_Client.h>
+
+typedef std::vector<esp_mail_imap_msg_num_t> Nums;
+
+// The previous ESP_Mail_Client::numDecSort
+static void previousDecSort(Nums &arr)
+{
+    struct esp_mail_imap_msg_num_t tmp;
+    for (size_t i = 0; i < arr.size(); ++i)
+    {
+        for (size_t j = i + 1; j < arr.size(); ++j)
+        {
+            if (arr[i].value < arr[j].value)
+            {
+                tmp = arr[i];
+                arr[i] = arr[j];
+                arr[j] = tmp;
+            }
+        }
+    }
+}
+
+template <typename Sort>
+static double timeSort(Nums &arr, Sort sort)
+{
+    auto start = std::chrono::steady_clock::now();
+    sort(arr);
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool same(const Nums &a, const Nums &b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); i++)
+        if (a[i].value != b[i].value)
+            return false;
+    return true;
+}
+
+static bool run(const char *order, const Nums &nums)
+{
+    Nums ref = nums, heap = nums, prev = nums;
+    double refMs = timeSort(ref, [](Nums &a) { std::sort(a.begin(), a.end(), compareMore); });
+    double heapMs = timeSort(heap, [](Nums &a) { MailClient.numDecSort(a); });
+    bool ok = same(heap, ref);
+
+    printf("{\"order\":\"%s\",\"numbers\":%zu,\"numDecSort_ms\":%.3f,\"std_sort_ms\":%.3f", order, nums.size(), heapMs, refMs);
+    if (nums.size() <= 10000)
+    {
+        printf(",\"previous_ms\":%.3f", timeSort(prev, previousDecSort));
+        ok = ok && same(prev, ref);
+    }
+    printf("}\n");
+    return ok;
+}
+
+// The newest limit numbers as ESP_Mail_Client::handleIMAPResponse keeps them for recent_sort
+static void keepRecent(const Nums &nums, size_t limit, Nums &kept)
+{
+    for (size_t i = 0; i < nums.size(); i++)
+    {
+        if (kept.size() < limit)
+            kept.push_back(nums[i]);
+        else
+            kept[i % limit] = nums[i];
+    }
+    MailClient.numDecSort(kept);
+}
+
+// The previous recent_sort selection
+static void previousKeepRecent(const Nums &nums, size_t limit, Nums &kept)
+{
+    for (size_t i = 0; i < nums.size(); i++)
+    {
+        kept.push_back(nums[i]);
+        if (kept.size() > limit)
+            kept.erase(kept.begin());
+    }
+    previousDecSort(kept);
+}
+
+static bool runLimit(const char *order, const Nums &nums, size_t limit)
+{
+    Nums kept, prev;
+    double ms = timeSort(kept, [&](Nums &a) { keepRecent(nums, limit, a); });
+    double prevMs = timeSort(prev, [&](Nums &a) { previousKeepRecent(nums, limit, a); });
+
+    printf("{\"order\":\"%s\",\"numbers\":%zu,\"limit\":%zu,\"ring_ms\":%.3f,\"previous_ms\":%.3f}\n", order, nums.size(), limit, ms, prevMs);
+    return kept.size() == limit && same(kept, prev);
+}
+
+int main(int argc, char **argv)
+{
+    size_t maxCount = argc > 1 && strcmp(argv[1], "--quick") == 0 ? 10000 : 100000;
+    bool ok = true;
+    for (size_t count = 1000; count <= maxCount; count *= 10)
+    {
+        Nums random(count), ascending(count);
+        uint32_t x = 2463534242UL;
+        for (size_t i = 0; i < count; i++)
+        {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            random[i].value = x % 1000000;
+            ascending[i].value = i * 3 + 1;
+        }
+        ok = run("random", random) && ok;
+        ok = run("ascending", ascending) && ok;
+        for (size_t limit : {10, 100, 1000})
+        {
+            ok = runLimit("random", random, limit) && ok;
+            ok = runLimit("ascending", ascending, limit) && ok;
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+/*
+ * LiquidCrystal_I2C character throughput on the timed mock TwoWire and the HD44780 model
+ * behind the PCF8574 at 100 kHz, 400 kHz and 1 MHz: write() per character, print() of a
+ * row in batched transmissions and refresh() of changed frames. One JSON line per mode and
+ * clock with the characters per second of virtual time, the bus bytes per character and
+ * the writes that reached the LCD while busy, which must be 0 up to 400 kHz.
+ * --quick sends 10 frames per test instead of 100.
+ */
+#include <LiquidCrystal_I2C.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include "support/HD44780.h"
+
+static size_t frames = 100;
+
+static const char *text[2] = {"The quick brown ", "fox jumps over! "};
+
+enum Mode
+{
+    per_char,
+    batched,
+    framebuffer
+};
+
+static bool run(Mode mode, uint32_t clock)
+{
+    static const char *names[] = {"write", "print", "refresh"};
+    HD44780_I2C dev;
+    Wire.setDevice(&dev);
+    Wire.setClock(clock);
+    LiquidCrystal_I2C lcd(0x27, 16, 2);
+    lcd.init();
+    if (mode == framebuffer && !lcd.setFramebuffer(true))
+        return false;
+
+    Wire.resetStats();
+    dev.lcd.violations = 0;
+    uint64_t start = host::nowMicros();
+    size_t chars = 0;
+    for (size_t i = 0; i < frames; i++)
+    {
+        // The frames swap the rows so that the refresh has all characters to send
+        const char *row0 = text[i & 1], *row1 = text[(i + 1) & 1];
+        lcd.setCursor(0, 0);
+        if (mode == per_char)
+            for (const char *p = row0; *p; p++)
+                lcd.write(*p);
+        else
+            lcd.print(row0);
+        chars += 16;
+        if (mode == framebuffer)
+        {
+            lcd.setCursor(0, 1);
+            lcd.print(row1);
+            lcd.refresh();
+            chars += 16;
+        }
+    }
+    double s = (host::nowMicros() - start) / 1e6;
+
+    bool ok = dev.lcd.text(0x00, 16) == text[(frames - 1) & 1];
+    if (mode == framebuffer)
+        ok = ok && dev.lcd.text(0x40, 16) == text[frames & 1];
+    printf("{\"mode\":\"%s\",\"clock\":%lu,\"chars\":%zu,\"chars/s\":%.0f,\"bytes_per_char\":%.2f,\"violations\":%lu}\n",
+           names[mode], (unsigned long)clock, chars, chars / s, (double)Wire.bytes / chars, dev.lcd.violations);
+    Wire.setDevice(nullptr);
+    return ok && Wire.overflows == 0 && (clock > 400000 || dev.lcd.violations == 0);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && strcmp(argv[1], "--quick") == 0)
+        frames = 10;
+    host::setVirtualClock(true);
+    bool ok = true;
+    for (uint32_t clock : {100000u, 400000u, 1000000u})
+        for (Mode mode : {per_char, batched, framebuffer})
+            ok = run(mode, clock) && ok;
+    host::setVirtualClock(false);
+    Wire.setClock(100000);
+    return ok ? 0 : 1;
+}
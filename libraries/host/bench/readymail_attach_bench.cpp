@@ -0,0 +1,87 @@
+/*
+ * ReadyMail attachment upload to the SMTP sink over the loopback Client: a 2 MB binary
+ * attachment sent with the attachment buffer of one line (78 bytes, the previous 57-byte
+ * steps), 1 KB, 4 KB and 16 KB. One JSON line per buffer size with the MB/s, the client
+ * writes and the heap allocations per MB counted by the heap shim. The base64 the sink
+ * received must decode to the attachment. --quick sends 256 KB instead of 2 MB.
+ */
+#define ENABLE_SMTP
+#include <ReadyMail.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "support/SMTPServer.h"
+
+// The base64 lines of the attachment in the message without the line breaks
+static std::string attachmentBase64(const std::string &message)
+{
+    size_t p = message.find("cam.jpg");
+    p = p == std::string::npos ? p : message.find("\r\n\r\n", p);
+    if (p == std::string::npos)
+        return "";
+    size_t end = message.find("\r\n--", p + 4);
+    std::string out;
+    for (size_t i = p + 4; i < end && i < message.size(); i++)
+        if (message[i] != '\r' && message[i] != '\n')
+            out += message[i];
+    return out;
+}
+
+static bool run(int bufferSize, const std::vector<uint8_t> &blob, const std::string &expected)
+{
+    SMTPServer server;
+    LoopbackClient client(server);
+    SMTPClient smtp(client);
+    smtp.setAttachmentBufferSize(bufferSize);
+    smtp.connect("127.0.0.1", 25, nullptr, false);
+    smtp.authenticate("cam@example.com", "pw", readymail_auth_password);
+
+    SMTPMessage msg;
+    msg.headers.add(rfc822_subject, "Camera");
+    msg.headers.add(rfc822_from, "Cam <cam@example.com>");
+    msg.headers.add(rfc822_to, "Ops <ops@example.com>");
+    msg.text.body("Snapshot attached.\r\n");
+    msg.timestamp = 1746013620;
+    Attachment att;
+    att.filename = "cam.jpg";
+    att.name = "cam.jpg";
+    att.mime = "image/jpeg";
+    att.attach_file.blob = blob.data();
+    att.attach_file.blob_size = blob.size();
+    msg.attachments.add(att, attach_type_attachment);
+
+    unsigned long writes = client.writes;
+    size_t allocs = host::heapStats().allocs;
+    auto start = std::chrono::steady_clock::now();
+    bool ok = smtp.send(msg);
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double mb = blob.size() / 1048576.0;
+
+    printf("{\"buffer\":%d,\"bytes\":%zu,\"MB/s\":%.1f,\"writes_per_mb\":%.0f,\"allocs_per_mb\":%.0f}\n",
+           bufferSize, blob.size(), mb / s, (client.writes - writes) / mb, (host::heapStats().allocs - allocs) / mb);
+    return ok && server.messages.size() == 1 && attachmentBase64(server.messages[0]) == expected;
+}
+
+int main(int argc, char **argv)
+{
+    size_t size = argc > 1 && strcmp(argv[1], "--quick") == 0 ? 256 * 1024 : 2 * 1024 * 1024;
+    std::vector<uint8_t> blob(size);
+    uint32_t x = 2463534242UL;
+    for (uint8_t &b : blob)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        b = (uint8_t)x;
+    }
+    char *enc = rd_b64_enc(blob.data(), blob.size());
+    std::string expected = enc;
+    rd_free(&enc);
+
+    bool ok = true;
+    for (int bufferSize : {78, 1024, 4096, 16384})
+        ok = run(bufferSize, blob, expected) && ok;
+    return ok ? 0 : 1;
+}
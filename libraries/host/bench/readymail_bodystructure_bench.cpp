@@ -0,0 +1,19 @@
+/*
+ * The ReadyMail BODYSTRUCTURE benchmark sketch (examples/Codec/BodyStructure) on the host:
+ * the Gmail, Outlook and Dovecot responses and the deep multipart tree, with the
+ * allocations counted by the heap shim. --quick parses each response 20 times instead of 500.
+ */
+#include <string.h>
+
+static int bench_rounds = 500;
+#define BENCH_ROUNDS bench_rounds
+
+#include "../../ReadyMail/examples/Codec/BodyStructure/BodyStructure.ino"
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && strcmp(argv[1], "--quick") == 0)
+        bench_rounds = 20;
+    setup();
+    return 0;
+}
@@ -0,0 +1,18 @@
+/*
+ * The ReadyMail codec benchmark sketch (examples/Codec/Benchmark) on the host, with the
+ * allocations counted by the heap shim. --quick processes 16 KB per test instead of 256 KB.
+ */
+#include <string.h>
+
+static size_t bench_min_bytes = 256 * 1024;
+#define BENCH_MIN_BYTES bench_min_bytes
+
+#include "../../ReadyMail/examples/Codec/Benchmark/Benchmark.ino"
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && strcmp(argv[1], "--quick") == 0)
+        bench_min_bytes = 16 * 1024;
+    setup();
+    return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * The ReadyMail line reader on a replayed IMAP FETCH transcript, 20 MB of BODY[] responses
+ * with base64 attachments sent by the loopback server in TCP-sized segments. The lines are
+ * read per byte into a String as the previous readLine did, with ReadyLineReader::readLine
+ * and as the views of ReadyLineReader::read. One JSON line per mode with the MB/s, the line
+ * count and the checksum must match. --quick replays 1 MB instead of 20 MB.
+ */
+#define ENABLE_IMAP
+#include <ReadyMail.h>
+#include <LoopbackClient.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+// Sends the transcript in 1460 byte segments as the client reads
+class TranscriptServer : public LoopbackServer
+{
+public:
+    explicit TranscriptServer(const std::string &data) : _data(data) {}
+
+    void service(LoopbackPeer &peer) override
+    {
+        peer.consume(peer.available());
+        while (_sent < _data.size() && peer.pending() < 16384)
+        {
+            size_t n = std::min((size_t)1460, _data.size() - _sent);
+            peer.write(reinterpret_cast<const uint8_t *>(_data.data()) + _sent, n);
+            _sent += n;
+        }
+    }
+
+private:
+    const std::string &_data;
+    size_t _sent = 0;
+};
+
+static std::string transcript(size_t total)
+{
+    std::string s;
+    char line[128];
+    for (unsigned long i = 1; s.size() < total; i++)
+    {
+        std::string msg = "From: Sensor <sensor@example.com>\r\nTo: ops@example.com\r\nSubject: Report " + std::to_string(i) +
+                          "\r\nContent-Type: multipart/mixed; boundary=\"b1\"\r\n\r\n--b1\r\nContent-Type: text/plain\r\n\r\nDaily report\r\n"
+                          "--b1\r\nContent-Type: image/jpeg; name=\"cam.jpg\"\r\nContent-Transfer-Encoding: base64\r\n\r\n";
+        for (int l = 0; l < 2000; l++)
+        {
+            for (int k = 0; k < 76; k++)
+                line[k] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[(i * 7 + l * 13 + k) & 63];
+            msg.append(line, 76);
+            msg += "\r\n";
+        }
+        msg += "--b1--\r\n";
+        snprintf(line, sizeof(line), "* %lu FETCH (UID %lu BODY[] {%zu}\r\n", i, i + 1000, msg.size());
+        s += line;
+        s += msg;
+        snprintf(line, sizeof(line), ")\r\nA%lu OK FETCH completed\r\n", i);
+        s += line;
+    }
+    return s;
+}
+
+enum Mode
+{
+    per_byte,
+    read_line,
+    view
+};
+
+struct Result
+{
+    size_t bytes = 0, lines = 0;
+    uint32_t sum = 0;
+
+    void add(const char *p, size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+            sum = sum * 31 + (uint8_t)p[i];
+        bytes += n;
+    }
+};
+
+static bool run(Mode mode, const std::string &data, Result &ref)
+{
+    static const char *names[] = {"per_byte", "readLine", "view"};
+    TranscriptServer server(data);
+    LoopbackClient client(server);
+    client.connect("localhost", 993);
+    ReadyLineReader reader;
+    String line;
+    Result r;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int idle = 0; r.bytes < data.size() && idle < 1000;)
+    {
+        size_t got = r.bytes;
+        switch (mode)
+        {
+        case per_byte:
+        {
+            // The previous IMAPResponse::readLine
+            line.remove(0);
+            while (client.available())
+            {
+                int c = client.read();
+                line += (char)c;
+                if (c == '\n')
+                    break;
+            }
+            r.add(line.c_str(), line.length());
+            r.lines += line.length() > 0 && line[line.length() - 1] == '\n';
+            break;
+        }
+        case read_line:
+        {
+            line.remove(0);
+            int n = reader.readLine(&client, line);
+            if (n > 0)
+            {
+                r.add(line.c_str(), line.length());
+                r.lines += line[line.length() - 1] == '\n';
+            }
+            break;
+        }
+        case view:
+        {
+            const char *p = nullptr;
+            bool eol = false;
+            int n = reader.read(&client, p, 0, eol);
+            if (n > 0)
+                r.add(p, n);
+            r.lines += eol;
+            break;
+        }
+        }
+        idle = r.bytes > got ? 0 : idle + 1;
+    }
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    client.stop();
+
+    printf("{\"mode\":\"%s\",\"bytes\":%zu,\"lines\":%zu,\"checksum\":%u,\"MB/s\":%.1f}\n",
+           names[mode], r.bytes, r.lines, (unsigned)r.sum, r.bytes / 1048576.0 / s);
+    if (mode == per_byte)
+        ref = r;
+    return r.bytes == data.size() && r.lines == ref.lines && r.sum == ref.sum;
+}
+
+int main(int argc, char **argv)
+{
+    size_t total = argc > 1 && strcmp(argv[1], "--quick") == 0 ? 1024 * 1024 : 20 * 1024 * 1024;
+    std::string data = transcript(total);
+    Result ref;
+    bool ok = true;
+    for (Mode mode : {per_byte, read_line, view})
+        ok = run(mode, data, ref) && ok;
+    return ok ? 0 : 1;
+}
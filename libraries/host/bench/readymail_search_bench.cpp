@@ -0,0 +1,127 @@
+/*
+ * ReadyMail IMAPParser::parseSearch on a synthetic SEARCH response of 100k numbers, split
+ * into the 2 KB segments the line reader hands over, in server (ascending) and random
+ * order, with the recent sort limit of 10, 100 and 1000. The numbers kept must be the ones
+ * of the previous parseSearch (nextToken per number and push_back/erase(begin())), which is
+ * timed next to it. One JSON line per case with the ns per number. --quick uses 10k numbers.
+ */
+#define private public
+#define ENABLE_IMAP
+#include <ReadyMail.h>
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+using namespace ReadyMailIMAP;
+
+// The response segments, each ends with a space except the last one with CRLF
+static std::vector<String> segments(const std::vector<uint32_t> &nums)
+{
+    std::string line = "* SEARCH";
+    for (uint32_t n : nums)
+        line += " " + std::to_string(n);
+    line += "\r\n";
+
+    std::vector<String> segs;
+    for (size_t p = 0; p < line.size();)
+    {
+        size_t e = line.find(' ', p + 2047);
+        e = e == std::string::npos ? line.size() - 1 : e;
+        segs.push_back(String(line.substr(p, e - p + 1).c_str()));
+        p = e + 1;
+    }
+    return segs;
+}
+
+// The previous IMAPParser::parseSearch
+static void previousParseSearch(IMAPParser &parser, const String &line, imap_context *imap_ctx, std::vector<uint32_t> &imap_msg_num)
+{
+    if (line.indexOf(imap_ctx->tag) > -1)
+    {
+        if (imap_ctx->options.recent_sort)
+            std::sort(imap_msg_num.begin(), imap_msg_num.end(), compareMore);
+        return;
+    }
+
+    String token;
+    int beginIndex = 0, lastIndex = 0;
+    parser.getBoundary(line, "* SEARCH", line[line.length() - 1] == ' ' ? " " : "\r\n", beginIndex, lastIndex);
+    int i = beginIndex;
+
+    while (i <= lastIndex)
+    {
+        token = parser.nextToken(line, i, lastIndex);
+
+        if (token.length() == 0)
+            break;
+
+        imap_ctx->cb_data.msgFound++;
+        uint32_t msg_num = parser.numString.toNum(token.c_str());
+        if (imap_ctx->options.recent_sort)
+        {
+            imap_msg_num.push_back(msg_num);
+            if (imap_msg_num.size() > imap_ctx->options.search_limit)
+                imap_msg_num.erase(imap_msg_num.begin());
+        }
+        else if (imap_msg_num.size() < imap_ctx->options.search_limit)
+            imap_msg_num.push_back(msg_num);
+    }
+}
+
+// The seconds to parse the segments, the numbers kept in found and the count of numbers in count
+template <typename Parse>
+static double parse(const std::vector<String> &segs, size_t limit, std::vector<uint32_t> &found, int &count, Parse fn)
+{
+    IMAPParser parser;
+    imap_context ctx;
+    ctx.tag = "A1";
+    ctx.options.search_limit = limit;
+    ctx.options.recent_sort = true;
+    auto start = std::chrono::steady_clock::now();
+    for (const String &s : segs)
+        fn(parser, s, &ctx, found);
+    fn(parser, "A1 OK SEARCH completed\r\n", &ctx, found);
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    count = ctx.cb_data.messageFound();
+    return s;
+}
+
+static bool run(const char *order, const std::vector<uint32_t> &nums, size_t limit)
+{
+    std::vector<String> segs = segments(nums);
+    std::vector<uint32_t> found, ref;
+    int count = 0, refCount = 0;
+    double s = parse(segs, limit, found, count, [](IMAPParser &p, const String &line, imap_context *ctx, std::vector<uint32_t> &v)
+                     { p.parseSearch(line, ctx, v); });
+    double refS = parse(segs, limit, ref, refCount, previousParseSearch);
+
+    printf("{\"order\":\"%s\",\"numbers\":%zu,\"limit\":%zu,\"ns_per_number\":%.1f,\"previous_ns_per_number\":%.1f}\n",
+           order, nums.size(), limit, s * 1e9 / nums.size(), refS * 1e9 / nums.size());
+    return found == ref && found.size() == limit && count == (int)nums.size() && refCount == count;
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = argc > 1 && strcmp(argv[1], "--quick") == 0 ? 10000 : 100000;
+    std::vector<uint32_t> ascending(count), random(count);
+    uint32_t x = 2463534242UL;
+    for (size_t i = 0; i < count; i++)
+    {
+        ascending[i] = i * 3 + 1;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        random[i] = x % 1000000;
+    }
+
+    bool ok = true;
+    for (size_t limit : {10, 100, 1000})
+    {
+        ok = run("ascending", ascending, limit) && ok;
+        ok = run("random", random, limit) && ok;
+    }
+    return ok ? 0 : 1;
+}
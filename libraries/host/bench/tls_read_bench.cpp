@@ -0,0 +1,159 @@
+/*
+ * Decrypted read throughput of the TLS client from the loopback TLS server, 8 MB of
+ * IMAP-style lines read per byte, with read(buf, 512), through peekBuffer/peekConsume, and
+ * split into lines in the peek window as readLine does. The line count and the checksum
+ * must match in every mode. --quick reads 512 KB instead of 8 MB.
+ */
+#include <client/SSLClient/ESP_SSLClient.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include "support/TLSServer.h"
+#include "support/test_certs.h"
+
+// Sends the lines once the client connects
+class LineServer : public LoopbackServer
+{
+public:
+    explicit LineServer(const std::string &data) : _data(data) {}
+
+    void accept(LoopbackPeer &peer) override
+    {
+        (void)peer;
+        _sent = 0;
+    }
+
+    void service(LoopbackPeer &peer) override
+    {
+        peer.consume(peer.available());
+        // The TLS server takes the data as it has room for it
+        while (_sent < _data.size() && peer.pending() < 65536)
+        {
+            size_t n = std::min((size_t)16384, _data.size() - _sent);
+            peer.write(reinterpret_cast<const uint8_t *>(_data.data()) + _sent, n);
+            _sent += n;
+        }
+    }
+
+private:
+    const std::string &_data;
+    size_t _sent = 0;
+};
+
+enum Mode
+{
+    per_byte,
+    buffered,
+    peek,
+    lines
+};
+
+struct Result
+{
+    size_t bytes = 0;
+    size_t lines = 0;
+    uint32_t sum = 0;
+
+    void add(uint8_t c)
+    {
+        bytes++;
+        sum = sum * 31 + c;
+        if (c == '\n')
+            lines++;
+    }
+};
+
+static std::string makeLines(size_t total)
+{
+    std::string s;
+    char line[96];
+    for (unsigned long i = 1; s.size() < total; i++)
+    {
+        snprintf(line, sizeof(line), "* %lu FETCH (UID %lu FLAGS (\\Seen) RFC822.SIZE %lu)\r\n", i, i * 7, (i * 2654435761UL) % 100000);
+        s += line;
+    }
+    return s;
+}
+
+static bool run(Mode mode, const std::string &data, Result &ref)
+{
+    static const char *names[] = {"read", "read(buf, 512)", "peekBuffer", "lines"};
+    LineServer app(data);
+    TLSServer server(test_srva_der, sizeof(test_srva_der), test_srva_key, sizeof(test_srva_key), &app);
+    LoopbackClient tcp(server);
+    ESP_SSLClient ssl;
+    ssl.setClient(&tcp);
+    ssl.setInsecure();
+    ssl.setBufferSizes(16384, 512);
+    if (!ssl.connect("localhost", 993))
+        return false;
+    ssl.print("a1 FETCH 1:* (UID FLAGS RFC822.SIZE)\r\n");
+
+    Result r;
+    auto start = std::chrono::steady_clock::now();
+    for (int idle = 0; r.bytes < data.size() && idle < 1000;)
+    {
+        size_t got = r.bytes;
+        switch (mode)
+        {
+        case per_byte:
+        {
+            int c = ssl.read();
+            if (c >= 0)
+                r.add(c);
+            break;
+        }
+        case buffered:
+        {
+            uint8_t buf[512];
+            int n = ssl.read(buf, sizeof(buf));
+            for (int i = 0; i < n; i++)
+                r.add(buf[i]);
+            break;
+        }
+        case peek:
+        case lines:
+        {
+            if (ssl.available() <= 0)
+                break;
+            size_t len = 0;
+            const char *p = ssl.peekBuffer(len);
+            if (mode == peek)
+            {
+                for (size_t i = 0; i < len; i++)
+                    r.add(p[i]);
+                ssl.peekConsume(len);
+                break;
+            }
+            // Up to and including the line break, the rest of the line is in the next window
+            const char *eol = reinterpret_cast<const char *>(memchr(p, '\n', len));
+            size_t n = eol ? eol - p + 1 : len;
+            for (size_t i = 0; i < n; i++)
+                r.add(p[i]);
+            ssl.peekConsume(n);
+            break;
+        }
+        }
+        idle = r.bytes > got ? 0 : idle + 1;
+    }
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ssl.stop();
+
+    printf("{\"mode\":\"%s\",\"bytes\":%zu,\"lines\":%zu,\"checksum\":%u,\"MB/s\":%.1f}\n",
+           names[mode], r.bytes, r.lines, (unsigned)r.sum, r.bytes / 1048576.0 / s);
+    if (mode == per_byte)
+        ref = r;
+    return r.bytes == data.size() && r.lines == ref.lines && r.sum == ref.sum;
+}
+
+int main(int argc, char **argv)
+{
+    size_t total = argc > 1 && strcmp(argv[1], "--quick") == 0 ? 512 * 1024 : 8 * 1024 * 1024;
+    std::string data = makeLines(total);
+    Result ref;
+    bool ok = true;
+    for (Mode mode : {per_byte, buffered, peek, lines})
+        ok = run(mode, data, ref) && ok;
+    return ok ? 0 : 1;
+}
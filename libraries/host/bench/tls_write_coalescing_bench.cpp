@@ -0,0 +1,124 @@
+/*
+ * TLS records per MB and MB/s of the 76 + 2 byte line writes, the base64 body of an
+ * attachment, to the loopback TLS sink. The plain writes poll available() after each line
+ * as the mail client did, the coalesced writes do not run the engine until the record is
+ * full, the corked writes only send full records. --quick sends 256 KB instead of 4 MB.
+ */
+#include <client/SSLClient/ESP_SSLClient.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include "support/TLSServer.h"
+#include "support/test_certs.h"
+
+// Counts the TLS records in the client's output
+class RecordClient : public LoopbackClient
+{
+public:
+    using LoopbackClient::LoopbackClient;
+    using LoopbackClient::write;
+
+    unsigned long records = 0;
+
+    size_t write(const uint8_t *buf, size_t size) override
+    {
+        for (size_t i = 0; i < size;)
+        {
+            if (_left)
+            {
+                size_t n = std::min(_left, size - i);
+                _left -= n;
+                i += n;
+                continue;
+            }
+            _hdr[_hdrLen++] = buf[i++];
+            if (_hdrLen == 5)
+            {
+                _left = (_hdr[3] << 8) | _hdr[4];
+                _hdrLen = 0;
+                if (_hdr[0] == 23)
+                    records++;
+            }
+        }
+        return LoopbackClient::write(buf, size);
+    }
+
+private:
+    uint8_t _hdr[5];
+    size_t _hdrLen = 0;
+    size_t _left = 0;
+};
+
+// Counts the received application data
+class SinkServer : public LoopbackServer
+{
+public:
+    size_t received = 0;
+
+    void service(LoopbackPeer &peer) override
+    {
+        received += peer.available();
+        peer.consume(peer.available());
+    }
+};
+
+enum Mode
+{
+    plain,
+    coalesced,
+    corked
+};
+
+static bool run(Mode mode, int xmit, size_t total)
+{
+    static const char *names[] = {"plain", "coalesced", "corked"};
+    SinkServer app;
+    TLSServer server(test_srva_der, sizeof(test_srva_der), test_srva_key, sizeof(test_srva_key), &app);
+    RecordClient tcp(server);
+    ESP_SSLClient ssl;
+    ssl.setClient(&tcp);
+    ssl.setInsecure();
+    ssl.setBufferSizes(16384, xmit);
+    ssl.setWriteCoalescing(mode != plain, 0);
+    if (!ssl.connect("localhost", 465))
+        return false;
+    if (mode == corked)
+        ssl.cork();
+
+    uint8_t line[78];
+    memset(line, 'A', 76);
+    line[76] = '\r';
+    line[77] = '\n';
+    size_t lines = total / sizeof(line);
+    unsigned long records = tcp.records;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < lines; i++)
+    {
+        ssl.write(line, sizeof(line));
+        if (mode == plain)
+            ssl.available();
+    }
+    if (mode == corked)
+        ssl.uncork();
+    ssl.flush();
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t bytes = lines * sizeof(line);
+    double mb = bytes / 1048576.0;
+    printf("{\"mode\":\"%s\",\"xmit\":%d,\"bytes\":%zu,\"records/MB\":%.0f,\"MB/s\":%.1f}\n",
+           names[mode], xmit, bytes, (tcp.records - records) / mb, mb / s);
+    bool ok = app.received == bytes;
+    ssl.stop();
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    size_t total = argc > 1 && strcmp(argv[1], "--quick") == 0 ? 256 * 1024 : 4 * 1024 * 1024;
+    bool ok = true;
+    for (int xmit : {1024, 4096, 16384})
+        for (Mode mode : {plain, coalesced, corked})
+            ok = run(mode, xmit, total) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,116 @@
+/*
+ * Minimal Arduino core for building the libraries on a Linux host.
+ *
+ * Only the parts of the Arduino API that the libraries in this tree use are
+ * provided. The time, pin and heap hooks in the host namespace let the tests
+ * run the drivers against simulated hardware in virtual time.
+ */
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <ctype.h>
+#include <math.h>
+#include <inttypes.h>
+#include <algorithm>
+
+// The IDE passes ARDUINO on the command line, so does CMakeLists.txt
+#ifndef ARDUINO
+#define ARDUINO 10819
+#endif
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint16_t word;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define PI 3.1415926535897932384626433832795
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define lowByte(w) ((uint8_t)((w) & 0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bit(b) (1UL << (b))
+
+using std::max;
+using std::min;
+
+template <typename T, typename L, typename H>
+inline T constrain(T x, L lo, H hi) { return x < lo ? lo : (x > hi ? hi : x); }
+
+#include "pgmspace.h"
+#include "binary.h"
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+class HostPins;
+
+namespace host
+{
+    // Virtual time: millis() and micros() only move with delay(), delayMicroseconds()
+    // and advanceMicros(), so a test sees the exact time the code under test waited.
+    void setVirtualClock(bool enable);
+    bool virtualClock();
+    void advanceMicros(uint64_t us);
+    uint64_t nowMicros();
+
+    // Route pinMode/digitalWrite/digitalRead to a simulated device, nullptr to detach
+    void setPins(HostPins *pins);
+
+    // The heap counters of the malloc shim (HostHeap.cpp)
+    struct HeapStats
+    {
+        size_t allocs;   // malloc, calloc, the aligned allocations and the blocks realloc moved
+        size_t frees;
+        size_t bytes;    // bytes in use
+        size_t peak;     // the largest bytes in use since resetHeapPeak()
+    };
+    const HeapStats &heapStats();
+    void resetHeapPeak();
+}
+
+// The simulated hardware behind the pin functions
+class HostPins
+{
+public:
+    virtual ~HostPins() {}
+    virtual void pinMode(uint8_t pin, uint8_t mode) { (void)pin, (void)mode; }
+    virtual void digitalWrite(uint8_t pin, uint8_t val) { (void)pin, (void)val; }
+    virtual int digitalRead(uint8_t pin) { (void)pin; return LOW; }
+};
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "IPAddress.h"
+#include "HardwareSerial.h"
+
+#endif
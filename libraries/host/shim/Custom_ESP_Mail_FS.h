@@ -0,0 +1,11 @@
+/*
+ * ESP_Mail_Client build options of the host build, picked up by ESP_Mail_FS.h: the flash
+ * storage is LittleFS on a host directory.
+ */
+#ifndef HOST_CUSTOM_ESP_MAIL_FS_H
+#define HOST_CUSTOM_ESP_MAIL_FS_H
+
+#include <LittleFS.h>
+#define ESP_MAIL_DEFAULT_FLASH_FS LittleFS
+
+#endif
@@ -0,0 +1,42 @@
+/*
+ * Host implementation of the FS in FS.h.
+ */
+#include <FS.h>
+#include <LittleFS.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+fs::FS LittleFS;
+
+namespace fs
+{
+    File FS::open(const char *path, const char *mode)
+    {
+        // The binary modes, a file opened for writing can also be read back
+        std::string m = mode;
+        if (m == "r")
+            m = "rb";
+        else if (m == "w")
+            m = "w+b";
+        else if (m == "a")
+            m = "a+b";
+        FILE *f = fopen(hostPath(path).c_str(), m.c_str());
+        if (f)
+            opens++;
+        return File(f, path);
+    }
+
+    bool FS::exists(const char *path)
+    {
+        struct stat st;
+        return stat(hostPath(path).c_str(), &st) == 0;
+    }
+
+    bool FS::remove(const char *path) { return ::remove(hostPath(path).c_str()) == 0; }
+
+    bool FS::rename(const char *pathFrom, const char *pathTo) { return ::rename(hostPath(pathFrom).c_str(), hostPath(pathTo).c_str()) == 0; }
+
+    bool FS::mkdir(const char *path) { return ::mkdir(hostPath(path).c_str(), 0755) == 0; }
+
+    bool FS::rmdir(const char *path) { return ::rmdir(hostPath(path).c_str()) == 0; }
+}
@@ -0,0 +1,130 @@
+/*
+ * Arduino (ESP32 style) FS on a host directory.
+ */
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+#include <stdio.h>
+#include <string>
+#include "Stream.h"
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs
+{
+    enum SeekMode
+    {
+        SeekSet = 0,
+        SeekCur = 1,
+        SeekEnd = 2
+    };
+
+    class File : public Stream
+    {
+    public:
+        File() {}
+        explicit File(FILE *f, const char *name = "") : _f(f), _name(name) {}
+        File(const File &) = delete;
+        File &operator=(const File &) = delete;
+        File(File &&other) { *this = static_cast<File &&>(other); }
+        File &operator=(File &&other)
+        {
+            if (this != &other)
+            {
+                close();
+                _f = other._f;
+                _name = other._name;
+                other._f = nullptr;
+            }
+            return *this;
+        }
+        ~File() { close(); }
+
+        size_t write(uint8_t c) override { return _f ? fwrite(&c, 1, 1, _f) : 0; }
+        size_t write(const uint8_t *buf, size_t size) override { return _f ? fwrite(buf, 1, size, _f) : 0; }
+        using Print::write;
+        int available() override { return _f ? (int)(size() - position()) : 0; }
+        int read() override { return _f ? fgetc(_f) : -1; }
+        size_t read(uint8_t *buf, size_t size) { return _f ? fread(buf, 1, size, _f) : 0; }
+        size_t readBytes(char *buffer, size_t length) override { return read(reinterpret_cast<uint8_t *>(buffer), length); }
+        int peek() override
+        {
+            if (!_f)
+                return -1;
+            int c = fgetc(_f);
+            if (c >= 0)
+                ungetc(c, _f);
+            return c;
+        }
+        void flush() override
+        {
+            if (_f)
+                fflush(_f);
+        }
+        bool seek(uint32_t pos, SeekMode mode = SeekSet) { return _f && fseek(_f, pos, mode == SeekSet ? SEEK_SET : (mode == SeekCur ? SEEK_CUR : SEEK_END)) == 0; }
+        size_t position() const { return _f ? ftell(_f) : 0; }
+        size_t size() const
+        {
+            if (!_f)
+                return 0;
+            long cur = ftell(_f);
+            fseek(_f, 0, SEEK_END);
+            long end = ftell(_f);
+            fseek(_f, cur, SEEK_SET);
+            return end;
+        }
+        void close()
+        {
+            if (_f)
+                fclose(_f);
+            _f = nullptr;
+        }
+        const char *name() const { return _name.c_str(); }
+        operator bool() const { return _f != nullptr; }
+
+    private:
+        FILE *_f = nullptr;
+        std::string _name;
+    };
+
+    // The paths are relative to the root directory
+    class FS
+    {
+    public:
+        explicit FS(const char *root = ".") : _root(root) {}
+        void setRoot(const char *root) { _root = root; }
+        bool begin(bool formatOnFail = false)
+        {
+            (void)formatOnFail;
+            return true;
+        }
+        void end() {}
+        File open(const char *path, const char *mode = FILE_READ);
+        File open(const String &path, const char *mode = FILE_READ) { return open(path.c_str(), mode); }
+        bool exists(const char *path);
+        bool exists(const String &path) { return exists(path.c_str()); }
+        bool remove(const char *path);
+        bool remove(const String &path) { return remove(path.c_str()); }
+        bool rename(const char *pathFrom, const char *pathTo);
+        bool mkdir(const char *path);
+        bool rmdir(const char *path);
+
+        // The files opened, for the tests
+        unsigned long opens = 0;
+
+    private:
+        std::string _root;
+        std::string hostPath(const char *path) const { return _root + (path[0] == '/' ? "" : "/") + path; }
+    };
+}
+
+using fs::File;
+using fs::FS;
+using fs::SeekCur;
+using fs::SeekEnd;
+using fs::SeekMode;
+using fs::SeekSet;
+
+#endif
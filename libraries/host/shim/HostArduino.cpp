@@ -0,0 +1,161 @@
+/*
+ * Host implementation of the Arduino core functions declared in Arduino.h and Wire.h.
+ */
+#include <Arduino.h>
+#include <Wire.h>
+#include <chrono>
+#include <thread>
+#include <random>
+
+HardwareSerial Serial;
+TwoWire Wire;
+
+namespace
+{
+    bool g_virtual = false;
+    uint64_t g_virtualUs = 0;
+    HostPins *g_pins = nullptr;
+    std::mt19937 g_random(1);
+
+    uint64_t realMicros()
+    {
+        static const auto start = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+namespace host
+{
+    void setVirtualClock(bool enable)
+    {
+        if (enable && !g_virtual)
+            g_virtualUs = realMicros();
+        g_virtual = enable;
+    }
+
+    bool virtualClock() { return g_virtual; }
+
+    void advanceMicros(uint64_t us)
+    {
+        if (g_virtual)
+            g_virtualUs += us;
+        else
+            std::this_thread::sleep_for(std::chrono::microseconds(us));
+    }
+
+    uint64_t nowMicros() { return g_virtual ? g_virtualUs : realMicros(); }
+
+    void setPins(HostPins *pins) { g_pins = pins; }
+}
+
+unsigned long millis() { return (unsigned long)(host::nowMicros() / 1000); }
+
+unsigned long micros() { return (unsigned long)host::nowMicros(); }
+
+void delay(unsigned long ms) { host::advanceMicros((uint64_t)ms * 1000); }
+
+void delayMicroseconds(unsigned int us) { host::advanceMicros(us); }
+
+void yield()
+{
+    if (!g_virtual)
+        std::this_thread::yield();
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    if (g_pins)
+        g_pins->pinMode(pin, mode);
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    if (g_pins)
+        g_pins->digitalWrite(pin, val);
+}
+
+int digitalRead(uint8_t pin) { return g_pins ? g_pins->digitalRead(pin) : LOW; }
+
+int analogRead(uint8_t pin)
+{
+    (void)pin;
+    return 0;
+}
+
+long random(long howbig)
+{
+    if (howbig <= 0)
+        return 0;
+    return (long)(g_random() % (unsigned long)howbig);
+}
+
+long random(long howsmall, long howbig)
+{
+    if (howsmall >= howbig)
+        return howsmall;
+    return howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed)
+{
+    if (seed != 0)
+        g_random.seed(seed);
+}
+
+void TwoWire::beginTransmission(uint8_t address)
+{
+    _address = address;
+    _len = 0;
+    _transmitting = true;
+}
+
+size_t TwoWire::write(uint8_t data)
+{
+    if (!_transmitting || _len >= BUFFER_LENGTH)
+    {
+        overflows++;
+        return 0;
+    }
+    _buf[_len++] = data;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity)
+{
+    size_t n = 0;
+    while (n < quantity && write(data[n]))
+        n++;
+    return n;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop)
+{
+    (void)sendStop;
+    if (!_transmitting)
+        return 4;
+    _transmitting = false;
+    transmissions++;
+    bytes += _len + 1;
+
+    // The start condition and the address byte (9 bit times with the ACK)
+    double bitUs = 1e6 / _clock;
+    double us = bitUs * 10;
+    uint64_t sent = 0;
+    for (size_t i = 0; i < _len; i++)
+    {
+        us += bitUs * 9;
+        if (host::virtualClock())
+        {
+            host::advanceMicros((uint64_t)us - sent);
+            sent = (uint64_t)us;
+        }
+        if (_device)
+            _device->receive(_address, _buf[i]);
+    }
+    // The stop condition
+    us += bitUs;
+    if (host::virtualClock())
+        host::advanceMicros((uint64_t)us - sent);
+    _len = 0;
+    return _device ? 0 : 2;
+}
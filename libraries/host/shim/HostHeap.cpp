@@ -0,0 +1,113 @@
+/*
+ * Heap counters for the host build.
+ *
+ * malloc and friends are replaced by wrappers around the glibc allocator, so every
+ * allocation of the code under test is counted, including those of String, operator
+ * new and the C libraries, whichever translation unit makes them.
+ */
+#include <Arduino.h>
+#include <errno.h>
+#include <malloc.h>
+#include <atomic>
+
+extern "C"
+{
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t nmemb, size_t size);
+    void *__libc_realloc(void *ptr, size_t size);
+    void *__libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void *ptr);
+}
+
+namespace
+{
+    std::atomic<size_t> g_allocs(0), g_frees(0), g_bytes(0), g_peak(0);
+    host::HeapStats g_stats;
+
+    void *counted(void *p)
+    {
+        if (!p)
+            return p;
+        g_allocs++;
+        size_t bytes = g_bytes += malloc_usable_size(p);
+        size_t peak = g_peak;
+        while (bytes > peak && !g_peak.compare_exchange_weak(peak, bytes))
+            ;
+        return p;
+    }
+
+    void uncount(void *p)
+    {
+        if (!p)
+            return;
+        g_frees++;
+        g_bytes -= malloc_usable_size(p);
+    }
+}
+
+namespace host
+{
+    const HeapStats &heapStats()
+    {
+        g_stats.allocs = g_allocs;
+        g_stats.frees = g_frees;
+        g_stats.bytes = g_bytes;
+        g_stats.peak = g_peak;
+        return g_stats;
+    }
+
+    void resetHeapPeak() { g_peak = g_bytes.load(); }
+}
+
+extern "C"
+{
+    void *malloc(size_t size) { return counted(__libc_malloc(size)); }
+
+    void *calloc(size_t nmemb, size_t size) { return counted(__libc_calloc(nmemb, size)); }
+
+    void free(void *ptr)
+    {
+        uncount(ptr);
+        __libc_free(ptr);
+    }
+
+    void *realloc(void *ptr, size_t size)
+    {
+        if (!ptr)
+            return malloc(size);
+        if (!size)
+        {
+            free(ptr);
+            return nullptr;
+        }
+        size_t old = malloc_usable_size(ptr);
+        void *p = __libc_realloc(ptr, size);
+        if (!p)
+            return p;
+        // A block that moved is a new allocation, one that grew in place is not
+        if (p != ptr)
+        {
+            g_frees++;
+            g_bytes -= old;
+            return counted(p);
+        }
+        size_t bytes = g_bytes += malloc_usable_size(p) - old;
+        size_t peak = g_peak;
+        while (bytes > peak && !g_peak.compare_exchange_weak(peak, bytes))
+            ;
+        return p;
+    }
+
+    void *memalign(size_t alignment, size_t size) { return counted(__libc_memalign(alignment, size)); }
+
+    void *aligned_alloc(size_t alignment, size_t size) { return counted(__libc_memalign(alignment, size)); }
+
+    int posix_memalign(void **memptr, size_t alignment, size_t size)
+    {
+        void *p = counted(__libc_memalign(alignment, size));
+        if (!p)
+            return ENOMEM;
+        *memptr = p;
+        return 0;
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * Arduino IPAddress (IPv4).
+ */
+#ifndef HOST_IPADDRESS_H
+#define HOST_IPADDRESS_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "WString.h"
+
+class IPAddress
+{
+public:
+    IPAddress() {}
+    IPAddress(uint8_t first_octet, uint8_t second_octet, uint8_t third_octet, uint8_t fourth_octet)
+    {
+        _address[0] = first_octet;
+        _address[1] = second_octet;
+        _address[2] = third_octet;
+        _address[3] = fourth_octet;
+    }
+    IPAddress(uint32_t address) { memcpy(_address, &address, 4); }
+    IPAddress(const uint8_t *address) { memcpy(_address, address, 4); }
+
+    bool fromString(const char *address)
+    {
+        int octet = 0, acc = -1;
+        uint8_t out[4];
+        for (const char *p = address;; p++)
+        {
+            if (*p >= '0' && *p <= '9')
+            {
+                acc = (acc < 0 ? 0 : acc * 10) + (*p - '0');
+                if (acc > 255)
+                    return false;
+            }
+            else if (*p == '.' || *p == 0)
+            {
+                if (acc < 0 || octet > 3)
+                    return false;
+                out[octet++] = acc;
+                acc = -1;
+                if (*p == 0)
+                    break;
+            }
+            else
+                return false;
+        }
+        if (octet != 4)
+            return false;
+        memcpy(_address, out, 4);
+        return true;
+    }
+    bool fromString(const String &address) { return fromString(address.c_str()); }
+
+    operator uint32_t() const
+    {
+        uint32_t v;
+        memcpy(&v, _address, 4);
+        return v;
+    }
+    bool operator==(const IPAddress &addr) const { return memcmp(_address, addr._address, 4) == 0; }
+    bool operator!=(const IPAddress &addr) const { return !(*this == addr); }
+    uint8_t operator[](int index) const { return _address[index]; }
+    uint8_t &operator[](int index) { return _address[index]; }
+
+    String toString() const
+    {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%u.%u.%u.%u", _address[0], _address[1], _address[2], _address[3]);
+        return String(buf);
+    }
+
+private:
+    uint8_t _address[4] = {0, 0, 0, 0};
+};
+
+#endif
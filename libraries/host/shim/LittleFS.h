@@ -0,0 +1,12 @@
+/*
+ * The LittleFS object of the ESP cores, the FS shim on a host directory. The root is the
+ * working directory unless the test sets it with LittleFS.setRoot().
+ */
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+#include "FS.h"
+
+extern fs::FS LittleFS;
+
+#endif
@@ -0,0 +1,207 @@
+/*
+ * In-memory loopback Client for the host tests.
+ *
+ * The client end is an Arduino Client, the server end is a LoopbackServer that runs in
+ * the same thread. The server is serviced whenever the client writes or polls for data,
+ * so a request is answered before the client's next available() or read().
+ */
+#ifndef HOST_LOOPBACK_CLIENT_H
+#define HOST_LOOPBACK_CLIENT_H
+
+#include <string>
+#include "Client.h"
+
+// A byte queue, the consumed front is dropped in large steps
+class HostPipe
+{
+public:
+    size_t size() const { return _buf.size() - _off; }
+    const uint8_t *data() const { return reinterpret_cast<const uint8_t *>(_buf.data()) + _off; }
+    void push(const uint8_t *data, size_t len) { _buf.append(reinterpret_cast<const char *>(data), len); }
+    void consume(size_t len)
+    {
+        _off += len < size() ? len : size();
+        if (_off == _buf.size())
+            clear();
+        else if (_off > 65536)
+        {
+            _buf.erase(0, _off);
+            _off = 0;
+        }
+    }
+    size_t read(uint8_t *buf, size_t len)
+    {
+        if (len > size())
+            len = size();
+        memcpy(buf, data(), len);
+        consume(len);
+        return len;
+    }
+    void clear()
+    {
+        _buf.clear();
+        _off = 0;
+    }
+
+private:
+    std::string _buf;
+    size_t _off = 0;
+};
+
+class LoopbackClient;
+
+// The server end of a loopback connection
+class LoopbackPeer
+{
+public:
+    explicit LoopbackPeer(LoopbackClient &client) : _client(client) {}
+    size_t available() const;
+    const uint8_t *data() const;
+    void consume(size_t len);
+    size_t read(uint8_t *buf, size_t len);
+    size_t write(const uint8_t *buf, size_t len);
+    size_t write(const std::string &s) { return write(reinterpret_cast<const uint8_t *>(s.data()), s.size()); }
+    size_t write(const char *s) { return write(reinterpret_cast<const uint8_t *>(s), strlen(s)); }
+    // Space the client may still read before the server should stop producing
+    size_t pending() const;
+    void close();
+    bool connected() const;
+
+private:
+    LoopbackClient &_client;
+};
+
+class LoopbackServer
+{
+public:
+    virtual ~LoopbackServer() {}
+    // A client connected, e.g. send the greeting
+    virtual void accept(LoopbackPeer &peer) { (void)peer; }
+    // Consume what the client sent and produce the reply
+    virtual void service(LoopbackPeer &peer) = 0;
+    // The client closed the connection
+    virtual void closed(LoopbackPeer &peer) { (void)peer; }
+};
+
+class LoopbackClient : public Client
+{
+public:
+    LoopbackClient() : _peer(*this) {}
+    explicit LoopbackClient(LoopbackServer &server) : _server(&server), _peer(*this) {}
+    LoopbackClient(const LoopbackClient &) = delete;
+    LoopbackClient &operator=(const LoopbackClient &) = delete;
+
+    void setServer(LoopbackServer *server) { _server = server; }
+
+    int connect(IPAddress ip, uint16_t port) override
+    {
+        (void)ip;
+        return connect("", port);
+    }
+    int connect(const char *host, uint16_t port) override
+    {
+        (void)host, (void)port;
+        if (!_server)
+            return 0;
+        _toServer.clear();
+        _toClient.clear();
+        _connected = true;
+        connects++;
+        _server->accept(_peer);
+        return 1;
+    }
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buf, size_t size) override
+    {
+        if (!_connected)
+            return 0;
+        writes++;
+        bytesSent += size;
+        _wrote = true;
+        _toServer.push(buf, size);
+        _server->service(_peer);
+        return size;
+    }
+    using Print::write;
+    int available() override
+    {
+        poll();
+        return _toClient.size();
+    }
+    int read() override
+    {
+        uint8_t c;
+        return read(&c, 1) == 1 ? c : -1;
+    }
+    int read(uint8_t *buf, size_t size) override
+    {
+        poll();
+        if (!_toClient.size())
+            return -1;
+        reads++;
+        size = _toClient.read(buf, size);
+        bytesReceived += size;
+        return size;
+    }
+    int peek() override
+    {
+        poll();
+        return _toClient.size() ? _toClient.data()[0] : -1;
+    }
+    void flush() override {}
+    void stop() override
+    {
+        if (_connected && _server)
+            _server->closed(_peer);
+        _connected = false;
+    }
+    uint8_t connected() override { return _connected || _toClient.size(); }
+    operator bool() override { return _connected; }
+
+    // The statistics of the client end
+    unsigned long connects = 0;
+    unsigned long writes = 0;
+    unsigned long reads = 0;
+    unsigned long roundTrips = 0; // the reads of data produced after the client's last write
+    size_t bytesSent = 0;
+    size_t bytesReceived = 0;
+
+private:
+    friend class LoopbackPeer;
+    LoopbackServer *_server = nullptr;
+    LoopbackPeer _peer;
+    HostPipe _toServer, _toClient;
+    bool _connected = false;
+    bool _wrote = false;
+    bool _served = false;
+
+    void poll()
+    {
+        if (_connected && _server)
+            _server->service(_peer);
+        if (_wrote && _served)
+        {
+            roundTrips++;
+            _served = false;
+        }
+        _wrote = false;
+    }
+};
+
+inline size_t LoopbackPeer::available() const { return _client._toServer.size(); }
+inline const uint8_t *LoopbackPeer::data() const { return _client._toServer.data(); }
+inline void LoopbackPeer::consume(size_t len) { _client._toServer.consume(len); }
+inline size_t LoopbackPeer::read(uint8_t *buf, size_t len) { return _client._toServer.read(buf, len); }
+inline size_t LoopbackPeer::write(const uint8_t *buf, size_t len)
+{
+    if (!_client._connected)
+        return 0;
+    _client._toClient.push(buf, len);
+    _client._served = true;
+    return len;
+}
+inline size_t LoopbackPeer::pending() const { return _client._toClient.size(); }
+inline void LoopbackPeer::close() { _client._connected = false; }
+inline bool LoopbackPeer::connected() const { return _client._connected; }
+
+#endif
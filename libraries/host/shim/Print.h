@@ -0,0 +1,111 @@
+/*
+ * Arduino Print.
+ */
+#ifndef HOST_PRINT_H
+#define HOST_PRINT_H
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "WString.h"
+
+class Print;
+
+class Printable
+{
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print &p) const = 0;
+};
+
+class Print
+{
+public:
+    Print() {}
+    virtual ~Print() {}
+
+    int getWriteError() { return write_error; }
+    void clearWriteError() { setWriteError(0); }
+
+    virtual size_t write(uint8_t) = 0;
+    size_t write(const char *str) { return str ? write(reinterpret_cast<const uint8_t *>(str), strlen(str)) : 0; }
+    virtual size_t write(const uint8_t *buffer, size_t size)
+    {
+        size_t n = 0;
+        while (size--)
+        {
+            if (write(*buffer++))
+                n++;
+            else
+                break;
+        }
+        return n;
+    }
+    size_t write(const char *buffer, size_t size) { return write(reinterpret_cast<const uint8_t *>(buffer), size); }
+
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)))
+    {
+        char buf[256];
+        va_list arg;
+        va_start(arg, format);
+        int len = vsnprintf(buf, sizeof(buf), format, arg);
+        va_end(arg);
+        if (len < 0)
+            return 0;
+        if (len < (int)sizeof(buf))
+            return write(buf, len);
+        char *tmp = new char[len + 1];
+        va_start(arg, format);
+        vsnprintf(tmp, len + 1, format, arg);
+        va_end(arg);
+        size_t n = write(tmp, len);
+        delete[] tmp;
+        return n;
+    }
+
+    size_t print(const __FlashStringHelper *s) { return write(reinterpret_cast<const char *>(s)); }
+    size_t print(const String &s) { return write(s.c_str(), s.length()); }
+    size_t print(const char str[]) { return write(str); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char n, int base = DEC_BASE) { return printNumber(n, base); }
+    size_t print(int n, int base = DEC_BASE) { return printSigned(n, base); }
+    size_t print(unsigned int n, int base = DEC_BASE) { return printNumber(n, base); }
+    size_t print(long n, int base = DEC_BASE) { return printSigned(n, base); }
+    size_t print(unsigned long n, int base = DEC_BASE) { return printNumber(n, base); }
+    size_t print(long long n, int base = DEC_BASE) { return printSigned(n, base); }
+    size_t print(unsigned long long n, int base = DEC_BASE) { return printNumber(n, base); }
+    size_t print(double n, int digits = 2) { return print(String(n, (unsigned char)digits)); }
+    size_t print(const Printable &x) { return x.printTo(*this); }
+
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(const T &x) { return print(x) + println(); }
+    template <typename T>
+    size_t println(const T &x, int format) { return print(x, format) + println(); }
+
+protected:
+    void setWriteError(int err = 1) { write_error = err; }
+
+private:
+    enum { DEC_BASE = 10 };
+    int write_error = 0;
+
+    size_t printNumber(unsigned long long n, int base)
+    {
+        if (base == 0)
+            return write((uint8_t)n);
+        return print(String(n, (unsigned char)base));
+    }
+    size_t printSigned(long long n, int base)
+    {
+        if (base == 0)
+            return write((uint8_t)n);
+        return print(String(n, (unsigned char)base));
+    }
+};
+
+#endif
@@ -0,0 +1,7 @@
+/*
+ * SPI of the Arduino core, included by the file system code but not used on the host.
+ */
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ * Arduino Stream. The timed reads give up as soon as nothing is available,
+ * the in-memory peers of the host tests answer synchronously.
+ */
+#ifndef HOST_STREAM_H
+#define HOST_STREAM_H
+
+#include "Print.h"
+
+unsigned long millis();
+
+class Stream : public Print
+{
+public:
+    Stream() {}
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+    unsigned long getTimeout() const { return _timeout; }
+
+    virtual size_t readBytes(char *buffer, size_t length)
+    {
+        size_t count = 0;
+        while (count < length)
+        {
+            int c = timedRead();
+            if (c < 0)
+                break;
+            *buffer++ = (char)c;
+            count++;
+        }
+        return count;
+    }
+    size_t readBytes(uint8_t *buffer, size_t length) { return readBytes(reinterpret_cast<char *>(buffer), length); }
+
+    size_t readBytesUntil(char terminator, char *buffer, size_t length)
+    {
+        size_t index = 0;
+        while (index < length)
+        {
+            int c = timedRead();
+            if (c < 0 || c == terminator)
+                break;
+            *buffer++ = (char)c;
+            index++;
+        }
+        return index;
+    }
+
+    String readString()
+    {
+        String ret;
+        int c;
+        while ((c = timedRead()) >= 0)
+            ret += (char)c;
+        return ret;
+    }
+
+    String readStringUntil(char terminator)
+    {
+        String ret;
+        int c;
+        while ((c = timedRead()) >= 0 && c != terminator)
+            ret += (char)c;
+        return ret;
+    }
+
+    bool find(const char *target)
+    {
+        size_t len = strlen(target), index = 0;
+        if (!len)
+            return true;
+        int c;
+        while ((c = timedRead()) >= 0)
+        {
+            index = c == target[index] ? index + 1 : (c == target[0] ? 1 : 0);
+            if (index == len)
+                return true;
+        }
+        return false;
+    }
+
+protected:
+    unsigned long _timeout = 1000;
+    unsigned long _startMillis = 0;
+
+    int timedRead()
+    {
+        _startMillis = millis();
+        do
+        {
+            int c = read();
+            if (c >= 0)
+                return c;
+        } while (millis() - _startMillis < _timeout && available() > 0);
+        return -1;
+    }
+};
+
+#endif
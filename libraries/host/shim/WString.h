@@ -0,0 +1,315 @@
+/*
+ * Arduino String on top of std::string.
+ */
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdio.h>
+#include <string>
+
+class __FlashStringHelper;
+#define FPSTR(pstr_pointer) (reinterpret_cast<const __FlashStringHelper *>(pstr_pointer))
+#define F(string_literal) (FPSTR(PSTR(string_literal)))
+
+class StringSumHelper;
+
+class String
+{
+public:
+    String(const char *cstr = "") { if (cstr) s = cstr; }
+    String(const char *cstr, unsigned int length) { if (cstr) s.assign(cstr, length); }
+    String(const String &str) = default;
+    String(String &&str) = default;
+    String(const std::string &str) : s(str) {}
+    String(const __FlashStringHelper *str) : String(reinterpret_cast<const char *>(str)) {}
+    explicit String(char c) : s(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10) { fromUnsigned(value, base); }
+    explicit String(int value, unsigned char base = 10) { fromSigned(value, base); }
+    explicit String(unsigned int value, unsigned char base = 10) { fromUnsigned(value, base); }
+    explicit String(long value, unsigned char base = 10) { fromSigned(value, base); }
+    explicit String(unsigned long value, unsigned char base = 10) { fromUnsigned(value, base); }
+    explicit String(long long value, unsigned char base = 10) { fromSigned(value, base); }
+    explicit String(unsigned long long value, unsigned char base = 10) { fromUnsigned(value, base); }
+    explicit String(float value, unsigned char decimalPlaces = 2) { fromDouble(value, decimalPlaces); }
+    explicit String(double value, unsigned char decimalPlaces = 2) { fromDouble(value, decimalPlaces); }
+
+    String &operator=(const String &rhs) = default;
+    String &operator=(String &&rhs) = default;
+    String &operator=(const char *cstr)
+    {
+        if (cstr)
+            s = cstr;
+        else
+            s.clear();
+        return *this;
+    }
+    String &operator=(const __FlashStringHelper *str) { return *this = reinterpret_cast<const char *>(str); }
+
+    bool reserve(unsigned int size)
+    {
+        s.reserve(size);
+        return true;
+    }
+    unsigned int length() const { return s.length(); }
+    bool isEmpty() const { return s.empty(); }
+    void clear() { s.clear(); }
+
+    bool concat(const String &str)
+    {
+        s += str.s;
+        return true;
+    }
+    bool concat(const char *cstr)
+    {
+        if (cstr)
+            s += cstr;
+        return true;
+    }
+    bool concat(const char *cstr, unsigned int length)
+    {
+        if (cstr)
+            s.append(cstr, length);
+        return true;
+    }
+    bool concat(const uint8_t *cstr, unsigned int length) { return concat(reinterpret_cast<const char *>(cstr), length); }
+    bool concat(const __FlashStringHelper *str) { return concat(reinterpret_cast<const char *>(str)); }
+    bool concat(char c)
+    {
+        s += c;
+        return true;
+    }
+    bool concat(unsigned char num) { return concat(String(num)); }
+    bool concat(int num) { return concat(String(num)); }
+    bool concat(unsigned int num) { return concat(String(num)); }
+    bool concat(long num) { return concat(String(num)); }
+    bool concat(unsigned long num) { return concat(String(num)); }
+    bool concat(long long num) { return concat(String(num)); }
+    bool concat(unsigned long long num) { return concat(String(num)); }
+    bool concat(float num) { return concat(String(num)); }
+    bool concat(double num) { return concat(String(num)); }
+
+    template <typename T>
+    String &operator+=(const T &rhs)
+    {
+        concat(rhs);
+        return *this;
+    }
+
+    friend StringSumHelper &operator+(const StringSumHelper &lhs, const String &rhs);
+    friend StringSumHelper &operator+(const StringSumHelper &lhs, const char *cstr);
+    friend StringSumHelper &operator+(const StringSumHelper &lhs, const __FlashStringHelper *rhs);
+    friend StringSumHelper &operator+(const StringSumHelper &lhs, char c);
+    friend StringSumHelper &operator+(const StringSumHelper &lhs, unsigned char num);
+    friend StringSumHelper &operator+(const StringSumHelper &lhs, int num);
+    friend StringSumHelper &operator+(const StringSumHelper &lhs, unsigned int num);
+    friend StringSumHelper &operator+(const StringSumHelper &lhs, long num);
+    friend StringSumHelper &operator+(const StringSumHelper &lhs, unsigned long num);
+    friend StringSumHelper &operator+(const StringSumHelper &lhs, long long num);
+    friend StringSumHelper &operator+(const StringSumHelper &lhs, unsigned long long num);
+    friend StringSumHelper &operator+(const StringSumHelper &lhs, float num);
+    friend StringSumHelper &operator+(const StringSumHelper &lhs, double num);
+
+    explicit operator bool() const { return true; }
+
+    int compareTo(const String &s2) const { return s.compare(s2.s); }
+    bool equals(const String &s2) const { return s == s2.s; }
+    bool equals(const char *cstr) const { return s == (cstr ? cstr : ""); }
+    bool equalsIgnoreCase(const String &s2) const { return s.size() == s2.s.size() && strcasecmp(s.c_str(), s2.s.c_str()) == 0; }
+    bool operator==(const String &rhs) const { return equals(rhs); }
+    bool operator==(const char *cstr) const { return equals(cstr); }
+    bool operator!=(const String &rhs) const { return !equals(rhs); }
+    bool operator!=(const char *cstr) const { return !equals(cstr); }
+    bool operator<(const String &rhs) const { return compareTo(rhs) < 0; }
+    bool operator>(const String &rhs) const { return compareTo(rhs) > 0; }
+    bool operator<=(const String &rhs) const { return compareTo(rhs) <= 0; }
+    bool operator>=(const String &rhs) const { return compareTo(rhs) >= 0; }
+    bool startsWith(const String &prefix) const { return s.compare(0, prefix.s.size(), prefix.s) == 0; }
+    bool startsWith(const String &prefix, unsigned int offset) const { return offset <= s.size() && s.compare(offset, prefix.s.size(), prefix.s) == 0; }
+    bool endsWith(const String &suffix) const { return s.size() >= suffix.s.size() && s.compare(s.size() - suffix.s.size(), suffix.s.size(), suffix.s) == 0; }
+
+    char charAt(unsigned int index) const { return index < s.size() ? s[index] : 0; }
+    void setCharAt(unsigned int index, char c)
+    {
+        if (index < s.size())
+            s[index] = c;
+    }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char &operator[](unsigned int index)
+    {
+        static char dummy_writable_char;
+        if (index >= s.size())
+        {
+            dummy_writable_char = 0;
+            return dummy_writable_char;
+        }
+        return s[index];
+    }
+    void getBytes(unsigned char *buf, unsigned int bufsize, unsigned int index = 0) const
+    {
+        if (!bufsize || !buf)
+            return;
+        if (index >= s.size())
+        {
+            buf[0] = 0;
+            return;
+        }
+        unsigned int n = std::min<size_t>(bufsize - 1, s.size() - index);
+        memcpy(buf, s.data() + index, n);
+        buf[n] = 0;
+    }
+    void toCharArray(char *buf, unsigned int bufsize, unsigned int index = 0) const { getBytes(reinterpret_cast<unsigned char *>(buf), bufsize, index); }
+    const char *c_str() const { return s.c_str(); }
+    char *begin() { return &s[0]; }
+    char *end() { return &s[0] + s.size(); }
+    const char *begin() const { return c_str(); }
+    const char *end() const { return c_str() + s.size(); }
+
+    int indexOf(char ch, unsigned int fromIndex = 0) const { return pos(s.find(ch, fromIndex)); }
+    int indexOf(const String &str, unsigned int fromIndex = 0) const { return pos(s.find(str.s, fromIndex)); }
+    int indexOf(const char *str, unsigned int fromIndex = 0) const { return pos(s.find(str, fromIndex)); }
+    int lastIndexOf(char ch) const { return pos(s.rfind(ch)); }
+    int lastIndexOf(char ch, unsigned int fromIndex) const { return pos(s.rfind(ch, fromIndex)); }
+    int lastIndexOf(const String &str) const { return pos(s.rfind(str.s)); }
+    int lastIndexOf(const String &str, unsigned int fromIndex) const { return pos(s.rfind(str.s, fromIndex)); }
+    String substring(unsigned int beginIndex) const { return substring(beginIndex, s.size()); }
+    String substring(unsigned int beginIndex, unsigned int endIndex) const
+    {
+        if (beginIndex > endIndex)
+            std::swap(beginIndex, endIndex);
+        if (beginIndex >= s.size())
+            return String();
+        return String(s.substr(beginIndex, std::min<size_t>(endIndex, s.size()) - beginIndex));
+    }
+
+    void replace(char find, char replace)
+    {
+        for (auto &c : s)
+            if (c == find)
+                c = replace;
+    }
+    void replace(const String &find, const String &replace)
+    {
+        if (find.s.empty())
+            return;
+        for (size_t p = 0; (p = s.find(find.s, p)) != std::string::npos; p += replace.s.size())
+            s.replace(p, find.s.size(), replace.s);
+    }
+    void remove(unsigned int index)
+    {
+        if (index < s.size())
+            s.erase(index);
+    }
+    void remove(unsigned int index, unsigned int count)
+    {
+        if (index < s.size())
+            s.erase(index, count);
+    }
+    void toLowerCase()
+    {
+        for (auto &c : s)
+            c = tolower((unsigned char)c);
+    }
+    void toUpperCase()
+    {
+        for (auto &c : s)
+            c = toupper((unsigned char)c);
+    }
+    void trim()
+    {
+        size_t a = s.find_first_not_of(" \t\r\n\v\f");
+        if (a == std::string::npos)
+        {
+            s.clear();
+            return;
+        }
+        s = s.substr(a, s.find_last_not_of(" \t\r\n\v\f") - a + 1);
+    }
+
+    long toInt() const { return atol(s.c_str()); }
+    float toFloat() const { return atof(s.c_str()); }
+    double toDouble() const { return atof(s.c_str()); }
+
+protected:
+    std::string s;
+
+    static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+    void fromUnsigned(unsigned long long v, unsigned char base)
+    {
+        char buf[66];
+        char *p = buf + sizeof(buf) - 1;
+        *p = 0;
+        if (base < 2)
+            base = 10;
+        do
+        {
+            int d = v % base;
+            *--p = d < 10 ? '0' + d : 'a' + d - 10;
+            v /= base;
+        } while (v);
+        s = p;
+    }
+    void fromSigned(long long v, unsigned char base)
+    {
+        if (base == 10 && v < 0)
+        {
+            fromUnsigned(0ULL - (unsigned long long)v, base);
+            s.insert(0, 1, '-');
+        }
+        else
+            fromUnsigned((unsigned long)v, base);
+    }
+    void fromDouble(double v, unsigned char decimalPlaces)
+    {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, v);
+        s = buf;
+    }
+};
+
+class StringSumHelper : public String
+{
+public:
+    StringSumHelper(const String &s) : String(s) {}
+    StringSumHelper(const char *p) : String(p) {}
+    StringSumHelper(char c) : String(c) {}
+    StringSumHelper(unsigned char num) : String(num) {}
+    StringSumHelper(int num) : String(num) {}
+    StringSumHelper(unsigned int num) : String(num) {}
+    StringSumHelper(long num) : String(num) {}
+    StringSumHelper(unsigned long num) : String(num) {}
+    StringSumHelper(long long num) : String(num) {}
+    StringSumHelper(unsigned long long num) : String(num) {}
+    StringSumHelper(float num) : String(num) {}
+    StringSumHelper(double num) : String(num) {}
+};
+
+#define HOST_STRING_SUM(type)                                                     \
+    inline StringSumHelper &operator+(const StringSumHelper &lhs, type rhs)       \
+    {                                                                             \
+        StringSumHelper &a = const_cast<StringSumHelper &>(lhs);                  \
+        a.concat(rhs);                                                            \
+        return a;                                                                 \
+    }
+HOST_STRING_SUM(const String &)
+HOST_STRING_SUM(const char *)
+HOST_STRING_SUM(const __FlashStringHelper *)
+HOST_STRING_SUM(char)
+HOST_STRING_SUM(unsigned char)
+HOST_STRING_SUM(int)
+HOST_STRING_SUM(unsigned int)
+HOST_STRING_SUM(long)
+HOST_STRING_SUM(unsigned long)
+HOST_STRING_SUM(long long)
+HOST_STRING_SUM(unsigned long long)
+HOST_STRING_SUM(float)
+HOST_STRING_SUM(double)
+#undef HOST_STRING_SUM
+
+inline bool operator==(const char *lhs, const String &rhs) { return rhs == lhs; }
+inline bool operator!=(const char *lhs, const String &rhs) { return rhs != lhs; }
+
+#endif
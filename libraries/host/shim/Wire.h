@@ -0,0 +1,69 @@
+/*
+ * Arduino TwoWire that hands each transmission to a simulated I2C device.
+ *
+ * The bytes are buffered like the AVR core (32 bytes) and sent on endTransmission().
+ * With the virtual clock each byte advances the time by its bus time at the setClock()
+ * rate, 9 bit times per byte plus start and stop, so the device sees when it arrives.
+ */
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include <Arduino.h>
+
+#ifndef BUFFER_LENGTH
+#define BUFFER_LENGTH 32
+#endif
+
+class TwoWireDevice
+{
+public:
+    virtual ~TwoWireDevice() {}
+    // A data byte was received, the address byte is not included
+    virtual void receive(uint8_t address, uint8_t data) = 0;
+};
+
+class TwoWire
+{
+public:
+    void begin() {}
+    void begin(int sda, int scl) { (void)sda, (void)scl; }
+    void end() {}
+    void setClock(uint32_t frequency) { _clock = frequency ? frequency : 100000; }
+    uint32_t getClock() const { return _clock; }
+
+    void beginTransmission(uint8_t address);
+    void beginTransmission(int address) { beginTransmission((uint8_t)address); }
+    uint8_t endTransmission(bool sendStop = true);
+
+    size_t write(uint8_t data);
+    size_t write(const uint8_t *data, size_t quantity);
+    size_t write(unsigned long n) { return write((uint8_t)n); }
+    size_t write(long n) { return write((uint8_t)n); }
+    size_t write(unsigned int n) { return write((uint8_t)n); }
+    size_t write(int n) { return write((uint8_t)n); }
+
+    uint8_t requestFrom(uint8_t address, uint8_t quantity) { (void)address, (void)quantity; return 0; }
+    int available() { return 0; }
+    int read() { return -1; }
+
+    // The device that receives the transmissions, nullptr to detach
+    void setDevice(TwoWireDevice *device) { _device = device; }
+
+    // Bus statistics, the bytes include the address byte of each transmission
+    unsigned long transmissions = 0;
+    unsigned long bytes = 0;
+    unsigned long overflows = 0;
+    void resetStats() { transmissions = bytes = overflows = 0; }
+
+private:
+    TwoWireDevice *_device = nullptr;
+    uint32_t _clock = 100000;
+    uint8_t _address = 0;
+    uint8_t _buf[BUFFER_LENGTH];
+    size_t _len = 0;
+    bool _transmitting = false;
+};
+
+extern TwoWire Wire;
+
+#endif
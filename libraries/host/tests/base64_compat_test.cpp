@@ -0,0 +1,126 @@
+/*
+ * The table-driven streaming base64 codecs of ReadyMail (ReadyCodec.h) and ESP_Mail_Client
+ * (MB_Base64.h) against the codecs they replaced, over 200k random inputs: the encoders,
+ * the in-place line encoder, the attachment stream fed in random chunks and the decoders
+ * with noise, truncation and data after the padding.
+ */
+#define ENABLE_SMTP
+#include <ReadyMail.h>
+#include <extras/MB_Base64.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "support/base64_ref.h"
+#include "support/check.h"
+
+static std::mt19937 rng(123);
+
+static std::string sendBase64(const std::string &data)
+{
+    const size_t chunk = 76 * 12 + 2 * 12, raw = 57 * 12;
+    std::vector<uint8_t> buf(chunk + 8);
+    std::string out;
+    mb_b64_enc_state st;
+    st.wrap = true;
+    for (size_t i = 0; i < data.size();)
+    {
+        size_t n = std::min(raw, data.size() - i);
+        if (rng() % 3 == 0)
+            n = std::min(n, (size_t)(1 + rng() % raw));
+        size_t o = mb_b64_enc_update(st, reinterpret_cast<const uint8_t *>(data.data()) + i, n, buf.data());
+        CHECK(o <= chunk);
+        out.append(reinterpret_cast<char *>(buf.data()), o);
+        i += n;
+    }
+    size_t o = mb_b64_enc_final(st, buf.data());
+    out.append(reinterpret_cast<char *>(buf.data()), o);
+    return out;
+}
+
+// The decodeBase64 result, fed in random chunks, null when it fails
+static bool decodeBase64(const std::string &s, std::string &out)
+{
+    mb_b64_dec_state st;
+    std::vector<uint8_t> buf(mb_b64_dec_len(s.size()) + 1);
+    size_t n = 0;
+    for (size_t i = 0; i < s.size();)
+    {
+        size_t k = std::min(s.size() - i, (size_t)(1 + rng() % 50));
+        n += mb_b64_dec_update(st, reinterpret_cast<const uint8_t *>(s.data()) + i, k, buf.data() + n);
+        i += k;
+    }
+    n += mb_b64_dec_final(st, buf.data() + n);
+    out.assign(reinterpret_cast<char *>(buf.data()), n);
+    return !st.error && n > 0;
+}
+
+int main()
+{
+    for (int it = 0; it < 200000 && check_failures < 10; it++)
+    {
+        size_t len = rng() % (it % 100 == 0 ? 5000 : 200);
+        std::string data(len, 0);
+        for (char &c : data)
+            c = rng();
+        const unsigned char *raw = reinterpret_cast<const unsigned char *>(data.data());
+
+        // ReadyMail encoder and decoder
+        char *ref = base64_ref::rd_b64_enc(raw, len);
+        char *enc = rd_b64_enc(raw, len);
+        CHECK(strcmp(ref, enc) == 0);
+        int l1 = 0, l2 = 0;
+        uint8_t *d1 = base64_ref::rd_b64_dec_impl(ref, l1);
+        uint8_t *d2 = rd_b64_dec_impl(ref, l2);
+        CHECK(l1 == l2 && memcmp(d1, d2, l1) == 0);
+        CHECK(l2 == (int)len && memcmp(d2, raw, len) == 0);
+
+        // ESP_Mail_Client encoder
+        std::vector<uint8_t> mb(mb_b64_enc_len(len, false) + 1);
+        size_t ml = mb_b64_enc(raw, len, mb.data());
+        CHECK(std::string(reinterpret_cast<char *>(mb.data()), ml) == ref);
+        free(d1);
+        free(d2);
+        free(enc);
+        free(ref);
+
+        // The line encoder in place
+        int lines = len / 57 + 1;
+        int size = lines * 78 + rng() % 10;
+        std::vector<uint8_t> b1(size), b2(size);
+        int offset = size - lines * 57;
+        memcpy(b1.data() + offset, raw, len);
+        memcpy(b2.data() + offset, raw, len);
+        int o1 = base64_ref::rd_b64_enc_lines(b1.data(), offset, len);
+        int o2 = rd_b64_enc_lines(b2.data(), offset, len);
+        CHECK(o1 == o2 && memcmp(b1.data(), b2.data(), o1) == 0);
+
+        // The attachment stream
+        std::string wrapped = base64_ref::esp_sendBase64(data);
+        CHECK(sendBase64(data) == wrapped);
+
+        // decodeBase64 of the wrapped data with junk, truncation or data after the padding
+        std::string s = wrapped;
+        switch (rng() % 4)
+        {
+        case 1:
+            for (int k = 0; k < 3 && !s.empty(); k++)
+                s.insert(rng() % s.size(), 1, (char)(rng() % 256));
+            break;
+        case 2:
+            s = s.substr(0, s.empty() ? 0 : rng() % s.size());
+            break;
+        case 3:
+            s += "=QQ==";
+            break;
+        }
+        size_t rl = 0;
+        unsigned char *rd = base64_ref::esp_decodeBase64(reinterpret_cast<const unsigned char *>(s.data()), s.size(), &rl);
+        std::string out;
+        bool ok = decodeBase64(s, out);
+        CHECK(ok == (rd != nullptr));
+        if (rd && ok)
+            CHECK(out == std::string(reinterpret_cast<char *>(rd), rl));
+        free(rd);
+    }
+    return check_report("base64_compat_test");
+}
@@ -0,0 +1,128 @@
+/*
+ * CertStore trust anchor lookup and LRU cache in TLS handshakes against the loopback
+ * TLS server.
+ */
+#include <client/SSLClient/ESP_SSLClient.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string>
+#include "support/TLSServer.h"
+#include "support/check.h"
+#include "support/test_certs.h"
+
+// Writes the DER certificates as a UNIX ar archive, the CertStore data file format
+static bool writeArchive(FS &fs, const char *name, const uint8_t *const *certs, const size_t *lens, int count)
+{
+    File f = fs.open(name, FILE_WRITE);
+    if (!f)
+        return false;
+    f.print("!<arch>\n");
+    for (int i = 0; i < count; i++)
+    {
+        char header[61];
+        snprintf(header, sizeof(header), "%-16s%-12s%-6s%-6s%-8s%-10u`\n", ("ca" + std::to_string(i) + ".der/").c_str(), "0", "0", "0", "644", (unsigned)lens[i]);
+        f.write(reinterpret_cast<const uint8_t *>(header), 60);
+        f.write(certs[i], lens[i]);
+        if (lens[i] & 1)
+            f.write('\n');
+    }
+    return true;
+}
+
+// Connects to the server, checks the echo and closes, returns true on success
+static bool handshake(CertStore &store, TLSServer &server)
+{
+    LoopbackClient tcp(server);
+    ESP_SSLClient ssl;
+    ssl.setClient(&tcp);
+    ssl.setCertStore(&store);
+    ssl.setX509Time(TEST_CERT_TIME);
+    if (!ssl.connect("localhost", 465))
+        return false;
+
+    ssl.print("ping\r\n");
+    char buf[16];
+    size_t n = 0;
+    for (int i = 0; i < 100 && n < 6; i++)
+    {
+        int r = ssl.read(reinterpret_cast<uint8_t *>(buf) + n, sizeof(buf) - n);
+        if (r > 0)
+            n += r;
+    }
+    bool echoed = n == 6 && memcmp(buf, "ping\r\n", 6) == 0;
+    ssl.stop();
+    return echoed;
+}
+
+int main()
+{
+    char dir[] = "/tmp/certstore_test_XXXXXX";
+    if (!mkdtemp(dir))
+        return 1;
+    FS fs(dir);
+
+    const uint8_t *certs[] = {test_ca_d1_der, test_ca_a_der, test_ca_x_der};
+    const size_t lens[] = {sizeof(test_ca_d1_der), sizeof(test_ca_a_der), sizeof(test_ca_x_der)};
+    CHECK(writeArchive(fs, "certs.ar", certs, lens, 3));
+
+    TLSServer serverA(test_srva_der, sizeof(test_srva_der), test_srva_key, sizeof(test_srva_key));
+    TLSServer serverX(test_srvx_der, sizeof(test_srvx_der), test_srvx_key, sizeof(test_srvx_key));
+    TLSServer serverD(test_srvd_der, sizeof(test_srvd_der), test_srvd_key, sizeof(test_srvd_key));
+
+    for (bool memIndex : {true, false})
+    {
+        CertStore store;
+        CHECK_EQ(store.initCertStore(fs, "certs.idx", "certs.ar", memIndex), 3);
+        store.setTrustAnchorCacheSize(2);
+
+        // The first lookup reads the trust anchor from the data file
+        unsigned long opens = fs.opens;
+        CHECK(handshake(store, serverA));
+        CHECK(fs.opens > opens);
+
+        // The next handshake with the same issuer is served from the cache
+        opens = fs.opens;
+        CHECK(handshake(store, serverA));
+        CHECK_EQ(fs.opens, opens);
+
+        // A second issuer takes the other slot, both stay cached
+        CHECK(handshake(store, serverX));
+        opens = fs.opens;
+        CHECK(handshake(store, serverA));
+        CHECK(handshake(store, serverX));
+        CHECK_EQ(fs.opens, opens);
+
+        // An issuer with the DN of a stored root but another key is not trusted
+        CHECK(!handshake(store, serverD));
+        CHECK_EQ(serverA.handshakes + serverX.handshakes, 5ul);
+        serverA.handshakes = serverX.handshakes = 0;
+    }
+
+    // Without the cache, each handshake loads the trust anchor again
+    {
+        CertStore store;
+        CHECK_EQ(store.initCertStore(fs, "certs.idx", "certs.ar", true), 3);
+        store.setTrustAnchorCacheSize(0);
+        CHECK(handshake(store, serverA));
+        unsigned long opens = fs.opens;
+        CHECK(handshake(store, serverA));
+        CHECK(fs.opens > opens);
+    }
+
+    // With a single slot, the least recently used issuer is evicted
+    {
+        CertStore store;
+        CHECK_EQ(store.initCertStore(fs, "certs.idx", "certs.ar", true), 3);
+        store.setTrustAnchorCacheSize(1);
+        CHECK(handshake(store, serverA));
+        CHECK(handshake(store, serverX));
+        unsigned long opens = fs.opens;
+        CHECK(handshake(store, serverA));
+        CHECK(fs.opens > opens);
+    }
+
+    fs.remove("certs.ar");
+    fs.remove("certs.idx");
+    rmdir(dir);
+    return check_report("certstore_handshake_test");
+}
@@ -0,0 +1,189 @@
+/*
+ * ESP_Mail_Client reading attachments from the loopback IMAP server as octet-counted
+ * literals: a base64 attachment in lines, one in a single line ending with the padding
+ * and a binary one, all larger than the response buffer, sent in segments of 1, 3 and
+ * odd sizes that split the lines, the CRLF, the base64 groups and the padding across
+ * reads. The files saved and the MIMEDataStreamCallback output must equal the
+ * attachments. A server that stalls in the literal ends the read with the timeout.
+ */
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "support/IMAPServer.h"
+#include "support/check.h"
+// The flash storage is marked mounted below, MB_FS mounts it only on the boards
+#define private public
+#include <ESP_Mail_Client.h>
+#undef private
+
+// The session is destroyed before the loopback client it uses
+static IMAPSession *session = nullptr;
+
+static void networkStatus() { session->setNetworkStatus(true); }
+
+static void networkConnection() {}
+
+static std::map<std::string, std::string> streamed;
+
+static void mimeStream(MIME_Data_Stream_Info info)
+{
+    if (strcmp(info.disposition, "attachment") == 0)
+        streamed[info.filename].append((const char *)info.data, info.data_size);
+}
+
+// Base64 in lines of 76 chars ending with CRLF, or in one line without CRLF
+static std::string base64(const std::string &data, bool lines)
+{
+    static const char *abc = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out, line;
+    for (size_t i = 0; i < data.size(); i += 3)
+    {
+        uint32_t v = (uint8_t)data[i] << 16;
+        if (i + 1 < data.size())
+            v |= (uint8_t)data[i + 1] << 8;
+        if (i + 2 < data.size())
+            v |= (uint8_t)data[i + 2];
+        line += abc[v >> 18];
+        line += abc[(v >> 12) & 63];
+        line += i + 1 < data.size() ? abc[(v >> 6) & 63] : '=';
+        line += i + 2 < data.size() ? abc[v & 63] : '=';
+        if (lines && line.size() == 76)
+        {
+            out += line + "\r\n";
+            line.clear();
+        }
+    }
+    return out + line + (lines ? "\r\n" : "");
+}
+
+static std::string readFile(const std::string &path)
+{
+    std::ifstream f(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+static std::string root;
+static std::string encoded(1000, 0), unbroken(1001, 0), binary(1500, 0);
+
+static IMAPServer makeServer()
+{
+    IMAPServer server;
+    server.header = "From: Sensor <sensor@example.com>\r\nTo: ops@example.com\r\nSubject: Logs\r\n"
+                    "Date: Mon, 01 Jan 2024 00:00:00 +0000\r\nMessage-ID: <1@example.com>\r\n"
+                    "Content-Type: multipart/mixed; boundary=\"b1\"\r\n";
+    server.parts["1.MIME"] = "Content-Type: text/plain; charset=utf-8\r\n\r\n";
+    server.parts["1"] = "See the logs.\r\n";
+    server.parts["2.MIME"] = "Content-Type: application/octet-stream; name=\"log.gz\"\r\n"
+                             "Content-Disposition: attachment; filename=\"log.gz\"\r\n"
+                             "Content-Transfer-Encoding: base64\r\n\r\n";
+    server.parts["2"] = base64(encoded, true);
+    server.parts["3.MIME"] = "Content-Type: application/octet-stream; name=\"raw.bin\"\r\n"
+                             "Content-Disposition: attachment; filename=\"raw.bin\"\r\n"
+                             "Content-Transfer-Encoding: binary\r\n\r\n";
+    server.parts["3"] = binary;
+    server.parts["4.MIME"] = "Content-Type: application/octet-stream; name=\"cfg.bin\"\r\n"
+                             "Content-Disposition: attachment; filename=\"cfg.bin\"\r\n"
+                             "Content-Transfer-Encoding: base64\r\n\r\n";
+    server.parts["4"] = base64(unbroken, false);
+    return server;
+}
+
+// Reads the message with the attachment downloads
+static bool readMessage(IMAPServer &server, unsigned long tcpTimeoutSec)
+{
+    LoopbackClient client(server);
+    IMAPSession imap;
+    session = &imap;
+    imap.setClient(&client);
+    imap.networkStatusRequestCallback(networkStatus);
+    imap.networkConnectionRequestCallback(networkConnection);
+    imap.mimeDataStreamCallback(mimeStream);
+    imap.setTCPTimeout(tcpTimeoutSec);
+
+    Session_Config config;
+    config.server.host_name = "127.0.0.1";
+    config.server.port = 143;
+    config.login.email = "me@example.com";
+    config.login.password = "pw";
+    config.secure.mode = esp_mail_secure_mode_nonsecure;
+
+    IMAP_Data data;
+    data.download.attachment = true;
+    data.storage.saved_path = "/mail";
+    data.storage.type = esp_mail_file_storage_type_flash;
+    data.fetch.uid = "1";
+
+    streamed.clear();
+    remove((root + "/mail/1/log.gz").c_str());
+    remove((root + "/mail/1/raw.bin").c_str());
+    remove((root + "/mail/1/cfg.bin").c_str());
+    bool ok = imap.connect(&config, &data) && imap.selectFolder("INBOX") && MailClient.readMail(&imap, false);
+    imap.closeSession();
+    return ok;
+}
+
+static void segmented(std::vector<size_t> segments)
+{
+    IMAPServer server = makeServer();
+    server.segments = segments;
+    REQUIRE(readMessage(server, 30));
+
+    CHECK(readFile(root + "/mail/1/log.gz") == encoded);
+    CHECK(readFile(root + "/mail/1/raw.bin") == binary);
+    CHECK(streamed["log.gz"] == encoded);
+    CHECK(streamed["raw.bin"] == binary);
+    CHECK(readFile(root + "/mail/1/cfg.bin") == unbroken);
+    CHECK(streamed["cfg.bin"] == unbroken);
+}
+
+static void stalled()
+{
+    IMAPServer server = makeServer();
+    server.segments = {61};
+    server.stallAfter = 200;
+
+    host::setVirtualClock(true);
+    uint64_t start = host::nowMicros();
+    CHECK(!readMessage(server, 2));
+    uint64_t waited = host::nowMicros() - start;
+    host::setVirtualClock(false);
+
+    // The literal read times out after 2 s without a byte, then the LOGOUT reply queued
+    // behind the stalled literal
+    CHECK(waited >= 4000000);
+    CHECK(waited < 5000000);
+    CHECK_EQ(server.commands.back(), std::string("xmail LOGOUT"));
+    CHECK(streamed["log.gz"].size() > 0);
+    CHECK(streamed["log.gz"].size() < 200);
+    CHECK_EQ(encoded.compare(0, streamed["log.gz"].size(), streamed["log.gz"]), 0);
+}
+
+int main()
+{
+    for (size_t i = 0; i < encoded.size(); i++)
+        encoded[i] = (char)(i * 7 + i / 256);
+    for (size_t i = 0; i < unbroken.size(); i++)
+        unbroken[i] = (char)(i * 13 + 5);
+    // CR, LF, ")" and NUL in the binary literal
+    for (size_t i = 0; i < binary.size(); i++)
+        binary[i] = "\r\n)\0{}*"[i % 7] ^ (char)(i / 7);
+
+    char dir[] = "/tmp/esp_mail_imap_XXXXXX";
+    if (!mkdtemp(dir))
+        return 1;
+    root = dir;
+    LittleFS.setRoot(dir);
+    MailClient.mbfs->flash_rdy = true;
+
+    segmented({4096});
+    segmented({1});
+    segmented({3});
+    segmented({1, 7, 13, 61, 509, 1021});
+    stalled();
+
+    system(("rm -rf " + root).c_str());
+    return check_report("esp_mail_imap_attachment_test");
+}
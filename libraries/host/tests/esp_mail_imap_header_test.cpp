@@ -0,0 +1,107 @@
+/*
+ * ESP_Mail_Client saving the message header from the loopback IMAP server to
+ * header.json and header.txt: the subject has quotes, a backslash, a tab and a control
+ * character, the quotes of the From name are removed in JSON, an attached message and
+ * an attachment add their sections. Both files must match byte for byte, the JSON with
+ * the escapes, the unquoted numbers and the closed objects, the text with the CRLF
+ * separators and the value as received.
+ */
+#include <fstream>
+#include <iterator>
+#include <stdlib.h>
+#include <string>
+#include "support/IMAPServer.h"
+#include "support/check.h"
+// The flash storage is marked mounted below, MB_FS mounts it only on the boards
+#define private public
+#include <ESP_Mail_Client.h>
+#undef private
+
+// The session is destroyed before the loopback client it uses
+static IMAPSession *session = nullptr;
+
+static void networkStatus() { session->setNetworkStatus(true); }
+
+static void networkConnection() {}
+
+static std::string readFile(const std::string &path)
+{
+    std::ifstream f(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+static const char *expectedJson =
+    "{\"Messages\":[{\"Number\":1,\"UID\":1,\"From\":\"Doe, John <john@example.com>\",\"Sender\":0,"
+    "\"To\":\"ops@example.com\",\"Cc\":0,\"Subject\":\"He said \\\"hi\\\" \\\\ back\\t\\u0001!\","
+    "\"Date\":\"Mon, 01 Jan 2024 00:00:00 +0000\",\"Message-ID\":\"<1@example.com>\",\"Return-Path\":0,"
+    "\"Reply-To\":0,\"In-Reply-To\":0,\"References\":0,\"Comments\":0,\"Keywords\":0,\"Bcc\":0,\"Flags\":0,"
+    "\"RFC822\":{\"From\":\"Ann <ann@example.com>\",\"Sender\":0,\"To\":0,\"Cc\":0,\"Subject\":\"C:\\\\logs\",\"Date\":0,"
+    "\"Message-ID\":0,\"Return-Path\":0,\"Reply-To\":0,\"In-Reply-To\":0,\"References\":0,\"Comments\":0,"
+    "\"Keywords\":0,\"Bcc\":0,\"Flags\":0},"
+    "\"Attachments\":{\"Count\":1,\"Files\":[{\"Filename\":\"data.csv\",\"Name\":\"data.csv\",\"Size\":0,"
+    "\"MIME\":\"text/csv\",\"Type\":\"attachment\",\"Description\":0,\"Creation-Date\":0}]}}]}";
+
+static const char *expectedText =
+    "Number: 1\r\nUID: 1\r\nFrom: \"Doe, John\" <john@example.com>\r\nSender: 0\r\nTo: ops@example.com\r\n"
+    "Cc: 0\r\nSubject: He said \"hi\" \\ back\t\x01!\r\nDate: Mon, 01 Jan 2024 00:00:00 +0000\r\n"
+    "Message-ID: <1@example.com>\r\nReturn-Path: 0\r\nReply-To: 0\r\nIn-Reply-To: 0\r\nReferences: 0\r\n"
+    "Comments: 0\r\nKeywords: 0\r\nBcc: 0\r\nFlags: 0\r\n"
+    "\r\nRFC822:\r\nFrom: \"Ann\" <ann@example.com>\r\nSender: 0\r\nTo: 0\r\nCc: 0\r\nSubject: C:\\logs\r\nDate: 0\r\n"
+    "Message-ID: 0\r\nReturn-Path: 0\r\nReply-To: 0\r\nIn-Reply-To: 0\r\nReferences: 0\r\nComments: 0\r\n"
+    "Keywords: 0\r\nBcc: 0\r\nFlags: 0\r\n"
+    "\r\nAttachments (1)\r\n\r\nIndex: 1\r\nFilename: data.csv\r\nName: data.csv\r\nSize: 0\r\n"
+    "MIME: text/csv\r\nType: attachment\r\nDescription: 0\r\nCreation-Date: 0";
+
+int main()
+{
+    char dir[] = "/tmp/esp_mail_header_XXXXXX";
+    if (!mkdtemp(dir))
+        return 1;
+    std::string root = dir;
+    LittleFS.setRoot(dir);
+    MailClient.mbfs->flash_rdy = true;
+
+    IMAPServer server;
+    server.header = "From: \"Doe, John\" <john@example.com>\r\nTo: ops@example.com\r\n"
+                    "Subject: He said \"hi\" \\ back\t\x01!\r\n"
+                    "Date: Mon, 01 Jan 2024 00:00:00 +0000\r\nMessage-ID: <1@example.com>\r\n"
+                    "Content-Type: multipart/mixed; boundary=\"b1\"\r\n";
+    server.parts["1.MIME"] = "Content-Type: text/plain; charset=utf-8\r\n\r\n";
+    server.parts["1"] = "Forwarded.\r\n";
+    server.parts["2.MIME"] = "Content-Type: message/rfc822\r\n\r\n";
+    server.parts["2.HEADER"] = "From: \"Ann\" <ann@example.com>\r\nSubject: C:\\logs\r\n";
+    server.parts["3.MIME"] = "Content-Type: text/csv; name=\"data.csv\"\r\n"
+                             "Content-Disposition: attachment; filename=\"data.csv\"\r\n\r\n";
+    server.parts["3"] = "a,b\r\n";
+
+    LoopbackClient client(server);
+    IMAPSession imap;
+    session = &imap;
+    imap.setClient(&client);
+    imap.networkStatusRequestCallback(networkStatus);
+    imap.networkConnectionRequestCallback(networkConnection);
+
+    Session_Config config;
+    config.server.host_name = "127.0.0.1";
+    config.server.port = 143;
+    config.login.email = "me@example.com";
+    config.login.password = "pw";
+    config.secure.mode = esp_mail_secure_mode_nonsecure;
+
+    IMAP_Data data;
+    data.download.header = true;
+    data.storage.saved_path = "/mail";
+    data.storage.type = esp_mail_file_storage_type_flash;
+    data.fetch.uid = "1";
+
+    CHECK(imap.connect(&config, &data));
+    CHECK(imap.selectFolder("INBOX"));
+    CHECK(MailClient.readMail(&imap, false));
+    imap.closeSession();
+
+    CHECK_EQ(readFile(root + "/mail/1/header.json"), std::string(expectedJson));
+    CHECK_EQ(readFile(root + "/mail/1/header.txt"), std::string(expectedText));
+
+    system(("rm -rf " + root).c_str());
+    return check_report("esp_mail_imap_header_test");
+}
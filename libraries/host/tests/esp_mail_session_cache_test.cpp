@@ -0,0 +1,137 @@
+/*
+ * The ESP_Mail_Client TLS session cache against the loopback TLS server that keeps its
+ * sessions: a second session to the same server resumes the session of the first one,
+ * the least recently used host is evicted from a full cache, and the sessions expire with
+ * their lifetime or when they were stored before the time was set.
+ */
+#include <ESP_Mail_Client.h>
+#include <string>
+#include "support/SMTPServer.h"
+#include "support/TLSServer.h"
+#include "support/check.h"
+#include "support/test_certs.h"
+
+// The session is destroyed before the loopback client it uses
+static SMTPSession *session = nullptr;
+
+static void networkStatus() { session->setNetworkStatus(true); }
+
+static void networkConnection() {}
+
+struct Server
+{
+    SMTPServer app;
+    TLSServer tls;
+
+    Server() : tls(test_srva_der, sizeof(test_srva_der), test_srva_key, sizeof(test_srva_key), &app) { tls.sessionCache = true; }
+};
+
+// Logs in and out over SMTPS with a new session
+static bool connect(Server &server, const char *host)
+{
+    LoopbackClient client(server.tls);
+    SMTPSession smtp;
+    session = &smtp;
+
+    Session_Config config;
+    config.server.host_name = host;
+    config.server.port = 465;
+    config.login.email = "me@example.com";
+    config.login.password = "pw";
+    config.login.user_domain = "127.0.0.1";
+    config.secure.mode = esp_mail_secure_mode_ssl_tls;
+
+    smtp.setClient(&client);
+    smtp.networkStatusRequestCallback(networkStatus);
+    smtp.networkConnectionRequestCallback(networkConnection);
+    bool ok = smtp.connect(&config);
+    smtp.closeSession();
+    return ok;
+}
+
+static void resumption()
+{
+    Server server;
+    MailClient.setSessionCache(true, 0);
+
+    CHECK(connect(server, "smtp.example.com"));
+    CHECK(connect(server, "smtp.example.com"));
+    CHECK_EQ(server.tls.handshakes, 2ul);
+    CHECK_EQ(server.tls.resumed, 1ul);
+    CHECK_EQ(MailClient.sessionCacheHits(), 1u);
+    CHECK_EQ(MailClient.sessionCacheMisses(), 1u);
+
+    // The server forgot the session, the full handshake is a miss
+    Server restarted;
+    CHECK(connect(restarted, "smtp.example.com"));
+    CHECK_EQ(restarted.tls.resumed, 0ul);
+    CHECK_EQ(MailClient.sessionCacheHits(), 1u);
+    CHECK_EQ(MailClient.sessionCacheMisses(), 2u);
+
+    // The new session replaced the old one
+    CHECK(connect(restarted, "smtp.example.com"));
+    CHECK_EQ(restarted.tls.resumed, 1ul);
+    CHECK_EQ(MailClient.sessionCacheHits(), 2u);
+}
+
+static void eviction()
+{
+    Server server;
+    MailClient.setSessionCache(true, 0);
+
+    char hosts[ESP_MAIL_SESSION_CACHE_SIZE + 1][32];
+    for (int i = 0; i <= ESP_MAIL_SESSION_CACHE_SIZE; i++)
+    {
+        snprintf(hosts[i], sizeof(hosts[i]), "smtp%d.example.com", i);
+        CHECK(connect(server, hosts[i]));
+    }
+    CHECK_EQ(server.tls.resumed, 0ul);
+    CHECK_EQ(MailClient.sessionCacheMisses(), (uint32_t)ESP_MAIL_SESSION_CACHE_SIZE + 1);
+
+    // The first host was evicted, its new session evicts the second one
+    CHECK(connect(server, hosts[0]));
+    CHECK_EQ(server.tls.resumed, 0ul);
+
+    // The others are still cached
+    for (int i = 2; i <= ESP_MAIL_SESSION_CACHE_SIZE; i++)
+        CHECK(connect(server, hosts[i]));
+    CHECK_EQ(server.tls.resumed, (unsigned long)ESP_MAIL_SESSION_CACHE_SIZE - 1);
+
+    CHECK(connect(server, hosts[1]));
+    CHECK_EQ(server.tls.resumed, (unsigned long)ESP_MAIL_SESSION_CACHE_SIZE - 1);
+    CHECK_EQ(MailClient.sessionCacheHits(), (uint32_t)ESP_MAIL_SESSION_CACHE_SIZE - 1);
+    CHECK_EQ(MailClient.sessionCacheMisses(), (uint32_t)ESP_MAIL_SESSION_CACHE_SIZE + 3);
+}
+
+static void expiry()
+{
+    Server server;
+    MailClient.setSessionCache(true, 3600);
+
+    // Stored before the time was set, its age is unknown
+    REQUIRE(!MailClient.Time.timeReady());
+    CHECK(connect(server, "smtp.example.com"));
+    CHECK(connect(server, "smtp.example.com"));
+    CHECK_EQ(server.tls.resumed, 0ul);
+    CHECK_EQ(MailClient.sessionCacheHits(), 0u);
+
+    MailClient.Time.setTimestamp(1704067200, 0);
+    CHECK(connect(server, "smtp.example.com"));
+    CHECK(connect(server, "smtp.example.com"));
+    CHECK_EQ(server.tls.resumed, 1ul);
+
+    MailClient.Time.setTimestamp(1704067200 + 3601, 0);
+    CHECK(connect(server, "smtp.example.com"));
+    CHECK_EQ(server.tls.resumed, 1ul);
+    CHECK_EQ(MailClient.sessionCacheHits(), 1u);
+    CHECK_EQ(MailClient.sessionCacheMisses(), 4u);
+}
+
+int main()
+{
+    resumption();
+    eviction();
+    expiry();
+    MailClient.setSessionCache(false);
+    return check_report("esp_mail_session_cache_test");
+}
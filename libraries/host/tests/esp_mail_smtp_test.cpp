@@ -0,0 +1,140 @@
+/*
+ * Smoke test of the host build: ESP_Mail_Client sends a message to the SMTP sink over
+ * the loopback Client, and a batch with rejected recipients over plain TCP with and
+ * without PIPELINING.
+ */
+#include <ESP_Mail_Client.h>
+#include <vector>
+#include "support/SMTPServer.h"
+#include "support/check.h"
+
+// The session is destroyed before the loopback client it uses
+static SMTPSession *session = nullptr;
+
+static void networkStatus() { session->setNetworkStatus(true); }
+
+static void networkConnection() {}
+
+// The counts of the last SMTP_Status reported to the callback and the sending results it
+// saw, the session clears them on close when there is a callback
+static size_t statusCompleted = 0, statusFailed = 0;
+static std::vector<SMTP_Result> results;
+
+static void smtpStatus(SMTP_Status status)
+{
+    statusCompleted = status.completedCount();
+    statusFailed = status.failedCount();
+    if (session->sendingResult.size() > 0)
+    {
+        results.clear();
+        for (size_t i = 0; i < session->sendingResult.size(); i++)
+            results.push_back(session->sendingResult.getItem(i));
+    }
+}
+
+static void espMailClientSend()
+{
+    SMTPServer server;
+    LoopbackClient client(server);
+    SMTPSession smtp;
+    session = &smtp;
+
+    Session_Config config;
+    config.server.host_name = "127.0.0.1";
+    config.server.port = 25;
+    config.login.email = "me@example.com";
+    config.login.password = "pw";
+    config.login.user_domain = "127.0.0.1";
+    config.secure.mode = esp_mail_secure_mode_nonsecure;
+
+    smtp.setClient(&client);
+    smtp.networkStatusRequestCallback(networkStatus);
+    smtp.networkConnectionRequestCallback(networkConnection);
+    CHECK(smtp.connect(&config));
+
+    SMTP_Message message;
+    message.sender.name = "Me";
+    message.sender.email = "me@example.com";
+    message.subject = "ESP_Mail_Client host test";
+    message.addRecipient("You", "you@example.com");
+    message.text.content = "Hello from the host build.";
+    message.date = "Mon, 01 Jan 2024 00:00:00 +0000";
+    CHECK(MailClient.sendMail(&smtp, &message, true));
+
+    REQUIRE(server.messages.size() == 1);
+    CHECK(server.messages[0].find("From: \"Me\" <me@example.com>\r\n") != std::string::npos);
+    CHECK(server.messages[0].find("Hello from the host build.") != std::string::npos);
+}
+
+static void espMailClientSendBatch(bool pipelining)
+{
+    SMTPServer server;
+    server.pipelining = pipelining;
+    LoopbackClient client(server);
+    SMTPSession smtp;
+    session = &smtp;
+
+    Session_Config config;
+    config.server.host_name = "127.0.0.1";
+    config.server.port = 25;
+    config.login.email = "me@example.com";
+    config.login.password = "pw";
+    config.login.user_domain = "127.0.0.1";
+    config.secure.mode = esp_mail_secure_mode_nonsecure;
+
+    smtp.setClient(&client);
+    smtp.networkStatusRequestCallback(networkStatus);
+    smtp.networkConnectionRequestCallback(networkConnection);
+    smtp.callback(smtpStatus);
+    statusCompleted = statusFailed = 0;
+    results.clear();
+    REQUIRE(smtp.connect(&config));
+
+    // The second message has its only recipient rejected, the third one of its two
+    SMTP_Message messages[4];
+    const char *subjects[4] = {"first", "rejected", "partly rejected", "last"};
+    for (int i = 0; i < 4; i++)
+    {
+        messages[i].sender.email = "me@example.com";
+        messages[i].subject = subjects[i];
+        messages[i].text.content = "Batch body.";
+        messages[i].date = "Mon, 01 Jan 2024 00:00:00 +0000";
+    }
+    messages[0].addRecipient("You", "you@example.com");
+    messages[1].addRecipient("Bad", "bad@example.com");
+    messages[2].addRecipient("You", "you@example.com");
+    messages[2].addCc("bad@example.com");
+    messages[3].addRecipient("Ops", "ops@example.com");
+
+    CHECK(!MailClient.sendMails(&smtp, messages, 4, true));
+
+    // One connection, the rejected transactions are cleared with RSET
+    CHECK_EQ(client.connects, 1ul);
+    CHECK_EQ(server.rsets, 2ul);
+    CHECK_EQ(server.messages.size(), (size_t)2);
+
+    REQUIRE(results.size() == 4);
+    const bool completed[4] = {true, false, false, true};
+    const char *recipients[4] = {"you@example.com", "bad@example.com", "you@example.com", "ops@example.com"};
+    for (int i = 0; i < 4; i++)
+    {
+        SMTP_Result &r = results[i];
+        CHECK_EQ(r.completed, completed[i]);
+        CHECK(strcmp(r.subject.c_str(), subjects[i]) == 0);
+        CHECK(strcmp(r.recipients.c_str(), recipients[i]) == 0);
+    }
+    CHECK_EQ(statusCompleted, (size_t)2);
+    CHECK_EQ(statusFailed, (size_t)2);
+
+    // With PIPELINING, MAIL FROM and the RCPT TO commands of an envelope take one round
+    // trip instead of one each, 5 fewer for the 4 envelopes with 9 commands
+    CHECK_EQ(client.roundTrips, pipelining ? 13ul : 18ul);
+}
+
+int main()
+{
+    espMailClientSend();
+    espMailClientSendBatch(false);
+    espMailClientSendBatch(true);
+    return check_report("esp_mail_smtp_test");
+}
@@ -0,0 +1,78 @@
+/*
+ * LiquidCrystal busy flag polling on the HD44780 pin model: a clear and a full 16x2
+ * redraw in the 4-bit and 8-bit interfaces with the fixed delays and with polling, an LCD
+ * whose busy flag never clears and a display without the RW pin.
+ */
+#include <LiquidCrystal.h>
+#include "support/HD44780.h"
+#include "support/check.h"
+
+static const uint8_t RS = 12, RW = 11, EN = 10;
+static const uint8_t DATA[8] = {2, 3, 4, 5, 6, 7, 8, 9};
+
+// The microseconds of the clear and the redraw, checks the display contents
+static uint64_t redraw(LiquidCrystal &lcd, HD44780 &model)
+{
+    uint64_t start = host::nowMicros();
+    lcd.clear();
+    lcd.print("The quick brown ");
+    lcd.setCursor(0, 1);
+    lcd.print("fox jumps over! ");
+    uint64_t us = host::nowMicros() - start;
+    CHECK(model.text(0x00, 16) == "The quick brown ");
+    CHECK(model.text(0x40, 16) == "fox jumps over! ");
+    CHECK_EQ(model.violations, 0ul);
+    return us;
+}
+
+static uint64_t run(int pins, bool polling, bool stuckBusy = false)
+{
+    // The 8-bit interface uses DB0..DB7, the 4-bit interface DB4..DB7
+    const uint8_t *d = pins == 8 ? DATA : DATA + 4;
+    HD44780_Pins model(RS, RW, EN, d, pins);
+    model.pinCallUs = 4;
+    host::setPins(&model);
+    LiquidCrystal *lcd = pins == 8 ? new LiquidCrystal(RS, RW, EN, d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7])
+                                   : new LiquidCrystal(RS, RW, EN, d[0], d[1], d[2], d[3]);
+    lcd->begin(16, 2);
+    lcd->setBusyPolling(polling);
+    model.lcd.stuckBusy = stuckBusy;
+    uint64_t us = redraw(*lcd, model.lcd);
+    CHECK(polling ? model.lcd.reads > 0 : model.lcd.reads == 0);
+    printf("%d-bit %s%s: %lu us\n", pins, polling ? "polling" : "fixed", stuckBusy ? " (stuck busy)" : "", (unsigned long)us);
+    delete lcd;
+    host::setPins(nullptr);
+    return us;
+}
+
+// Without the RW pin the polling stays off
+static void noRwPin()
+{
+    HD44780_Pins model(RS, 255, EN, DATA + 4, 4);
+    host::setPins(&model);
+    LiquidCrystal lcd(RS, EN, DATA[4], DATA[5], DATA[6], DATA[7]);
+    lcd.begin(16, 2);
+    lcd.setBusyPolling(true);
+    redraw(lcd, model.lcd);
+    CHECK_EQ(model.lcd.reads, 0ul);
+    host::setPins(nullptr);
+}
+
+int main()
+{
+    host::setVirtualClock(true);
+    for (int pins : {4, 8})
+    {
+        uint64_t fixed = run(pins, false);
+        uint64_t polling = run(pins, true);
+        // At least a quarter faster with the AVR digitalWrite time per pin call
+        CHECK(polling * 4 < fixed * 3);
+        // The fixed command times are the timeout, the redraw completes without the busy flag
+        // in about the fixed time plus the polling pin calls
+        uint64_t stuck = run(pins, true, true);
+        CHECK(stuck < fixed + fixed / 10);
+    }
+    noRwPin();
+    host::setVirtualClock(false);
+    return check_report("lcd_busy_test");
+}
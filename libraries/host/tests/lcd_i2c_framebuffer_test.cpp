@@ -0,0 +1,81 @@
+/*
+ * LiquidCrystal_I2C framebuffer mode: the I2C bytes of each refresh() on a 16x2 display
+ * behind the PCF8574 model, and the display contents.
+ */
+#include <LiquidCrystal_I2C.h>
+#include <type_traits>
+#include "support/HD44780.h"
+#include "support/check.h"
+
+static_assert(!std::is_copy_constructible<LiquidCrystal_I2C>::value, "LiquidCrystal_I2C owns its framebuffer");
+static_assert(!std::is_copy_assignable<LiquidCrystal_I2C>::value, "LiquidCrystal_I2C owns its framebuffer");
+
+// Each command or character is 6 bytes, a transmission takes 5 of them after the address byte
+static size_t busBytes(size_t sends) { return sends * 6 + (sends + 4) / 5; }
+
+// Refreshes and checks that the returned bytes are the bytes on the bus
+static size_t refresh(LiquidCrystal_I2C &lcd)
+{
+    unsigned long bytes = Wire.bytes;
+    size_t n = lcd.refresh();
+    CHECK_EQ(Wire.bytes - bytes, n);
+    return n;
+}
+
+static void frames(HD44780_I2C &dev)
+{
+    LiquidCrystal_I2C lcd(0x27, 16, 2);
+    lcd.init();
+    REQUIRE(lcd.setFramebuffer(true));
+
+    // The first frame sends every character, the display starts at the first row and the
+    // second row needs its address
+    lcd.setCursor(0, 0);
+    lcd.print("The-quick-brown-");
+    lcd.setCursor(0, 1);
+    lcd.print("fox-jumps-over-.");
+    CHECK_EQ(refresh(lcd), busBytes(1 + 32));
+    CHECK(dev.lcd.text(0x00, 16) == "The-quick-brown-");
+    CHECK(dev.lcd.text(0x40, 16) == "fox-jumps-over-.");
+
+    // An unchanged frame sends nothing
+    lcd.setCursor(0, 0);
+    lcd.print("The-quick-brown-");
+    CHECK_EQ(refresh(lcd), 0u);
+
+    // A changed character is sent with its address
+    lcd.setCursor(4, 1);
+    lcd.print("J");
+    CHECK_EQ(refresh(lcd), busBytes(2));
+    CHECK(dev.lcd.text(0x40, 16) == "fox-Jumps-over-.");
+
+    // Adjacent characters follow the address counter, the next row needs its address
+    lcd.setCursor(14, 0);
+    lcd.print("!!");
+    lcd.setCursor(0, 1);
+    lcd.print("F");
+    CHECK_EQ(refresh(lcd), busBytes(5));
+    CHECK(dev.lcd.text(0x00, 16) == "The-quick-brow!!");
+    CHECK(dev.lcd.text(0x40, 16) == "Fox-Jumps-over-.");
+
+    // clear() only clears the buffer, the refresh sends the differences
+    lcd.clear();
+    lcd.print("The");
+    CHECK_EQ(refresh(lcd), busBytes(1 + 13 + 1 + 16));
+    CHECK(dev.lcd.text(0x00, 16) == "The             ");
+    CHECK(dev.lcd.text(0x40, 16) == "                ");
+
+    CHECK_EQ(dev.lcd.violations, 0ul);
+    CHECK_EQ(Wire.overflows, 0ul);
+}
+
+int main()
+{
+    host::setVirtualClock(true);
+    HD44780_I2C dev;
+    Wire.setDevice(&dev);
+    frames(dev);
+    Wire.setDevice(nullptr);
+    host::setVirtualClock(false);
+    return check_report("lcd_i2c_framebuffer_test");
+}
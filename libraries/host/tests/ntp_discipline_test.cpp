@@ -0,0 +1,157 @@
+/*
+ * NTPClient clock discipline against the stub NTP server with a drifting local clock,
+ * in virtual time.
+ */
+#include <Arduino.h>
+#include <math.h>
+#include "support/NTPStub.h"
+#include "support/check.h"
+// The invariants that keep the 32-bit arithmetic of the MCU targets in range are
+// checked on the private state
+#define private public
+#include <NTPClient.h>
+#undef private
+
+struct RunResult
+{
+    double maxError;      // ms, after the first hour
+    double meanError;     // ms, after the first hour
+    unsigned long rounds; // requests sent
+    long maxRefSpan;      // ms, the largest local time since the reference at a sample
+    long maxSampleOffset; // ms, the largest fit offset from the reference
+};
+
+// The fit offsets are measured against the undrifted local clock, so they span the
+// drift over the sample window plus the measurement error
+static long offsetBound(double skewPpm) { return (long)(fabs(skewPpm) * 1e-6 * NTP_DISCIPLINE_SAMPLES * NTP_MAX_POLL_INTERVAL) + 100; }
+
+// Polls for hours of virtual time and samples the error every second
+static RunResult run(NTPClient &ntp, NTPStubUDP &udp, double hours)
+{
+    RunResult r = {0, 0, 0, 0, 0};
+    double sum = 0;
+    unsigned long n = 0;
+    uint64_t end = host::nowMicros() + (uint64_t)(hours * 3600e6);
+    uint64_t warmup = host::nowMicros() + 3600000000ULL;
+    unsigned long requests = udp.requests;
+
+    while (host::nowMicros() < end)
+    {
+        unsigned long refTime = ntp._refTime;
+        if (ntp.poll() && ntp._discipline)
+        {
+            long span = (long)(ntp._sampleTime - refTime);
+            if (span > r.maxRefSpan)
+                r.maxRefSpan = span;
+            for (byte i = 0; i < ntp._samples; i++)
+                if (labs(ntp._sampleOffsets[i]) > r.maxSampleOffset)
+                    r.maxSampleOffset = labs(ntp._sampleOffsets[i]);
+        }
+        if (ntp.isUpdating())
+        {
+            delay(1);
+            continue;
+        }
+        delay(1000);
+        if (ntp.isTimeSet() && host::nowMicros() > warmup)
+        {
+            double e = fabs((double)ntp.getEpochMillis() - udp.trueEpochMs());
+            if (e > r.maxError)
+                r.maxError = e;
+            sum += e;
+            n++;
+        }
+    }
+    r.meanError = n ? sum / n : 0;
+    r.rounds = udp.requests - requests;
+    return r;
+}
+
+static void skews()
+{
+    static const double skewsPpm[] = {0, 40, -120, 300};
+    for (double skew : skewsPpm)
+    {
+        RunResult undisciplined = {}, disciplined = {};
+        float drift = 0;
+        for (int discipline = 0; discipline < 2; discipline++)
+        {
+            host::setVirtualClock(false);
+            host::setVirtualClock(true);
+            NTPStubUDP udp(11);
+            udp.skewPpm = skew;
+            udp.addServer("a.ntp.test");
+            NTPClient ntp(udp, "a.ntp.test");
+            ntp.begin();
+            ntp.setDiscipline(discipline);
+            RunResult r = run(ntp, udp, 24);
+            printf("{\"test\":\"ntp_discipline\",\"skew_ppm\":%.0f,\"discipline\":%d,\"rounds\":%lu,\"max_error_ms\":%.1f,\"mean_error_ms\":%.1f,\"drift_ppm\":%.2f,\"poll_s\":%lu}\n",
+                   skew, discipline, r.rounds, r.maxError, r.meanError, ntp.getDrift(), ntp.getPollInterval() / 1000);
+            (discipline ? disciplined : undisciplined) = r;
+            if (discipline)
+                drift = ntp.getDrift();
+        }
+
+        // The drift is estimated and the error stays within the measurement error
+        // while the poll interval backs off to the maximum
+        CHECK(fabs(drift - skew) < 5);
+        CHECK(disciplined.maxError < 60);
+        CHECK(disciplined.rounds < undisciplined.rounds / 4);
+        if (skew != 0)
+            CHECK(disciplined.maxError < undisciplined.maxError);
+    }
+}
+
+static void longRun()
+{
+    // Past the 49.7 days at which a 32-bit millis() wraps, the reference follows the
+    // samples so the local time differences stay within one poll interval
+    host::setVirtualClock(false);
+    host::setVirtualClock(true);
+    NTPStubUDP udp(5);
+    udp.skewPpm = 80;
+    udp.addServer("a.ntp.test");
+    NTPClient ntp(udp, "a.ntp.test");
+    ntp.begin();
+    ntp.setDiscipline(true);
+    RunResult r = run(ntp, udp, 60 * 24);
+    printf("{\"test\":\"ntp_discipline_60d\",\"rounds\":%lu,\"max_error_ms\":%.1f,\"max_ref_span_ms\":%ld,\"max_sample_offset_ms\":%ld}\n",
+           r.rounds, r.maxError, r.maxRefSpan, r.maxSampleOffset);
+    CHECK(r.maxRefSpan <= (long)NTP_MAX_POLL_INTERVAL + 2000);
+    CHECK(r.maxSampleOffset < offsetBound(udp.skewPpm));
+    CHECK(r.maxError < 60);
+}
+
+static void enableAfterTimeSet()
+{
+    // The first disciplined sample steps the clock instead of measuring the offset
+    // from an empty reference
+    host::setVirtualClock(false);
+    host::setVirtualClock(true);
+    NTPStubUDP udp(9);
+    udp.skewPpm = -50;
+    udp.addServer("a.ntp.test");
+    NTPClient ntp(udp, "a.ntp.test");
+    ntp.begin();
+    CHECK(ntp.forceUpdate());
+    delay(30000);
+
+    ntp.setDiscipline(true);
+    CHECK(ntp.forceUpdate());
+    REQUIRE(ntp._samples == 1);
+    CHECK(labs(ntp._sampleOffsets[0]) < offsetBound(udp.skewPpm));
+    CHECK(fabs((double)ntp.getEpochMillis() - udp.trueEpochMs()) <= udp.jitterMs / 2 + 2);
+
+    RunResult r = run(ntp, udp, 6);
+    CHECK(r.maxSampleOffset < offsetBound(udp.skewPpm));
+    CHECK(r.maxError < 60);
+    CHECK(fabs(ntp.getDrift() + 50) < 5);
+}
+
+int main()
+{
+    skews();
+    longRun();
+    enableAfterTimeSet();
+    return check_report("ntp_discipline_test");
+}
@@ -0,0 +1,140 @@
+/*
+ * NTPClient beginUpdate()/poll() against the stub NTP servers with jitter, in virtual time.
+ */
+#include <NTPClient.h>
+#include <math.h>
+#include "support/NTPStub.h"
+#include "support/check.h"
+
+// Runs poll() every ms until the time is set, returns the virtual ms it took
+static long pollUntilSet(NTPClient &ntp, unsigned long limitMs)
+{
+    unsigned long start = millis();
+    while (millis() - start < limitMs)
+    {
+        if (ntp.poll())
+            return millis() - start;
+        delay(1);
+    }
+    return -1;
+}
+
+static double error(NTPClient &ntp, NTPStubUDP &udp) { return (double)ntp.getEpochMillis() - udp.trueEpochMs(); }
+
+static void singleServer()
+{
+    NTPStubUDP udp(1);
+    udp.addServer(IPAddress(127, 0, 0, 1));
+    NTPClient ntp(udp, IPAddress(127, 0, 0, 1));
+    ntp.begin();
+
+    // The first poll() only sends the request
+    CHECK(!ntp.poll());
+    CHECK(ntp.isUpdating());
+    CHECK_EQ(udp.requests, 1u);
+
+    long took = pollUntilSet(ntp, 2000);
+    REQUIRE(took >= 0);
+    CHECK(ntp.isTimeSet());
+    CHECK(!ntp.isUpdating());
+    CHECK(took < 200);
+
+    // The error is the path asymmetry, at most half the jitter of the round trip
+    for (int i = 0; i < 20; i++)
+    {
+        CHECK(ntp.forceUpdate());
+        CHECK(fabs(error(ntp, udp)) <= udp.jitterMs / 2 + 2);
+        CHECK(ntp.getLastDelay() >= udp.baseDelayMs - 1);
+        CHECK(ntp.getLastDelay() <= udp.baseDelayMs + 2 * udp.jitterMs + 1);
+    }
+}
+
+// The mean delay of the selected samples over a number of rounds
+static double meanDelay(int servers, int rounds)
+{
+    static const char *names[] = {"a.ntp.test", "b.ntp.test", "c.ntp.test", "d.ntp.test"};
+    NTPStubUDP udp(7);
+    for (int i = 0; i < servers; i++)
+        udp.addServer(names[i]);
+    NTPClient ntp(udp, names[0]);
+    for (int i = 1; i < servers; i++)
+        CHECK(ntp.addServer(names[i]));
+    ntp.begin();
+
+    double sum = 0;
+    for (int i = 0; i < rounds; i++)
+    {
+        CHECK(ntp.forceUpdate());
+        sum += ntp.getLastDelay();
+    }
+    CHECK_EQ(udp.requests, (unsigned long)(servers * rounds));
+    return sum / rounds;
+}
+
+static void multiServer()
+{
+    // All servers are requested in each round and the lowest delay sample is kept
+    double one = meanDelay(1, 50);
+    double four = meanDelay(4, 50);
+    CHECK(four < one * 0.75);
+
+    NTPStubUDP udp;
+    NTPClient ntp(udp, "a.ntp.test");
+    CHECK(ntp.addServer("b.ntp.test"));
+    CHECK(ntp.addServer("c.ntp.test"));
+    CHECK(ntp.addServer(IPAddress(127, 0, 0, 2)));
+    CHECK(!ntp.addServer("e.ntp.test"));
+}
+
+static void unresolvedAndSilentServers()
+{
+    // A server that does not resolve is skipped, a silent one delays the round till the timeout
+    NTPStubUDP udp(3);
+    udp.addServer("a.ntp.test");
+    udp.addServer("c.ntp.test", 0, true);
+    NTPClient ntp(udp, "a.ntp.test");
+    ntp.addServer("bad.invalid");
+    ntp.addServer("c.ntp.test");
+    ntp.setUpdateTimeout(300);
+    ntp.begin();
+
+    unsigned long start = millis();
+    CHECK(ntp.forceUpdate());
+    unsigned long took = millis() - start;
+    CHECK(took >= 300 && took <= 302);
+    CHECK(fabs(error(ntp, udp)) <= udp.jitterMs / 2 + 2);
+}
+
+static void timeoutAndRetry()
+{
+    NTPStubUDP udp;
+    udp.addServer("a.ntp.test", 0, true);
+    NTPClient ntp(udp, "a.ntp.test");
+    ntp.setUpdateTimeout(300);
+    ntp.begin();
+
+    unsigned long start = millis();
+    CHECK(!ntp.forceUpdate());
+    CHECK(millis() - start >= 300);
+    CHECK(!ntp.isTimeSet());
+
+    // Without the time poll() retries after NTP_RETRY_INTERVAL, not on every call
+    udp.requests = 0;
+    start = millis();
+    while (millis() - start < NTP_RETRY_INTERVAL * 3 - 1)
+    {
+        ntp.poll();
+        delay(1);
+    }
+    CHECK_EQ(udp.requests, 3u);
+}
+
+int main()
+{
+    host::setVirtualClock(true);
+    singleServer();
+    multiServer();
+    unresolvedAndSilentServers();
+    timeoutAndRetry();
+    return check_report("ntp_poll_test");
+}
@@ -0,0 +1,89 @@
+/*
+ * The files of the span-based BODYSTRUCTURE parser against the files the previous
+ * tokenizing parser found in the same responses (recorded from it), over the Dovecot, Gmail
+ * and Outlook corpus and a deep tree with a forwarded message. The previous parser kept the
+ * quoted-string escapes in the file name (report (final) \"v2\".bin), the new one removes them.
+ */
+#define private public
+#define ENABLE_IMAP
+#include <ReadyMail.h>
+#include "support/bodystructure_corpus.h"
+#include "support/check.h"
+
+using namespace ReadyMailIMAP;
+
+struct expected_file
+{
+    int response; // the corpus index, 7 is the deep tree
+    const char *section, *mime, *filename;
+    imap_transfer_encoding_scheme encoding;
+    uint32_t octets, size;
+    const char *charset;
+};
+
+static const expected_file expected[] = {
+    {0, "1", "text/plain", "1.txt", imap_transfer_encoding_7bit, 1152, 0, "us-ascii"},
+    {1, "1", "text/plain", "1.txt", imap_transfer_encoding_quoted_printable, 1340, 0, "utf-8"},
+    {1, "2", "text/html", "2.html", imap_transfer_encoding_quoted_printable, 4812, 0, "utf-8"},
+    {2, "1.1", "text/plain", "1_1.txt", imap_transfer_encoding_7bit, 54, 0, "utf-8"},
+    {2, "1.2", "text/html", "1_2.html", imap_transfer_encoding_7bit, 124, 0, "utf-8"},
+    {2, "2", "application/pdf", "invoice-2024.pdf", imap_transfer_encoding_base64, 124330, 93247, ""},
+    {2, "3", "image/jpeg", "photo 1.jpg", imap_transfer_encoding_base64, 524288, 393216, ""},
+    {3, "1.1", "text/plain", "1_1.txt", imap_transfer_encoding_base64, 2340, 1755, "utf-8"},
+    {3, "1.2.1", "text/html", "1_2_1.html", imap_transfer_encoding_quoted_printable, 9876, 0, "utf-8"},
+    {3, "1.2.2", "image/png", "image001.png", imap_transfer_encoding_base64, 23456, 17592, ""},
+    {3, "2", "application/vnd.openxmlformats-officedocument.spreadsheetml.sheet", "รายงาน.xlsx", imap_transfer_encoding_base64, 45678, 34258, ""},
+    {4, "1", "text/plain", "1.txt", imap_transfer_encoding_8bit, 320, 0, "utf-8"},
+    {4, "2", "message/rfc822", "Fwd.eml", imap_transfer_encoding_7bit, 2048, 2048, ""},
+    {4, "2.1", "text/plain", "2_1.txt", imap_transfer_encoding_7bit, 120, 0, "us-ascii"},
+    {4, "2.2", "text/html", "2_2.html", imap_transfer_encoding_7bit, 450, 0, "us-ascii"},
+    {5, "1", "text/plain", "1.txt", imap_transfer_encoding_quoted_printable, 800, 0, "iso-8859-1"},
+    {5, "2", "application/octet-stream", "report (final) \"v2\".bin", imap_transfer_encoding_base64, 3000, 2250, ""},
+    {6, "1", "text/plain", "1.txt", imap_transfer_encoding_7bit, 10, 0, "utf-8"},
+    {6, "2", "application/zip", "a.zip", imap_transfer_encoding_base64, 4000, 2900, ""},
+    {7, "1.1", "text/plain", "1_1.txt", imap_transfer_encoding_quoted_printable, 2000, 0, "utf-8"},
+    {7, "1.2.1", "text/html", "1_2_1.html", imap_transfer_encoding_quoted_printable, 9000, 0, "utf-8"},
+    {7, "1.2.2", "image/png", "img0.png", imap_transfer_encoding_base64, 12000, 9000, ""},
+    {7, "1.2.3", "image/png", "img1.png", imap_transfer_encoding_base64, 12000, 9000, ""},
+    {7, "1.2.4", "image/png", "img2.png", imap_transfer_encoding_base64, 12000, 9000, ""},
+    {7, "2", "application/pdf", "doc0.pdf", imap_transfer_encoding_base64, 50000, 37500, ""},
+    {7, "3", "application/pdf", "doc1.pdf", imap_transfer_encoding_base64, 50000, 37500, ""},
+    {7, "4", "application/pdf", "doc2.pdf", imap_transfer_encoding_base64, 50000, 37500, ""},
+    {7, "5", "message/rfc822", "5.eml", imap_transfer_encoding_7bit, 4000, 4000, ""},
+    {7, "5.1", "text/plain", "5_1.txt", imap_transfer_encoding_7bit, 100, 0, "utf-8"},
+    {7, "5.2", "application/pdf", "inner.pdf", imap_transfer_encoding_base64, 3000, 2250, ""},
+};
+
+static IMAPParser parser;
+static imap_context ctx;
+static size_t e = 0;
+
+// The files of the response are the next expected files
+static void checkResponse(int r, const String &line)
+{
+    imap_msg_ctx cmsg;
+    parser.parseBodyStructure(&ctx, line, cmsg);
+    for (const imap_file_ctx &f : cmsg.files)
+    {
+        REQUIRE(e < sizeof(expected) / sizeof(expected[0]) && expected[e].response == r);
+        const expected_file &x = expected[e++];
+        CHECK(f.section == x.section);
+        CHECK(f.info.mime == x.mime);
+        CHECK(f.info.filename == x.filename);
+        CHECK_EQ(f.transfer_encoding, x.encoding);
+        CHECK_EQ(f.octet_count, x.octets);
+        CHECK_EQ(f.info.fileSize, x.size);
+        CHECK(f.info.charset == x.charset);
+        CHECK(f.fetch);
+    }
+}
+
+int main()
+{
+    const int responses = sizeof(bodystructure_corpus) / sizeof(bodystructure_corpus[0]);
+    for (int r = 0; r < responses; r++)
+        checkResponse(r, bodystructure_corpus[r]);
+    checkResponse(responses, bodystructure_deep(3).c_str());
+    CHECK_EQ(e, sizeof(expected) / sizeof(expected[0]));
+    return check_report("readymail_bodystructure_test");
+}
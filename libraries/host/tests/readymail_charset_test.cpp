@@ -0,0 +1,32 @@
+/*
+ * The ReadyMail charset decoders of ReadyCodec.h with bytes above 0x7f, which are negative
+ * where char is signed as on this host: TIS-620 Thai to UTF-8 and the 7-bit line decoder.
+ */
+#define ENABLE_IMAP
+#include <ReadyMail.h>
+#include <string.h>
+#include "support/check.h"
+
+static void tis620()
+{
+    // "Thai" (ไทย) and the digit ๑ between ASCII, 0xdb..0xde and 0xfc.. are not assigned
+    const char in[] = "A \xe4\xb7\xc2 \xf1\xdb\xfc.";
+    char out[sizeof(in) * 3];
+    memset(out, 0, sizeof(out));
+    rd_dec_tis620_utf8(out, in, strlen(in));
+    CHECK(strcmp(out, "A \xe0\xb9\x84\xe0\xb8\x97\xe0\xb8\xa2 \xe0\xb9\x91.") == 0);
+}
+
+static void sevenBit()
+{
+    char *out = rd_dec_7bit_utf8("caf\xc3\xa9 =3D ok");
+    CHECK(strcmp(out, "caf = ok") == 0);
+    rd_free(&out);
+}
+
+int main()
+{
+    tis620();
+    sevenBit();
+    return check_report("readymail_charset_test");
+}
@@ -0,0 +1,89 @@
+/*
+ * ReadyMail rd_qb_encode_chunk: the line limits of each transfer encoding.
+ */
+#define ENABLE_SMTP
+#include <ReadyMail.h>
+#include <string>
+#include "support/check.h"
+
+static std::string encode(const std::string &in, int mode, bool flowed)
+{
+    src_data_ctx src;
+    src.setSource(in.data(), in.size(), src_data_static);
+    rd_line_enc_ctx ctx;
+    char line[RD_LINE_ENC_OUT_SIZE];
+    std::string out;
+    int index = 0;
+    while (index < (int)in.size())
+    {
+        int n = rd_qb_encode_chunk(src, index, mode, flowed, MAX_LINE_LEN, ctx, line);
+        out.append(line, n);
+    }
+    return out;
+}
+
+// The longest line without its CRLF, -1 if there is a CR or LF outside a CRLF pair
+static int longestLine(const std::string &s)
+{
+    int longest = 0, len = 0;
+    for (size_t i = 0; i < s.size(); i++)
+    {
+        if (s[i] == '\r' && i + 1 < s.size() && s[i + 1] == '\n')
+        {
+            longest = len > longest ? len : longest;
+            len = 0;
+            i++;
+        }
+        else if (s[i] == '\r' || s[i] == '\n')
+            return -1;
+        else
+            len++;
+    }
+    return len > longest ? len : longest;
+}
+
+static std::string withoutLineBreaks(const std::string &s)
+{
+    std::string out;
+    for (char c : s)
+        if (c != '\r' && c != '\n')
+            out += c;
+    return out;
+}
+
+int main()
+{
+    // A line over the 998 octets of rfc5321, bare LFs and regular CRLF lines
+    std::string in = "Subject line of the body\r\n";
+    for (int i = 0; i < 1500; i++)
+        in += (char)('a' + i % 26);
+    in += "\nbare LF line\nanother\r\nlast line without break";
+
+    // No transfer encoding and 8bit are broken at MAX_LINE_LEN with CRLF only
+    for (int mode : {0 /* xenc_none */, 4 /* xenc_8bit */})
+    {
+        std::string out = encode(in, mode, false);
+        int longest = longestLine(out);
+        CHECK(longest > 0);
+        CHECK(longest <= MAX_LINE_LEN);
+        CHECK(withoutLineBreaks(out) == withoutLineBreaks(in));
+        CHECK(out.find("bare LF line\r\nanother\r\n") != std::string::npos);
+    }
+
+    // Flowed 7bit breaks after the last space
+    std::string words;
+    for (int i = 0; i < 100; i++)
+        words += "word ";
+    std::string flowed = encode(words, 1 /* xenc_7bit */, true);
+    CHECK(longestLine(flowed) > 0 && longestLine(flowed) <= MAX_LINE_LEN);
+    CHECK(withoutLineBreaks(flowed) == words);
+
+    // Binary data and non flowed 7bit go as is
+    std::string binary;
+    for (int i = 0; i < 3000; i++)
+        binary += (char)(i * 7);
+    CHECK(encode(binary, 5 /* xenc_binary */, false) == binary);
+    CHECK(encode(in, 1 /* xenc_7bit */, false) == in);
+
+    return check_report("readymail_line_enc_test");
+}
@@ -0,0 +1,38 @@
+/*
+ * Smoke test of the host build: ReadyMail sends a message to the SMTP sink over the
+ * loopback Client.
+ */
+#define ENABLE_SMTP
+#include <ReadyMail.h>
+#include "support/SMTPServer.h"
+#include "support/check.h"
+
+static void readyMailSend()
+{
+    SMTPServer server;
+    LoopbackClient client(server);
+    SMTPClient smtp(client);
+
+    smtp.connect("127.0.0.1", 25, nullptr, false);
+    CHECK(smtp.isConnected());
+    smtp.authenticate("me@example.com", "pw", readymail_auth_password);
+    CHECK(smtp.isAuthenticated());
+
+    SMTPMessage msg;
+    msg.headers.add(rfc822_subject, "ReadyMail host test");
+    msg.headers.add(rfc822_from, "Me <me@example.com>");
+    msg.headers.add(rfc822_to, "You <you@example.com>");
+    msg.text.body("Hello from the host build.\r\n");
+    msg.timestamp = 1746013620;
+    CHECK(smtp.send(msg));
+
+    REQUIRE(server.messages.size() == 1);
+    CHECK(server.messages[0].find("From: \"Me\" <me@example.com>\r\n") != std::string::npos);
+    CHECK(server.messages[0].find("Hello from the host build.") != std::string::npos);
+}
+
+int main()
+{
+    readyMailSend();
+    return check_report("readymail_smtp_test");
+}
@@ -0,0 +1,206 @@
+/*
+ * HD44780 LCD controller model on the virtual clock, behind a PCF8574 I2C backpack or
+ * the parallel pins.
+ *
+ * The controller decodes the enable falling edges in the 8-bit interface until the
+ * function set selects 4 bits, keeps the DDRAM and the address counter, and is busy for
+ * 37 us after each instruction or character (1.52 ms after clear and home). An
+ * instruction with either nibble written while it is busy is counted in violations and
+ * still executed, like the real controller that may drop it. The busy flag and the address counter are read with RW high.
+ */
+#ifndef HOST_HD44780_H
+#define HOST_HD44780_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <string.h>
+#include <string>
+
+class HD44780
+{
+public:
+    static const unsigned EXEC_US = 37;
+    static const unsigned HOME_US = 1520;
+
+    unsigned long writes = 0;     // the instructions and characters
+    unsigned long violations = 0; // the writes while busy
+    unsigned long reads = 0;      // the busy flag reads
+    bool stuckBusy = false;       // the busy flag always reads 1, e.g. an LCD that does not answer
+
+    HD44780() { memset(_ddram, ' ', sizeof(_ddram)); }
+
+    // The enable falling edge with RW low, the data on DB7..DB0 (DB7..DB4 in 4-bit mode)
+    void write(bool rs, uint8_t data)
+    {
+        bool early = busy();
+        if (!_fourBit)
+            return execute(rs, data, early);
+        if (!_low)
+        {
+            _high = data & 0xf0;
+            _highEarly = early;
+            _low = true;
+            return;
+        }
+        _low = false;
+        execute(rs, _high | (data >> 4), early || _highEarly);
+    }
+
+    // The enable rising edge with RW high, the value on DB7..DB0 (DB7..DB4 in 4-bit mode)
+    uint8_t read()
+    {
+        uint8_t v = ((busy() || stuckBusy) ? 0x80 : 0) | _ac;
+        if (!_fourBit)
+        {
+            reads++;
+            return v;
+        }
+        _readLow = !_readLow;
+        if (_readLow)
+        {
+            reads++;
+            return v & 0xf0;
+        }
+        return v << 4;
+    }
+
+    bool busy() const { return host::nowMicros() < _busyUntil; }
+
+    std::string text(uint8_t addr, size_t len) const { return std::string(reinterpret_cast<const char *>(_ddram) + addr, len); }
+
+    uint8_t address() const { return _ac; }
+
+private:
+    uint8_t _ddram[0x80];
+    uint8_t _ac = 0;
+    bool _increment = true;
+    bool _cgram = false;
+    bool _fourBit = false;
+    bool _low = false;
+    bool _readLow = false;
+    bool _highEarly = false;
+    uint8_t _high = 0;
+    uint64_t _busyUntil = 0;
+
+    void execute(bool rs, uint8_t v, bool early)
+    {
+        writes++;
+        if (early)
+            violations++;
+        unsigned us = EXEC_US;
+        if (rs)
+        {
+            if (!_cgram)
+                _ddram[_ac] = v;
+            step();
+        }
+        else if (v & 0x80)
+        {
+            _ac = v & 0x7f;
+            _cgram = false;
+        }
+        else if (v & 0x40)
+            _cgram = true;
+        else if (v & 0x20)
+            _fourBit = !(v & 0x10);
+        else if (v & 0x04 && !(v & 0x18))
+            _increment = v & 0x02;
+        else if (v == 0x01 || (v & 0xfe) == 0x02)
+        {
+            if (v == 0x01)
+            {
+                memset(_ddram, ' ', sizeof(_ddram));
+                _increment = true;
+            }
+            _ac = 0;
+            _cgram = false;
+            us = HOME_US;
+        }
+        _busyUntil = host::nowMicros() + us;
+    }
+
+    void step() { _ac = (_ac + (_increment ? 1 : 0x7f)) & 0x7f; }
+};
+
+// The PCF8574 backpack: P0 RS, P1 RW, P2 EN, P3 backlight, P4..P7 DB4..DB7
+class HD44780_I2C : public TwoWireDevice
+{
+public:
+    HD44780 lcd;
+
+    void receive(uint8_t address, uint8_t data) override
+    {
+        (void)address;
+        if ((_port & 0x04) && !(data & 0x04) && !(data & 0x02))
+            lcd.write(data & 0x01, data & 0xf0);
+        _port = data;
+    }
+
+private:
+    uint8_t _port = 0;
+};
+
+// The parallel interface, data[0..3] to DB4..DB7 in 4-bit mode or DB0..DB7 in 8-bit mode.
+// Each pin call takes pinCallUs, e.g. 4 us for digitalWrite on AVR.
+class HD44780_Pins : public HostPins
+{
+public:
+    HD44780 lcd;
+    unsigned pinCallUs = 0;
+
+    HD44780_Pins(uint8_t rs, uint8_t rw, uint8_t en, const uint8_t *data, int pins)
+        : _rs(rs), _rw(rw), _en(en), _pins(pins)
+    {
+        memcpy(_data, data, pins);
+    }
+
+    void digitalWrite(uint8_t pin, uint8_t val) override
+    {
+        host::advanceMicros(pinCallUs);
+        bool level = val != LOW;
+        if (pin == _en && level != _enLevel)
+        {
+            _enLevel = level;
+            if (_rwLevel && level)
+                _out = lcd.read();
+            else if (!_rwLevel && !level)
+                lcd.write(_rsLevel, bus());
+        }
+        else if (pin == _rs)
+            _rsLevel = level;
+        else if (pin == _rw)
+            _rwLevel = level;
+        else
+            for (int i = 0; i < _pins; i++)
+                if (pin == _data[i])
+                    _in[i] = level;
+    }
+
+    int digitalRead(uint8_t pin) override
+    {
+        host::advanceMicros(pinCallUs);
+        int shift = _pins == 8 ? 0 : 4;
+        for (int i = 0; i < _pins; i++)
+            if (pin == _data[i])
+                return (_out >> (i + shift)) & 1;
+        return LOW;
+    }
+
+private:
+    uint8_t _rs, _rw, _en, _data[8];
+    int _pins;
+    bool _rsLevel = false, _rwLevel = false, _enLevel = false;
+    bool _in[8] = {};
+    uint8_t _out = 0;
+
+    uint8_t bus() const
+    {
+        uint8_t v = 0;
+        int shift = _pins == 8 ? 0 : 4;
+        for (int i = 0; i < _pins; i++)
+            v |= _in[i] << (i + shift);
+        return v;
+    }
+};
+
+#endif
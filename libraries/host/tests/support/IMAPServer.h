@@ -0,0 +1,152 @@
+/*
+ * IMAP server for the loopback Client with one message in INBOX, enough for
+ * ESP_Mail_Client readMail: the message header fields, the part MIME headers and the
+ * part bodies are answered as literals from header and parts. The header fields of an
+ * attached message are parts["N.HEADER"], empty when not given.
+ *
+ * The replies go out in segments of the sizes in segments, repeated, the next one when
+ * the client has read the previous one, so that lines, CRLF and base64 groups are split
+ * across reads. With stallAfter set, the server sends that many bytes of the first part
+ * body literal and then stops, moving the virtual clock by 1 ms whenever the client polls.
+ */
+#ifndef HOST_IMAP_SERVER_H
+#define HOST_IMAP_SERVER_H
+
+#include <algorithm>
+#include <ctype.h>
+#include <map>
+#include <string>
+#include <vector>
+#include <Arduino.h>
+#include <LoopbackClient.h>
+
+class IMAPServer : public LoopbackServer
+{
+public:
+    std::string header;                       // the message header fields, each line ending with CRLF
+    std::map<std::string, std::string> parts; // the literals by section, e.g. "2", "2.MIME" and "2.HEADER"
+    std::vector<size_t> segments = {4096};
+    long stallAfter = -1;
+    std::vector<std::string> commands; // the command lines received
+
+    void accept(LoopbackPeer &peer) override
+    {
+        _line.clear();
+        _out.clear();
+        _seg = 0;
+        _stalled = false;
+        queue("* OK IMAP4rev1 ready\r\n");
+        flush(peer);
+    }
+
+    void service(LoopbackPeer &peer) override
+    {
+        size_t n = peer.available();
+        if (n)
+        {
+            _line.append(reinterpret_cast<const char *>(peer.data()), n);
+            peer.consume(n);
+            size_t eol;
+            while ((eol = _line.find("\r\n")) != std::string::npos)
+            {
+                std::string cmd = _line.substr(0, eol);
+                _line.erase(0, eol + 2);
+                commands.push_back(cmd);
+                reply(cmd);
+            }
+        }
+        flush(peer);
+    }
+
+private:
+    std::string _line, _out, _authTag;
+    size_t _seg = 0;
+    bool _stalled = false;
+    size_t _beforeStall = 0; // the bytes of _out still sent when stalled
+
+    void queue(const std::string &s) { _out += s; }
+
+    void flush(LoopbackPeer &peer)
+    {
+        if (_stalled && _beforeStall == 0)
+        {
+            host::advanceMicros(1000);
+            return;
+        }
+        if (_out.empty() || peer.pending())
+            return;
+        size_t n = std::min(segments[_seg++ % segments.size()], _out.size());
+        if (_stalled)
+        {
+            n = std::min(n, _beforeStall);
+            _beforeStall -= n;
+        }
+        peer.write(_out.substr(0, n));
+        _out.erase(0, n);
+    }
+
+    // The section of BODY[...] or BODY.PEEK[...] in the command
+    static bool section(const std::string &cmd, std::string &sec)
+    {
+        size_t p = cmd.find("BODY");
+        if (p == std::string::npos || (p = cmd.find('[', p)) == std::string::npos)
+            return false;
+        sec = cmd.substr(p + 1, cmd.find(']', p) - p - 1);
+        return true;
+    }
+
+    void literal(const std::string &sec, const std::string &data, bool stall)
+    {
+        queue("* 1 FETCH (UID 1 BODY[" + sec + "] {" + std::to_string(data.size()) + "}\r\n");
+        if (stall)
+        {
+            _stalled = true;
+            _beforeStall = _out.size() + stallAfter;
+        }
+        queue(data + ")\r\n");
+    }
+
+    void reply(const std::string &line)
+    {
+        // The SASL response to the continuation request
+        if (line.find(' ') == std::string::npos)
+        {
+            queue(_authTag + " OK logged in\r\n");
+            return;
+        }
+
+        std::string tag = line.substr(0, line.find(' '));
+        std::string cmd = line.substr(tag.size() + 1);
+        std::transform(cmd.begin(), cmd.end(), cmd.begin(), [](unsigned char c) { return (char)toupper(c); });
+        std::string ok = tag + " OK completed\r\n";
+        std::string sec;
+
+        if (cmd.compare(0, 10, "CAPABILITY") == 0)
+            queue("* CAPABILITY IMAP4rev1 AUTH=PLAIN\r\n" + ok);
+        else if (cmd == "AUTHENTICATE PLAIN")
+        {
+            _authTag = tag;
+            queue("+ \r\n");
+        }
+        else if (cmd.compare(0, 6, "SELECT") == 0 || cmd.compare(0, 7, "EXAMINE") == 0)
+            queue("* 1 EXISTS\r\n* 0 RECENT\r\n* FLAGS (\\Seen \\Answered)\r\n* OK [UIDVALIDITY 7] ok\r\n* OK [UIDNEXT 2] ok\r\n" + ok);
+        else if (cmd.find("FETCH") != std::string::npos)
+        {
+            if (section(cmd, sec) && sec.compare(0, 6, "HEADER") == 0)
+                literal(sec, header + "\r\n", false);
+            else if (section(cmd, sec) && sec.find(".HEADER") != std::string::npos)
+                literal(sec, parts[sec.substr(0, sec.find(".HEADER") + 7)] + "\r\n", false);
+            else if (section(cmd, sec) && parts.count(sec))
+                literal(sec, parts[sec], stallAfter >= 0 && !_stalled && sec.find('.') == std::string::npos);
+            else if (!section(cmd, sec))
+                queue("* 1 FETCH (UID 1 FLAGS (\\Seen))\r\n");
+            queue(ok);
+        }
+        else if (cmd == "LOGOUT")
+            queue("* BYE\r\n" + ok);
+        else
+            queue(ok);
+    }
+};
+
+#endif
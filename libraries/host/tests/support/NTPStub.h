@@ -0,0 +1,173 @@
+/*
+ * Stub UDP with simulated NTP servers behind it, for the virtual clock.
+ *
+ * The true time runs at the local rate corrected by skewPpm, millis() runs slow by
+ * skewPpm. Each request is answered after a one way delay of baseDelayMs / 2 plus a
+ * uniform jitter in each direction, so the reply is seen by parsePacket() once the
+ * virtual clock has reached its arrival time.
+ */
+#ifndef HOST_NTP_STUB_H
+#define HOST_NTP_STUB_H
+
+#include <Arduino.h>
+#include <Udp.h>
+#include <random>
+#include <string>
+#include <vector>
+
+class NTPStubUDP : public UDP
+{
+public:
+    struct Server
+    {
+        std::string name;   // the host name, empty for servers addressed by IP
+        IPAddress ip;
+        double offsetMs;    // the error of the server clock
+        bool silent;        // never replies
+    };
+
+    unsigned long long epoch0Ms = 1700000000000ULL; // the true epoch at local time 0
+    double skewPpm = 0;
+    double baseDelayMs = 20;
+    double jitterMs = 80;
+    unsigned long requests = 0;
+
+    explicit NTPStubUDP(unsigned long seed = 1) : _rng(seed) {}
+
+    void addServer(const char *name, double offsetMs = 0, bool silent = false) { _servers.push_back({name, IPAddress(), offsetMs, silent}); }
+    void addServer(IPAddress ip, double offsetMs = 0, bool silent = false) { _servers.push_back({"", ip, offsetMs, silent}); }
+
+    // The true epoch in ms at the current local time
+    double trueEpochMs() const { return epoch0Ms + trueMs(); }
+
+    uint8_t begin(uint16_t port) override
+    {
+        (void)port;
+        return 1;
+    }
+    void stop() override { _queue.clear(); }
+
+    int beginPacket(IPAddress ip, uint16_t port) override
+    {
+        (void)port;
+        for (size_t i = 0; i < _servers.size(); i++)
+            if (_servers[i].name.empty() && _servers[i].ip == ip)
+                return open(i);
+        return 0;
+    }
+    int beginPacket(const char *host, uint16_t port) override
+    {
+        (void)port;
+        for (size_t i = 0; i < _servers.size(); i++)
+            if (_servers[i].name == host)
+                return open(i);
+        return 0; // the name does not resolve
+    }
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buffer, size_t size) override
+    {
+        _request.append(reinterpret_cast<const char *>(buffer), size);
+        return size;
+    }
+    using Print::write;
+    int endPacket() override
+    {
+        if (_server < 0)
+            return 0;
+        requests++;
+        const Server &server = _servers[_server];
+        _server = -1;
+        if (server.silent || _request.size() < PACKET_SIZE)
+            return 1;
+
+        std::uniform_real_distribution<double> jitter(0, jitterMs);
+        double t1 = trueMs();
+        double t2 = t1 + baseDelayMs / 2 + jitter(_rng);
+        double t3 = t2 + 0.1;
+        double t4 = t3 + baseDelayMs / 2 + jitter(_rng);
+
+        Packet p;
+        memset(p.data, 0, sizeof(p.data));
+        p.data[0] = 0x24; // no leap warning, version 4, server mode
+        p.data[1] = 2;    // stratum
+        memcpy(p.data + 24, _request.data() + 40, 8);
+        putTimestamp(p.data + 32, epoch0Ms + t2 + server.offsetMs);
+        putTimestamp(p.data + 40, epoch0Ms + t3 + server.offsetMs);
+        p.arrivalUs = (uint64_t)(t4 * (1 - skewPpm * 1e-6) * 1000);
+        p.ip = server.ip;
+
+        // Keep the queue in arrival order
+        size_t i = _queue.size();
+        while (i > 0 && _queue[i - 1].arrivalUs > p.arrivalUs)
+            i--;
+        _queue.insert(_queue.begin() + i, p);
+        return 1;
+    }
+
+    int parsePacket() override
+    {
+        if (_queue.empty() || _queue.front().arrivalUs > host::nowMicros())
+            return 0;
+        _current = _queue.front();
+        _queue.erase(_queue.begin());
+        _pos = 0;
+        return PACKET_SIZE;
+    }
+    int available() override { return PACKET_SIZE - _pos; }
+    int read() override { return _pos < PACKET_SIZE ? _current.data[_pos++] : -1; }
+    int read(unsigned char *buffer, size_t len) override
+    {
+        size_t n = PACKET_SIZE - _pos;
+        if (len < n)
+            n = len;
+        memcpy(buffer, _current.data + _pos, n);
+        _pos += n;
+        return n;
+    }
+    int read(char *buffer, size_t len) override { return read(reinterpret_cast<unsigned char *>(buffer), len); }
+    int peek() override { return _pos < PACKET_SIZE ? _current.data[_pos] : -1; }
+    void flush() override { _pos = PACKET_SIZE; }
+    IPAddress remoteIP() override { return _current.ip; }
+    uint16_t remotePort() override { return 123; }
+
+private:
+    static const size_t PACKET_SIZE = 48;
+
+    struct Packet
+    {
+        uint8_t data[PACKET_SIZE];
+        uint64_t arrivalUs;
+        IPAddress ip;
+    };
+
+    std::vector<Server> _servers;
+    std::vector<Packet> _queue;
+    std::string _request;
+    int _server = -1;
+    Packet _current;
+    size_t _pos = PACKET_SIZE;
+    std::mt19937 _rng;
+
+    double trueMs() const { return host::nowMicros() / 1000.0 / (1 - skewPpm * 1e-6); }
+
+    int open(size_t server)
+    {
+        _server = (int)server;
+        _request.clear();
+        return 1;
+    }
+
+    static void putTimestamp(uint8_t *buf, double epochMs)
+    {
+        unsigned long long ms = (unsigned long long)epochMs;
+        unsigned long long secs = ms / 1000 + 2208988800ULL;
+        unsigned long long frac = ((ms % 1000) << 32) / 1000;
+        for (int i = 0; i < 4; i++)
+        {
+            buf[i] = (uint8_t)(secs >> (24 - 8 * i));
+            buf[4 + i] = (uint8_t)(frac >> (24 - 8 * i));
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,124 @@
+/*
+ * SMTP sink for the loopback Client.
+ *
+ * Answers each command line as soon as it is complete and keeps the messages it
+ * received. Recipients containing "bad@" are rejected with 550. With replyDelayUs set,
+ * the replies are held back for that long after the command arrived, the round trip of a
+ * remote server; the replies to pipelined commands arrive together.
+ */
+#ifndef HOST_SMTP_SERVER_H
+#define HOST_SMTP_SERVER_H
+
+#include <deque>
+#include <string>
+#include <vector>
+#include <Arduino.h>
+#include <LoopbackClient.h>
+
+class SMTPServer : public LoopbackServer
+{
+public:
+    bool pipelining = true;
+    std::string transcript;            // everything the client sent
+    std::vector<std::string> messages; // the DATA payloads, dot-stuffing left in place
+    unsigned long rsets = 0;
+    uint64_t replyDelayUs = 0;
+
+    void accept(LoopbackPeer &peer) override
+    {
+        _data = false;
+        _line.clear();
+        _scanned = 0;
+        _delayed.clear();
+        send(peer, "220 host ESMTP\r\n");
+    }
+
+    void service(LoopbackPeer &peer) override
+    {
+        while (_delayed.size() && host::nowMicros() >= _delayed.front().first)
+        {
+            peer.write(_delayed.front().second);
+            _delayed.pop_front();
+        }
+
+        size_t n = peer.available();
+        if (!n)
+            return;
+        const char *p = reinterpret_cast<const char *>(peer.data());
+        transcript.append(p, n);
+        _line.append(p, n);
+        peer.consume(n);
+
+        for (;;)
+        {
+            if (_data)
+            {
+                // Only the new data and the 4 bytes before it can complete the terminator
+                size_t end = _line.find("\r\n.\r\n", _scanned > 4 ? _scanned - 4 : 0);
+                if (end == std::string::npos)
+                {
+                    _scanned = _line.size();
+                    return;
+                }
+                messages.push_back(_line.substr(2, end));
+                _line.erase(0, end + 5);
+                _data = false;
+                _scanned = 0;
+                send(peer, "250 queued\r\n");
+                continue;
+            }
+            size_t eol = _line.find("\r\n");
+            if (eol == std::string::npos)
+                return;
+            std::string cmd = _line.substr(0, eol);
+            _line.erase(0, eol + 2);
+            reply(peer, cmd);
+        }
+    }
+
+private:
+    bool _data = false;
+    std::string _line;
+    size_t _scanned = 0; // the DATA payload searched for the terminator
+    std::deque<std::pair<uint64_t, std::string>> _delayed; // the replies and when they are due
+
+    void send(LoopbackPeer &peer, const char *reply)
+    {
+        if (replyDelayUs)
+            _delayed.emplace_back(host::nowMicros() + replyDelayUs, reply);
+        else
+            peer.write(reply);
+    }
+
+    static bool startsWith(const std::string &s, const char *prefix) { return s.compare(0, strlen(prefix), prefix) == 0; }
+
+    void reply(LoopbackPeer &peer, const std::string &cmd)
+    {
+        if (startsWith(cmd, "EHLO"))
+            send(peer, pipelining ? "250-host\r\n250-PIPELINING\r\n250-8BITMIME\r\n250 AUTH PLAIN LOGIN\r\n" : "250-host\r\n250-8BITMIME\r\n250 AUTH PLAIN LOGIN\r\n");
+        else if (startsWith(cmd, "HELO"))
+            send(peer, "250 host\r\n");
+        else if (startsWith(cmd, "AUTH"))
+            send(peer, "235 ok\r\n");
+        else if (startsWith(cmd, "DATA"))
+        {
+            _data = true;
+            // The CRLF that ends the DATA line also starts the "\r\n.\r\n" search
+            _line.insert(0, "\r\n");
+            send(peer, "354 go\r\n");
+        }
+        else if (startsWith(cmd, "QUIT"))
+            send(peer, "221 bye\r\n");
+        else if (startsWith(cmd, "RSET"))
+        {
+            rsets++;
+            send(peer, "250 reset\r\n");
+        }
+        else if (cmd.find("bad@") != std::string::npos)
+            send(peer, "550 no such user\r\n");
+        else
+            send(peer, "250 ok\r\n");
+    }
+};
+
+#endif
@@ -0,0 +1,167 @@
+/*
+ * TLS server for the loopback Client, on the BearSSL server engine of the library.
+ *
+ * The records from the client are decrypted in service(). The plain text goes to the
+ * application server through an inner loopback connection, or is echoed back when there
+ * is none. The server stops producing records while the client has more than
+ * MAX_PENDING bytes left to read, so a slow reader keeps the memory bounded. With
+ * sessionCache set, the server keeps the sessions and resumes the ones the client offers.
+ */
+#ifndef HOST_TLS_SERVER_H
+#define HOST_TLS_SERVER_H
+
+#include <set>
+#include <string>
+#include <bearssl.h>
+#include <LoopbackClient.h>
+
+class TLSServer : public LoopbackServer
+{
+public:
+    static const size_t MAX_PENDING = 65536;
+
+    unsigned long handshakes = 0;  // the completed handshakes
+    unsigned long resumed = 0;     // the handshakes that resumed a session
+    bool sessionCache = false;     // keep the sessions for resumption
+    int lastError = 0;             // the engine error when it closed
+    bool ignoreMaxFragLen = false; // decline the max fragment length and send full records
+
+    // The EC server certificate and its key in DER, both must stay valid
+    TLSServer(const uint8_t *cert, size_t certLen, const uint8_t *key, size_t keyLen, LoopbackServer *app = nullptr)
+        : _key(key), _keyLen(keyLen), _app(app)
+    {
+        _chain.data = const_cast<uint8_t *>(cert);
+        _chain.data_len = certLen;
+        if (_app)
+            _inner.setServer(_app);
+        br_ssl_session_cache_lru_init(&_lru, _lruStore, sizeof(_lruStore));
+    }
+    TLSServer(const TLSServer &) = delete;
+    TLSServer &operator=(const TLSServer &) = delete;
+
+    void accept(LoopbackPeer &peer) override
+    {
+        (void)peer;
+        br_skey_decoder_init(&_kd);
+        br_skey_decoder_push(&_kd, _key, _keyLen);
+        br_ssl_server_init_full_ec(&_sc, &_chain, 1, BR_KEYTYPE_EC, br_skey_decoder_get_ec(&_kd));
+        br_ssl_engine_set_buffer(&_sc.eng, _iobuf, sizeof(_iobuf), 1);
+        if (sessionCache)
+            br_ssl_server_set_cache(&_sc, &_lru.vtable);
+        // The server only accepts a requested fragment length below its own one
+        if (ignoreMaxFragLen)
+            _sc.eng.log_max_frag_len = 9;
+        br_ssl_server_reset(&_sc);
+        _echo.clear();
+        _open = false;
+        lastError = 0;
+        if (_app)
+        {
+            _inner.stop();
+            _inner.connect("", 0);
+        }
+    }
+
+    void service(LoopbackPeer &peer) override
+    {
+        br_ssl_engine_context *eng = &_sc.eng;
+        for (;;)
+        {
+            unsigned state = br_ssl_engine_current_state(eng);
+            size_t len;
+            if (state & BR_SSL_CLOSED)
+            {
+                lastError = br_ssl_engine_last_error(eng);
+                peer.close();
+                return;
+            }
+            if (state & BR_SSL_SENDREC)
+            {
+                unsigned char *buf = br_ssl_engine_sendrec_buf(eng, &len);
+                peer.write(buf, len);
+                br_ssl_engine_sendrec_ack(eng, len);
+                continue;
+            }
+            if (state & BR_SSL_RECVAPP)
+            {
+                unsigned char *buf = br_ssl_engine_recvapp_buf(eng, &len);
+                if (_app)
+                    _inner.write(buf, len);
+                else
+                    _echo.push(buf, len);
+                br_ssl_engine_recvapp_ack(eng, len);
+                continue;
+            }
+            if (state & BR_SSL_SENDAPP)
+            {
+                if (!_open)
+                {
+                    _open = true;
+                    handshakes++;
+                    // A new session ID each time unless the session was resumed
+                    br_ssl_session_parameters params;
+                    br_ssl_engine_get_session_parameters(eng, &params);
+                    if (!_sessionIds.insert(std::string((const char *)params.session_id, params.session_id_len)).second)
+                        resumed++;
+                }
+                size_t n = pendingApp();
+                if (n && peer.pending() < MAX_PENDING)
+                {
+                    unsigned char *buf = br_ssl_engine_sendapp_buf(eng, &len);
+                    if (n > len)
+                        n = len;
+                    if (_app)
+                        _inner.read(buf, n);
+                    else
+                        _echo.read(buf, n);
+                    br_ssl_engine_sendapp_ack(eng, n);
+                    br_ssl_engine_flush(eng, 0);
+                    continue;
+                }
+            }
+            if ((state & BR_SSL_RECVREC) && peer.available())
+            {
+                unsigned char *buf = br_ssl_engine_recvrec_buf(eng, &len);
+                if (len > peer.available())
+                    len = peer.available();
+                memcpy(buf, peer.data(), len);
+                peer.consume(len);
+                br_ssl_engine_recvrec_ack(eng, len);
+                continue;
+            }
+            return;
+        }
+    }
+
+    void closed(LoopbackPeer &peer) override
+    {
+        (void)peer;
+        if (_app)
+            _inner.stop();
+    }
+
+private:
+    br_ssl_server_context _sc;
+    br_skey_decoder_context _kd;
+    br_x509_certificate _chain;
+    const uint8_t *_key;
+    size_t _keyLen;
+    unsigned char _iobuf[BR_SSL_BUFSIZE_BIDI];
+    LoopbackServer *_app;
+    LoopbackClient _inner;
+    HostPipe _echo;
+    bool _open = false;
+    br_ssl_session_cache_lru _lru;
+    unsigned char _lruStore[16 * 100];
+    std::set<std::string> _sessionIds;
+
+    size_t pendingApp()
+    {
+        if (!_app)
+            return _echo.size();
+        int n = _inner.available();
+        return n > 0 ? n : 0;
+    }
+};
+
+#endif
@@ -0,0 +1,291 @@
+/*
+ * The base64 codecs of ReadyMail and ESP_Mail_Client before the table-driven streaming
+ * codec, as the reference output of base64_compat_test.
+ */
+#ifndef HOST_BASE64_REF_H
+#define HOST_BASE64_REF_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace base64_ref
+{
+
+static const unsigned char rd_b64_map[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static unsigned char rd_b64_lookup(char c)
+{
+    if (c >= 'A' && c <= 'Z')
+        return c - 'A';
+    if (c >= 'a' && c <= 'z')
+        return c - 71;
+    if (c >= '0' && c <= '9')
+        return c + 4;
+    if (c == '+')
+        return 62;
+    if (c == '/')
+        return 63;
+    return -1;
+}
+
+static void rd_a4_to_a3(unsigned char *a3, unsigned char *a4)
+{
+    a3[0] = (a4[0] << 2) + ((a4[1] & 0x30) >> 4);
+    a3[1] = ((a4[1] & 0xf) << 4) + ((a4[2] & 0x3c) >> 2);
+    a3[2] = ((a4[2] & 0x3) << 6) + a4[3];
+}
+
+// base64 decoder
+static uint8_t *rd_b64_dec_impl(const char *encoded, int &size)
+{
+    int encoded_len = strlen(encoded);
+    int decoded_len = (encoded_len * 3) / 4;
+    uint8_t *raw = (uint8_t *)calloc(decoded_len + 1,1);
+    int i = 0;
+    int raw_len = 0;
+    unsigned char a3[3];
+    unsigned char a4[4];
+
+    while (encoded_len--)
+    {
+        if (*encoded == '=')
+            break;
+
+        a4[i++] = *(encoded++);
+        if (i == 4)
+        {
+            for (i = 0; i < 4; i++)
+                a4[i] = rd_b64_lookup(a4[i]);
+
+            rd_a4_to_a3(a3, a4);
+            for (i = 0; i < 3; i++)
+                raw[raw_len++] = a3[i];
+            i = 0;
+        }
+    }
+
+    if (i)
+    {
+        for (int j = i; j < 4; j++)
+            a4[j] = '\0';
+
+        for (int j = 0; j < 4; j++)
+            a4[j] = rd_b64_lookup(a4[j]);
+
+        rd_a4_to_a3(a3, a4);
+
+        for (int j = 0; j < i - 1; j++)
+            raw[raw_len++] = a3[j];
+    }
+    size = raw_len;
+    return raw;
+}
+
+// base64 encoder that writes to the provided buffer
+// and returns the encoded length (without null terminator)
+static int rd_b64_enc_to(char *encoded, const unsigned char *raw, int len)
+{
+    uint8_t count = 0;
+    unsigned char buffer[3];
+    int c = 0;
+    for (int i = 0; i < len; i++)
+    {
+        buffer[count++] = raw[i];
+        if (count == 3)
+        {
+            encoded[c++] = rd_b64_map[buffer[0] >> 2];
+            encoded[c++] = rd_b64_map[((buffer[0] & 0x03) << 4) + (buffer[1] >> 4)];
+            encoded[c++] = rd_b64_map[((buffer[1] & 0x0f) << 2) + (buffer[2] >> 6)];
+            encoded[c++] = rd_b64_map[buffer[2] & 0x3f];
+            count = 0;
+        }
+    }
+    if (count > 0)
+    {
+        encoded[c++] = rd_b64_map[buffer[0] >> 2];
+        if (count == 1)
+        {
+            encoded[c++] = rd_b64_map[(buffer[0] & 0x03) << 4];
+            encoded[c++] = '=';
+        }
+        else if (count == 2)
+        {
+            encoded[c++] = rd_b64_map[((buffer[0] & 0x03) << 4) + (buffer[1] >> 4)];
+            encoded[c++] = rd_b64_map[(buffer[1] & 0x0f) << 2];
+        }
+        encoded[c++] = '=';
+    }
+    return c;
+}
+
+// base64 encoder
+static char *rd_b64_enc(const unsigned char *raw, int len)
+{
+    char *encoded = (char *)calloc(len * 4 / 3 + 4,1);
+    encoded[rd_b64_enc_to(encoded, raw, len)] = '\0';
+    return encoded;
+}
+
+// base64 line encoder that works in place.
+// The raw data (len bytes, len <= lines * 57) should be placed at
+// the end of buf (offset = size - lines * 57, where lines = rd_b64_lines(size)).
+// Each 57-byte group is encoded to the 76-column line with CRLF from the beginning of buf.
+// The write position never reaches the unread data because each line only grows by 21 bytes.
+// Returns the encoded length.
+static int rd_b64_enc_lines(uint8_t *buf, int offset, int len)
+{
+    int out = 0;
+    for (int i = 0; i < len; i += 57)
+    {
+        out += rd_b64_enc_to((char *)(buf + out), buf + offset + i, len - i > 57 ? 57 : len - i);
+        buf[out++] = '\r';
+        buf[out++] = '\n';
+    }
+    return out;
+}
+
+static const unsigned char b64_index_table[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static unsigned char *esp_decodeBase64(const unsigned char *src, size_t len, size_t *out_len)
+{
+  unsigned char *out, *pos, block[4], tmp;
+  size_t i, count, olen;
+  int pad = 0;
+  size_t extra_pad;
+
+  unsigned char *dtable = (unsigned char *)calloc(256,1);
+
+  memset(dtable, 0x80, 256);
+
+  for (i = 0; i < sizeof(b64_index_table) - 1; i++)
+    dtable[b64_index_table[i]] = (unsigned char)i;
+  dtable['='] = 0;
+
+  count = 0;
+  for (i = 0; i < len; i++)
+  {
+    if (dtable[src[i]] != 0x80)
+      count++;
+  }
+
+  if (count == 0)
+    goto exit;
+
+  extra_pad = (4 - count % 4) % 4;
+
+  olen = (count + extra_pad) / 4 * 3;
+
+  pos = out = (unsigned char *)calloc(olen+1,1);
+
+  if (out == NULL)
+    goto exit;
+
+  count = 0;
+
+  for (i = 0; i < len + extra_pad; i++)
+  {
+    unsigned char val;
+
+    if (i >= len)
+      val = '=';
+    else
+      val = src[i];
+    tmp = dtable[val];
+    if (tmp == 0x80)
+      continue;
+
+    if (val == '=')
+      pad++;
+    block[count] = tmp;
+    count++;
+    if (count == 4)
+    {
+      *pos++ = (block[0] << 2) | (block[1] >> 4);
+      *pos++ = (block[1] << 4) | (block[2] >> 2);
+      *pos++ = (block[2] << 6) | block[3];
+      count = 0;
+      if (pad)
+      {
+        if (pad == 1)
+          pos--;
+        else if (pad == 2)
+          pos -= 2;
+        else
+        {
+          // release memory
+          free(out);
+          goto exit;
+        }
+        break;
+      }
+    }
+  }
+
+  *out_len = pos - out;
+  // release memory
+  free(dtable);
+  return out;
+exit:
+  // release memory
+  free(dtable);
+  return nullptr;
+}
+
+// The base64 attachment stream of ESP_Mail_Client sendBase64, UPLOAD_CHUNKS_NUM (12) lines
+// of 76 characters and CRLF per chunk
+static std::string esp_sendBase64(const std::string &data)
+{
+    const size_t chunk = 76 * 12 + 2 * 12;
+    std::string out;
+    std::vector<uint8_t> buf(chunk);
+    size_t bi = 0, ec = 0, i = 0;
+    while (i + 3 <= data.size())
+    {
+        const uint8_t *in = reinterpret_cast<const uint8_t *>(data.data()) + i;
+        i += 3;
+        buf[bi++] = b64_index_table[in[0] >> 2];
+        buf[bi++] = b64_index_table[((in[0] & 3) << 4) | (in[1] >> 4)];
+        buf[bi++] = b64_index_table[((in[1] & 15) << 2) | (in[2] >> 6)];
+        buf[bi++] = b64_index_table[in[2] & 63];
+        ec += 4;
+        if (ec == 76)
+        {
+            if (bi + 1 < chunk)
+            {
+                buf[bi++] = '\r';
+                buf[bi++] = '\n';
+            }
+            ec = 0;
+        }
+        if (bi >= chunk - 4)
+        {
+            out.append(reinterpret_cast<char *>(buf.data()), bi);
+            bi = 0;
+        }
+    }
+    out.append(reinterpret_cast<char *>(buf.data()), bi);
+    size_t r = data.size() - i;
+    if (r)
+    {
+        const uint8_t *c = reinterpret_cast<const uint8_t *>(data.data()) + i;
+        out += b64_index_table[c[0] >> 2];
+        if (r == 1)
+        {
+            out += b64_index_table[(c[0] & 3) << 4];
+            out += '=';
+        }
+        else
+        {
+            out += b64_index_table[((c[0] & 3) << 4) | (c[1] >> 4)];
+            out += b64_index_table[(c[1] & 15) << 2];
+        }
+        out += '=';
+    }
+    return out;
+}
+
+} // namespace base64_ref
+
+#endif
@@ -0,0 +1,40 @@
+/*
+ * BODY responses in the styles of Dovecot, Gmail and Outlook for the BODYSTRUCTURE parser
+ * tests, and a deep multipart/mixed tree with a forwarded message.
+ */
+#ifndef HOST_BODYSTRUCTURE_CORPUS_H
+#define HOST_BODYSTRUCTURE_CORPUS_H
+
+#include <string>
+
+static const char *bodystructure_corpus[] = {
+    // dovecot simple text
+    "* 1 FETCH (FLAGS (\\Seen) INTERNALDATE \"17-Jul-2024 02:44:25 -0700\" RFC822.SIZE 1452 ENVELOPE (\"Wed, 17 Jul 2024 02:23:25 -0700\" \"Hello\" ((\"Alice\" NIL \"alice\" \"example.com\")) ((\"Alice\" NIL \"alice\" \"example.com\")) ((\"Alice\" NIL \"alice\" \"example.com\")) ((NIL NIL \"bob\" \"example.org\")) NIL NIL NIL \"<1@example.com>\") BODY (\"text\" \"plain\" (\"charset\" \"us-ascii\") NIL NIL \"7bit\" 1152 23))\r\n",
+    // gmail alternative
+    "* 2 FETCH (FLAGS () INTERNALDATE \"17-Jul-2024 02:44:25 +0000\" RFC822.SIZE 7000 ENVELOPE (\"Wed, 17 Jul 2024 09:44:25 +0700\" \"=?UTF-8?B?4LiX4LiU4Liq4Lit4Lia?=\" ((\"Bob\" NIL \"bob\" \"gmail.com\")) ((\"Bob\" NIL \"bob\" \"gmail.com\")) ((\"Bob\" NIL \"bob\" \"gmail.com\")) ((NIL NIL \"alice\" \"example.com\")) NIL NIL NIL \"<CAB1@mail.gmail.com>\") BODY ((\"TEXT\" \"PLAIN\" (\"CHARSET\" \"UTF-8\") NIL NIL \"QUOTED-PRINTABLE\" 1340 27)(\"TEXT\" \"HTML\" (\"CHARSET\" \"UTF-8\") NIL NIL \"QUOTED-PRINTABLE\" 4812 62) \"ALTERNATIVE\"))\r\n",
+    // gmail mixed with alternative and attachments
+    "* 3 FETCH (FLAGS () INTERNALDATE \"17-Jul-2024 02:44:25 +0000\" RFC822.SIZE 900000 ENVELOPE (\"Wed, 17 Jul 2024 09:44:25 +0700\" \"Invoice\" ((\"Bob\" NIL \"bob\" \"gmail.com\")) ((\"Bob\" NIL \"bob\" \"gmail.com\")) ((\"Bob\" NIL \"bob\" \"gmail.com\")) ((NIL NIL \"alice\" \"example.com\")) NIL NIL NIL \"<CAB2@mail.gmail.com>\") BODY (((\"TEXT\" \"PLAIN\" (\"CHARSET\" \"UTF-8\") NIL NIL \"7BIT\" 54 2)(\"TEXT\" \"HTML\" (\"CHARSET\" \"UTF-8\") NIL NIL \"7BIT\" 124 2) \"ALTERNATIVE\")(\"APPLICATION\" \"PDF\" (\"NAME\" \"invoice-2024.pdf\") \"<f_lx1>\" NIL \"BASE64\" 124330)(\"IMAGE\" \"JPEG\" (\"NAME\" \"photo 1.jpg\") \"<ii_lx2>\" NIL \"BASE64\" 524288) \"MIXED\"))\r\n",
+    // outlook mixed(alternative(plain, related(html, image)), xlsx)
+    "* 4 FETCH (FLAGS (\\Seen \\Answered) INTERNALDATE \"17-Jul-2024 02:44:25 +0000\" RFC822.SIZE 120000 ENVELOPE (\"Wed, 17 Jul 2024 02:44:25 +0000\" \"RE: Report\" ((\"Carol\" NIL \"carol\" \"outlook.com\")) ((\"Carol\" NIL \"carol\" \"outlook.com\")) ((\"Carol\" NIL \"carol\" \"outlook.com\")) ((NIL NIL \"alice\" \"example.com\")) ((NIL NIL \"dave\" \"example.com\")) NIL \"<AM1@outlook.com>\" \"<AM2@outlook.com>\") BODY (((\"text\" \"plain\" (\"charset\" \"utf-8\") NIL NIL \"base64\" 2340 30)((\"text\" \"html\" (\"charset\" \"utf-8\") NIL NIL \"quoted-printable\" 9876 120)(\"image\" \"png\" (\"name\" \"image001.png\") \"<image001.png@01DA1234.5678ABCD>\" \"image001.png\" \"base64\" 23456) \"related\") \"alternative\")(\"application\" \"vnd.openxmlformats-officedocument.spreadsheetml.sheet\" (\"name\" \"=?utf-8?B?4Lij4Liy4Lii4LiH4Liy4LiZLnhsc3g=?=\") NIL \"=?utf-8?B?4Lij4Liy4Lii4LiH4Liy4LiZLnhsc3g=?=\" \"base64\" 45678) \"mixed\"))\r\n",
+    // dovecot forwarded message
+    "* 5 FETCH (FLAGS () INTERNALDATE \"17-Jul-2024 02:44:25 +0000\" RFC822.SIZE 3000 ENVELOPE (\"Wed, 17 Jul 2024 02:44:25 +0000\" \"Fwd: test\" ((\"Alice\" NIL \"alice\" \"example.com\")) ((\"Alice\" NIL \"alice\" \"example.com\")) ((\"Alice\" NIL \"alice\" \"example.com\")) ((NIL NIL \"bob\" \"example.org\")) NIL NIL NIL \"<f1@example.com>\") BODY ((\"text\" \"plain\" (\"charset\" \"utf-8\" \"format\" \"flowed\") NIL NIL \"8bit\" 320 10)(\"message\" \"rfc822\" (\"name\" \"Fwd.eml\") NIL NIL \"7bit\" 2048 (\"Mon, 7 Feb 1994 21:52:25 -0800\" \"test\" ((\"Eve\" NIL \"eve\" \"example.net\")) ((\"Eve\" NIL \"eve\" \"example.net\")) ((\"Eve\" NIL \"eve\" \"example.net\")) ((NIL NIL \"alice\" \"example.com\")) NIL NIL NIL \"<e1@example.net>\") ((\"text\" \"plain\" (\"charset\" \"us-ascii\") NIL NIL \"7bit\" 120 4)(\"text\" \"html\" (\"charset\" \"us-ascii\") NIL NIL \"7bit\" 450 12) \"alternative\") 60) \"mixed\"))\r\n",
+    // latin-1 text and a quoted filename with escapes and parentheses
+    "* 6 FETCH (FLAGS () INTERNALDATE \"17-Jul-2024 02:44:25 +0000\" RFC822.SIZE 5000 ENVELOPE (\"Wed, 17 Jul 2024 02:44:25 +0000\" \"=?ISO-8859-1?Q?Andr=E9?=\" ((\"Andre\" NIL \"andre\" \"example.fr\")) ((\"Andre\" NIL \"andre\" \"example.fr\")) ((\"Andre\" NIL \"andre\" \"example.fr\")) ((NIL NIL \"alice\" \"example.com\")) NIL NIL NIL \"<l1@example.fr>\") BODY ((\"text\" \"plain\" (\"charset\" \"iso-8859-1\") NIL NIL \"quoted-printable\" 800 20)(\"application\" \"octet-stream\" (\"name\" \"report (final) \\\"v2\\\".bin\") NIL NIL \"base64\" 3000) \"mixed\"))\r\n",
+    // extension data with disposition
+    "* 7 FETCH (FLAGS () INTERNALDATE \"17-Jul-2024 02:44:25 +0000\" RFC822.SIZE 5000 ENVELOPE (\"Wed, 17 Jul 2024 02:44:25 +0000\" \"zip\" ((\"Alice\" NIL \"alice\" \"example.com\")) ((\"Alice\" NIL \"alice\" \"example.com\")) ((\"Alice\" NIL \"alice\" \"example.com\")) ((NIL NIL \"bob\" \"example.org\")) NIL NIL NIL \"<z1@example.com>\") BODY ((\"text\" \"plain\" (\"charset\" \"utf-8\") NIL NIL \"7bit\" 10 1 NIL NIL NIL)(\"application\" \"zip\" (\"name\" \"a.zip\") NIL NIL \"base64\" 4000 NIL (\"attachment\" (\"filename\" \"archive.zip\" \"size\" \"2900\")) NIL) \"mixed\" (\"boundary\" \"xyz\") NIL NIL))\r\n",
+};
+
+// mixed(alternative(plain, related(html, n images)), n attachments, message/rfc822(mixed(plain, pdf)))
+inline std::string bodystructure_deep(int n)
+{
+    std::string s = "* 9 FETCH (FLAGS () RFC822.SIZE 9 ENVELOPE (NIL \"deep\" NIL NIL NIL NIL NIL NIL NIL NIL) BODY (((\"text\" \"plain\" (\"charset\" \"utf-8\") NIL NIL \"quoted-printable\" 2000 40)((\"text\" \"html\" (\"charset\" \"utf-8\") NIL NIL \"quoted-printable\" 9000 100)";
+    for (int i = 0; i < n; i++)
+        s += "(\"image\" \"png\" (\"name\" \"img" + std::to_string(i) + ".png\") \"<img" + std::to_string(i) + "@x>\" NIL \"base64\" 12000)";
+    s += " \"related\") \"alternative\")";
+    for (int i = 0; i < n; i++)
+        s += "(\"application\" \"pdf\" (\"name\" \"doc" + std::to_string(i) + ".pdf\") NIL NIL \"base64\" 50000)";
+    s += "(\"message\" \"rfc822\" NIL NIL NIL \"7bit\" 4000 (NIL \"inner\" NIL NIL NIL NIL NIL NIL NIL NIL) ((\"text\" \"plain\" (\"charset\" \"utf-8\") NIL NIL \"7bit\" 100 3)(\"application\" \"pdf\" (\"name\" \"inner.pdf\") NIL NIL \"base64\" 3000) \"mixed\") 80) \"mixed\"))\r\n";
+    return s;
+}
+
+#endif
@@ -0,0 +1,44 @@
+/*
+ * Assertions for the host tests, a failed check is reported and the test goes on.
+ */
+#ifndef HOST_CHECK_H
+#define HOST_CHECK_H
+
+#include <stdio.h>
+
+static int check_failures = 0;
+
+#define CHECK(cond)                                                          \
+    do                                                                       \
+    {                                                                        \
+        if (!(cond))                                                         \
+        {                                                                    \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            check_failures++;                                                \
+        }                                                                    \
+    } while (0)
+
+#define CHECK_EQ(a, b) CHECK((a) == (b))
+
+// Like CHECK, but leaves the (void) test function on failure
+#define REQUIRE(cond)                                                        \
+    do                                                                       \
+    {                                                                        \
+        if (!(cond))                                                         \
+        {                                                                    \
+            fprintf(stderr, "%s:%d: requirement failed: %s\n", __FILE__, __LINE__, #cond); \
+            check_failures++;                                                \
+            return;                                                          \
+        }                                                                    \
+    } while (0)
+
+static inline int check_report(const char *name)
+{
+    if (check_failures)
+        fprintf(stderr, "%s: %d check(s) failed\n", name, check_failures);
+    else
+        fprintf(stderr, "%s: ok\n", name);
+    return check_failures ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,301 @@
+/*
+ * Test certificates: EC P-256 roots and server certificates for "localhost".
+ *
+ * Test Root A signs srvA, Dup Root (two roots with the same DN, D1 and D2) signs srvD
+ * with the D2 key, Other Root signs srvX. Valid from 2026-10-17 to 2027-10-17 for the
+ * servers, the tests set the X.509 time to TEST_CERT_TIME.
+ */
+#ifndef HOST_TEST_CERTS_H
+#define HOST_TEST_CERTS_H
+
+#include <stdint.h>
+
+// 2027-01-01 00:00:00 UTC
+#define TEST_CERT_TIME 1798761600
+
+static const uint8_t test_ca_a_der[] = {
+    0x30, 0x82, 0x01, 0x91, 0x30, 0x82, 0x01, 0x37, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x14, 0x02,
+    0x71, 0x96, 0xf2, 0x8a, 0x8a, 0xa2, 0x54, 0x76, 0x84, 0xe1, 0x95, 0x60, 0x43, 0x31, 0xf8, 0xbc,
+    0xf5, 0x1b, 0xb8, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x30,
+    0x16, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x0b, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x41, 0x30, 0x1e, 0x17, 0x0d, 0x32, 0x36, 0x31, 0x30, 0x31,
+    0x37, 0x30, 0x33, 0x30, 0x37, 0x30, 0x30, 0x5a, 0x17, 0x0d, 0x33, 0x36, 0x31, 0x30, 0x31, 0x34,
+    0x30, 0x33, 0x30, 0x37, 0x30, 0x30, 0x5a, 0x30, 0x16, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55,
+    0x04, 0x03, 0x0c, 0x0b, 0x54, 0x65, 0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x41, 0x30,
+    0x59, 0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x08, 0x2a, 0x86,
+    0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00, 0x04, 0x21, 0x16, 0xa9, 0x4d, 0xcf, 0xde,
+    0xbd, 0x87, 0xd9, 0xd3, 0x25, 0x6b, 0x22, 0xa4, 0xc5, 0xad, 0x62, 0x58, 0x63, 0x78, 0x81, 0x35,
+    0x96, 0x43, 0xd3, 0x68, 0x7c, 0x5e, 0xf8, 0x66, 0x1d, 0x12, 0x64, 0xdc, 0xa6, 0x70, 0xb0, 0xde,
+    0x5d, 0x77, 0x2d, 0xe4, 0xd6, 0x29, 0x93, 0xae, 0xa2, 0xbe, 0x24, 0xf1, 0xae, 0x9a, 0x90, 0x82,
+    0xe7, 0x4c, 0x43, 0xa8, 0x61, 0xe6, 0xea, 0xad, 0x36, 0x91, 0xa3, 0x63, 0x30, 0x61, 0x30, 0x1d,
+    0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0x14, 0x59, 0xaf, 0x24, 0xc1, 0xea, 0x8c,
+    0x8c, 0x8b, 0xae, 0xc5, 0x67, 0x32, 0x48, 0xc1, 0x46, 0xd4, 0xe3, 0xb4, 0x45, 0x30, 0x1f, 0x06,
+    0x03, 0x55, 0x1d, 0x23, 0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0x14, 0x59, 0xaf, 0x24, 0xc1, 0xea,
+    0x8c, 0x8c, 0x8b, 0xae, 0xc5, 0x67, 0x32, 0x48, 0xc1, 0x46, 0xd4, 0xe3, 0xb4, 0x45, 0x30, 0x0f,
+    0x06, 0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01, 0x01, 0xff, 0x30,
+    0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30,
+    0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x03, 0x48, 0x00, 0x30, 0x45,
+    0x02, 0x21, 0x00, 0xf3, 0x26, 0xe1, 0xb2, 0x86, 0x1d, 0xe9, 0xd5, 0x7f, 0x24, 0x2d, 0x83, 0xbb,
+    0xe1, 0x9a, 0x1f, 0xc3, 0xef, 0x55, 0xee, 0x86, 0xdc, 0xdb, 0xf5, 0xb6, 0x15, 0x13, 0x1a, 0x0e,
+    0xfd, 0xfe, 0xaa, 0x02, 0x20, 0x2c, 0x5f, 0x2d, 0xee, 0xbe, 0x48, 0x8a, 0x7c, 0x29, 0x5f, 0xad,
+    0x3f, 0x97, 0x16, 0x93, 0x72, 0x33, 0xa6, 0xcf, 0xee, 0xcd, 0x66, 0xcb, 0xb5, 0x7d, 0xf8, 0x9f,
+    0x3d, 0xca, 0xa2, 0xf2, 0x7d,
+};
+
+static const char test_ca_a_pem[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIBkTCCATegAwIBAgIUAnGW8oqKolR2hOGVYEMx+Lz1G7gwCgYIKoZIzj0EAwIw\n"
+    "FjEUMBIGA1UEAwwLVGVzdCBSb290IEEwHhcNMjYxMDE3MDMwNzAwWhcNMzYxMDE0\n"
+    "MDMwNzAwWjAWMRQwEgYDVQQDDAtUZXN0IFJvb3QgQTBZMBMGByqGSM49AgEGCCqG\n"
+    "SM49AwEHA0IABCEWqU3P3r2H2dMlayKkxa1iWGN4gTWWQ9NofF74Zh0SZNymcLDe\n"
+    "XXct5NYpk66iviTxrpqQgudMQ6hh5uqtNpGjYzBhMB0GA1UdDgQWBBQUWa8kweqM\n"
+    "jIuuxWcySMFG1OO0RTAfBgNVHSMEGDAWgBQUWa8kweqMjIuuxWcySMFG1OO0RTAP\n"
+    "BgNVHRMBAf8EBTADAQH/MA4GA1UdDwEB/wQEAwIBBjAKBggqhkjOPQQDAgNIADBF\n"
+    "AiEA8ybhsoYd6dV/JC2Du+GaH8PvVe6G3Nv1thUTGg79/qoCICxfLe6+SIp8KV+t\n"
+    "P5cWk3Izps/uzWbLtX34nz3KovJ9\n"
+    "-----END CERTIFICATE-----\n";
+
+static const uint8_t test_ca_d1_der[] = {
+    0x30, 0x82, 0x01, 0x8b, 0x30, 0x82, 0x01, 0x31, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x14, 0x07,
+    0x42, 0x58, 0xf1, 0x35, 0x77, 0x43, 0xe0, 0xb5, 0xd5, 0xa0, 0x91, 0xfe, 0xa3, 0xd9, 0x8a, 0xfa,
+    0x8f, 0xef, 0xa8, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x30,
+    0x13, 0x31, 0x11, 0x30, 0x0f, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x08, 0x44, 0x75, 0x70, 0x20,
+    0x52, 0x6f, 0x6f, 0x74, 0x30, 0x1e, 0x17, 0x0d, 0x32, 0x36, 0x31, 0x30, 0x31, 0x37, 0x30, 0x33,
+    0x30, 0x37, 0x30, 0x30, 0x5a, 0x17, 0x0d, 0x33, 0x36, 0x31, 0x30, 0x31, 0x34, 0x30, 0x33, 0x30,
+    0x37, 0x30, 0x30, 0x5a, 0x30, 0x13, 0x31, 0x11, 0x30, 0x0f, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x08, 0x44, 0x75, 0x70, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x30, 0x59, 0x30, 0x13, 0x06, 0x07, 0x2a,
+    0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07,
+    0x03, 0x42, 0x00, 0x04, 0xd3, 0x4a, 0x85, 0xdb, 0xf7, 0x2a, 0xb1, 0xf3, 0xbd, 0x8f, 0x8e, 0x17,
+    0x0a, 0xe1, 0x38, 0x3d, 0x54, 0x3a, 0x3f, 0xfc, 0x93, 0xb3, 0x87, 0xf2, 0x98, 0x20, 0x2b, 0x48,
+    0x0e, 0xf6, 0x7f, 0x33, 0x64, 0x1f, 0x18, 0x89, 0x43, 0xb9, 0x23, 0x9f, 0x4d, 0x83, 0xa2, 0x06,
+    0xcf, 0x8e, 0x29, 0x88, 0xc7, 0xb3, 0xfd, 0x61, 0x32, 0x8a, 0xcd, 0x8b, 0x45, 0xcb, 0x48, 0xf1,
+    0x35, 0x3d, 0xda, 0xcb, 0xa3, 0x63, 0x30, 0x61, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04,
+    0x16, 0x04, 0x14, 0x6d, 0xba, 0x10, 0xa4, 0xf0, 0xb4, 0x25, 0x29, 0x0c, 0x78, 0x3e, 0x93, 0x5b,
+    0xb6, 0xca, 0xe2, 0xf8, 0x5a, 0x17, 0x44, 0x30, 0x1f, 0x06, 0x03, 0x55, 0x1d, 0x23, 0x04, 0x18,
+    0x30, 0x16, 0x80, 0x14, 0x6d, 0xba, 0x10, 0xa4, 0xf0, 0xb4, 0x25, 0x29, 0x0c, 0x78, 0x3e, 0x93,
+    0x5b, 0xb6, 0xca, 0xe2, 0xf8, 0x5a, 0x17, 0x44, 0x30, 0x0f, 0x06, 0x03, 0x55, 0x1d, 0x13, 0x01,
+    0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01, 0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f,
+    0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48,
+    0xce, 0x3d, 0x04, 0x03, 0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x20, 0x46, 0x12, 0x52, 0x82,
+    0x45, 0xd4, 0xe2, 0x17, 0xed, 0xa5, 0x5d, 0xf5, 0x80, 0x20, 0xef, 0x74, 0xe9, 0x20, 0xcf, 0x65,
+    0x61, 0xb7, 0x04, 0xb5, 0xd4, 0x77, 0x9d, 0x82, 0xee, 0x86, 0x92, 0xcf, 0x02, 0x21, 0x00, 0xda,
+    0x30, 0x2f, 0x03, 0xc2, 0x69, 0x02, 0xe5, 0x4f, 0x34, 0x41, 0x0b, 0x65, 0xa9, 0xb0, 0xee, 0x46,
+    0xc7, 0xc2, 0xe7, 0x1a, 0xb7, 0x35, 0xe7, 0x70, 0x90, 0xed, 0xba, 0x25, 0x14, 0xa2, 0x5d,
+};
+
+static const char test_ca_d1_pem[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIBizCCATGgAwIBAgIUB0JY8TV3Q+C11aCR/qPZivqP76gwCgYIKoZIzj0EAwIw\n"
+    "EzERMA8GA1UEAwwIRHVwIFJvb3QwHhcNMjYxMDE3MDMwNzAwWhcNMzYxMDE0MDMw\n"
+    "NzAwWjATMREwDwYDVQQDDAhEdXAgUm9vdDBZMBMGByqGSM49AgEGCCqGSM49AwEH\n"
+    "A0IABNNKhdv3KrHzvY+OFwrhOD1UOj/8k7OH8pggK0gO9n8zZB8YiUO5I59Ng6IG\n"
+    "z44piMez/WEyis2LRctI8TU92sujYzBhMB0GA1UdDgQWBBRtuhCk8LQlKQx4PpNb\n"
+    "tsri+FoXRDAfBgNVHSMEGDAWgBRtuhCk8LQlKQx4PpNbtsri+FoXRDAPBgNVHRMB\n"
+    "Af8EBTADAQH/MA4GA1UdDwEB/wQEAwIBBjAKBggqhkjOPQQDAgNIADBFAiBGElKC\n"
+    "RdTiF+2lXfWAIO906SDPZWG3BLXUd52C7oaSzwIhANowLwPCaQLlTzRBC2WpsO5G\n"
+    "x8LnGrc153CQ7bolFKJd\n"
+    "-----END CERTIFICATE-----\n";
+
+static const uint8_t test_ca_d2_der[] = {
+    0x30, 0x82, 0x01, 0x8c, 0x30, 0x82, 0x01, 0x31, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x14, 0x61,
+    0xaa, 0xde, 0xf9, 0xdd, 0x2e, 0x1d, 0x5c, 0x82, 0x91, 0x26, 0x82, 0x26, 0x01, 0x7f, 0x4d, 0xd3,
+    0x44, 0x55, 0x9d, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x30,
+    0x13, 0x31, 0x11, 0x30, 0x0f, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x08, 0x44, 0x75, 0x70, 0x20,
+    0x52, 0x6f, 0x6f, 0x74, 0x30, 0x1e, 0x17, 0x0d, 0x32, 0x36, 0x31, 0x30, 0x31, 0x37, 0x30, 0x33,
+    0x30, 0x37, 0x30, 0x30, 0x5a, 0x17, 0x0d, 0x33, 0x36, 0x31, 0x30, 0x31, 0x34, 0x30, 0x33, 0x30,
+    0x37, 0x30, 0x30, 0x5a, 0x30, 0x13, 0x31, 0x11, 0x30, 0x0f, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x08, 0x44, 0x75, 0x70, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x30, 0x59, 0x30, 0x13, 0x06, 0x07, 0x2a,
+    0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07,
+    0x03, 0x42, 0x00, 0x04, 0x17, 0xf5, 0xec, 0xe2, 0x4e, 0xdc, 0xbe, 0xbc, 0x27, 0xe1, 0x4c, 0x7c,
+    0xc9, 0x4f, 0xed, 0x65, 0x5c, 0x49, 0xea, 0x12, 0xd1, 0xd5, 0xc5, 0x10, 0x42, 0xd7, 0x04, 0x1b,
+    0x67, 0x66, 0x64, 0xf4, 0x48, 0x85, 0xe9, 0x82, 0xd4, 0x14, 0xe0, 0x1e, 0x87, 0x25, 0x9f, 0xda,
+    0xc1, 0x13, 0x2f, 0x11, 0xdc, 0x2b, 0xf6, 0x27, 0x3f, 0xec, 0x2f, 0xf8, 0xf6, 0xc7, 0x41, 0x34,
+    0x31, 0xea, 0x0f, 0x39, 0xa3, 0x63, 0x30, 0x61, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04,
+    0x16, 0x04, 0x14, 0xc5, 0x72, 0xa0, 0x80, 0xd8, 0x02, 0xc7, 0x53, 0x97, 0x7a, 0xe3, 0xb8, 0xc6,
+    0xcf, 0x68, 0xf0, 0xb1, 0x4c, 0x1c, 0x6e, 0x30, 0x1f, 0x06, 0x03, 0x55, 0x1d, 0x23, 0x04, 0x18,
+    0x30, 0x16, 0x80, 0x14, 0xc5, 0x72, 0xa0, 0x80, 0xd8, 0x02, 0xc7, 0x53, 0x97, 0x7a, 0xe3, 0xb8,
+    0xc6, 0xcf, 0x68, 0xf0, 0xb1, 0x4c, 0x1c, 0x6e, 0x30, 0x0f, 0x06, 0x03, 0x55, 0x1d, 0x13, 0x01,
+    0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01, 0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f,
+    0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48,
+    0xce, 0x3d, 0x04, 0x03, 0x02, 0x03, 0x49, 0x00, 0x30, 0x46, 0x02, 0x21, 0x00, 0xed, 0xdf, 0x71,
+    0xfd, 0x60, 0xce, 0x37, 0xa2, 0x88, 0x3d, 0x5b, 0x2a, 0x52, 0x48, 0xca, 0x04, 0x4c, 0x0c, 0x12,
+    0xc7, 0xbf, 0x73, 0xea, 0x31, 0xff, 0x3c, 0x0d, 0xcb, 0xe3, 0x88, 0x89, 0x3a, 0x02, 0x21, 0x00,
+    0xb0, 0xac, 0xf4, 0x46, 0x15, 0xc4, 0x66, 0xac, 0x8e, 0x56, 0x38, 0xd2, 0x8c, 0xb1, 0xa3, 0x27,
+    0x45, 0x70, 0xd7, 0x0c, 0x61, 0x26, 0x62, 0x0b, 0x04, 0x58, 0xe1, 0x50, 0xec, 0x6b, 0xc5, 0xac,
+};
+
+static const char test_ca_d2_pem[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIBjDCCATGgAwIBAgIUYare+d0uHVyCkSaCJgF/TdNEVZ0wCgYIKoZIzj0EAwIw\n"
+    "EzERMA8GA1UEAwwIRHVwIFJvb3QwHhcNMjYxMDE3MDMwNzAwWhcNMzYxMDE0MDMw\n"
+    "NzAwWjATMREwDwYDVQQDDAhEdXAgUm9vdDBZMBMGByqGSM49AgEGCCqGSM49AwEH\n"
+    "A0IABBf17OJO3L68J+FMfMlP7WVcSeoS0dXFEELXBBtnZmT0SIXpgtQU4B6HJZ/a\n"
+    "wRMvEdwr9ic/7C/49sdBNDHqDzmjYzBhMB0GA1UdDgQWBBTFcqCA2ALHU5d647jG\n"
+    "z2jwsUwcbjAfBgNVHSMEGDAWgBTFcqCA2ALHU5d647jGz2jwsUwcbjAPBgNVHRMB\n"
+    "Af8EBTADAQH/MA4GA1UdDwEB/wQEAwIBBjAKBggqhkjOPQQDAgNJADBGAiEA7d9x\n"
+    "/WDON6KIPVsqUkjKBEwMEse/c+ox/zwNy+OIiToCIQCwrPRGFcRmrI5WONKMsaMn\n"
+    "RXDXDGEmYgsEWOFQ7GvFrA==\n"
+    "-----END CERTIFICATE-----\n";
+
+static const uint8_t test_ca_x_der[] = {
+    0x30, 0x82, 0x01, 0x8f, 0x30, 0x82, 0x01, 0x35, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x14, 0x3c,
+    0x72, 0x50, 0x82, 0xf7, 0x24, 0xf8, 0xc8, 0xf4, 0x03, 0xb5, 0x53, 0x74, 0x79, 0x8c, 0xfc, 0x74,
+    0x93, 0x61, 0xa8, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x30,
+    0x15, 0x31, 0x13, 0x30, 0x11, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x0a, 0x4f, 0x74, 0x68, 0x65,
+    0x72, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x30, 0x1e, 0x17, 0x0d, 0x32, 0x36, 0x31, 0x30, 0x31, 0x37,
+    0x30, 0x33, 0x30, 0x37, 0x30, 0x30, 0x5a, 0x17, 0x0d, 0x33, 0x36, 0x31, 0x30, 0x31, 0x34, 0x30,
+    0x33, 0x30, 0x37, 0x30, 0x30, 0x5a, 0x30, 0x15, 0x31, 0x13, 0x30, 0x11, 0x06, 0x03, 0x55, 0x04,
+    0x03, 0x0c, 0x0a, 0x4f, 0x74, 0x68, 0x65, 0x72, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x30, 0x59, 0x30,
+    0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00, 0x04, 0x8a, 0x2c, 0xdb, 0x8d, 0xcb, 0x4b, 0x8b, 0xbf,
+    0x70, 0x4e, 0x2b, 0xa3, 0x20, 0x13, 0x00, 0x45, 0x0c, 0x6c, 0x4d, 0xf9, 0xc5, 0x86, 0x77, 0x2b,
+    0x15, 0x77, 0xf5, 0x64, 0x93, 0xec, 0x12, 0x69, 0xc1, 0x5b, 0x9c, 0xbb, 0x06, 0xcd, 0x59, 0xf9,
+    0x4e, 0xd4, 0xc3, 0x87, 0x7c, 0x69, 0x29, 0x9e, 0x35, 0x03, 0x14, 0x7a, 0xe9, 0xf1, 0x05, 0x19,
+    0xd3, 0xc7, 0xb5, 0x74, 0x91, 0xb4, 0x54, 0x23, 0xa3, 0x63, 0x30, 0x61, 0x30, 0x1d, 0x06, 0x03,
+    0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0x95, 0x4c, 0x77, 0xd3, 0x08, 0x8c, 0x08, 0x82, 0x55,
+    0xde, 0xc2, 0xdb, 0x51, 0xdb, 0xa4, 0x6d, 0x45, 0x1e, 0x23, 0x4b, 0x30, 0x1f, 0x06, 0x03, 0x55,
+    0x1d, 0x23, 0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0x95, 0x4c, 0x77, 0xd3, 0x08, 0x8c, 0x08, 0x82,
+    0x55, 0xde, 0xc2, 0xdb, 0x51, 0xdb, 0xa4, 0x6d, 0x45, 0x1e, 0x23, 0x4b, 0x30, 0x0f, 0x06, 0x03,
+    0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01, 0x01, 0xff, 0x30, 0x0e, 0x06,
+    0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x0a, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x21,
+    0x00, 0x90, 0x8d, 0x14, 0xcc, 0x47, 0x9c, 0x63, 0x19, 0x96, 0x90, 0x8e, 0xcf, 0xd9, 0xe3, 0x8a,
+    0x5a, 0x45, 0x81, 0xec, 0xd7, 0xfb, 0x1b, 0x30, 0xfe, 0xa7, 0x64, 0xbf, 0x2f, 0xb6, 0x7f, 0xd3,
+    0x6a, 0x02, 0x20, 0x66, 0xd5, 0xb1, 0x4e, 0x5d, 0x7e, 0xc0, 0xb6, 0x2d, 0x1e, 0x89, 0x24, 0x90,
+    0x35, 0x0e, 0x67, 0x3f, 0xee, 0x4d, 0x2b, 0xf1, 0x71, 0x05, 0x56, 0x32, 0x55, 0x81, 0xce, 0x8e,
+    0x31, 0x7b, 0xbc,
+};
+
+static const char test_ca_x_pem[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIBjzCCATWgAwIBAgIUPHJQgvck+Mj0A7VTdHmM/HSTYagwCgYIKoZIzj0EAwIw\n"
+    "FTETMBEGA1UEAwwKT3RoZXIgUm9vdDAeFw0yNjEwMTcwMzA3MDBaFw0zNjEwMTQw\n"
+    "MzA3MDBaMBUxEzARBgNVBAMMCk90aGVyIFJvb3QwWTATBgcqhkjOPQIBBggqhkjO\n"
+    "PQMBBwNCAASKLNuNy0uLv3BOK6MgEwBFDGxN+cWGdysVd/Vkk+wSacFbnLsGzVn5\n"
+    "TtTDh3xpKZ41AxR66fEFGdPHtXSRtFQjo2MwYTAdBgNVHQ4EFgQUlUx30wiMCIJV\n"
+    "3sLbUdukbUUeI0swHwYDVR0jBBgwFoAUlUx30wiMCIJV3sLbUdukbUUeI0swDwYD\n"
+    "VR0TAQH/BAUwAwEB/zAOBgNVHQ8BAf8EBAMCAQYwCgYIKoZIzj0EAwIDSAAwRQIh\n"
+    "AJCNFMxHnGMZlpCOz9njilpFgezX+xsw/qdkvy+2f9NqAiBm1bFOXX7Ati0eiSSQ\n"
+    "NQ5nP+5NK/FxBVYyVYHOjjF7vA==\n"
+    "-----END CERTIFICATE-----\n";
+
+static const uint8_t test_srva_der[] = {
+    0x30, 0x82, 0x01, 0x90, 0x30, 0x82, 0x01, 0x35, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x14, 0x35,
+    0xe3, 0x12, 0x98, 0x57, 0xa2, 0x5f, 0x51, 0x67, 0x90, 0x00, 0x49, 0x73, 0x91, 0xf6, 0x03, 0xf5,
+    0xaa, 0xc0, 0x9d, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x30,
+    0x16, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x0b, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x41, 0x30, 0x1e, 0x17, 0x0d, 0x32, 0x36, 0x31, 0x30, 0x31,
+    0x37, 0x30, 0x33, 0x30, 0x37, 0x30, 0x30, 0x5a, 0x17, 0x0d, 0x32, 0x37, 0x31, 0x30, 0x31, 0x37,
+    0x30, 0x33, 0x30, 0x37, 0x30, 0x30, 0x5a, 0x30, 0x14, 0x31, 0x12, 0x30, 0x10, 0x06, 0x03, 0x55,
+    0x04, 0x03, 0x0c, 0x09, 0x6c, 0x6f, 0x63, 0x61, 0x6c, 0x68, 0x6f, 0x73, 0x74, 0x30, 0x59, 0x30,
+    0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00, 0x04, 0x62, 0x96, 0x17, 0xe8, 0xf1, 0x22, 0x0b, 0xee,
+    0x51, 0x2e, 0x5e, 0xe2, 0xc6, 0x2a, 0x2c, 0x44, 0x0a, 0x53, 0xee, 0x52, 0xed, 0xc6, 0x64, 0xa2,
+    0xed, 0x6e, 0x18, 0xc9, 0xf1, 0xa3, 0x4b, 0x09, 0x0b, 0x0b, 0xc2, 0xef, 0x11, 0xad, 0x7c, 0x59,
+    0xe2, 0x7a, 0xf0, 0x19, 0x43, 0x80, 0xf1, 0xbd, 0x67, 0xe9, 0x82, 0x80, 0x99, 0xec, 0x57, 0xfd,
+    0xb6, 0x55, 0xcc, 0x15, 0x97, 0x2f, 0x54, 0xdb, 0xa3, 0x63, 0x30, 0x61, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x1d, 0x13, 0x04, 0x02, 0x30, 0x00, 0x30, 0x14, 0x06, 0x03, 0x55, 0x1d, 0x11, 0x04, 0x0d,
+    0x30, 0x0b, 0x82, 0x09, 0x6c, 0x6f, 0x63, 0x61, 0x6c, 0x68, 0x6f, 0x73, 0x74, 0x30, 0x1d, 0x06,
+    0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0xd1, 0xb6, 0x25, 0x5a, 0x13, 0xb6, 0x48, 0xf5,
+    0x37, 0x34, 0xd8, 0xff, 0x06, 0x0e, 0xb2, 0xf6, 0x1b, 0xd6, 0xc3, 0x40, 0x30, 0x1f, 0x06, 0x03,
+    0x55, 0x1d, 0x23, 0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0x14, 0x59, 0xaf, 0x24, 0xc1, 0xea, 0x8c,
+    0x8c, 0x8b, 0xae, 0xc5, 0x67, 0x32, 0x48, 0xc1, 0x46, 0xd4, 0xe3, 0xb4, 0x45, 0x30, 0x0a, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x03, 0x49, 0x00, 0x30, 0x46, 0x02, 0x21,
+    0x00, 0xc2, 0xf8, 0x37, 0xdd, 0xa0, 0x30, 0xe7, 0x00, 0x0c, 0x48, 0x84, 0x70, 0x8e, 0x82, 0x6e,
+    0x0f, 0x01, 0x18, 0xb7, 0x47, 0xbb, 0x2d, 0xfe, 0x49, 0xd8, 0xdd, 0x33, 0x71, 0x6a, 0x00, 0x89,
+    0xc6, 0x02, 0x21, 0x00, 0xe5, 0x91, 0xad, 0x95, 0x73, 0x45, 0xac, 0x0e, 0x4a, 0x75, 0x0e, 0x02,
+    0x8e, 0x78, 0x1a, 0x2b, 0x39, 0x30, 0x75, 0xea, 0x0c, 0x89, 0x26, 0xa5, 0x1e, 0xc8, 0x19, 0x4a,
+    0xfa, 0xd9, 0x2a, 0x55,
+};
+
+static const uint8_t test_srva_key[] = {
+    0x30, 0x77, 0x02, 0x01, 0x01, 0x04, 0x20, 0x36, 0x8b, 0xb4, 0xcc, 0x41, 0x96, 0x68, 0x34, 0x8f,
+    0x32, 0xe9, 0x66, 0xf9, 0x0e, 0xe2, 0x5a, 0xfc, 0x50, 0x7a, 0xd8, 0xc3, 0x3a, 0x40, 0x13, 0xed,
+    0x48, 0x78, 0x3f, 0x1a, 0x74, 0x19, 0x05, 0xa0, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d,
+    0x03, 0x01, 0x07, 0xa1, 0x44, 0x03, 0x42, 0x00, 0x04, 0x62, 0x96, 0x17, 0xe8, 0xf1, 0x22, 0x0b,
+    0xee, 0x51, 0x2e, 0x5e, 0xe2, 0xc6, 0x2a, 0x2c, 0x44, 0x0a, 0x53, 0xee, 0x52, 0xed, 0xc6, 0x64,
+    0xa2, 0xed, 0x6e, 0x18, 0xc9, 0xf1, 0xa3, 0x4b, 0x09, 0x0b, 0x0b, 0xc2, 0xef, 0x11, 0xad, 0x7c,
+    0x59, 0xe2, 0x7a, 0xf0, 0x19, 0x43, 0x80, 0xf1, 0xbd, 0x67, 0xe9, 0x82, 0x80, 0x99, 0xec, 0x57,
+    0xfd, 0xb6, 0x55, 0xcc, 0x15, 0x97, 0x2f, 0x54, 0xdb,
+};
+
+static const uint8_t test_srvd_der[] = {
+    0x30, 0x82, 0x01, 0x8c, 0x30, 0x82, 0x01, 0x32, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x14, 0x1b,
+    0xd2, 0xe8, 0xe8, 0x02, 0x04, 0x44, 0x43, 0x09, 0x3f, 0x66, 0xe0, 0x20, 0x29, 0xfb, 0xea, 0xdc,
+    0xa0, 0x83, 0x76, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x30,
+    0x13, 0x31, 0x11, 0x30, 0x0f, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x08, 0x44, 0x75, 0x70, 0x20,
+    0x52, 0x6f, 0x6f, 0x74, 0x30, 0x1e, 0x17, 0x0d, 0x32, 0x36, 0x31, 0x30, 0x31, 0x37, 0x30, 0x33,
+    0x30, 0x37, 0x30, 0x31, 0x5a, 0x17, 0x0d, 0x32, 0x37, 0x31, 0x30, 0x31, 0x37, 0x30, 0x33, 0x30,
+    0x37, 0x30, 0x31, 0x5a, 0x30, 0x14, 0x31, 0x12, 0x30, 0x10, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x09, 0x6c, 0x6f, 0x63, 0x61, 0x6c, 0x68, 0x6f, 0x73, 0x74, 0x30, 0x59, 0x30, 0x13, 0x06, 0x07,
+    0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01,
+    0x07, 0x03, 0x42, 0x00, 0x04, 0x19, 0x1b, 0x8d, 0x27, 0x1d, 0xf5, 0x6e, 0x8c, 0x97, 0x5e, 0x96,
+    0xfb, 0x9a, 0xbc, 0xd8, 0x37, 0x0b, 0x80, 0xf6, 0xed, 0xe3, 0x17, 0x54, 0x1b, 0x0b, 0xd8, 0x6a,
+    0x93, 0x1d, 0xa7, 0x05, 0xf3, 0x08, 0x6b, 0xad, 0x34, 0xd6, 0x87, 0xca, 0xe8, 0xa8, 0x90, 0xa7,
+    0x8d, 0x8a, 0x20, 0x59, 0x7a, 0x9e, 0x43, 0x44, 0xce, 0xdc, 0xf6, 0x2d, 0x36, 0x9f, 0xac, 0xda,
+    0x73, 0x82, 0x96, 0x16, 0xc8, 0xa3, 0x63, 0x30, 0x61, 0x30, 0x09, 0x06, 0x03, 0x55, 0x1d, 0x13,
+    0x04, 0x02, 0x30, 0x00, 0x30, 0x14, 0x06, 0x03, 0x55, 0x1d, 0x11, 0x04, 0x0d, 0x30, 0x0b, 0x82,
+    0x09, 0x6c, 0x6f, 0x63, 0x61, 0x6c, 0x68, 0x6f, 0x73, 0x74, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0x3f, 0x64, 0xed, 0x66, 0x11, 0xba, 0x26, 0xd3, 0xa6, 0x13, 0xb0,
+    0x5e, 0x56, 0x24, 0xe4, 0xd6, 0x09, 0x6e, 0x60, 0x4d, 0x30, 0x1f, 0x06, 0x03, 0x55, 0x1d, 0x23,
+    0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0xc5, 0x72, 0xa0, 0x80, 0xd8, 0x02, 0xc7, 0x53, 0x97, 0x7a,
+    0xe3, 0xb8, 0xc6, 0xcf, 0x68, 0xf0, 0xb1, 0x4c, 0x1c, 0x6e, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86,
+    0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x21, 0x00, 0xfb, 0xf4,
+    0x9a, 0x45, 0x7f, 0x8b, 0x06, 0xf4, 0xc6, 0x1f, 0xcc, 0x40, 0x1c, 0x46, 0xc7, 0x4d, 0x41, 0xbb,
+    0xdb, 0xf5, 0xda, 0x9f, 0x52, 0x51, 0x7c, 0xfd, 0x54, 0x9a, 0x48, 0x4e, 0xf4, 0x1c, 0x02, 0x20,
+    0x5d, 0x4c, 0x01, 0x58, 0x67, 0x1b, 0x9a, 0x11, 0x5d, 0x11, 0x9a, 0x81, 0xbf, 0xc6, 0x16, 0x3e,
+    0x8a, 0x14, 0xa7, 0x05, 0x1d, 0xfc, 0x93, 0xff, 0xd4, 0x98, 0x8f, 0x2e, 0xcd, 0x61, 0xc7, 0x5b,
+};
+
+static const uint8_t test_srvd_key[] = {
+    0x30, 0x77, 0x02, 0x01, 0x01, 0x04, 0x20, 0x68, 0xa5, 0x06, 0xaa, 0x14, 0xb9, 0x9b, 0x93, 0x3b,
+    0x6e, 0x1b, 0x3e, 0x20, 0xee, 0xf1, 0x93, 0x97, 0xa8, 0xf8, 0xcf, 0xcd, 0xb1, 0xb8, 0x4c, 0xc8,
+    0xf0, 0x7c, 0x0f, 0x6b, 0x1d, 0x45, 0x35, 0xa0, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d,
+    0x03, 0x01, 0x07, 0xa1, 0x44, 0x03, 0x42, 0x00, 0x04, 0x19, 0x1b, 0x8d, 0x27, 0x1d, 0xf5, 0x6e,
+    0x8c, 0x97, 0x5e, 0x96, 0xfb, 0x9a, 0xbc, 0xd8, 0x37, 0x0b, 0x80, 0xf6, 0xed, 0xe3, 0x17, 0x54,
+    0x1b, 0x0b, 0xd8, 0x6a, 0x93, 0x1d, 0xa7, 0x05, 0xf3, 0x08, 0x6b, 0xad, 0x34, 0xd6, 0x87, 0xca,
+    0xe8, 0xa8, 0x90, 0xa7, 0x8d, 0x8a, 0x20, 0x59, 0x7a, 0x9e, 0x43, 0x44, 0xce, 0xdc, 0xf6, 0x2d,
+    0x36, 0x9f, 0xac, 0xda, 0x73, 0x82, 0x96, 0x16, 0xc8,
+};
+
+static const uint8_t test_srvx_der[] = {
+    0x30, 0x82, 0x01, 0x8d, 0x30, 0x82, 0x01, 0x34, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x14, 0x71,
+    0xc8, 0x1c, 0x00, 0x34, 0x1b, 0x53, 0x61, 0x73, 0xa8, 0x1c, 0x38, 0x36, 0x54, 0x37, 0x90, 0xeb,
+    0x0d, 0xb1, 0x53, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x30,
+    0x15, 0x31, 0x13, 0x30, 0x11, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x0a, 0x4f, 0x74, 0x68, 0x65,
+    0x72, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x30, 0x1e, 0x17, 0x0d, 0x32, 0x36, 0x31, 0x30, 0x31, 0x37,
+    0x30, 0x33, 0x30, 0x37, 0x30, 0x31, 0x5a, 0x17, 0x0d, 0x32, 0x37, 0x31, 0x30, 0x31, 0x37, 0x30,
+    0x33, 0x30, 0x37, 0x30, 0x31, 0x5a, 0x30, 0x14, 0x31, 0x12, 0x30, 0x10, 0x06, 0x03, 0x55, 0x04,
+    0x03, 0x0c, 0x09, 0x6c, 0x6f, 0x63, 0x61, 0x6c, 0x68, 0x6f, 0x73, 0x74, 0x30, 0x59, 0x30, 0x13,
+    0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d,
+    0x03, 0x01, 0x07, 0x03, 0x42, 0x00, 0x04, 0xd6, 0xc0, 0x5a, 0x55, 0xb3, 0x74, 0x9c, 0xcf, 0xf1,
+    0x9b, 0x8b, 0x7c, 0x6e, 0x48, 0xe4, 0x97, 0xdb, 0xc5, 0x97, 0xd4, 0xd4, 0x21, 0x45, 0x56, 0x81,
+    0x58, 0x61, 0xae, 0xc6, 0x80, 0x68, 0x8f, 0x8d, 0x33, 0x63, 0xd1, 0xc7, 0x4e, 0x5e, 0x5b, 0xae,
+    0xed, 0xf8, 0x51, 0x7c, 0x7d, 0x4c, 0x4d, 0xc6, 0x75, 0x54, 0x49, 0xeb, 0x7c, 0x67, 0x79, 0x78,
+    0x84, 0x0d, 0x10, 0xb8, 0xf9, 0x5b, 0xcc, 0xa3, 0x63, 0x30, 0x61, 0x30, 0x09, 0x06, 0x03, 0x55,
+    0x1d, 0x13, 0x04, 0x02, 0x30, 0x00, 0x30, 0x14, 0x06, 0x03, 0x55, 0x1d, 0x11, 0x04, 0x0d, 0x30,
+    0x0b, 0x82, 0x09, 0x6c, 0x6f, 0x63, 0x61, 0x6c, 0x68, 0x6f, 0x73, 0x74, 0x30, 0x1d, 0x06, 0x03,
+    0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0xa7, 0xd8, 0xcd, 0x5e, 0x4f, 0x64, 0x0a, 0x93, 0xd8,
+    0x6b, 0x93, 0x04, 0xa4, 0xa4, 0x57, 0x21, 0x4d, 0x69, 0x6e, 0x58, 0x30, 0x1f, 0x06, 0x03, 0x55,
+    0x1d, 0x23, 0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0x95, 0x4c, 0x77, 0xd3, 0x08, 0x8c, 0x08, 0x82,
+    0x55, 0xde, 0xc2, 0xdb, 0x51, 0xdb, 0xa4, 0x6d, 0x45, 0x1e, 0x23, 0x4b, 0x30, 0x0a, 0x06, 0x08,
+    0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x03, 0x47, 0x00, 0x30, 0x44, 0x02, 0x20, 0x28,
+    0x32, 0x2b, 0x67, 0xd9, 0xdf, 0x34, 0x7e, 0xf5, 0xa6, 0xec, 0x25, 0x62, 0x68, 0xd7, 0x98, 0x7d,
+    0x14, 0xc6, 0xea, 0x0e, 0x89, 0xf3, 0xe2, 0x14, 0x87, 0xfd, 0x56, 0x98, 0x0c, 0x15, 0x40, 0x02,
+    0x20, 0x55, 0x02, 0xdc, 0xf8, 0xb3, 0xed, 0xdf, 0x59, 0xb9, 0xa4, 0xbd, 0x09, 0x4f, 0x4b, 0x33,
+    0x39, 0xe4, 0x1b, 0x48, 0x9b, 0xa4, 0x89, 0xa3, 0xb6, 0x35, 0x28, 0x8a, 0x3f, 0xa8, 0x4c, 0xb5,
+    0x74,
+};
+
+static const uint8_t test_srvx_key[] = {
+    0x30, 0x77, 0x02, 0x01, 0x01, 0x04, 0x20, 0xab, 0x77, 0x4f, 0x35, 0x31, 0xe8, 0xce, 0x1e, 0x8f,
+    0x30, 0x7b, 0xc5, 0x72, 0xab, 0x08, 0xfd, 0x3e, 0xe3, 0x1e, 0x8b, 0x21, 0xe9, 0x8e, 0x00, 0x66,
+    0xe6, 0x38, 0x4c, 0x08, 0x54, 0x16, 0x62, 0xa0, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d,
+    0x03, 0x01, 0x07, 0xa1, 0x44, 0x03, 0x42, 0x00, 0x04, 0xd6, 0xc0, 0x5a, 0x55, 0xb3, 0x74, 0x9c,
+    0xcf, 0xf1, 0x9b, 0x8b, 0x7c, 0x6e, 0x48, 0xe4, 0x97, 0xdb, 0xc5, 0x97, 0xd4, 0xd4, 0x21, 0x45,
+    0x56, 0x81, 0x58, 0x61, 0xae, 0xc6, 0x80, 0x68, 0x8f, 0x8d, 0x33, 0x63, 0xd1, 0xc7, 0x4e, 0x5e,
+    0x5b, 0xae, 0xed, 0xf8, 0x51, 0x7c, 0x7d, 0x4c, 0x4d, 0xc6, 0x75, 0x54, 0x49, 0xeb, 0x7c, 0x67,
+    0x79, 0x78, 0x84, 0x0d, 0x10, 0xb8, 0xf9, 0x5b, 0xcc,
+};
+
+#endif
@@ -0,0 +1,233 @@
+/*
+ * The adaptive TLS buffer sizes against the loopback TLS server: the sizes in use, the
+ * receive buffer growth when the server ignores the max fragment length, and the pipelined
+ * requests and SMTPS PIPELINING where the replies arrive while the client is still writing,
+ * and the flush delay of the write coalescing.
+ */
+#include <ESP_Mail_Client.h>
+#include <string>
+#include "support/SMTPServer.h"
+#include "support/TLSServer.h"
+#include "support/check.h"
+#include "support/test_certs.h"
+
+static const int IN_OVERHEAD = BSSL_SSL_CLIENT_MAX_IN_OVERHEAD;
+static const int OUT_OVERHEAD = BSSL_SSL_CLIENT_MAX_OUT_OVERHEAD;
+
+static std::string pattern(size_t len)
+{
+    std::string s(len, 0);
+    uint32_t x = 2463534242UL;
+    for (char &c : s)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        c = (char)x;
+    }
+    return s;
+}
+
+// Replies to the request line "<n>" with the first n bytes of the pattern
+class BulkServer : public LoopbackServer
+{
+public:
+    void service(LoopbackPeer &peer) override
+    {
+        _line.append(reinterpret_cast<const char *>(peer.data()), peer.available());
+        peer.consume(peer.available());
+        size_t eol;
+        while ((eol = _line.find("\r\n")) != std::string::npos)
+        {
+            peer.write(pattern(strtoul(_line.c_str(), nullptr, 10)));
+            _line.erase(0, eol + 2);
+        }
+    }
+
+private:
+    std::string _line;
+};
+
+static bool request(ESP_SSLClient &ssl, size_t len)
+{
+    ssl.print(std::to_string(len).c_str());
+    ssl.print("\r\n");
+    std::string got;
+    for (int i = 0; i < 1000 && got.size() < len; i++)
+    {
+        uint8_t buf[4096];
+        int r = ssl.read(buf, sizeof(buf));
+        if (r > 0)
+            got.append(reinterpret_cast<char *>(buf), r);
+    }
+    return got == pattern(len);
+}
+
+static void adaptive(bool ignoreMaxFragLen, int xmit)
+{
+    BulkServer app;
+    TLSServer server(test_srva_der, sizeof(test_srva_der), test_srva_key, sizeof(test_srva_key), &app);
+    server.ignoreMaxFragLen = ignoreMaxFragLen;
+    LoopbackClient tcp(server);
+    ESP_SSLClient ssl;
+    ssl.setClient(&tcp);
+    ssl.setInsecure();
+    ssl.setAdaptiveBufferSizes(2048, xmit);
+    REQUIRE(ssl.connect("localhost", 465));
+
+    int in = 2048 + IN_OVERHEAD, out = xmit ? xmit + OUT_OVERHEAD : 0;
+    CHECK_EQ(ssl.getInBufferSize(), in);
+    CHECK_EQ(ssl.getOutBufferSize(), out);
+    CHECK_EQ(ssl.getPeakBufferSize(), in + out);
+
+    // The reply comes in the records of the negotiated fragment, or in full records that
+    // grow the receive buffer
+    CHECK(request(ssl, 100));
+    CHECK(request(ssl, 40000));
+    if (ignoreMaxFragLen)
+    {
+        int grown = 16384 + IN_OVERHEAD;
+        CHECK_EQ(ssl.getInBufferSize(), grown);
+        CHECK_EQ(ssl.getOutBufferSize(), out);
+        CHECK_EQ(ssl.getPeakBufferSize(), in + grown + out);
+    }
+    else
+    {
+        CHECK_EQ(ssl.getInBufferSize(), in);
+        CHECK_EQ(ssl.getPeakBufferSize(), in + out);
+    }
+    ssl.stop();
+}
+
+static void pipelined()
+{
+    // The requests span several records and each reply arrives while the next request is
+    // written. The separate buffers take it, the shared buffer would stop the write until
+    // the reply is read, so it is opt-in for the strictly half-duplex use.
+    BulkServer app;
+    TLSServer server(test_srva_der, sizeof(test_srva_der), test_srva_key, sizeof(test_srva_key), &app);
+    LoopbackClient tcp(server);
+    ESP_SSLClient ssl;
+    ssl.setClient(&tcp);
+    ssl.setInsecure();
+    ssl.setAdaptiveBufferSizes(2048, 1024);
+    REQUIRE(ssl.connect("localhost", 465));
+
+    std::string req = std::string(1500, '0') + "3000\r\n";
+    for (int i = 0; i < 5; i++)
+        CHECK_EQ(ssl.write(reinterpret_cast<const uint8_t *>(req.data()), req.size()), req.size());
+    std::string got;
+    for (int i = 0; i < 1000 && got.size() < 15000; i++)
+    {
+        uint8_t buf[4096];
+        int r = ssl.read(buf, sizeof(buf));
+        if (r > 0)
+            got.append(reinterpret_cast<char *>(buf), r);
+    }
+    std::string reply = pattern(3000);
+    CHECK(got == reply + reply + reply + reply + reply);
+    ssl.stop();
+}
+
+static void flushDelay()
+{
+    // The staged data is sent once it is older than the flush delay, at the next write() or
+    // connected() call
+    TLSServer server(test_srva_der, sizeof(test_srva_der), test_srva_key, sizeof(test_srva_key));
+    LoopbackClient tcp(server);
+    ESP_SSLClient ssl;
+    ssl.setClient(&tcp);
+    ssl.setInsecure();
+    ssl.setWriteCoalescing(true, 5);
+    REQUIRE(ssl.connect("localhost", 465));
+
+    host::setVirtualClock(true);
+    ssl.print("ping");
+    ssl.print("\r\n");
+    unsigned long writes = tcp.writes;
+    CHECK(ssl.connected());
+    CHECK_EQ(tcp.writes, writes);
+    delay(5);
+    CHECK(ssl.connected());
+    CHECK(tcp.writes > writes);
+    host::setVirtualClock(false);
+
+    char buf[8];
+    size_t n = 0;
+    for (int i = 0; i < 100 && n < 6; i++)
+    {
+        int r = ssl.read(reinterpret_cast<uint8_t *>(buf) + n, sizeof(buf) - n);
+        if (r > 0)
+            n += r;
+    }
+    CHECK(n == 6 && memcmp(buf, "ping\r\n", 6) == 0);
+    ssl.stop();
+}
+
+// The session is destroyed before the loopback client it uses
+static SMTPSession *session = nullptr;
+
+static void networkStatus() { session->setNetworkStatus(true); }
+
+static void networkConnection() {}
+
+static void smtpsPipelining()
+{
+    SMTPServer app;
+    TLSServer server(test_srva_der, sizeof(test_srva_der), test_srva_key, sizeof(test_srva_key), &app);
+    LoopbackClient client(server);
+    SMTPSession smtp;
+    session = &smtp;
+
+    Session_Config config;
+    config.server.host_name = "127.0.0.1";
+    config.server.port = 465;
+    config.login.email = "me@example.com";
+    config.login.password = "pw";
+    config.login.user_domain = "127.0.0.1";
+    config.secure.mode = esp_mail_secure_mode_ssl_tls;
+
+    smtp.setClient(&client);
+    smtp.networkStatusRequestCallback(networkStatus);
+    smtp.networkConnectionRequestCallback(networkConnection);
+    REQUIRE(smtp.connect(&config));
+
+    // In batch sending, MAIL FROM and RCPT TO are pipelined and their replies, including
+    // the rejection of the recipient, arrive while the client is still writing
+    SMTP_Message messages[2];
+    messages[0].sender.email = "me@example.com";
+    messages[0].subject = "rejected";
+    messages[0].addRecipient("Bad", "bad@example.com");
+    messages[0].text.content = "Not delivered.";
+    messages[0].date = "Mon, 01 Jan 2024 00:00:00 +0000";
+
+    messages[1].sender.name = "Me";
+    messages[1].sender.email = "me@example.com";
+    messages[1].subject = "ESP_Mail_Client SMTPS host test";
+    messages[1].addRecipient("You", "you@example.com");
+    std::string body = pattern(30000);
+    for (char &c : body)
+        c = 'a' + (uint8_t)c % 26;
+    messages[1].text.content = body.c_str();
+    messages[1].date = "Mon, 01 Jan 2024 00:00:00 +0000";
+
+    CHECK(!MailClient.sendMails(&smtp, messages, 2, true));
+    CHECK_EQ(app.rsets, 1ul);
+    CHECK_EQ(server.handshakes, 1ul);
+    CHECK(app.transcript.find("RCPT TO:<bad@example.com>") != std::string::npos);
+    REQUIRE(app.messages.size() == 1);
+    CHECK(app.messages[0].find("From: \"Me\" <me@example.com>\r\n") != std::string::npos);
+    CHECK(app.messages[0].find(body.substr(0, 60)) != std::string::npos);
+}
+
+int main()
+{
+    adaptive(false, 1024);
+    adaptive(true, 1024);
+    adaptive(false, 0);
+    adaptive(true, 0);
+    pipelined();
+    flushDelay();
+    smtpsPipelining();
+    return check_report("tls_buffer_test");
+}
@@ -0,0 +1,116 @@
+/*
+ * TrustAnchorBlob: the blob bounds checks in load() and the trust anchor lookup in TLS
+ * handshakes against the loopback TLS server.
+ */
+#include <client/SSLClient/ESP_SSLClient.h>
+#include <type_traits>
+#include <vector>
+#include "support/TLSServer.h"
+#include "support/check.h"
+#include "support/test_certs.h"
+
+static_assert(!std::is_copy_constructible<TrustAnchorBlob>::value, "TrustAnchorBlob owns its duplicate trust anchors");
+static_assert(!std::is_copy_assignable<TrustAnchorBlob>::value, "TrustAnchorBlob owns its duplicate trust anchors");
+
+static std::vector<uint8_t> buildBlob(const X509List &list)
+{
+    std::vector<uint8_t> blob(TrustAnchorBlob::build(&list, nullptr, 0));
+    CHECK_EQ(TrustAnchorBlob::build(&list, blob.data(), blob.size()), blob.size());
+    return blob;
+}
+
+static void wr32(uint8_t *p, uint32_t v)
+{
+    for (int i = 0; i < 4; i++)
+        p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static bool handshake(TrustAnchorBlob &blob, TLSServer &server)
+{
+    LoopbackClient tcp(server);
+    ESP_SSLClient ssl;
+    ssl.setClient(&tcp);
+    ssl.setCertStore(&blob);
+    ssl.setX509Time(TEST_CERT_TIME);
+    bool ok = ssl.connect("localhost", 465);
+    ssl.stop();
+    return ok;
+}
+
+static void bounds()
+{
+    X509List list(test_ca_a_pem);
+    list.append(test_ca_x_pem);
+    std::vector<uint8_t> blob = buildBlob(list);
+    const size_t header = 12, index = 36;
+    const size_t records = header + 2 * index;
+
+    TrustAnchorBlob tb;
+    CHECK_EQ(tb.load(blob.data(), blob.size()), 2);
+    CHECK_EQ(tb.load(blob.data(), blob.size() - 1), 0);
+
+    // A record offset inside the header or the index is rejected
+    for (size_t offset : {(size_t)0, header, records - 1})
+    {
+        std::vector<uint8_t> bad = blob;
+        wr32(bad.data() + header + index + 32, offset);
+        CHECK_EQ(tb.load(bad.data(), bad.size()), 0);
+        CHECK_EQ(tb.getCount(), 0u);
+    }
+
+    // As is a record past the end, also where the offset plus the record size wraps a 32-bit size_t
+    for (size_t offset : {blob.size() - 4, blob.size() + 1, (size_t)0xfffffffc, (size_t)0xffffffff})
+    {
+        std::vector<uint8_t> bad = blob;
+        wr32(bad.data() + header + 32, (uint32_t)offset);
+        CHECK_EQ(tb.load(bad.data(), bad.size()), 0);
+    }
+
+    // And a DN or key length past the end
+    const size_t rec = blob[header + 32] | blob[header + 33] << 8 | blob[header + 34] << 16 | (size_t)blob[header + 35] << 24;
+    for (size_t field : {rec, rec + 6})
+    {
+        std::vector<uint8_t> bad = blob;
+        bad[field] = bad[field + 1] = 0xff;
+        CHECK_EQ(tb.load(bad.data(), bad.size()), 0);
+    }
+
+    // A count with the index past the total size
+    std::vector<uint8_t> bad = blob;
+    bad[6] = 0xff;
+    CHECK_EQ(tb.load(bad.data(), bad.size()), 0);
+}
+
+static void handshakes()
+{
+    TLSServer serverA(test_srva_der, sizeof(test_srva_der), test_srva_key, sizeof(test_srva_key));
+    TLSServer serverD(test_srvd_der, sizeof(test_srvd_der), test_srvd_key, sizeof(test_srvd_key));
+    TLSServer serverX(test_srvx_der, sizeof(test_srvx_der), test_srvx_key, sizeof(test_srvx_key));
+
+    // The two roots with the DN of the srvD issuer are both tried
+    X509List list(test_ca_a_pem);
+    list.append(test_ca_d1_pem);
+    list.append(test_ca_d2_pem);
+    std::vector<uint8_t> blob = buildBlob(list);
+
+    TrustAnchorBlob tb(blob.data(), blob.size());
+    REQUIRE(tb.getCount() == 3);
+    CHECK(handshake(tb, serverA));
+    CHECK(handshake(tb, serverD));
+    CHECK(!handshake(tb, serverX));
+
+    // Without D2 the srvD issuer key does not match
+    X509List list1(test_ca_a_pem);
+    list1.append(test_ca_d1_pem);
+    std::vector<uint8_t> blob1 = buildBlob(list1);
+    TrustAnchorBlob tb1(blob1.data(), blob1.size());
+    CHECK(handshake(tb1, serverA));
+    CHECK(!handshake(tb1, serverD));
+}
+
+int main()
+{
+    bounds();
+    handshakes();
+    return check_report("trust_anchor_blob_test");
+}
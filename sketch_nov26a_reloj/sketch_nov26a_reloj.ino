@@ -37,6 +37,7 @@ void setup() {
   Wire.begin(SDA_PIN, SCL_PIN);
   lcd.init();
   lcd.backlight();
+  lcd.setFramebuffer(true);  // solo se envían los caracteres que cambian
 
   WiFi.begin(ssid, password);
   while (WiFi.status() != WL_CONNECTED) {
@@ -90,6 +91,7 @@ void loop() {
   lcd.setCursor(0,1);
   lcd.printf("Hora: %02d:%02d:%02d",
     timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
+  lcd.flush();
 
   delay(1000);
 }